@@ -794,6 +794,10 @@ static void OnStateRestored()
 
     auto& pAssets = ra::services::ServiceLocator::GetMutable<ra::data::context::GameContext>().Assets();
     pAssets.BeginUpdate();
+
+    // synchronizing states may change several properties of every asset. only notify the asset list once per
+    // asset/property after everything has been synchronized.
+    pAssets.BeginNotificationBatch();
     for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(pAssets.Count()); ++nIndex)
     {
         auto* pAsset = pAssets.GetItemAt(nIndex);
@@ -842,6 +846,7 @@ static void OnStateRestored()
             }
         }
     }
+    pAssets.EndNotificationBatch();
     pAssets.EndUpdate();
 
 #ifndef RA_UTEST
@@ -110,7 +110,7 @@ API int CCONV _RA_Shutdown()
     if (!ra::services::ServiceLocator::Get<ra::services::IConfiguration>()
         .IsFeatureEnabled(ra::services::Feature::Offline))
     {
-        ra::services::ServiceLocator::Get<ra::services::GameIdentifier>().SaveKnownHashes();
+        ra::services::ServiceLocator::GetMutable<ra::services::GameIdentifier>().SaveKnownHashes();
     }
 
     ra::services::ServiceLocator::Get<ra::services::IConfiguration>().Save();
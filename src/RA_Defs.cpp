@@ -10,12 +10,21 @@ namespace ra {
 
 _Use_decl_annotations_
 std::string ByteAddressToString(ByteAddress nAddr)
+{
+    FixedString<char, 10> sAddress;
+    AppendByteAddress(sAddress, nAddr);
+    return std::string(sAddress.View());
+}
+
+_Use_decl_annotations_
+size_t ByteAddressDigits(ByteAddress nAddr)
 {
 #ifndef RA_UTEST
     const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
-    return pEmulatorContext.FormatAddress(nAddr);
+    return pEmulatorContext.GetAddressDigits(nAddr);
 #else
-    return ra::StringPrintf("0x%04x", nAddr);
+    (void)nAddr;
+    return 4;
 #endif
 }
 
@@ -80,18 +89,16 @@ std::wstring MemSizeFormat(unsigned nValue, MemSize nSize, MemFormat nFormat)
             return U32ToFloatString(nValue, RC_MEMSIZE_MBF32_LE);
 
         default:
+        {
             if (nFormat == MemFormat::Dec)
                 return std::to_wstring(nValue);
 
-            const auto nBits = MemSizeBits(nSize);
-            switch (nBits / 8)
-            {
-                default: return ra::StringPrintf(L"%x", nValue);
-                case 1: return ra::StringPrintf(L"%02x", nValue);
-                case 2: return ra::StringPrintf(L"%04x", nValue);
-                case 3: return ra::StringPrintf(L"%06x", nValue);
-                case 4: return ra::StringPrintf(L"%08x", nValue);
-            }
+            // called for every changed bookmark each frame, so avoid the StringPrintf overhead
+            const auto nBytes = MemSizeBits(nSize) / 8;
+            FixedString<wchar_t, 8> sValue;
+            sValue.AppendHex(nValue, (nBytes <= 4) ? nBytes * 2 : 0);
+            return std::wstring(sValue.View());
+        }
     }
 }
 
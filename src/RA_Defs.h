@@ -45,6 +45,7 @@ using namespace std::string_literals;
 #define RA_GAME_HASH_FILENAME           RA_DIR_DATA L"gamehashlibrary.txt"
 #define RA_MY_PROGRESS_FILENAME         RA_DIR_DATA L"myprogress.txt"
 #define RA_MY_GAME_LIBRARY_FILENAME     RA_DIR_DATA L"mygamelibrary.txt"
+#define RA_MY_GAME_LIBRARY_INDEX_FILENAME RA_DIR_DATA L"mygamelibrary.idx"
 
 #define RA_NEWS_FILENAME                RA_DIR_DATA L"ra_news.txt"
 #define RA_TITLES_FILENAME              RA_DIR_DATA L"gametitles.txt"
@@ -166,6 +167,18 @@ public:
 
 namespace ra {
 _NODISCARD std::string ByteAddressToString(_In_ ByteAddress nAddr);
+_NODISCARD size_t ByteAddressDigits(_In_ ByteAddress nAddr);
+
+/// <summary>
+/// Appends the displayable representation of an address (as returned by <see cref="ByteAddressToString" />)
+/// without allocating.
+/// </summary>
+template<typename CharT, size_t N>
+void AppendByteAddress(_Inout_ FixedString<CharT, N>& sBuffer, _In_ ByteAddress nAddr)
+{
+    sBuffer.Append(CharT('0')).Append(CharT('x')).AppendHex(nAddr, ByteAddressDigits(nAddr));
+}
+
 _NODISCARD ByteAddress ByteAddressFromString(_In_ const std::string& sByteAddress);
 } // namespace ra
 
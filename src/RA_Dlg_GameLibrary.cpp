@@ -20,15 +20,9 @@ inline constexpr std::array<LPCTSTR, 4> COL_TITLE{_T("ID"), _T("Game Title"), _T
 inline constexpr std::array<int, 4> COL_SIZE{30, 230, 110, 170};
 inline constexpr auto bCancelScan = false;
 
-std::mutex mtx;
-
 // static
-std::deque<std::string> Dlg_GameLibrary::FilesToScan;
-std::map<std::string, std::string> Dlg_GameLibrary::Results;        //	filepath,md5
 std::map<std::string, std::string> Dlg_GameLibrary::VisibleResults; //	filepath,md5
 size_t Dlg_GameLibrary::nNumParsed = 0;
-bool Dlg_GameLibrary::ThreadProcessingAllowed = true;
-bool Dlg_GameLibrary::ThreadProcessingActive = false;
 
 Dlg_GameLibrary g_GameLibrary;
 
@@ -262,47 +256,18 @@ void Dlg_GameLibrary::ClearTitles() noexcept
     VisibleResults.clear();
 }
 
-// static
-void Dlg_GameLibrary::ThreadedScanProc()
+void Dlg_GameLibrary::UpdateScanProgress()
 {
-    Dlg_GameLibrary::ThreadProcessingActive = true;
-
-    while (FilesToScan.size() > 0)
-    {
-        mtx.lock();
-        if (!Dlg_GameLibrary::ThreadProcessingAllowed)
-        {
-            mtx.unlock();
-            break;
-        }
-        mtx.unlock();
-
-        FILE* pf = nullptr;
-        if ((fopen_s(&pf, FilesToScan.front().c_str(), "rb") == 0) && pf)
-        {
-            // obtain file size:
-            fseek(pf, 0, SEEK_END);
-            const DWORD nSize = ftell(pf);
-            rewind(pf);
-
-            auto pBuf = std::make_unique<unsigned char[]>(6 * 1024 * 1024);
-
-            fread(pBuf.get(), sizeof(unsigned char), nSize, pf); // Check
-            Results.insert_or_assign(FilesToScan.front(), RAGenerateMD5(pBuf.get(), nSize));
-            pBuf.reset();
-
-            SendMessage(g_GameLibrary.GetHWND(), WM_TIMER, 0U, 0L);
-
-            fclose(pf);
-        }
-
-        mtx.lock();
-        FilesToScan.pop_front();
-        mtx.unlock();
-    }
+    const auto pProgress = m_oScanner.GetProgress();
+    if (pProgress.nFilesTotal == 0)
+        return;
 
-    Dlg_GameLibrary::ThreadProcessingActive = false;
-    ExitThread(0);
+    const auto sProgress = pProgress.bComplete ?
+        ra::StringPrintf(L"Scanning complete: %zu files (%zu unchanged), %0.1f MB/s", pProgress.nFilesProcessed,
+            pProgress.nFilesSkipped, pProgress.fMegabytesPerSecond) :
+        ra::StringPrintf(L"Scanning %zu/%zu: %0.1f files/s, %0.1f MB/s", pProgress.nFilesProcessed,
+            pProgress.nFilesTotal, pProgress.fFilesPerSecond, pProgress.fMegabytesPerSecond);
+    SetDlgItemText(m_hDialogBox, IDC_RA_SCANNERFOUNDINFO, NativeStr(sProgress).c_str());
 }
 
 void Dlg_GameLibrary::ScanAndAddRomsRecursive(const std::string& sBaseDir)
@@ -401,27 +366,36 @@ void Dlg_GameLibrary::ReloadGameListData()
     TCHAR sROMDir[1024];
     GetDlgItemText(m_hDialogBox, IDC_RA_ROMDIR, sROMDir, 1024);
 
-    mtx.lock();
-    while (FilesToScan.size() > 0)
-        FilesToScan.pop_front();
-    mtx.unlock();
-
-    bool bOK = ListFiles(ra::Narrow(sROMDir), "*.bin", FilesToScan);
-    bOK |= ListFiles(ra::Narrow(sROMDir), "*.gen", FilesToScan);
+    std::deque<std::string> vFilesToScan;
+    bool bOK = ListFiles(ra::Narrow(sROMDir), "*.bin", vFilesToScan);
+    bOK |= ListFiles(ra::Narrow(sROMDir), "*.gen", vFilesToScan);
 
     if (bOK)
     {
-        std::thread scanner(&Dlg_GameLibrary::ThreadedScanProc);
-        scanner.detach();
+        std::vector<std::wstring> vFiles;
+        vFiles.reserve(vFilesToScan.size());
+        for (const auto& sFile : vFilesToScan)
+            vFiles.push_back(ra::Widen(sFile));
+
+        // the scanner reports progress from the background threads. only post a refresh if the previous one has
+        // been processed so a fast scan of unchanged files doesn't flood the message queue
+        m_oScanner.SetProgressHandler([this]()
+        {
+            if (!m_bRefreshPending.exchange(true))
+                PostMessage(m_hDialogBox, WM_TIMER, 0U, 0L);
+        });
+
+        m_oScanner.Scan(std::move(vFiles));
     }
 }
 
 void Dlg_GameLibrary::RefreshList()
 {
-    std::map<std::string, std::string>::iterator iter = Results.begin();
-    while (iter != Results.end())
+    const auto mHashes = m_oScanner.GetHashes();
+    auto iter = mHashes.begin();
+    while (iter != mHashes.end())
     {
-        const std::string& filepath = iter->first;
+        const std::string filepath = ra::Narrow(iter->first);
         const std::string& md5 = iter->second;
 
         if (VisibleResults.find(filepath) == VisibleResults.end())
@@ -468,9 +442,13 @@ BOOL Dlg_GameLibrary::LaunchSelected()
 void Dlg_GameLibrary::LoadAll()
 {
     auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    if (m_oScanner.LoadIndex(pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_INDEX_FILENAME))
+        return;
+
+    // no index yet. import the hashes from the old text format. they'll be rehashed the next time the library
+    // is scanned to capture the size and modification time of each file.
     std::wstring sMyGameLibraryFile = pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME;
     {
-        std::scoped_lock lock{mtx};
         std::ifstream ifile{sMyGameLibraryFile, std::ios::binary};
         if (ifile.is_open())
         {
@@ -498,7 +476,7 @@ void Dlg_GameLibrary::LoadAll()
                     std::string file{fileBuf.data()};
                     std::string md5{md5Buf.data()};
 
-                    Results.try_emplace(file, md5);
+                    m_oScanner.AddHash(ra::Widen(file), md5);
                 }
 
             } while (nCharsRead1 > 0 && nCharsRead2 > 0);
@@ -509,30 +487,7 @@ void Dlg_GameLibrary::LoadAll()
 void Dlg_GameLibrary::SaveAll()
 {
     auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    std::wstring sMyGameLibraryFile = pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME;
-
-    mtx.lock();
-    FILE* pf = nullptr;
-    _wfopen_s(&pf, sMyGameLibraryFile.c_str(), L"wb");
-    if (pf != nullptr)
-    {
-        std::map<std::string, std::string>::iterator iter = Results.begin();
-        while (iter != Results.end())
-        {
-            const std::string& sFilepath = iter->first;
-            const std::string& sMD5 = iter->second;
-
-            fwrite(sFilepath.c_str(), sizeof(char), strlen(sFilepath.c_str()), pf);
-            fwrite("\n", sizeof(char), 1, pf);
-            fwrite(sMD5.c_str(), sizeof(char), strlen(sMD5.c_str()), pf);
-            fwrite("\n", sizeof(char), 1, pf);
-
-            iter++;
-        }
-
-        fclose(pf);
-    }
-    mtx.unlock();
+    m_oScanner.SaveIndex(pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_INDEX_FILENAME);
 }
 
 // static
@@ -571,8 +526,12 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
         }
 
         case WM_TIMER:
+            m_bRefreshPending = false;
             if ((g_GameLibrary.GetHWND() != nullptr) && (IsWindowVisible(g_GameLibrary.GetHWND())))
+            {
                 RefreshList();
+                UpdateScanProgress();
+            }
             // ReloadGameListData();
             return FALSE;
 
@@ -639,11 +598,8 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
                     }
 
                 case IDC_RA_RESCAN:
-                    ReloadGameListData();
-
-                    mtx.lock(); //?
                     SetDlgItemText(m_hDialogBox, IDC_RA_SCANNERFOUNDINFO, TEXT("Scanning..."));
-                    mtx.unlock();
+                    ReloadGameListData();
                     return FALSE;
 
                 case IDC_RA_PICKROMDIR:
@@ -682,8 +638,7 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
             }
 
         case WM_PAINT:
-            if (nNumParsed != Results.size())
-                nNumParsed = Results.size();
+            nNumParsed = m_oScanner.GetProgress().nFilesProcessed;
             return FALSE;
 
         case WM_CLOSE:
@@ -700,12 +655,7 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
 
 void Dlg_GameLibrary::KillThread()
 {
-    Dlg_GameLibrary::ThreadProcessingAllowed = false;
-    while (Dlg_GameLibrary::ThreadProcessingActive)
-    {
-        RA_LOG_INFO("Waiting for background scanner...");
-        Sleep(200);
-    }
+    m_oScanner.CancelAndWait();
 }
 
 ////static
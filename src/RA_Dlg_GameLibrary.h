@@ -4,6 +4,8 @@
 
 #include "ra_fwd.h"
 
+#include "services\RomLibraryScanner.hh"
+
 class GameEntry
 {
 public:
@@ -50,14 +52,13 @@ private:
     void RefreshList();
 
 private:
-    static std::deque<std::string> FilesToScan;
-    static std::map<std::string, std::string> Results;			//	filepath,md5 (parsed/persisted)
+    void UpdateScanProgress();
+
     static std::map<std::string, std::string> VisibleResults;	//	filepath,md5 (added to renderable)
     static size_t nNumParsed;
 
-    static void ThreadedScanProc();
-    static bool ThreadProcessingAllowed;
-    static bool ThreadProcessingActive;
+    ra::services::RomLibraryScanner m_oScanner;
+    std::atomic<bool> m_bRefreshPending{ false };
 
 private:
     HWND m_hDialogBox{};
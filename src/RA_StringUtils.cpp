@@ -75,6 +75,144 @@ std::string Narrow(const std::string& str)
     return str;
 }
 
+_Use_decl_annotations_
+std::wstring_view Widen(std::string_view sText, std::wstring& sBuffer)
+{
+    // each UTF-8 byte generates at most one UTF-16 code unit
+    sBuffer.resize(sText.length());
+
+    const auto nLength = sText.length();
+    size_t nIndex = 0;
+    size_t nOut = 0;
+    while (nIndex < nLength)
+    {
+        const auto c = gsl::narrow_cast<unsigned char>(sText[nIndex]);
+        if (c < 0x80)
+        {
+            sBuffer[nOut++] = c;
+            ++nIndex;
+            continue;
+        }
+
+        uint32_t nCodePoint = 0;
+        uint32_t nMinimum = 0;
+        size_t nBytes = 0;
+        if ((c & 0xE0) == 0xC0)
+        {
+            nCodePoint = c & 0x1F;
+            nMinimum = 0x80;
+            nBytes = 2;
+        }
+        else if ((c & 0xF0) == 0xE0)
+        {
+            nCodePoint = c & 0x0F;
+            nMinimum = 0x800;
+            nBytes = 3;
+        }
+        else if ((c & 0xF8) == 0xF0)
+        {
+            nCodePoint = c & 0x07;
+            nMinimum = 0x10000;
+            nBytes = 4;
+        }
+        else
+        {
+            // unexpected continuation byte or invalid lead byte
+            sBuffer[nOut++] = 0xFFFD;
+            ++nIndex;
+            continue;
+        }
+
+        size_t nRead = 1;
+        while (nRead < nBytes && nIndex + nRead < nLength)
+        {
+            const auto c2 = gsl::narrow_cast<unsigned char>(sText[nIndex + nRead]);
+            if ((c2 & 0xC0) != 0x80)
+                break;
+
+            nCodePoint = (nCodePoint << 6) | (c2 & 0x3F);
+            ++nRead;
+        }
+
+        nIndex += nRead;
+
+        if (nRead < nBytes || nCodePoint < nMinimum || nCodePoint > 0x10FFFF ||
+            (nCodePoint >= 0xD800 && nCodePoint <= 0xDFFF))
+        {
+            // truncated sequence, overlong encoding, or value that can't be represented in UTF-16
+            sBuffer[nOut++] = 0xFFFD;
+        }
+        else if (nCodePoint >= 0x10000)
+        {
+            nCodePoint -= 0x10000;
+            sBuffer[nOut++] = gsl::narrow_cast<wchar_t>(0xD800 | (nCodePoint >> 10));
+            sBuffer[nOut++] = gsl::narrow_cast<wchar_t>(0xDC00 | (nCodePoint & 0x3FF));
+        }
+        else
+        {
+            sBuffer[nOut++] = gsl::narrow_cast<wchar_t>(nCodePoint);
+        }
+    }
+
+    sBuffer.resize(nOut);
+    return sBuffer;
+}
+
+_Use_decl_annotations_
+std::string_view Narrow(std::wstring_view sText, std::string& sBuffer)
+{
+    // each UTF-16 code unit generates at most three UTF-8 bytes (surrogate pairs generate four bytes from two)
+    sBuffer.resize(sText.length() * 3);
+
+    const auto nLength = sText.length();
+    size_t nIndex = 0;
+    size_t nOut = 0;
+    while (nIndex < nLength)
+    {
+        uint32_t nCodePoint = gsl::narrow_cast<uint32_t>(sText[nIndex++]);
+        if (nCodePoint < 0x80)
+        {
+            sBuffer[nOut++] = gsl::narrow_cast<char>(nCodePoint);
+            continue;
+        }
+
+        if (nCodePoint >= 0xD800 && nCodePoint <= 0xDFFF)
+        {
+            const auto nLow = (nIndex < nLength) ? gsl::narrow_cast<uint32_t>(sText[nIndex]) : 0U;
+            if (nCodePoint <= 0xDBFF && nLow >= 0xDC00 && nLow <= 0xDFFF)
+            {
+                nCodePoint = 0x10000 + ((nCodePoint - 0xD800) << 10) + (nLow - 0xDC00);
+                ++nIndex;
+            }
+            else
+            {
+                nCodePoint = 0xFFFD;
+            }
+        }
+
+        if (nCodePoint < 0x800)
+        {
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0xC0 | (nCodePoint >> 6));
+        }
+        else if (nCodePoint < 0x10000)
+        {
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0xE0 | (nCodePoint >> 12));
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F));
+        }
+        else
+        {
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0xF0 | (nCodePoint >> 18));
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0x80 | ((nCodePoint >> 12) & 0x3F));
+            sBuffer[nOut++] = gsl::narrow_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F));
+        }
+
+        sBuffer[nOut++] = gsl::narrow_cast<char>(0x80 | (nCodePoint & 0x3F));
+    }
+
+    sBuffer.resize(nOut);
+    return sBuffer;
+}
+
 _Use_decl_annotations_
 bool ParseUnsignedInt(const std::wstring& sValue, unsigned int nMaximumValue, unsigned int& nValue, std::wstring& sError)
 {
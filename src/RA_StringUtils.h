@@ -20,6 +20,26 @@ _NODISCARD std::wstring Widen(_In_ const std::wstring& wstr);
 _NODISCARD std::string Narrow(_In_z_ const char* str);
 _NODISCARD std::string Narrow(_In_ const std::string& wstr);
 
+/// <summary>
+/// Converts a UTF-8 string to UTF-16, replacing the contents of <paramref name="sBuffer" />.
+/// </summary>
+/// <returns>A view of <paramref name="sBuffer" />, which is valid until the buffer is modified.</returns>
+/// <remarks>
+/// Keeping <paramref name="sBuffer" /> around between calls allows its capacity to be reused, so repeated
+/// conversions don't allocate memory. Invalid sequences are replaced with U+FFFD.
+/// </remarks>
+std::wstring_view Widen(std::string_view sText, _Inout_ std::wstring& sBuffer);
+
+/// <summary>
+/// Converts a UTF-16 string to UTF-8, replacing the contents of <paramref name="sBuffer" />.
+/// </summary>
+/// <returns>A view of <paramref name="sBuffer" />, which is valid until the buffer is modified.</returns>
+/// <remarks>
+/// Keeping <paramref name="sBuffer" /> around between calls allows its capacity to be reused, so repeated
+/// conversions don't allocate memory. Unpaired surrogates are replaced with U+FFFD.
+/// </remarks>
+std::string_view Narrow(std::wstring_view sText, _Inout_ std::string& sBuffer);
+
 bool ParseUnsignedInt(const std::wstring& sValue, unsigned int nMaximumValue, _Out_ unsigned int& nValue, _Out_ std::wstring& sError);
 bool ParseHex(const std::wstring& sValue, unsigned int nMaximumValue, _Out_ unsigned int& nValue, _Out_ std::wstring& sError);
 bool ParseFloat(const std::wstring& sValue, _Out_ float& fValue, _Out_ std::wstring& sError);
@@ -590,6 +610,150 @@ _NODISCARD inline auto StringPrintf(_In_z_ _Printf_format_string_ const CharT* c
     }
 }
 
+// ----- allocation-free formatting -----
+
+/// <summary>
+/// A fixed-capacity, null-terminated string that can be built without allocating memory. Text that doesn't fit
+/// is truncated.
+/// </summary>
+/// <remarks>
+/// Intended for short strings that are rebuilt frequently (per row or per frame), like addresses and counters.
+/// </remarks>
+template<typename CharT, size_t N, typename = std::enable_if_t<is_char_v<CharT>>>
+class FixedString
+{
+public:
+    FixedString() noexcept = default;
+    explicit FixedString(std::basic_string_view<CharT> sText) noexcept { Append(sText); }
+
+    /// <summary>
+    /// Gets the number of characters the string can hold (not including the null terminator).
+    /// </summary>
+    static constexpr size_t Capacity() noexcept { return N; }
+
+    /// <summary>
+    /// Gets the number of characters in the string.
+    /// </summary>
+    _NODISCARD size_t Length() const noexcept { return m_nLength; }
+
+    /// <summary>
+    /// Determines whether the string is empty.
+    /// </summary>
+    _NODISCARD bool IsEmpty() const noexcept { return (m_nLength == 0); }
+
+    /// <summary>
+    /// Determines whether any text was discarded because the string was full.
+    /// </summary>
+    _NODISCARD bool IsTruncated() const noexcept { return m_bTruncated; }
+
+    /// <summary>
+    /// Gets a pointer to the null-terminated string.
+    /// </summary>
+    _NODISCARD const CharT* GetString() const noexcept { return m_pBuffer.data(); }
+
+    /// <summary>
+    /// Gets a view of the string, which is valid until the string is modified.
+    /// </summary>
+    _NODISCARD std::basic_string_view<CharT> View() const noexcept { return {m_pBuffer.data(), m_nLength}; }
+    operator std::basic_string_view<CharT>() const noexcept { return View(); }
+
+    /// <summary>
+    /// Empties the string.
+    /// </summary>
+    void Clear() noexcept
+    {
+        m_nLength = 0;
+        m_pBuffer.front() = '\0';
+        m_bTruncated = false;
+    }
+
+    /// <summary>
+    /// Appends a single character.
+    /// </summary>
+    FixedString& Append(CharT c) noexcept
+    {
+        if (m_nLength < N)
+        {
+            GSL_SUPPRESS_BOUNDS4 m_pBuffer[m_nLength++] = c;
+            GSL_SUPPRESS_BOUNDS4 m_pBuffer[m_nLength] = '\0';
+        }
+        else
+        {
+            m_bTruncated = true;
+        }
+
+        return *this;
+    }
+
+    /// <summary>
+    /// Appends a string.
+    /// </summary>
+    FixedString& Append(std::basic_string_view<CharT> sText) noexcept
+    {
+        auto nCount = sText.length();
+        if (nCount > N - m_nLength)
+        {
+            nCount = N - m_nLength;
+            m_bTruncated = true;
+        }
+
+        std::char_traits<CharT>::copy(m_pBuffer.data() + m_nLength, sText.data(), nCount);
+        m_nLength += nCount;
+        GSL_SUPPRESS_BOUNDS4 m_pBuffer[m_nLength] = '\0';
+        return *this;
+    }
+
+    /// <summary>
+    /// Appends the decimal representation of an integer.
+    /// </summary>
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedString& AppendDecimal(T nValue) noexcept
+    {
+        std::array<char, 24> pDigits{};
+        const auto pResult = std::to_chars(pDigits.data(), pDigits.data() + pDigits.size(), nValue);
+        return AppendDigits(pDigits.data(), pResult.ptr, 0);
+    }
+
+    /// <summary>
+    /// Appends the hexadecimal representation of an unsigned integer.
+    /// </summary>
+    /// <param name="nMinDigits">The number of digits to zero-pad the value to.</param>
+    /// <param name="bUppercase"><c>true</c> to use uppercase letters for the digits A-F.</param>
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>>>
+    FixedString& AppendHex(T nValue, size_t nMinDigits = 0, bool bUppercase = false) noexcept
+    {
+        std::array<char, 24> pDigits{};
+        const auto pResult = std::to_chars(pDigits.data(), pDigits.data() + pDigits.size(), nValue, 16);
+        if (bUppercase)
+        {
+            for (auto* pDigit = pDigits.data(); pDigit < pResult.ptr; ++pDigit)
+            {
+                if (*pDigit >= 'a')
+                    *pDigit -= ('a' - 'A');
+            }
+        }
+
+        return AppendDigits(pDigits.data(), pResult.ptr, nMinDigits);
+    }
+
+private:
+    FixedString& AppendDigits(const char* pStart, const char* pEnd, size_t nMinDigits) noexcept
+    {
+        for (auto nDigits = gsl::narrow_cast<size_t>(pEnd - pStart); nDigits < nMinDigits; ++nDigits)
+            Append(CharT('0'));
+
+        // digits are ASCII, so they can be copied directly into either character type
+        for (; pStart < pEnd; ++pStart)
+            Append(gsl::narrow_cast<CharT>(*pStart));
+
+        return *this;
+    }
+
+    std::array<CharT, N + 1> m_pBuffer{};
+    size_t m_nLength = 0;
+    bool m_bTruncated = false;
+};
+
 // ----- string parsing -----
 
 class Tokenizer
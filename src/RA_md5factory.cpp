@@ -2,8 +2,7 @@
 
 #include "RA_Defs.h"
 
-#include "services\IFileSystem.hh"
-#include "services\ServiceLocator.hh"
+#include "services\FileHasher.hh"
 
 #include <rcheevos/src/rhash/md5.h>
 
@@ -63,28 +62,9 @@ std::string RAGenerateMD5(const std::vector<BYTE> DataIn)
 
 std::string RAGenerateFileMD5(const std::wstring& sPath)
 {
-    md5_state_t pms{};
-    md5_byte_t digest[16]{};
-
-    md5_byte_t bytes[4096]{};
-    static_assert(sizeof(md5_byte_t) == sizeof(uint8_t), "Must be equivalent for the MD5 to work!");
-
-    auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    auto pFile = pFileSystem.OpenTextFile(sPath);
-    if (pFile == nullptr)
+    ra::services::FileHasher pHasher(ra::services::HashAlgorithm::MD5);
+    if (!pHasher.AppendFile(sPath))
         return "";
 
-    md5_init(&pms);
-    do
-    {
-        size_t nBytes = pFile->GetBytes(static_cast<uint8_t*>(bytes), sizeof(bytes));
-        if (nBytes == 0)
-            break;
-
-        md5_append(&pms, bytes, gsl::narrow_cast<int>(nBytes));
-    } while (true);
-    md5_finish(&pms, digest);
-
-    return RAFormatMD5(digest);
+    return pHasher.GetMD5();
 }
-
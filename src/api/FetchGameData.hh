@@ -51,6 +51,18 @@ public:
     {
         unsigned int GameId{ 0U };
 
+        /// <summary>
+        /// If set, called for each achievement as it's read instead of adding it to the response. The object is
+        /// reused for the next achievement, so it must not be retained.
+        /// </summary>
+        std::function<void(const Response::Achievement&)> AchievementHandler;
+
+        /// <summary>
+        /// If set, called for each leaderboard as it's read instead of adding it to the response. The object is
+        /// reused for the next leaderboard, so it must not be retained.
+        /// </summary>
+        std::function<void(const Response::Leaderboard&)> LeaderboardHandler;
+
         using Callback = std::function<void(const Response& response)>;
 
         Response Call() const;
@@ -1,6 +1,7 @@
 #include "ConnectedServer.hh"
 
 #include "DisconnectedServer.hh"
+#include "PatchDataParser.hh"
 #include "RA_Defs.h"
 
 #include "RA_md5factory.h"
@@ -8,6 +9,7 @@
 #include "data\context\UserContext.hh"
 
 #include "services\Http.hh"
+#include "services\IClock.hh"
 #include "services\IFileSystem.hh"
 #include "services\IHttpRequester.hh"
 #include "services\ILocalStorage.hh"
@@ -17,7 +19,6 @@
 
 #include <rapidjson\document.h>
 
-#include <rcheevos\src\rapi\rc_api_common.h> // for parsing cached patchdata response
 #include <rc_api_editor.h>
 #include <rc_api_info.h>
 #include <rc_api_runtime.h>
@@ -53,6 +54,23 @@ _NODISCARD static bool HandleHttpError(_In_ const ra::services::Http::StatusCode
     return false;
 }
 
+#ifndef RA_UTEST
+// some responses (like patch data) can be hundreds of KB. only log the start of them.
+static constexpr size_t MAX_LOGGED_RESPONSE_LENGTH = 512;
+
+_NODISCARD static std::string SummarizeResponse(_In_ const std::string& sContent)
+{
+    if (sContent.length() <= MAX_LOGGED_RESPONSE_LENGTH)
+        return sContent;
+
+    std::string sSummary(sContent, 0, MAX_LOGGED_RESPONSE_LENGTH);
+    sSummary.append("... (");
+    sSummary.append(std::to_string(sContent.length()));
+    sSummary.append(" bytes)");
+    return sSummary;
+}
+#endif
+
 _NODISCARD static bool GetJson([[maybe_unused]] _In_ const char* sApiName,
                                _In_ const ra::services::Http::Response& httpResponse,
                                _Inout_ ApiResponseBase& pResponse, _Out_ rapidjson::Document& pDocument)
@@ -71,7 +89,7 @@ _NODISCARD static bool GetJson([[maybe_unused]] _In_ const char* sApiName,
         return false;
     }
 
-    RA_LOG_INFO("-- %s Response: %s", sApiName, httpResponse.Content());
+    RA_LOG_INFO("-- %s Response: %s", sApiName, SummarizeResponse(httpResponse.Content()));
 
     pDocument.Parse(httpResponse.Content());
     if (pDocument.HasParseError())
@@ -274,7 +292,7 @@ static bool DoRequestWithoutLog(const rc_api_request_t& api_request, _UNUSED con
         return false;
     }
 
-    RA_LOG_INFO("-- %s Response: %s", sApiName, pHttpResponse.Content());
+    RA_LOG_INFO("-- %s Response: %s", sApiName, SummarizeResponse(pHttpResponse.Content()));
 
     switch (pHttpResponse.Content().at(0))
     {
@@ -778,6 +796,32 @@ ResolveHash::Response ConnectedServer::ResolveHash(const ResolveHash::Request& r
     return response;
 }
 
+static void ValidateGamePatchData(PatchDataParser::Result nResult, const PatchDataParser& pParser,
+    ra::services::Http::StatusCode nStatusCode, FetchGameData::Response& response)
+{
+    int nParseResult = RC_OK;
+    switch (nResult)
+    {
+        case PatchDataParser::Result::InvalidJson:
+            nParseResult = RC_INVALID_JSON;
+            break;
+
+        case PatchDataParser::Result::MissingValue:
+            nParseResult = RC_MISSING_VALUE;
+            break;
+
+        default:
+            break;
+    }
+
+    rc_api_response_t api_response{};
+    api_response.succeeded = pParser.Succeeded() ? 1 : 0;
+    api_response.error_message = pParser.GetErrorMessage().c_str();
+
+    if (ValidateResponse(nParseResult, api_response, FetchGameData::Name(), nStatusCode, response))
+        response.Result = ApiResult::Success;
+}
+
 FetchGameData::Response ConnectedServer::FetchGameData(const FetchGameData::Request& request)
 {
     FetchGameData::Response response;
@@ -796,30 +840,33 @@ FetchGameData::Response ConnectedServer::FetchGameData(const FetchGameData::Requ
         ra::services::Http::Response httpResponse;
         if (DoRequest(api_request, FetchGameData::Name(), httpResponse, response))
         {
-            // process it
-            ProcessGamePatchData(response, httpResponse);
+#ifndef RA_UTEST
+            const auto tStart = ra::services::ServiceLocator::Get<ra::services::IClock>().UpTime();
+#endif
+
+            // the assets are read directly out of the response as it's parsed
+            PatchDataParser pParser(request, response);
+            const auto nResult = pParser.ParseServerResponse(httpResponse.Content());
+            ValidateGamePatchData(nResult, pParser, httpResponse.StatusCode(), response);
+
+#ifndef RA_UTEST
+            const auto tElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                ra::services::ServiceLocator::Get<ra::services::IClock>().UpTime() - tStart);
+            RA_LOG_INFO("-- %s: read %zu achievements and %zu leaderboards from %zu bytes in %dms", FetchGameData::Name(),
+                pParser.GetAchievementCount(), pParser.GetLeaderboardCount(), httpResponse.Content().length(),
+                gsl::narrow_cast<int>(tElapsed.count()));
+#endif
 
             if (response.Result == ApiResult::Success)
             {
-                // extract the PatchData and store a copy in the cache for offline mode
-                rc_api_response_t api_response{};
-                rc_json_field_t fields[] = {
-                    {"Success"},
-                    {"Error"},
-                    {"PatchData"}
-                };
-
-                if (rc_json_parse_response(&api_response, httpResponse.Content().c_str(), fields, sizeof(fields) / sizeof(fields[0])) == RC_OK &&
-                    fields[2].value_start && fields[2].value_end)
+                // store a copy of the PatchData in the cache for offline mode
+                const auto sPatchData = pParser.GetPatchData();
+                if (!sPatchData.empty())
                 {
                     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
                     auto pData = pLocalStorage.WriteText(ra::services::StorageItemType::GameData, std::to_wstring(request.GameId));
                     if (pData != nullptr)
-                    {
-                        std::string sPatchData;
-                        sPatchData.append(fields[2].value_start, fields[2].value_end - fields[2].value_start);
-                        pData->Write(sPatchData);
-                    }
+                        pData->Write(std::string(sPatchData));
                 }
             }
         }
@@ -829,50 +876,12 @@ FetchGameData::Response ConnectedServer::FetchGameData(const FetchGameData::Requ
     return response;
 }
 
-void ConnectedServer::ProcessGamePatchData(ra::api::FetchGameData::Response &response, const ra::services::Http::Response& httpResponse)
+void ConnectedServer::ProcessGamePatchData(const FetchGameData::Request& request, FetchGameData::Response& response,
+    ra::services::TextReader& pPatchData)
 {
-    rc_api_fetch_game_data_response_t api_response;
-    const auto nResult = rc_api_process_fetch_game_data_response(&api_response, httpResponse.Content().c_str());
-
-    if (ValidateResponse(nResult, api_response.response, FetchGameData::Name(), httpResponse.StatusCode(), response))
-    {
-        response.Result = ApiResult::Success;
-        response.Title = ra::Widen(api_response.title);
-        response.ConsoleId = api_response.console_id;
-        response.ImageIcon = api_response.image_name;
-        response.RichPresence = api_response.rich_presence_script;
-
-        for (unsigned i = 0; i < api_response.num_achievements; ++i)
-        {
-            const auto* pSrcAchievement = &api_response.achievements[i];
-            auto& pAchievement = response.Achievements.emplace_back();
-            pAchievement.Id = pSrcAchievement->id;
-            pAchievement.Title = pSrcAchievement->title;
-            pAchievement.Description = pSrcAchievement->description;
-            pAchievement.CategoryId = pSrcAchievement->category;
-            pAchievement.Points = pSrcAchievement->points;
-            pAchievement.Definition = pSrcAchievement->definition;
-            pAchievement.Author = pSrcAchievement->author;
-            pAchievement.BadgeName = pSrcAchievement->badge_name;
-            pAchievement.Created = pSrcAchievement->created;
-            pAchievement.Updated = pSrcAchievement->updated;
-        }
-
-        for (unsigned i = 0; i < api_response.num_leaderboards; ++i)
-        {
-            const auto* pSrcLeaderboard = &api_response.leaderboards[i];
-            auto& pLeaderboard = response.Leaderboards.emplace_back();
-            pLeaderboard.Id = pSrcLeaderboard->id;
-            pLeaderboard.Title = pSrcLeaderboard->title;
-            pLeaderboard.Description = pSrcLeaderboard->description;
-            pLeaderboard.Definition = pSrcLeaderboard->definition;
-            pLeaderboard.Format = pSrcLeaderboard->format;
-            pLeaderboard.LowerIsBetter = pSrcLeaderboard->lower_is_better;
-            pLeaderboard.Hidden = pSrcLeaderboard->hidden;
-        }
-    }
-
-    rc_api_destroy_fetch_game_data_response(&api_response);
+    PatchDataParser pParser(request, response);
+    const auto nResult = pParser.ParsePatchData(pPatchData);
+    ValidateGamePatchData(nResult, pParser, ra::services::Http::StatusCode::OK, response);
 }
 
 FetchCodeNotes::Response ConnectedServer::FetchCodeNotes(const FetchCodeNotes::Request& request)
@@ -3,6 +3,7 @@
 #include "ServerBase.hh"
 
 #include "services\Http.hh"
+#include "services\TextReader.hh"
 
 namespace ra {
 namespace api {
@@ -39,7 +40,7 @@ public:
     FetchBadgeIds::Response FetchBadgeIds(const FetchBadgeIds::Request& request) override;
     UploadBadge::Response UploadBadge(const UploadBadge::Request& request) override;
 
-    static void ProcessGamePatchData(FetchGameData::Response &response, const ra::services::Http::Response& httpResponse);
+    static void ProcessGamePatchData(const FetchGameData::Request& request, FetchGameData::Response& response, ra::services::TextReader& pPatchData);
     static void ProcessCodeNotes(FetchCodeNotes::Response &response, const void* api_response);
 
 private:
@@ -48,7 +48,6 @@ SubmitLeaderboardEntry::Response OfflineServer::SubmitLeaderboardEntry(const Sub
 FetchGameData::Response OfflineServer::FetchGameData(const FetchGameData::Request& request)
 {
     FetchGameData::Response response;
-    rapidjson::Document document;
 
     // see if the data is available in the cache
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
@@ -60,19 +59,7 @@ FetchGameData::Response OfflineServer::FetchGameData(const FetchGameData::Reques
     }
     else 
     {
-        std::string sContents = "{\"Success\":true,\"PatchData\":";
-        std::string sLine;
-        while (pData->GetLine(sLine))
-        {
-            if (!sContents.empty())
-                sContents.push_back('\n');
-
-            sContents.append(sLine);
-        }
-        sContents.push_back('}');
-
-        ra::services::Http::Response httpResponse(ra::services::Http::StatusCode::OK, sContents);
-        ConnectedServer::ProcessGamePatchData(response, httpResponse);
+        ConnectedServer::ProcessGamePatchData(request, response, *pData);
     }
 
     return response;
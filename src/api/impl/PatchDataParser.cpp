@@ -0,0 +1,527 @@
+#include "PatchDataParser.hh"
+
+#include "RA_StringUtils.h"
+
+#include "services\impl\FileTextReader.hh"
+#include "services\impl\StringTextReader.hh"
+
+namespace ra {
+namespace api {
+namespace impl {
+
+class PatchDataParser::Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler>
+{
+public:
+    Handler(PatchDataParser& pParser, const rapidjson::StringStream* pStream) noexcept
+        : m_pParser(pParser), m_pStream(pStream)
+    {
+    }
+
+    bool Null() noexcept
+    {
+        // treat null values as missing
+        m_nField = Field::None;
+        return true;
+    }
+
+    bool Bool(bool bValue)
+    {
+        return Number(bValue ? 1 : 0);
+    }
+
+    bool Int(int nValue) { return Number(nValue); }
+    bool Uint(unsigned nValue) { return Number(nValue); }
+    bool Int64(int64_t nValue) { return Number(nValue); }
+    bool Uint64(uint64_t nValue) { return Number(gsl::narrow_cast<int64_t>(nValue)); }
+    bool Double(double dValue) { return Number(gsl::narrow_cast<int64_t>(dValue)); }
+
+    bool String(const char* sValue, rapidjson::SizeType nLength, bool)
+    {
+        if (m_nSkipDepth > 0)
+            return true;
+
+        const std::string_view sView(sValue, nLength);
+        switch (m_nState)
+        {
+            case State::Root:
+                if (m_nField == Field::Error)
+                    m_pParser.m_sErrorMessage.assign(sView);
+                break;
+
+            case State::PatchData:
+                switch (m_nField)
+                {
+                    case Field::Title:
+                        ra::Widen(sView, m_pParser.m_pResponse.Title);
+                        break;
+
+                    case Field::ImageIcon:
+                    {
+                        // ImageIcon will be "/Images/0123456.png" - only keep the "0123456"
+                        auto sImage = sView;
+                        const auto nSlash = sImage.find_last_of('/');
+                        if (nSlash != std::string_view::npos)
+                            sImage.remove_prefix(nSlash + 1);
+                        if (sImage.length() > 4 && sImage.substr(sImage.length() - 4) == ".png")
+                            sImage.remove_suffix(4);
+                        m_pParser.m_pResponse.ImageIcon.assign(sImage);
+                        break;
+                    }
+
+                    case Field::RichPresence:
+                        m_pParser.m_pResponse.RichPresence.assign(sView);
+                        break;
+
+                    default:
+                        break;
+                }
+                break;
+
+            case State::Achievement:
+                switch (m_nField)
+                {
+                    case Field::Title: m_pAchievement.Title.assign(sView); break;
+                    case Field::Description: m_pAchievement.Description.assign(sView); break;
+                    case Field::Definition: m_pAchievement.Definition.assign(sView); break;
+                    case Field::Author: m_pAchievement.Author.assign(sView); break;
+                    case Field::BadgeName: m_pAchievement.BadgeName.assign(sView); break;
+                    default: break;
+                }
+                break;
+
+            case State::Leaderboard:
+                switch (m_nField)
+                {
+                    case Field::Title: m_pLeaderboard.Title.assign(sView); break;
+                    case Field::Description: m_pLeaderboard.Description.assign(sView); break;
+                    case Field::Definition: m_pLeaderboard.Definition.assign(sView); break;
+                    case Field::Format: m_pLeaderboard.Format = rc_parse_format(sValue); break;
+                    default: break;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        MarkFieldSeen();
+        return true;
+    }
+
+    bool Key(const char* sKey, rapidjson::SizeType nLength, bool)
+    {
+        if (m_nSkipDepth == 0)
+            m_nField = GetField(std::string_view(sKey, nLength));
+
+        return true;
+    }
+
+    bool StartObject()
+    {
+        if (m_nSkipDepth > 0)
+        {
+            ++m_nSkipDepth;
+            return true;
+        }
+
+        switch (m_nState)
+        {
+            case State::Start:
+                m_nState = (m_pStream != nullptr) ? State::Root : State::PatchData;
+                return true;
+
+            case State::Root:
+                if (m_nField != Field::PatchData)
+                    break;
+
+                // the stream has already consumed the opening brace
+                m_nPatchDataStart = m_pStream->Tell() - 1;
+                m_bPatchDataSeen = true;
+                m_nState = State::PatchData;
+                m_nFieldsSeen = 0;
+                return true;
+
+            case State::Achievements:
+                m_pAchievement.Id = m_pAchievement.CategoryId = m_pAchievement.Points = 0;
+                m_pAchievement.Title.clear();
+                m_pAchievement.Description.clear();
+                m_pAchievement.Definition.clear();
+                m_pAchievement.Author.clear();
+                m_pAchievement.BadgeName.clear();
+                m_pAchievement.Created = m_pAchievement.Updated = 0;
+                m_nState = State::Achievement;
+                m_nItemFieldsSeen = 0;
+                return true;
+
+            case State::Leaderboards:
+                m_pLeaderboard.Id = 0;
+                m_pLeaderboard.Title.clear();
+                m_pLeaderboard.Description.clear();
+                m_pLeaderboard.Definition.clear();
+                m_pLeaderboard.Format = RC_FORMAT_VALUE;
+                m_pLeaderboard.LowerIsBetter = m_pLeaderboard.Hidden = false;
+                m_nState = State::Leaderboard;
+                m_nItemFieldsSeen = 0;
+                return true;
+
+            default:
+                break;
+        }
+
+        m_nSkipDepth = 1;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType)
+    {
+        if (m_nSkipDepth > 0)
+        {
+            --m_nSkipDepth;
+            return true;
+        }
+
+        switch (m_nState)
+        {
+            case State::Achievement:
+                m_nState = State::Achievements;
+                if (!HasFields(m_nItemFieldsSeen, { Field::Id, Field::Definition }))
+                    return false;
+
+                ++m_pParser.m_nAchievementCount;
+                if (m_pParser.m_pRequest.AchievementHandler)
+                    m_pParser.m_pRequest.AchievementHandler(m_pAchievement);
+                else
+                    m_pParser.m_pResponse.Achievements.push_back(m_pAchievement);
+                break;
+
+            case State::Leaderboard:
+                m_nState = State::Leaderboards;
+                if (!HasFields(m_nItemFieldsSeen, { Field::Id, Field::Definition }))
+                    return false;
+
+                ++m_pParser.m_nLeaderboardCount;
+                if (m_pParser.m_pRequest.LeaderboardHandler)
+                    m_pParser.m_pRequest.LeaderboardHandler(m_pLeaderboard);
+                else
+                    m_pParser.m_pResponse.Leaderboards.push_back(m_pLeaderboard);
+                break;
+
+            case State::PatchData:
+                if (!HasFields(m_nFieldsSeen, { Field::Id, Field::Title, Field::ConsoleId }))
+                    return false;
+
+                if (m_pStream != nullptr)
+                {
+                    m_nPatchDataEnd = m_pStream->Tell();
+                    m_nState = State::Root;
+                }
+                else
+                {
+                    m_nState = State::Done;
+                }
+                break;
+
+            default:
+                m_nState = State::Done;
+                break;
+        }
+
+        return true;
+    }
+
+    bool StartArray()
+    {
+        if (m_nSkipDepth > 0)
+        {
+            ++m_nSkipDepth;
+            return true;
+        }
+
+        if (m_nState == State::PatchData)
+        {
+            if (m_nField == Field::Achievements)
+            {
+                m_nState = State::Achievements;
+                return true;
+            }
+
+            if (m_nField == Field::Leaderboards)
+            {
+                m_nState = State::Leaderboards;
+                return true;
+            }
+        }
+
+        m_nSkipDepth = 1;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType)
+    {
+        if (m_nSkipDepth > 0)
+            --m_nSkipDepth;
+        else
+            m_nState = State::PatchData;
+
+        m_nField = Field::None;
+        return true;
+    }
+
+    bool IsMissingValue() const noexcept { return m_bMissingValue; }
+
+    bool HasPatchData() const noexcept
+    {
+        return (m_pStream != nullptr) ? m_bPatchDataSeen : (m_nState == State::Done);
+    }
+
+    size_t GetPatchDataStart() const noexcept { return m_nPatchDataStart; }
+    size_t GetPatchDataEnd() const noexcept { return m_nPatchDataEnd; }
+
+private:
+    enum class State
+    {
+        Start,
+        Root,
+        PatchData,
+        Achievements,
+        Achievement,
+        Leaderboards,
+        Leaderboard,
+        Done,
+    };
+
+    enum class Field
+    {
+        None,
+        Success,
+        Error,
+        PatchData,
+        Id,
+        Title,
+        Description,
+        ConsoleId,
+        ImageIcon,
+        RichPresence,
+        Achievements,
+        Leaderboards,
+        Flags,
+        Points,
+        Definition,
+        Author,
+        BadgeName,
+        Created,
+        Modified,
+        Format,
+        LowerIsBetter,
+        Hidden,
+    };
+
+    Field GetField(std::string_view sKey) const noexcept
+    {
+        switch (m_nState)
+        {
+            case State::Root:
+                if (sKey == "Success") return Field::Success;
+                if (sKey == "Error") return Field::Error;
+                if (sKey == "PatchData") return Field::PatchData;
+                break;
+
+            case State::PatchData:
+                if (sKey == "ID") return Field::Id;
+                if (sKey == "Title") return Field::Title;
+                if (sKey == "ConsoleID") return Field::ConsoleId;
+                if (sKey == "ImageIcon") return Field::ImageIcon;
+                if (sKey == "RichPresencePatch") return Field::RichPresence;
+                if (sKey == "Achievements") return Field::Achievements;
+                if (sKey == "Leaderboards") return Field::Leaderboards;
+                break;
+
+            case State::Achievement:
+                if (sKey == "ID") return Field::Id;
+                if (sKey == "Title") return Field::Title;
+                if (sKey == "Description") return Field::Description;
+                if (sKey == "Flags") return Field::Flags;
+                if (sKey == "Points") return Field::Points;
+                if (sKey == "MemAddr") return Field::Definition;
+                if (sKey == "Author") return Field::Author;
+                if (sKey == "BadgeName") return Field::BadgeName;
+                if (sKey == "Created") return Field::Created;
+                if (sKey == "Modified") return Field::Modified;
+                break;
+
+            case State::Leaderboard:
+                if (sKey == "ID") return Field::Id;
+                if (sKey == "Title") return Field::Title;
+                if (sKey == "Description") return Field::Description;
+                if (sKey == "Mem") return Field::Definition;
+                if (sKey == "Format") return Field::Format;
+                if (sKey == "LowerIsBetter") return Field::LowerIsBetter;
+                if (sKey == "Hidden") return Field::Hidden;
+                break;
+
+            default:
+                break;
+        }
+
+        return Field::None;
+    }
+
+    bool Number(int64_t nValue)
+    {
+        if (m_nSkipDepth > 0)
+            return true;
+
+        const auto nUnsigned = gsl::narrow_cast<unsigned int>(nValue);
+        switch (m_nState)
+        {
+            case State::Root:
+                if (m_nField == Field::Success)
+                    m_pParser.m_bSucceeded = (nValue != 0);
+                break;
+
+            case State::PatchData:
+                if (m_nField == Field::ConsoleId)
+                    m_pParser.m_pResponse.ConsoleId = nUnsigned;
+                break;
+
+            case State::Achievement:
+                switch (m_nField)
+                {
+                    case Field::Id: m_pAchievement.Id = nUnsigned; break;
+                    case Field::Flags: m_pAchievement.CategoryId = nUnsigned; break;
+                    case Field::Points: m_pAchievement.Points = nUnsigned; break;
+                    case Field::Created: m_pAchievement.Created = gsl::narrow_cast<time_t>(nValue); break;
+                    case Field::Modified: m_pAchievement.Updated = gsl::narrow_cast<time_t>(nValue); break;
+                    default: break;
+                }
+                break;
+
+            case State::Leaderboard:
+                switch (m_nField)
+                {
+                    case Field::Id: m_pLeaderboard.Id = nUnsigned; break;
+                    case Field::LowerIsBetter: m_pLeaderboard.LowerIsBetter = (nValue != 0); break;
+                    case Field::Hidden: m_pLeaderboard.Hidden = (nValue != 0); break;
+                    default: break;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        MarkFieldSeen();
+        return true;
+    }
+
+    void MarkFieldSeen() noexcept
+    {
+        const auto nBit = 1U << ra::etoi(m_nField);
+        if (m_nState == State::Achievement || m_nState == State::Leaderboard)
+            m_nItemFieldsSeen |= nBit;
+        else
+            m_nFieldsSeen |= nBit;
+
+        m_nField = Field::None;
+    }
+
+    bool HasFields(uint32_t nFieldsSeen, std::initializer_list<Field> vRequired) noexcept
+    {
+        for (const auto nField : vRequired)
+        {
+            if ((nFieldsSeen & (1U << ra::etoi(nField))) == 0)
+            {
+                m_bMissingValue = true;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    PatchDataParser& m_pParser;
+    const rapidjson::StringStream* m_pStream; // only set when parsing a server response
+
+    State m_nState = State::Start;
+    Field m_nField = Field::None;
+    unsigned int m_nSkipDepth = 0; // depth within a value that's being ignored
+    uint32_t m_nFieldsSeen = 0;
+    uint32_t m_nItemFieldsSeen = 0;
+    bool m_bMissingValue = false;
+
+    bool m_bPatchDataSeen = false;
+    size_t m_nPatchDataStart = 0;
+    size_t m_nPatchDataEnd = 0;
+
+    // reused for each item so the string buffers only have to be allocated once
+    FetchGameData::Response::Achievement m_pAchievement;
+    FetchGameData::Response::Leaderboard m_pLeaderboard;
+};
+
+PatchDataParser::Result PatchDataParser::ParseServerResponse(const std::string& sJson)
+{
+    rapidjson::StringStream pStream(sJson.c_str());
+    Handler pHandler(*this, &pStream);
+
+    rapidjson::Reader pReader;
+    pReader.Parse(pStream, pHandler);
+
+    if (pHandler.IsMissingValue())
+        return Result::MissingValue;
+    if (pReader.HasParseError())
+        return Result::InvalidJson;
+
+    // if the server reported an error, the PatchData won't be present
+    if (!m_bSucceeded)
+        return Result::Success;
+    if (!pHandler.HasPatchData())
+        return Result::MissingValue;
+
+    m_sPatchData = std::string_view(sJson).substr(pHandler.GetPatchDataStart(),
+        pHandler.GetPatchDataEnd() - pHandler.GetPatchDataStart());
+    return Result::Success;
+}
+
+PatchDataParser::Result PatchDataParser::ParsePatchData(ra::services::TextReader& pReader)
+{
+    Handler pHandler(*this, nullptr);
+    rapidjson::Reader pJsonReader;
+
+    auto* pFileTextReader = dynamic_cast<ra::services::impl::FileTextReader*>(&pReader);
+    if (pFileTextReader != nullptr)
+    {
+        // read directly from the file rather than loading it into memory first
+        auto& iFile = pFileTextReader->GetFStream();
+        if (!iFile.is_open())
+            return Result::MissingValue;
+
+        rapidjson::IStreamWrapper iStreamWrapper(iFile);
+        pJsonReader.Parse(iStreamWrapper, pHandler);
+    }
+    else
+    {
+        auto* pStringTextReader = dynamic_cast<ra::services::impl::StringTextReader*>(&pReader);
+        if (pStringTextReader == nullptr)
+        {
+            assert(!"Unsupported TextReader");
+            return Result::InvalidJson;
+        }
+
+        const auto sJson = pStringTextReader->GetString();
+        rapidjson::StringStream pStream(sJson.c_str());
+        pJsonReader.Parse(pStream, pHandler);
+    }
+
+    if (pHandler.IsMissingValue())
+        return Result::MissingValue;
+    if (pJsonReader.HasParseError())
+        return Result::InvalidJson;
+    if (!pHandler.HasPatchData())
+        return Result::MissingValue;
+
+    return Result::Success;
+}
+
+} // namespace impl
+} // namespace api
+} // namespace ra
@@ -0,0 +1,95 @@
+#ifndef RA_API_PATCH_DATA_PARSER_HH
+#define RA_API_PATCH_DATA_PARSER_HH
+#pragma once
+
+#include "api\FetchGameData.hh"
+
+#include "services\TextReader.hh"
+
+namespace ra {
+namespace api {
+namespace impl {
+
+/// <summary>
+/// Reads game patch data from JSON directly into a <see cref="FetchGameData::Response" /> without building a
+/// document.
+/// </summary>
+/// <remarks>
+/// Each achievement and leaderboard is passed to the handler on the request as soon as it has been read. The same
+/// object is reused for every item, so its strings only have to grow to fit the largest item. If the request
+/// doesn't have a handler, the items are added to the response instead.
+/// </remarks>
+class PatchDataParser
+{
+public:
+    enum class Result
+    {
+        Success,
+        InvalidJson,
+        MissingValue,
+    };
+
+    PatchDataParser(const FetchGameData::Request& pRequest, FetchGameData::Response& pResponse) noexcept
+        : m_pRequest(pRequest), m_pResponse(pResponse)
+    {
+    }
+
+    ~PatchDataParser() noexcept = default;
+    PatchDataParser(const PatchDataParser&) noexcept = delete;
+    PatchDataParser& operator=(const PatchDataParser&) noexcept = delete;
+    PatchDataParser(PatchDataParser&&) noexcept = delete;
+    PatchDataParser& operator=(PatchDataParser&&) noexcept = delete;
+
+    /// <summary>
+    /// Parses a server response in the form {"Success":true,"PatchData":{...}}.
+    /// </summary>
+    Result ParseServerResponse(const std::string& sJson);
+
+    /// <summary>
+    /// Parses patch data that was extracted from a server response.
+    /// </summary>
+    Result ParsePatchData(ra::services::TextReader& pReader);
+
+    /// <summary>
+    /// Gets whether the server reported that the request succeeded.
+    /// </summary>
+    bool Succeeded() const noexcept { return m_bSucceeded; }
+
+    /// <summary>
+    /// Gets the error message returned by the server.
+    /// </summary>
+    const std::string& GetErrorMessage() const noexcept { return m_sErrorMessage; }
+
+    /// <summary>
+    /// Gets the PatchData object from the string passed to <see cref="ParseServerResponse" />.
+    /// </summary>
+    std::string_view GetPatchData() const noexcept { return m_sPatchData; }
+
+    /// <summary>
+    /// Gets the number of achievements that were read.
+    /// </summary>
+    size_t GetAchievementCount() const noexcept { return m_nAchievementCount; }
+
+    /// <summary>
+    /// Gets the number of leaderboards that were read.
+    /// </summary>
+    size_t GetLeaderboardCount() const noexcept { return m_nLeaderboardCount; }
+
+private:
+    class Handler;
+
+    const FetchGameData::Request& m_pRequest;
+    FetchGameData::Response& m_pResponse;
+
+    bool m_bSucceeded = true;
+    std::string m_sErrorMessage;
+    std::string_view m_sPatchData;
+    size_t m_nAchievementCount = 0;
+    size_t m_nLeaderboardCount = 0;
+};
+
+} // namespace impl
+} // namespace api
+} // namespace ra
+
+#endif // !RA_API_PATCH_DATA_PARSER_HH
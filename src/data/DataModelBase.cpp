@@ -31,16 +31,7 @@ void DataModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
         }
     }
 
-    if (!m_vNotifyTargets.empty())
-    {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelBoolValueChanged(args);
-        }
-    }
+    m_vNotifyTargets.Dispatch([&args](NotifyTarget& pTarget) { pTarget.OnDataModelBoolValueChanged(args); });
 
     ModelBase::OnValueChanged(args);
 }
@@ -88,16 +79,7 @@ void DataModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
         }
     }
 
-    if (!m_vNotifyTargets.empty())
-    {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelStringValueChanged(args);
-        }
-    }
+    m_vNotifyTargets.Dispatch([&args](NotifyTarget& pTarget) { pTarget.OnDataModelStringValueChanged(args); });
 
     ModelBase::OnValueChanged(args);
 }
@@ -145,16 +127,7 @@ void DataModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
         }
     }
 
-    if (!m_vNotifyTargets.empty())
-    {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelIntValueChanged(args);
-        }
-    }
+    m_vNotifyTargets.Dispatch([&args](NotifyTarget& pTarget) { pTarget.OnDataModelIntValueChanged(args); });
 
     ModelBase::OnValueChanged(args);
 }
@@ -51,10 +51,10 @@ public:
     {
         if (!IsFrozen())
         {
-            if (m_vNotifyTargets.empty())
+            if (m_vNotifyTargets.IsEmpty())
                 StartWatching();
 
-            m_vNotifyTargets.insert(&pTarget);
+            m_vNotifyTargets.Add(pTarget);
         }
     }
 
@@ -64,11 +64,11 @@ public:
         Expects(!m_bDisposed);
 #endif
 
-        if (!m_vNotifyTargets.empty())
+        if (!m_vNotifyTargets.IsEmpty())
         {
-            m_vNotifyTargets.erase(&pTarget);
+            m_vNotifyTargets.Remove(pTarget);
 
-            if (m_vNotifyTargets.empty())
+            if (m_vNotifyTargets.IsEmpty())
                 StopWatching();
         }
     }
@@ -80,7 +80,7 @@ protected:
 
     bool IsWatching() const noexcept override 
     { 
-        return !IsFrozen() && !m_vNotifyTargets.empty(); 
+        return !IsFrozen() && !m_vNotifyTargets.IsEmpty(); 
     }
 
     void OnFrozen() noexcept override;
@@ -92,13 +92,7 @@ protected:
     void OnItemsChanged(const std::vector<gsl::index>& vChangedIndices) override;
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
-
-    /// <summary>
-    /// A collection of pointers to other objects. These are not allocated object and do not need to be free'd. It's
-    /// impossible to create a set of <c>NotifyTarget</c> references.
-    /// </summary>
-    NotifyTargetSet m_vNotifyTargets;
+    NotifyTargetSet<NotifyTarget> m_vNotifyTargets;
 };
 
 template<class T>
@@ -8,7 +8,7 @@ namespace data {
 void ModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 {
     if (m_pCollection)
-        m_pCollection->NotifyModelValueChanged(m_nCollectionIndex, args);
+        m_pCollection->NotifyModelValueChanged(*this, args);
 
     ModelPropertyContainer::OnValueChanged(args);
 }
@@ -16,7 +16,7 @@ void ModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 void ModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 {
     if (m_pCollection)
-        m_pCollection->NotifyModelValueChanged(m_nCollectionIndex, args);
+        m_pCollection->NotifyModelValueChanged(*this, args);
 
     ModelPropertyContainer::OnValueChanged(args);
 }
@@ -24,7 +24,7 @@ void ModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 void ModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
 {
     if (m_pCollection)
-        m_pCollection->NotifyModelValueChanged(m_nCollectionIndex, args);
+        m_pCollection->NotifyModelValueChanged(*this, args);
 
     ModelPropertyContainer::OnValueChanged(args);
 }
@@ -235,6 +235,102 @@ void ModelCollectionBase::EndUpdate()
     }
 }
 
+void ModelCollectionBase::BeginNotificationBatch()
+{
+    if (m_pNotificationBatch == nullptr)
+        m_pNotificationBatch = std::make_unique<NotificationBatch>();
+
+    ++m_pNotificationBatch->m_nBatchCount;
+}
+
+void ModelCollectionBase::EndNotificationBatch()
+{
+    if (m_pNotificationBatch == nullptr || --m_pNotificationBatch->m_nBatchCount > 0)
+        return;
+
+    std::unique_ptr<NotificationBatch> pNotificationBatch = std::move(m_pNotificationBatch);
+    if (pNotificationBatch->IsEmpty())
+        return;
+
+    // raise all of the notifications within a single update so bound controls only redraw once. don't start
+    // the update unless something actually changed.
+    bool bUpdating = false;
+    const auto BeginUpdateOnce = [this, &bUpdating]() {
+        if (!bUpdating)
+        {
+            bUpdating = true;
+            BeginUpdate();
+        }
+    };
+
+    for (const auto& pChange : pNotificationBatch->m_vDeferredIntChanges)
+    {
+        // ignore items that have been removed from the collection
+        if (pChange.pModel->m_pCollection != this)
+            continue;
+
+        const int nNewValue = pChange.pModel->GetValue(*pChange.pProperty);
+        if (nNewValue != pChange.tOldValue)
+        {
+            IntModelProperty::ChangeArgs args{ *pChange.pProperty, pChange.tOldValue, nNewValue };
+            BeginUpdateOnce();
+            NotifyModelValueChanged(*pChange.pModel, args);
+        }
+    }
+
+    for (const auto& pChange : pNotificationBatch->m_vDeferredBoolChanges)
+    {
+        if (pChange.pModel->m_pCollection != this)
+            continue;
+
+        const bool bNewValue = pChange.pModel->GetValue(*pChange.pProperty);
+        if (bNewValue != pChange.tOldValue)
+        {
+            BoolModelProperty::ChangeArgs args{ *pChange.pProperty, pChange.tOldValue, bNewValue };
+            BeginUpdateOnce();
+            NotifyModelValueChanged(*pChange.pModel, args);
+        }
+    }
+
+    for (const auto& pChange : pNotificationBatch->m_vDeferredStringChanges)
+    {
+        if (pChange.pModel->m_pCollection != this)
+            continue;
+
+        // copy the new value in case a callback changes the property again
+        const std::wstring sNewValue = pChange.pModel->GetValue(*pChange.pProperty);
+        if (sNewValue != pChange.tOldValue)
+        {
+            StringModelProperty::ChangeArgs args{ *pChange.pProperty, pChange.tOldValue, sNewValue };
+            BeginUpdateOnce();
+            NotifyModelValueChanged(*pChange.pModel, args);
+        }
+    }
+
+    if (bUpdating)
+        EndUpdate();
+}
+
+void ModelCollectionBase::NotificationBatch::Forget(const ModelBase& pModel)
+{
+    const auto fIsForModel = [pModel = &pModel](const auto& pChange) noexcept { return pChange.pModel == pModel; };
+
+    m_vDeferredIntChanges.erase(std::remove_if(m_vDeferredIntChanges.begin(), m_vDeferredIntChanges.end(), fIsForModel),
+                                m_vDeferredIntChanges.end());
+    m_vDeferredBoolChanges.erase(std::remove_if(m_vDeferredBoolChanges.begin(), m_vDeferredBoolChanges.end(), fIsForModel),
+                                 m_vDeferredBoolChanges.end());
+    m_vDeferredStringChanges.erase(std::remove_if(m_vDeferredStringChanges.begin(), m_vDeferredStringChanges.end(), fIsForModel),
+                                   m_vDeferredStringChanges.end());
+
+    for (auto iter = m_vDeferredKeys.begin(); iter != m_vDeferredKeys.end();)
+    {
+        if (iter->first == &pModel)
+            iter = m_vDeferredKeys.erase(iter);
+        else
+            ++iter;
+    }
+}
+
 void ModelCollectionBase::UpdateIndices()
 {
     const bool bWatching = IsWatching();
@@ -251,6 +347,9 @@ void ModelCollectionBase::UpdateIndices()
         {
             auto& pModel = *m_vItems.at(nIndex);
             OnBeforeItemRemoved(pModel);
+
+            if (m_pNotificationBatch != nullptr)
+                m_pNotificationBatch->Forget(pModel);
             vDeletedIndices.push_back(pModel.m_nCollectionIndex);
         }
 
@@ -328,8 +427,16 @@ void ModelCollectionBase::UpdateIndices()
         OnItemsChanged(vChangedIndices);
 }
 
-void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args)
+void ModelCollectionBase::NotifyModelValueChanged(const ModelBase& pModel, const BoolModelProperty::ChangeArgs& args)
 {
+    if (m_pNotificationBatch != nullptr)
+    {
+        m_pNotificationBatch->Defer(m_pNotificationBatch->m_vDeferredBoolChanges, pModel, args);
+        return;
+    }
+
+    const auto nIndex = pModel.m_nCollectionIndex;
+
     // ignore events for items added while updates are suspended
     if (nIndex < 0)
         return;
@@ -351,8 +458,16 @@ void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const BoolM
     }
 }
 
-void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const StringModelProperty::ChangeArgs& args)
+void ModelCollectionBase::NotifyModelValueChanged(const ModelBase& pModel, const StringModelProperty::ChangeArgs& args)
 {
+    if (m_pNotificationBatch != nullptr)
+    {
+        m_pNotificationBatch->Defer(m_pNotificationBatch->m_vDeferredStringChanges, pModel, args);
+        return;
+    }
+
+    const auto nIndex = pModel.m_nCollectionIndex;
+
     // ignore events for items added while updates are suspended
     if (nIndex < 0)
         return;
@@ -374,8 +489,16 @@ void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const Strin
     }
 }
 
-void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args)
+void ModelCollectionBase::NotifyModelValueChanged(const ModelBase& pModel, const IntModelProperty::ChangeArgs& args)
 {
+    if (m_pNotificationBatch != nullptr)
+    {
+        m_pNotificationBatch->Defer(m_pNotificationBatch->m_vDeferredIntChanges, pModel, args);
+        return;
+    }
+
+    const auto nIndex = pModel.m_nCollectionIndex;
+
     // ignore events for items added while updates are suspended
     if (nIndex < 0)
         return;
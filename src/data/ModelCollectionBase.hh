@@ -180,6 +180,27 @@ public:
         return -1;
     }
 
+    /// <summary>
+    /// Finds the index of the specified item.
+    /// </summary>
+    /// <param name="pModel">The item to find.</param>
+    /// <returns>Index of the item, <c>-1</c> if not found.</returns>
+    gsl::index FindItemIndex(const ModelBase& pModel) const
+    {
+        // the index stored in the item is only stale if items were moved while updates are suspended
+        const auto nIndex = pModel.m_nCollectionIndex;
+        if (nIndex >= 0 && ra::to_unsigned(nIndex) < m_nSize && m_vItems.at(nIndex).get() == &pModel)
+            return nIndex;
+
+        for (gsl::index nScanIndex = 0; nScanIndex < gsl::narrow<gsl::index>(m_nSize); ++nScanIndex)
+        {
+            if (m_vItems.at(nScanIndex).get() == &pModel)
+                return nScanIndex;
+        }
+
+        return -1;
+    }
+
     /// <summary>
     /// Calls the OnBeginModelCollectionUpdate method of any attached NotifyTargets.
     /// </summary>
@@ -195,6 +216,27 @@ public:
     /// </summary>
     bool IsUpdating() const noexcept { return (m_nUpdateCount > 0); }
 
+    /// <summary>
+    /// Defers value change notifications for items in the collection until the matching
+    /// <see cref="EndNotificationBatch" /> is called.
+    /// </summary>
+    /// <remarks>
+    /// Multiple changes to the same property of the same item are coalesced into a single notification from the
+    /// value the property had before its first change to the value it has when the batch ends. Changes that end
+    /// with the property having its original value are discarded.
+    /// </remarks>
+    void BeginNotificationBatch();
+
+    /// <summary>
+    /// Raises the change notifications deferred since <see cref="BeginNotificationBatch" /> was called.
+    /// </summary>
+    void EndNotificationBatch();
+
+    /// <summary>
+    /// Determines if value change notifications are being deferred.
+    /// </summary>
+    bool IsBatchingNotifications() const noexcept { return (m_pNotificationBatch != nullptr); }
+
 protected:
     virtual void OnFrozen() noexcept(false) {}
     virtual void OnBeginUpdate() noexcept(false) {}
@@ -241,15 +283,68 @@ private:
 
     // allow ModelBase to call NotifyModelValueChanged
     friend class ModelBase;
-    void NotifyModelValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args);
-    void NotifyModelValueChanged(gsl::index nIndex, const StringModelProperty::ChangeArgs& args);
-    void NotifyModelValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args);
+    void NotifyModelValueChanged(const ModelBase& pModel, const BoolModelProperty::ChangeArgs& args);
+    void NotifyModelValueChanged(const ModelBase& pModel, const StringModelProperty::ChangeArgs& args);
+    void NotifyModelValueChanged(const ModelBase& pModel, const IntModelProperty::ChangeArgs& args);
 
     bool m_bFrozen = false;
     unsigned int m_nUpdateCount = 0;
     size_t m_nSize = 0;
 
     std::vector<std::unique_ptr<ModelBase>> m_vItems;
+
+    class NotificationBatch
+    {
+    public:
+        template<class T>
+        struct DeferredChange
+        {
+            const ModelBase* pModel;
+            const ModelProperty<T>* pProperty;
+            T tOldValue;
+        };
+
+        /// <summary>
+        /// Records the value a property had before it was changed. Only the first change to each property of each
+        /// item is recorded. The new value is read from the item when the batch ends.
+        /// </summary>
+        template<class T>
+        void Defer(std::vector<DeferredChange<T>>& vChanges, const ModelBase& pModel,
+                   const typename ModelProperty<T>::ChangeArgs& args)
+        {
+            if (m_vDeferredKeys.emplace(&pModel, args.Property.GetKey()).second)
+                vChanges.push_back({ &pModel, &args.Property, args.tOldValue });
+        }
+
+        /// <summary>
+        /// Discards any changes recorded for an item that is being removed from the collection.
+        /// </summary>
+        void Forget(const ModelBase& pModel);
+
+        bool IsEmpty() const noexcept
+        {
+            return m_vDeferredIntChanges.empty() && m_vDeferredBoolChanges.empty() && m_vDeferredStringChanges.empty();
+        }
+
+        unsigned int m_nBatchCount = 0;
+        std::vector<DeferredChange<int>> m_vDeferredIntChanges;
+        std::vector<DeferredChange<bool>> m_vDeferredBoolChanges;
+        std::vector<DeferredChange<std::wstring>> m_vDeferredStringChanges;
+
+    private:
+        using DeferredKey = std::pair<const ModelBase*, int>;
+
+        struct DeferredKeyHash
+        {
+            size_t operator()(const DeferredKey& pKey) const noexcept
+            {
+                return std::hash<const ModelBase*>()(pKey.first) ^ (gsl::narrow_cast<size_t>(pKey.second) * 0x9E3779B9U);
+            }
+        };
+
+        std::unordered_set<DeferredKey, DeferredKeyHash> m_vDeferredKeys;
+    };
+    std::unique_ptr<NotificationBatch> m_pNotificationBatch;
 };
 
 } // namespace data
@@ -67,6 +67,72 @@ private:
     static int s_nNextKey;
 };
 
+/// <summary>
+/// Associates values to property keys. Entries are kept sorted by key in a contiguous array.
+/// </summary>
+/// <remarks>
+/// Objects typically only hold a handful of non-default values, so searching a contiguous array is faster than
+/// walking the nodes of a <c>std::map</c>, and an object with no values doesn't allocate anything.
+/// Unlike <c>std::map</c>, inserting or erasing an entry invalidates references to every other entry, so this is
+/// only used for values that are returned by value.
+/// </remarks>
+template<class T>
+class ModelPropertyValueMap
+{
+public:
+    using value_type = std::pair<int, T>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    iterator begin() noexcept { return m_vValues.begin(); }
+    iterator end() noexcept { return m_vValues.end(); }
+    const_iterator begin() const noexcept { return m_vValues.begin(); }
+    const_iterator end() const noexcept { return m_vValues.end(); }
+
+    size_t size() const noexcept { return m_vValues.size(); }
+    bool empty() const noexcept { return m_vValues.empty(); }
+    void clear() noexcept { m_vValues.clear(); }
+    void swap(ModelPropertyValueMap& that) noexcept { m_vValues.swap(that.m_vValues); }
+
+    iterator find(int nKey)
+    {
+        const auto iter = LowerBound(m_vValues, nKey);
+        return (iter != m_vValues.end() && iter->first == nKey) ? iter : m_vValues.end();
+    }
+
+    const_iterator find(int nKey) const
+    {
+        const auto iter = LowerBound(m_vValues, nKey);
+        return (iter != m_vValues.end() && iter->first == nKey) ? iter : m_vValues.end();
+    }
+
+    // tValue is taken by value so it's copied before the array changes. it may refer to another entry.
+    std::pair<iterator, bool> insert_or_assign(int nKey, T tValue)
+    {
+        auto iter = LowerBound(m_vValues, nKey);
+        if (iter != m_vValues.end() && iter->first == nKey)
+        {
+            iter->second = std::move(tValue);
+            return { iter, false };
+        }
+
+        iter = m_vValues.emplace(iter, nKey, std::move(tValue));
+        return { iter, true };
+    }
+
+    iterator erase(const_iterator iter) { return m_vValues.erase(iter); }
+
+private:
+    template<typename TVector>
+    static auto LowerBound(TVector& vValues, int nKey)
+    {
+        return std::lower_bound(vValues.begin(), vValues.end(), nKey,
+                                [](const value_type& pPair, int nKey) noexcept { return pPair.first < nKey; });
+    }
+
+    std::vector<value_type> m_vValues;
+};
+
 template<class T>
 class ModelProperty : public ModelPropertyBase
 {
@@ -87,7 +153,9 @@ public:
     /// <remarks>Affects all existing instances where a value has not been set, not just new instances.</remarks>
     void SetDefaultValue(const T& tValue) noexcept(std::is_nothrow_copy_assignable_v<T>) { m_tDefaultValue = tValue; }
 
-    using ValueMap = std::map<int, T>;
+    // string values are returned by reference, so they're kept in a std::map where inserting or removing another
+    // value doesn't move them
+    using ValueMap = std::conditional_t<std::is_same_v<T, std::wstring>, std::map<int, T>, ModelPropertyValueMap<T>>;
 
     struct ChangeArgs
     {
@@ -40,6 +40,10 @@ void ModelPropertyContainer::SetValue(const StringModelProperty& pProperty, cons
     std::wstring sOldValue;
     const std::wstring* pOldValue{};
 
+    // sValue is often the value of another property, which a change handler could modify. report the stored
+    // value instead, which only changes if this property is changed again.
+    const std::wstring* pNewValue{};
+
     if (sValue == pProperty.GetDefaultValue())
     {
         if (iter == m_mStringValues.end())
@@ -52,12 +56,13 @@ void ModelPropertyContainer::SetValue(const StringModelProperty& pProperty, cons
         sOldValue = iter->second;
         pOldValue = &sOldValue;
         m_mStringValues.erase(iter);
+        pNewValue = &(pProperty.GetDefaultValue());
     }
     else if (iter == m_mStringValues.end())
     {
         // not in map, add it
         pOldValue = &(pProperty.GetDefaultValue());
-        m_mStringValues.insert_or_assign(pProperty.GetKey(), sValue);
+        pNewValue = &(m_mStringValues.insert_or_assign(pProperty.GetKey(), sValue).first->second);
     }
     else if (iter->second != sValue)
     {
@@ -65,6 +70,7 @@ void ModelPropertyContainer::SetValue(const StringModelProperty& pProperty, cons
         sOldValue = iter->second;
         pOldValue = &sOldValue;
         iter->second = sValue;
+        pNewValue = &iter->second;
     }
     else
     {
@@ -73,10 +79,10 @@ void ModelPropertyContainer::SetValue(const StringModelProperty& pProperty, cons
     }
 
 #ifdef _DEBUG
-    m_mDebugValues.insert_or_assign(pProperty.GetPropertyName(), sValue);
+    m_mDebugValues.insert_or_assign(pProperty.GetPropertyName(), *pNewValue);
 #endif
 
-    StringModelProperty::ChangeArgs args{ pProperty, *pOldValue, sValue };
+    StringModelProperty::ChangeArgs args{ pProperty, *pOldValue, *pNewValue };
     OnValueChanged(args);
 }
 
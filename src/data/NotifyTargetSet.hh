@@ -0,0 +1,142 @@
+#ifndef RA_DATA_NOTIFY_TARGET_SET_H
+#define RA_DATA_NOTIFY_TARGET_SET_H
+#pragma once
+
+#include "ra_fwd.h"
+
+namespace ra {
+namespace data {
+
+/// <summary>
+/// A collection of pointers to objects that should be notified when something changes. These are not allocated
+/// objects and do not need to be free'd.
+/// </summary>
+/// <remarks>
+/// Targets may be added or removed by the callbacks while a notification is being dispatched. Instead of copying
+/// the collection before every dispatch, removed targets are cleared in place (and skipped) and the collection is
+/// compacted when the outermost dispatch completes. Targets added during a dispatch are not notified until the
+/// next dispatch.
+/// </remarks>
+template<class TTarget>
+class NotifyTargetSet
+{
+public:
+    /// <summary>
+    /// Adds a target to the collection. Does nothing if the target is already in the collection.
+    /// </summary>
+    void Add(TTarget& pTarget)
+    {
+        if (std::find(m_vTargets.begin(), m_vTargets.end(), &pTarget) == m_vTargets.end())
+        {
+            m_vTargets.push_back(&pTarget);
+            ++m_nCount;
+        }
+    }
+
+    /// <summary>
+    /// Removes a target from the collection.
+    /// </summary>
+    void Remove(TTarget& pTarget) noexcept
+    {
+        const auto iter = std::find(m_vTargets.begin(), m_vTargets.end(), &pTarget);
+        if (iter == m_vTargets.end())
+            return;
+
+        if (m_nDispatchDepth > 0)
+        {
+            // a dispatch is iterating the collection. don't shift the remaining items
+            *iter = nullptr;
+            m_bCompactPending = true;
+        }
+        else
+        {
+            m_vTargets.erase(iter);
+        }
+
+        --m_nCount;
+    }
+
+    /// <summary>
+    /// Removes all targets from the collection.
+    /// </summary>
+    void Clear() noexcept
+    {
+        if (m_nDispatchDepth > 0)
+        {
+            std::fill(m_vTargets.begin(), m_vTargets.end(), nullptr);
+            m_bCompactPending = true;
+        }
+        else
+        {
+            m_vTargets.clear();
+        }
+
+        m_nCount = 0;
+    }
+
+    /// <summary>
+    /// Determines whether the collection contains any targets.
+    /// </summary>
+    bool IsEmpty() const noexcept { return (m_nCount == 0); }
+
+    /// <summary>
+    /// Gets the number of targets in the collection.
+    /// </summary>
+    size_t Count() const noexcept { return m_nCount; }
+
+    /// <summary>
+    /// Calls <paramref name="fHandler" /> for each target in the collection.
+    /// </summary>
+    template<typename THandler>
+    void Dispatch(const THandler& fHandler)
+    {
+        if (m_nCount == 0)
+            return;
+
+        DispatchScope oScope(*this);
+
+        // only notify the targets that were registered when the dispatch started
+        const size_t nTargets = m_vTargets.size();
+        for (size_t nIndex = 0; nIndex < nTargets; ++nIndex)
+        {
+            TTarget* pTarget = m_vTargets.at(nIndex);
+            if (pTarget != nullptr)
+                fHandler(*pTarget);
+        }
+    }
+
+private:
+    class DispatchScope
+    {
+    public:
+        explicit DispatchScope(NotifyTargetSet& pOwner) noexcept : m_pOwner(pOwner) { ++m_pOwner.m_nDispatchDepth; }
+
+        ~DispatchScope() noexcept
+        {
+            if (--m_pOwner.m_nDispatchDepth == 0 && m_pOwner.m_bCompactPending)
+            {
+                m_pOwner.m_vTargets.erase(std::remove(m_pOwner.m_vTargets.begin(), m_pOwner.m_vTargets.end(), nullptr),
+                                          m_pOwner.m_vTargets.end());
+                m_pOwner.m_bCompactPending = false;
+            }
+        }
+
+        DispatchScope(const DispatchScope&) noexcept = delete;
+        DispatchScope& operator=(const DispatchScope&) noexcept = delete;
+        DispatchScope(DispatchScope&&) noexcept = delete;
+        DispatchScope& operator=(DispatchScope&&) noexcept = delete;
+
+    private:
+        NotifyTargetSet& m_pOwner;
+    };
+
+    std::vector<TTarget*> m_vTargets;
+    size_t m_nCount = 0;
+    unsigned int m_nDispatchDepth = 0;
+    bool m_bCompactPending = false;
+};
+
+} // namespace data
+} // namespace ra
+
+#endif RA_DATA_NOTIFY_TARGET_SET_H
@@ -28,40 +28,10 @@ namespace ra {
 namespace data {
 namespace context {
 
-static std::string FormatAddressLarge(ra::ByteAddress nAddress)
-{
-    std::string sAddress;
-    sAddress.resize(10);
-    sprintf_s(sAddress.data(), 11, "0x%08x", nAddress);
-    return sAddress;
-}
-
-static std::string FormatAddressMedium(ra::ByteAddress nAddress)
-{
-    if (nAddress & 0xFF000000)
-        return FormatAddressLarge(nAddress);
-
-    std::string sAddress;
-    sAddress.resize(8);
-    sprintf_s(sAddress.data(), 9, "0x%06x", nAddress);
-    return sAddress;
-}
-
-static std::string FormatAddressSmall(ra::ByteAddress nAddress)
-{
-    if (nAddress & 0xFFFF0000)
-        return FormatAddressMedium(nAddress);
-
-    std::string sAddress;
-    sAddress.resize(6);
-    sprintf_s(sAddress.data(), 7, "0x%04x", nAddress);
-    return sAddress;
-}
-
 void EmulatorContext::Initialize(EmulatorID nEmulatorId, const char* sClientName)
 {
     m_nEmulatorId = nEmulatorId;
-    m_fFormatAddress = FormatAddressSmall;
+    m_nMinAddressDigits = 4;
 
     switch (nEmulatorId)
     {
@@ -657,11 +627,11 @@ void EmulatorContext::AddMemoryBlockReader(gsl::index nIndex,
 void EmulatorContext::OnTotalMemorySizeChanged()
 {
     if (m_nTotalMemorySize <= 0x10000)
-        m_fFormatAddress = FormatAddressSmall;
+        m_nMinAddressDigits = 4;
     else if (m_nTotalMemorySize <= 0x1000000)
-        m_fFormatAddress = FormatAddressMedium;
+        m_nMinAddressDigits = 6;
     else
-        m_fFormatAddress = FormatAddressLarge;
+        m_nMinAddressDigits = 8;
 
     // create a copy of the list of pointers in case it's modified by one of the callbacks
     NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
@@ -701,6 +671,19 @@ bool EmulatorContext::IsValidAddress(ra::ByteAddress nAddress) const noexcept
     return false;
 }
 
+size_t EmulatorContext::GetReadableBytes(ra::ByteAddress nAddress) const noexcept
+{
+    for (const auto& pBlock : m_vMemoryBlocks)
+    {
+        if (nAddress < pBlock.size)
+            return (pBlock.read || pBlock.readBlock) ? pBlock.size - nAddress : 0;
+
+        nAddress -= gsl::narrow_cast<ra::ByteAddress>(pBlock.size);
+    }
+
+    return 0;
+}
+
 uint8_t EmulatorContext::ReadMemoryByte(ra::ByteAddress nAddress) const
 {
     const ra::ByteAddress nOriginalAddress = nAddress;
@@ -793,77 +776,102 @@ void EmulatorContext::ReadMemory(ra::ByteAddress nAddress, uint8_t pBuffer[], si
         memset(pBuffer, 0, nCount);
 }
 
+std::string EmulatorContext::FormatAddress(ra::ByteAddress nAddress) const
+{
+    ra::FixedString<char, 10> sAddress;
+    sAddress.Append('0').Append('x').AppendHex(nAddress, GetAddressDigits(nAddress));
+    return std::string(sAddress.View());
+}
+
 uint32_t EmulatorContext::ReadMemory(ra::ByteAddress nAddress, MemSize nSize) const
 {
+    std::array<uint8_t, 4> pBuffer{};
+
     switch (nSize)
     {
         case MemSize::Bit_0:
-            return (ReadMemoryByte(nAddress) & 0x01);
         case MemSize::Bit_1:
-            return (ReadMemoryByte(nAddress) & 0x02) ? 1 : 0;
         case MemSize::Bit_2:
-            return (ReadMemoryByte(nAddress) & 0x04) ? 1 : 0;
         case MemSize::Bit_3:
-            return (ReadMemoryByte(nAddress) & 0x08) ? 1 : 0;
         case MemSize::Bit_4:
-            return (ReadMemoryByte(nAddress) & 0x10) ? 1 : 0;
         case MemSize::Bit_5:
-            return (ReadMemoryByte(nAddress) & 0x20) ? 1 : 0;
         case MemSize::Bit_6:
-            return (ReadMemoryByte(nAddress) & 0x40) ? 1 : 0;
         case MemSize::Bit_7:
-            return (ReadMemoryByte(nAddress) & 0x80) ? 1 : 0;
         case MemSize::Nibble_Lower:
-            return (ReadMemoryByte(nAddress) & 0x0F);
         case MemSize::Nibble_Upper:
-            return ((ReadMemoryByte(nAddress) >> 4) & 0x0F);
         case MemSize::EightBit:
-            return ReadMemoryByte(nAddress);
+        case MemSize::BitCount:
+            pBuffer.at(0) = ReadMemoryByte(nAddress);
+            break;
+
+        case MemSize::TwentyFourBit:
+        case MemSize::TwentyFourBitBigEndian:
+            ReadMemory(nAddress, pBuffer.data(), 3);
+            break;
+
+        case MemSize::Float:
+        case MemSize::MBF32:
+        case MemSize::MBF32LE:
+        case MemSize::ThirtyTwoBit:
+        case MemSize::ThirtyTwoBitBigEndian:
+            ReadMemory(nAddress, pBuffer.data(), 4);
+            break;
+
+        default:
+            ReadMemory(nAddress, pBuffer.data(), 2);
+            break;
+    }
+
+    return DecodeMemoryValue(pBuffer.data(), nSize);
+}
+
+_Use_decl_annotations_
+uint32_t EmulatorContext::DecodeMemoryValue(const uint8_t pBuffer[], MemSize nSize) noexcept
+{
+    switch (nSize)
+    {
+        case MemSize::Bit_0:
+            return (pBuffer[0] & 0x01);
+        case MemSize::Bit_1:
+            return (pBuffer[0] & 0x02) ? 1 : 0;
+        case MemSize::Bit_2:
+            return (pBuffer[0] & 0x04) ? 1 : 0;
+        case MemSize::Bit_3:
+            return (pBuffer[0] & 0x08) ? 1 : 0;
+        case MemSize::Bit_4:
+            return (pBuffer[0] & 0x10) ? 1 : 0;
+        case MemSize::Bit_5:
+            return (pBuffer[0] & 0x20) ? 1 : 0;
+        case MemSize::Bit_6:
+            return (pBuffer[0] & 0x40) ? 1 : 0;
+        case MemSize::Bit_7:
+            return (pBuffer[0] & 0x80) ? 1 : 0;
+        case MemSize::Nibble_Lower:
+            return (pBuffer[0] & 0x0F);
+        case MemSize::Nibble_Upper:
+            return ((pBuffer[0] >> 4) & 0x0F);
+        case MemSize::EightBit:
+            return pBuffer[0];
         default:
         case MemSize::SixteenBit:
-        {
-            uint8_t buffer[2];
-            ReadMemory(nAddress, buffer, 2);
-            return buffer[0] | (buffer[1] << 8);
-        }
+            return pBuffer[0] | (pBuffer[1] << 8);
         case MemSize::TwentyFourBit:
-        {
-            uint8_t buffer[3];
-            ReadMemory(nAddress, buffer, 3);
-            return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16);
-        }
+            return pBuffer[0] | (pBuffer[1] << 8) | (pBuffer[2] << 16);
         case MemSize::Float:
         case MemSize::MBF32:
         case MemSize::MBF32LE:
         case MemSize::ThirtyTwoBit:
-        {
-            uint8_t buffer[4];
-            ReadMemory(nAddress, buffer, 4);
-            return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
-        }
+            return pBuffer[0] | (pBuffer[1] << 8) | (pBuffer[2] << 16) | (pBuffer[3] << 24);
         case MemSize::SixteenBitBigEndian:
-        {
-            uint8_t buffer[2];
-            ReadMemory(nAddress, buffer, 2);
-            return buffer[1] | (buffer[0] << 8);
-        }
+            return pBuffer[1] | (pBuffer[0] << 8);
         case MemSize::TwentyFourBitBigEndian:
-        {
-            uint8_t buffer[3];
-            ReadMemory(nAddress, buffer, 3);
-            return buffer[2] | (buffer[1] << 8) | (buffer[0] << 16);
-        }
+            return pBuffer[2] | (pBuffer[1] << 8) | (pBuffer[0] << 16);
         case MemSize::ThirtyTwoBitBigEndian:
-        {
-            uint8_t buffer[4];
-            ReadMemory(nAddress, buffer, 4);
-            return buffer[3] | (buffer[2] << 8) | (buffer[1] << 16) | (buffer[0] << 24);
-        }
+            return pBuffer[3] | (pBuffer[2] << 8) | (pBuffer[1] << 16) | (pBuffer[0] << 24);
         case MemSize::BitCount:
         {
-            const uint8_t nValue = ReadMemoryByte(nAddress);
-            static const std::array<uint8_t, 16> nBitsSet = { 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4 };
-            return nBitsSet.at(nValue & 0x0F) + nBitsSet.at((nValue >> 4) & 0x0F);
+            static constexpr std::array<uint8_t, 16> nBitsSet = { 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4 };
+            return nBitsSet[pBuffer[0] & 0x0F] + nBitsSet[(pBuffer[0] >> 4) & 0x0F];
         }
     }
 }
@@ -207,6 +207,13 @@ public:
     /// </summary>
     bool IsValidAddress(ra::ByteAddress nAddress) const noexcept;
 
+    /// <summary>
+    /// Gets the number of bytes that can be read from <paramref name="nAddress" /> without leaving the memory
+    /// block containing it.
+    /// </summary>
+    /// <returns>The number of bytes, or <c>0</c> if the address is not readable.</returns>
+    size_t GetReadableBytes(ra::ByteAddress nAddress) const noexcept;
+
     /// <summary>
     /// Reads memory from the emulator.
     /// </summary>
@@ -222,6 +229,14 @@ public:
     /// </summary>
     void ReadMemory(ra::ByteAddress nAddress, _Out_writes_(nCount) uint8_t pBuffer[], size_t nCount) const;
 
+    /// <summary>
+    /// Extracts a value of the specified size from a buffer of memory previously read from the emulator.
+    /// </summary>
+    /// <remarks>
+    /// <paramref name="pBuffer" /> must contain at least <see cref="ra::data::MemSizeBytes" /> bytes.
+    /// </remarks>
+    static uint32_t DecodeMemoryValue(_In_ const uint8_t pBuffer[], MemSize nSize) noexcept;
+
     /// <summary>
     /// Writes memory to the emulator.
     /// </summary>
@@ -235,7 +250,23 @@ public:
     /// <summary>
     /// Converts an address to a displayable string.
     /// </summary>
-    std::string FormatAddress(ra::ByteAddress nAddress) const { return m_fFormatAddress(nAddress); }
+    std::string FormatAddress(ra::ByteAddress nAddress) const;
+
+    /// <summary>
+    /// Gets the number of hex digits used to display an address.
+    /// </summary>
+    /// <remarks>
+    /// Addresses are padded to the width needed for the largest address in the emulator's memory, but
+    /// larger addresses are never truncated.
+    /// </remarks>
+    size_t GetAddressDigits(ra::ByteAddress nAddress) const noexcept
+    {
+        if (nAddress & 0xFF000000)
+            return 8;
+        if ((nAddress & 0x00FF0000) && m_nMinAddressDigits < 6)
+            return 6;
+        return m_nMinAddressDigits;
+    }
 
     /// <summary>
     /// Gets whether or not memory has been modified.
@@ -298,7 +329,7 @@ protected:
     std::function<void(char*)> m_fGetGameTitle;
     std::function<void()> m_fRebuildMenu;
 
-    std::function<std::string(ra::ByteAddress)> m_fFormatAddress;
+    size_t m_nMinAddressDigits = 4;
 
     struct MemoryBlock
     {
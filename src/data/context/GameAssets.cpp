@@ -11,6 +11,8 @@
 #include "services\ILocalStorage.hh"
 #include "services\ServiceLocator.hh"
 
+#include "services\impl\StringTextWriter.hh"
+
 namespace ra {
 namespace data {
 namespace context {
@@ -130,6 +132,8 @@ void GameAssets::OnItemsAdded(const std::vector<gsl::index>& vNewIndices)
 
 void GameAssets::OnBeforeItemRemoved(ModelBase& pModel)
 {
+    m_mSerializedAssets.erase(dynamic_cast<const ra::data::models::AssetModelBase*>(&pModel));
+
     auto* pLocalBadges = dynamic_cast<ra::data::models::LocalBadgesModel*>(FindAsset(ra::data::models::AssetType::LocalBadges, 0));
     if (pLocalBadges)
     {
@@ -141,6 +145,120 @@ void GameAssets::OnBeforeItemRemoved(ModelBase& pModel)
     ra::data::DataModelCollection<ra::data::models::AssetModelBase>::OnBeforeItemRemoved(pModel);
 }
 
+static constexpr uint64_t GetAssetKey(ra::data::models::AssetType nType, uint32_t nId) noexcept
+{
+    return (gsl::narrow_cast<uint64_t>(ra::etoi(nType)) << 32) | nId;
+}
+
+static std::string GetRecordPrefix(ra::data::models::AssetType nType, uint32_t nId)
+{
+    std::string sPrefix;
+    if (nType == ra::data::models::AssetType::Leaderboard)
+        sPrefix.push_back('L');
+
+    sPrefix.append(std::to_string(nId));
+    return sPrefix;
+}
+
+bool GameAssets::IsFileIndexValid(size_t nFileSize) const
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    if (m_mFileIndex.empty() || m_nFileIndexGameId != pGameContext.GameId() || m_nFileIndexSize != nFileSize)
+        return false;
+
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    return (pLocalStorage.GetLastModified(ra::services::StorageItemType::UserAchievements,
+                                          std::to_wstring(m_nFileIndexGameId)) == m_tFileIndexModified);
+}
+
+void GameAssets::UpdateFileIndexState(size_t nFileSize)
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    m_nFileIndexGameId = pGameContext.GameId();
+    m_nFileIndexSize = nFileSize;
+
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    m_tFileIndexModified = pLocalStorage.GetLastModified(ra::services::StorageItemType::UserAchievements,
+                                                         std::to_wstring(m_nFileIndexGameId));
+}
+
+void GameAssets::DiscardLocalAsset(ra::data::models::AssetModelBase& pAsset)
+{
+    // the item no longer exists in the file. if the item is on the server, just reset to the server state.
+    // otherwise, delete the item.
+    if (pAsset.GetCategory() == ra::data::models::AssetCategory::Local)
+    {
+        for (gsl::index nIndex = gsl::narrow_cast<gsl::index>(Count()) - 1; nIndex >= 0; --nIndex)
+        {
+            if (GetItemAt(nIndex) == &pAsset)
+            {
+                RemoveAt(nIndex);
+                break;
+            }
+        }
+    }
+    else
+    {
+        pAsset.RestoreServerCheckpoint();
+    }
+}
+
+bool GameAssets::ReloadIndexedAssets(const std::vector<ra::data::models::AssetModelBase*>& vAssetsToReload,
+                                     ra::services::TextReader& pData)
+{
+    if (!IsFileIndexValid(pData.GetSize()))
+        return false;
+
+    // read the record for each requested asset before changing anything. if any record isn't where the index
+    // says it should be, the file has been modified and the caller has to scan the whole file.
+    std::vector<std::pair<ra::data::models::AssetModelBase*, std::string>> vRecords;
+    vRecords.reserve(vAssetsToReload.size());
+    for (auto* pAsset : vAssetsToReload)
+    {
+        if (pAsset == nullptr)
+            continue;
+
+        auto& pRecord = vRecords.emplace_back(pAsset, std::string());
+
+        const auto pIter = m_mFileIndex.find(GetAssetKey(pAsset->GetType(), pAsset->GetID()));
+        if (pIter == m_mFileIndex.end())
+            continue; // not in the file
+
+        // records always follow the header lines, so there's always a newline in front of them
+        uint8_t nPrevious = 0;
+        pData.SetPosition(pIter->second - 1);
+        if (pData.GetBytes(&nPrevious, 1) != 1 || nPrevious != '\n')
+            return false;
+
+        const auto sPrefix = GetRecordPrefix(pAsset->GetType(), pAsset->GetID());
+        if (!pData.GetLine(pRecord.second) || pRecord.second.length() <= sPrefix.length() ||
+            pRecord.second.at(sPrefix.length()) != ':' || !ra::StringStartsWith(pRecord.second, sPrefix))
+        {
+            return false;
+        }
+    }
+
+    BeginUpdate();
+
+    for (auto& pRecord : vRecords)
+    {
+        auto* pAsset = pRecord.first;
+        if (pRecord.second.empty())
+        {
+            DiscardLocalAsset(*pAsset);
+            continue;
+        }
+
+        ra::Tokenizer pTokenizer(pRecord.second);
+        pTokenizer.Advance(GetRecordPrefix(pAsset->GetType(), pAsset->GetID()).length() + 1); // skip "L123:"
+        pAsset->ResetLocalCheckpoint(pTokenizer);
+    }
+
+    EndUpdate();
+
+    return true;
+}
+
 void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase*>& vAssetsToReload)
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
@@ -151,8 +269,22 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
 
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
     auto pData = pLocalStorage.ReadText(ra::services::StorageItemType::UserAchievements, std::to_wstring(pGameContext.GameId()));
+
+    // if the file hasn't changed since it was indexed, only read the records for the requested assets
+    const bool bReloadAll = vAssetsToReload.empty();
+    if (pData != nullptr && !bReloadAll && !m_mFileIndex.empty())
+    {
+        if (ReloadIndexedAssets(vAssetsToReload, *pData))
+            return;
+
+        // the file doesn't match the index. start over and read the whole file.
+        pData = pLocalStorage.ReadText(ra::services::StorageItemType::UserAchievements, std::to_wstring(pGameContext.GameId()));
+    }
+
     if (pData == nullptr)
     {
+        m_mFileIndex.clear();
+
         // no local file found. reset non-local items to their server state
         BeginUpdate();
         for (auto* pAsset : vAssetsToReload)
@@ -165,8 +297,9 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
         return;
     }
 
+    const auto nFileSize = pData->GetSize();
+
     std::vector<ra::data::models::AssetModelBase*> vRemainingAssetsToReload(vAssetsToReload);
-    const bool bReloadAll = vAssetsToReload.empty();
     if (bReloadAll)
     {
         // when reloading all, populate vRemainingAssetsToReload with all local assets
@@ -200,6 +333,31 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
         }
     }
 
+    // map each asset to reload to its slot in vRemainingAssetsToReload. the slot is cleared when the asset is
+    // found in the file. if the same asset appears multiple times in the file, only the first is merged.
+    std::unordered_map<uint64_t, gsl::index> mRemainingAssetsToReload;
+    for (gsl::index nIndex = gsl::narrow_cast<gsl::index>(vRemainingAssetsToReload.size()) - 1; nIndex >= 0; --nIndex)
+    {
+        const auto* pAsset = vRemainingAssetsToReload.at(nIndex);
+        if (pAsset != nullptr)
+            mRemainingAssetsToReload.insert_or_assign(GetAssetKey(pAsset->GetType(), pAsset->GetID()), nIndex);
+    }
+
+    // when reloading all, unmodified published assets aren't in vRemainingAssetsToReload, but we still want to
+    // merge them if they're in the file.
+    std::unordered_map<uint64_t, ra::data::models::AssetModelBase*> mPublishedAssets;
+    if (bReloadAll)
+    {
+        for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(Count()); ++nIndex)
+        {
+            auto* pAsset = GetItemAt(nIndex);
+            if (pAsset != nullptr && pAsset->GetID() < FirstLocalId)
+                mPublishedAssets.emplace(GetAssetKey(pAsset->GetType(), pAsset->GetID()), pAsset);
+        }
+    }
+
+    m_mFileIndex.clear();
+
     std::string sLine;
     pData->GetLine(sLine); // version used to create the file
     pData->GetLine(sLine); // game title
@@ -207,8 +365,12 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
     BeginUpdate();
 
     std::vector<ra::data::models::AssetModelBase*> vUnnumberedAssets;
-    while (pData->GetLine(sLine))
+    do
     {
+        const auto nPosition = pData->GetPosition();
+        if (!pData->GetLine(sLine))
+            break;
+
         ra::data::models::AssetType nType = ra::data::models::AssetType::None;
         unsigned nId = 0;
 
@@ -246,21 +408,27 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
             if (nId >= m_nNextLocalId)
                 m_nNextLocalId = nId + 1;
 
-            for (auto pIter = vRemainingAssetsToReload.begin(); pIter != vRemainingAssetsToReload.end(); ++pIter)
+            const auto nKey = GetAssetKey(nType, nId);
+            if (nType != ra::data::models::AssetType::CodeNotes)
+                m_mFileIndex.emplace(nKey, nPosition);
+
+            const auto pIter = mRemainingAssetsToReload.find(nKey);
+            if (pIter != mRemainingAssetsToReload.end())
             {
-                auto* pAssetToReset = *pIter;
-                if (pAssetToReset != nullptr && pAssetToReset->GetID() == nId && pAssetToReset->GetType() == nType)
-                {
-                    pAsset = pAssetToReset;
-                    vRemainingAssetsToReload.erase(pIter);
-                    break;
-                }
+                auto& pAssetToReset = vRemainingAssetsToReload.at(pIter->second);
+                pAsset = pAssetToReset;
+                pAssetToReset = nullptr;
+                mRemainingAssetsToReload.erase(pIter);
             }
 
             // when reloading all, if the asset wasn't modified it won't be in vRemainingAssetsToReload
             // but we still want to merge the item. see if it exists at all.
             if (!pAsset && bReloadAll && nId < FirstLocalId)
-                pAsset = FindAsset(nType, nId);
+            {
+                const auto pPublished = mPublishedAssets.find(nKey);
+                if (pPublished != mPublishedAssets.end())
+                    pAsset = pPublished->second;
+            }
         }
 
         if (pAsset)
@@ -312,40 +480,25 @@ void GameAssets::ReloadAssets(const std::vector<ra::data::models::AssetModelBase
                     vUnnumberedAssets.push_back(pAsset);
             }
         }
-    }
+    } while (true);
 
-    // assign IDs for any assets where one was not available
+    // assign IDs for any assets where one was not available. they aren't indexed as their IDs aren't in the file.
     for (auto* pAsset : vUnnumberedAssets)
     {
         if (pAsset != nullptr)
             pAsset->SetID(m_nNextLocalId++);
     }
 
-    // any items still in the source list no longer exist in the file. if the item is on the server,
-    // just reset to the server state. otherwise, delete the item.
+    // any items still in the source list no longer exist in the file.
     for (auto* pAsset : vRemainingAssetsToReload)
     {
-        if (pAsset == nullptr)
-            continue;
-
-        if (pAsset->GetCategory() == ra::data::models::AssetCategory::Local)
-        {
-            for (gsl::index nIndex = gsl::narrow_cast<gsl::index>(Count()) - 1; nIndex >= 0; --nIndex)
-            {
-                if (GetItemAt(nIndex) == pAsset)
-                {
-                    RemoveAt(nIndex);
-                    break;
-                }
-            }
-        }
-        else
-        {
-            pAsset->RestoreServerCheckpoint();
-        }
+        if (pAsset != nullptr)
+            DiscardLocalAsset(*pAsset);
     }
 
     EndUpdate();
+
+    UpdateFileIndexState(nFileSize);
 }
 
 void GameAssets::SaveAssets(const std::vector<ra::data::models::AssetModelBase*>& vAssetsToSave)
@@ -356,9 +509,12 @@ void GameAssets::SaveAssets(const std::vector<ra::data::models::AssetModelBase*>
     if (pData == nullptr)
     {
         RA_LOG_ERR("Failed to create user assets file");
+        m_mFileIndex.clear();
         return;
     }
 
+    m_mFileIndex.clear();
+
 #ifdef RA_UTEST
     pData->WriteLine("0.0.0.0");
 #else
@@ -434,11 +590,28 @@ void GameAssets::SaveAssets(const std::vector<ra::data::models::AssetModelBase*>
         switch (pItem->GetType())
         {
             case ra::data::models::AssetType::Achievement:
-                break;
-
             case ra::data::models::AssetType::Leaderboard:
-                pData->Write("L");
-                break;
+            {
+                // achievements and leaderboards that haven't changed since the last save are written from the
+                // text generated by the last save
+                auto& pSerialized = m_mSerializedAssets[pItem];
+                if (pSerialized.nVersion != pItem->GetSerializationVersion() || pSerialized.nId != pItem->GetID() ||
+                    pSerialized.sText.empty())
+                {
+                    pSerialized.sText.clear();
+                    ra::services::impl::StringTextWriter pWriter(pSerialized.sText);
+                    pItem->Serialize(pWriter);
+
+                    pSerialized.nVersion = pItem->GetSerializationVersion();
+                    pSerialized.nId = pItem->GetID();
+                }
+
+                m_mFileIndex.emplace(GetAssetKey(pItem->GetType(), pItem->GetID()), pData->GetPosition());
+                pData->Write(GetRecordPrefix(pItem->GetType(), pItem->GetID()));
+                pData->Write(pSerialized.sText);
+                pData->WriteLine();
+                continue;
+            }
 
             case ra::data::models::AssetType::CodeNotes:
                 pData->Write("N");
@@ -453,6 +626,10 @@ void GameAssets::SaveAssets(const std::vector<ra::data::models::AssetModelBase*>
         pData->WriteLine();
     }
 
+    const auto nFileSize = gsl::narrow_cast<size_t>(pData->GetPosition());
+    pData.reset();
+    UpdateFileIndexState(nFileSize);
+
     RA_LOG_INFO("Wrote user assets file");
 
     if (bHasDeleted)
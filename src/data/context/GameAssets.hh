@@ -10,6 +10,8 @@
 #include "data\models\LeaderboardModel.hh"
 #include "data\models\RichPresenceModel.hh"
 
+#include "services\TextReader.hh"
+
 namespace ra {
 namespace data {
 namespace context {
@@ -142,6 +144,29 @@ protected:
     void OnItemsAdded(const std::vector<gsl::index>& vNewIndices) override;
 
     uint32_t m_nNextLocalId = FirstLocalId;
+
+private:
+    bool ReloadIndexedAssets(const std::vector<ra::data::models::AssetModelBase*>& vAssetsToReload,
+                             ra::services::TextReader& pData);
+    void DiscardLocalAsset(ra::data::models::AssetModelBase& pAsset);
+    void UpdateFileIndexState(size_t nFileSize);
+    bool IsFileIndexValid(size_t nFileSize) const;
+
+    // the text written for an asset by the last save, reused until the asset changes
+    struct SerializedAsset
+    {
+        uint32_t nId = 0;
+        unsigned nVersion = 0;
+        std::string sText;
+    };
+    std::unordered_map<const ra::data::models::AssetModelBase*, SerializedAsset> m_mSerializedAssets;
+
+    // the offset of each achievement and leaderboard in the local assets file, as of the last time the file was
+    // completely read or written. only valid while the file still has the recorded size and timestamp.
+    std::unordered_map<uint64_t, std::streampos> m_mFileIndex;
+    unsigned m_nFileIndexGameId = 0;
+    size_t m_nFileIndexSize = 0;
+    std::chrono::system_clock::time_point m_tFileIndexModified;
 };
 
 } // namespace context
@@ -26,6 +26,7 @@
 #include "services\IAudioSystem.hh"
 #include "services\IConfiguration.hh"
 #include "services\ILocalStorage.hh"
+#include "services\SubmissionOutbox.hh"
 #include "services\impl\FileTextReader.hh"
 #include "services\impl\FileTextWriter.hh"
 #include "services\impl\StringTextReader.hh"
@@ -81,6 +82,13 @@ void GameContext::LoadGame(unsigned int nGameId, Mode nMode)
     BeginLoad();
     m_nGameId = nGameId;
 
+    // resend anything that wasn't delivered the last time the user played
+    if (!ra::services::ServiceLocator::Get<ra::services::IConfiguration>().IsFeatureEnabled(ra::services::Feature::Offline))
+    {
+        const auto& pUserContext = ra::services::ServiceLocator::Get<ra::data::context::UserContext>();
+        ra::services::ServiceLocator::GetMutable<ra::services::SubmissionOutbox>().Initialize(pUserContext.GetUsername());
+    }
+
     // create a model for managing badges
     auto pLocalBadges = std::make_unique<ra::data::models::LocalBadgesModel>();
     pLocalBadges->CreateServerCheckpoint();
@@ -100,10 +108,69 @@ void GameContext::LoadGame(unsigned int nGameId, Mode nMode)
         }
     }
 
-    // download the game data
+    // download the game data. the achievements and leaderboards are created as they're read from the server
+    // response, so the response doesn't have to hold a copy of every string. the handlers are stored in the
+    // request, so they share ownership of the models they create rather than referencing locals.
     ra::api::FetchGameData::Request request;
     request.GameId = nGameId;
 
+    struct LoadedAssets
+    {
+        std::vector<std::unique_ptr<ra::data::models::AchievementModel>> vAchievements;
+        std::vector<std::unique_ptr<ra::data::models::LeaderboardModel>> vLeaderboards;
+        std::vector<std::string> vBadgeNames;
+        unsigned int nNumCoreAchievements = 0;
+        unsigned int nTotalCoreAchievementPoints = 0;
+    };
+    auto pLoadedAssets = std::make_shared<LoadedAssets>();
+
+    request.AchievementHandler = [pLoadedAssets](const ra::api::FetchGameData::Response::Achievement& pAchievementData)
+    {
+        // if the server has provided an unexpected category (usually 0), ignore it.
+        const auto nCategory = ra::itoe<ra::data::models::AssetCategory>(pAchievementData.CategoryId);
+        if (nCategory != ra::data::models::AssetCategory::Core && nCategory != ra::data::models::AssetCategory::Unofficial)
+            return;
+
+        auto vmAchievement = std::make_unique<ra::data::models::AchievementModel>();
+        vmAchievement->SetID(pAchievementData.Id);
+        vmAchievement->SetName(ra::Widen(pAchievementData.Title));
+        vmAchievement->SetDescription(ra::Widen(pAchievementData.Description));
+        vmAchievement->SetCategory(nCategory);
+        vmAchievement->SetPoints(pAchievementData.Points);
+        vmAchievement->SetAuthor(ra::Widen(pAchievementData.Author));
+        vmAchievement->SetBadge(ra::Widen(pAchievementData.BadgeName));
+        vmAchievement->SetTrigger(pAchievementData.Definition);
+        vmAchievement->SetCreationTime(pAchievementData.Created);
+        vmAchievement->SetUpdatedTime(pAchievementData.Updated);
+        vmAchievement->CreateServerCheckpoint();
+        vmAchievement->CreateLocalCheckpoint();
+        pLoadedAssets->vAchievements.push_back(std::move(vmAchievement));
+
+        pLoadedAssets->vBadgeNames.push_back(pAchievementData.BadgeName);
+
+        if (nCategory == ra::data::models::AssetCategory::Core)
+        {
+            ++pLoadedAssets->nNumCoreAchievements;
+            pLoadedAssets->nTotalCoreAchievementPoints += pAchievementData.Points;
+        }
+    };
+
+    request.LeaderboardHandler = [pLoadedAssets](const ra::api::FetchGameData::Response::Leaderboard& pLeaderboardData)
+    {
+        auto vmLeaderboard = std::make_unique<ra::data::models::LeaderboardModel>();
+        vmLeaderboard->SetID(pLeaderboardData.Id);
+        vmLeaderboard->SetName(ra::Widen(pLeaderboardData.Title));
+        vmLeaderboard->SetDescription(ra::Widen(pLeaderboardData.Description));
+        vmLeaderboard->SetCategory(ra::data::models::AssetCategory::Core);
+        vmLeaderboard->SetValueFormat(ra::itoe<ValueFormat>(pLeaderboardData.Format));
+        vmLeaderboard->SetLowerIsBetter(pLeaderboardData.LowerIsBetter);
+        vmLeaderboard->SetHidden(pLeaderboardData.Hidden);
+        vmLeaderboard->SetDefinition(pLeaderboardData.Definition);
+        vmLeaderboard->CreateServerCheckpoint();
+        vmLeaderboard->CreateLocalCheckpoint();
+        pLoadedAssets->vLeaderboards.push_back(std::move(vmLeaderboard));
+    };
+
     const auto response = request.Call();
     if (response.Failed())
     {
@@ -116,6 +183,12 @@ void GameContext::LoadGame(unsigned int nGameId, Mode nMode)
         return;
     }
 
+    // servers that don't use the handlers return the assets in the response
+    for (const auto& pAchievementData : response.Achievements)
+        request.AchievementHandler(pAchievementData);
+    for (const auto& pLeaderboardData : response.Leaderboards)
+        request.LeaderboardHandler(pLeaderboardData);
+
     const auto& pConsoleContext = ra::services::ServiceLocator::Get<ra::data::context::ConsoleContext>();
     const auto nServerConsoleId = ra::itoe<ConsoleID>(response.ConsoleId);
     if (nServerConsoleId != pConsoleContext.Id())
@@ -175,62 +248,18 @@ void GameContext::LoadGame(unsigned int nGameId, Mode nMode)
     const bool bWasPaused = pRuntime.IsPaused();
     pRuntime.SetPaused(true);
 
-#ifndef RA_UTEST
-    auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
-#endif
-
-    unsigned int nNumCoreAchievements = 0;
-    unsigned int nTotalCoreAchievementPoints = 0;
-    for (const auto& pAchievementData : response.Achievements)
-    {
-        // if the server has provided an unexpected category (usually 0), ignore it.
-        const auto nCategory = ra::itoe<ra::data::models::AssetCategory>(pAchievementData.CategoryId);
-        if (nCategory != ra::data::models::AssetCategory::Core && nCategory != ra::data::models::AssetCategory::Unofficial)
-            continue;
-
-        auto vmAchievement = std::make_unique<ra::data::models::AchievementModel>();
-        vmAchievement->SetID(pAchievementData.Id);
-        vmAchievement->SetName(ra::Widen(pAchievementData.Title));
-        vmAchievement->SetDescription(ra::Widen(pAchievementData.Description));
-        vmAchievement->SetCategory(nCategory);
-        vmAchievement->SetPoints(pAchievementData.Points);
-        vmAchievement->SetAuthor(ra::Widen(pAchievementData.Author));
-        vmAchievement->SetBadge(ra::Widen(pAchievementData.BadgeName));
-        vmAchievement->SetTrigger(pAchievementData.Definition);
-        vmAchievement->SetCreationTime(pAchievementData.Created);
-        vmAchievement->SetUpdatedTime(pAchievementData.Updated);
-        vmAchievement->CreateServerCheckpoint();
-        vmAchievement->CreateLocalCheckpoint();
+    for (auto& vmAchievement : pLoadedAssets->vAchievements)
         m_vAssets.Append(std::move(vmAchievement));
 
 #ifndef RA_UTEST
-        // prefetch the achievement image
-        pImageRepository.FetchImage(ra::ui::ImageType::Badge, pAchievementData.BadgeName);
+    // prefetch the achievement images
+    ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>().FetchImages(
+        ra::ui::ImageType::Badge, pLoadedAssets->vBadgeNames, false);
 #endif
 
-        if (nCategory == ra::data::models::AssetCategory::Core)
-        {
-            ++nNumCoreAchievements;
-            nTotalCoreAchievementPoints += pAchievementData.Points;
-        }
-    }
-
     // leaderboards
-    for (const auto& pLeaderboardData : response.Leaderboards)
-    {
-        auto vmLeaderboard = std::make_unique<ra::data::models::LeaderboardModel>();
-        vmLeaderboard->SetID(pLeaderboardData.Id);
-        vmLeaderboard->SetName(ra::Widen(pLeaderboardData.Title));
-        vmLeaderboard->SetDescription(ra::Widen(pLeaderboardData.Description));
-        vmLeaderboard->SetCategory(ra::data::models::AssetCategory::Core);
-        vmLeaderboard->SetValueFormat(ra::itoe<ValueFormat>(pLeaderboardData.Format));
-        vmLeaderboard->SetLowerIsBetter(pLeaderboardData.LowerIsBetter);
-        vmLeaderboard->SetHidden(pLeaderboardData.Hidden);
-        vmLeaderboard->SetDefinition(pLeaderboardData.Definition);
-        vmLeaderboard->CreateServerCheckpoint();
-        vmLeaderboard->CreateLocalCheckpoint();
+    for (auto& vmLeaderboard : pLoadedAssets->vLeaderboards)
         m_vAssets.Append(std::move(vmLeaderboard));
-    }
 
     ActivateLeaderboards();
 
@@ -286,7 +315,7 @@ void GameContext::LoadGame(unsigned int nGameId, Mode nMode)
     ra::services::ServiceLocator::Get<ra::services::IAudioSystem>().PlayAudioFile(L"Overlay\\info.wav");
     const auto nPopup = ra::services::ServiceLocator::GetMutable<ra::ui::viewmodels::OverlayManager>().QueueMessage(
         ra::StringPrintf(L"Loaded %s", response.Title),
-        ra::StringPrintf(L"%u achievements, %u points", nNumCoreAchievements, nTotalCoreAchievementPoints),
+        ra::StringPrintf(L"%u achievements, %u points", pLoadedAssets->nNumCoreAchievements, pLoadedAssets->nTotalCoreAchievementPoints),
         ra::ui::ImageType::Icon, m_sGameImage);
 
     // get user unlocks asynchronously
@@ -398,10 +427,8 @@ void GameContext::UpdateUnlocks(const std::set<unsigned int>& vUnlockedAchieveme
         }
     }
 
-#ifndef RA_UTEST
-    auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
-#endif
     // activate any core achievements the player hasn't earned and pre-fetch the locked image
+    std::vector<std::string> vLockedBadgeNames;
     for (auto nAchievementId : vLockedAchievements)
     {
         auto* pAchievement = Assets().FindAchievement(nAchievementId);
@@ -416,13 +443,17 @@ void GameContext::UpdateUnlocks(const std::set<unsigned int>& vUnlockedAchieveme
                     pAchievement->SetState(ra::data::models::AssetState::Waiting);
             }
 
-#ifndef RA_UTEST
             if (!pAchievement->GetBadge().empty())
-                pImageRepository.FetchImage(ra::ui::ImageType::Badge, ra::Narrow(pAchievement->GetBadge()) + "_lock");
-#endif
+                vLockedBadgeNames.push_back(ra::Narrow(pAchievement->GetBadge()) + "_lock");
         }
     }
 
+#ifndef RA_UTEST
+    // locked badges are what's displayed in the overlay, fetch them before any remaining unlocked badges
+    ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>().FetchImages(
+        ra::ui::ImageType::Badge, vLockedBadgeNames, true);
+#endif
+
     if (bUnpause)
     {
         ra::services::ServiceLocator::GetMutable<ra::services::AchievementRuntime>().SetPaused(false);
@@ -452,12 +483,27 @@ void GameContext::UpdateUnlocks(const std::set<unsigned int>& vUnlockedAchieveme
 
 void GameContext::DoFrame()
 {
-    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(m_vAssets.Count()); ++nIndex)
+    // only synchronize the assets whose state was changed by the runtime
+    auto& pRuntime = ra::services::ServiceLocator::GetMutable<ra::services::AchievementRuntime>();
+    pRuntime.GetStateChanges(m_vChangedAchievementIds, m_vChangedLeaderboardIds);
+
+    for (const auto nId : m_vChangedAchievementIds)
     {
-        auto* pItem = m_vAssets.GetItemAt(nIndex);
-        if (pItem != nullptr)
-            pItem->DoFrame();
+        auto* pAchievement = m_vAssets.FindAchievement(nId);
+        if (pAchievement != nullptr)
+            pAchievement->DoFrame();
+    }
+
+    for (const auto nId : m_vChangedLeaderboardIds)
+    {
+        auto* pLeaderboard = m_vAssets.FindLeaderboard(nId);
+        if (pLeaderboard != nullptr)
+            pLeaderboard->DoFrame();
     }
+
+    auto* pCodeNotes = m_vAssets.FindCodeNotes();
+    if (pCodeNotes != nullptr)
+        pCodeNotes->DoFrame();
 }
 
 void GameContext::AwardAchievement(ra::AchievementID nAchievementId)
@@ -573,7 +619,8 @@ void GameContext::AwardAchievement(ra::AchievementID nAchievementId)
     request.AchievementId = nAchievementId;
     request.Hardcore = _RA_HardcoreModeIsActive();
     request.GameHash = GameHash();
-    request.CallAsyncWithRetry([this, nPopupId, nAchievementId](const ra::api::AwardAchievement::Response& response)
+    ra::services::ServiceLocator::GetMutable<ra::services::SubmissionOutbox>().QueueUnlock(request,
+        [this, nPopupId, nAchievementId](const ra::api::AwardAchievement::Response& response)
     {
         if (response.Succeeded())
         {
@@ -818,7 +865,8 @@ void GameContext::SubmitLeaderboardEntry(ra::LeaderboardID nLeaderboardId, int n
     request.LeaderboardId = pLeaderboard->GetID();
     request.Score = nScore;
     request.GameHash = GameHash();
-    request.CallAsyncWithRetry([this, nLeaderboardId = pLeaderboard->GetID()](const ra::api::SubmitLeaderboardEntry::Response& response)
+    ra::services::ServiceLocator::GetMutable<ra::services::SubmissionOutbox>().QueueLeaderboardEntry(request,
+        [this, nLeaderboardId = pLeaderboard->GetID()](const ra::api::SubmitLeaderboardEntry::Response& response)
     {
         const auto* pLeaderboard = Assets().FindLeaderboard(nLeaderboardId);
 
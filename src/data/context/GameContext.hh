@@ -158,6 +158,10 @@ private:
 
     GameAssets m_vAssets;
 
+    // reused each frame to avoid allocations
+    std::vector<ra::AchievementID> m_vChangedAchievementIds;
+    std::vector<ra::LeaderboardID> m_vChangedLeaderboardIds;
+
     std::atomic<int> m_nLoadCount = 0;
     int m_nMasteryPopupId = 0;
 };
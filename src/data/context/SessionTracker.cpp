@@ -25,6 +25,86 @@ namespace context {
 
 constexpr int SERVER_PING_FREQUENCY = 2 * 60; // seconds between server pings
 
+// session log layout: "RASL", version (uint32), then fixed-size records:
+//   game id (uint32), session start (int64), session length in seconds (uint32), CRC32 of the preceding 16 bytes
+// the record for the current session is rewritten in place each time the session is updated.
+static constexpr std::array<char, 4> LOG_SIGNATURE{ 'R', 'A', 'S', 'L' };
+static constexpr uint32_t LOG_VERSION = 1;
+static constexpr size_t LOG_HEADER_SIZE = LOG_SIGNATURE.size() + sizeof(uint32_t);
+static constexpr size_t LOG_RECORD_SIZE = sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t) + sizeof(uint32_t);
+static constexpr size_t LOG_RECORDS_PER_READ = 1024;
+
+// index layout: "RASI", version (uint32), length of the session log summarized by the index (int64), game count
+//   (uint32), then for each game: game id (uint32), total playtime in seconds (int64), last session start (int64)
+//   followed by a CRC32 of everything before it
+static constexpr std::array<char, 4> INDEX_SIGNATURE{ 'R', 'A', 'S', 'I' };
+static constexpr uint32_t INDEX_VERSION = 1;
+static constexpr size_t INDEX_HEADER_SIZE = INDEX_SIGNATURE.size() + sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t);
+static constexpr size_t INDEX_ENTRY_SIZE = sizeof(uint32_t) + sizeof(int64_t) + sizeof(int64_t);
+
+static constexpr std::array<uint32_t, 256> BuildCrc32Table() noexcept
+{
+    std::array<uint32_t, 256> pTable{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t nValue = i;
+        for (int j = 0; j < 8; ++j)
+            nValue = (nValue & 1) ? (0xEDB88320 ^ (nValue >> 1)) : (nValue >> 1);
+
+        pTable.at(i) = nValue;
+    }
+
+    return pTable;
+}
+
+static uint32_t Crc32(const std::string& sBuffer, size_t nOffset, size_t nLength)
+{
+    static constexpr auto CRC32_TABLE = BuildCrc32Table();
+
+    uint32_t nCrc = 0xFFFFFFFF;
+    for (size_t i = nOffset; i < nOffset + nLength; ++i)
+        nCrc = CRC32_TABLE.at((nCrc ^ static_cast<uint8_t>(sBuffer.at(i))) & 0xFF) ^ (nCrc >> 8);
+
+    return ~nCrc;
+}
+
+template<typename T>
+static void WriteValue(std::string& sBuffer, T nValue)
+{
+    // values are always written little-endian
+    auto nBits = static_cast<std::make_unsigned_t<T>>(nValue);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        sBuffer.push_back(gsl::narrow_cast<char>(nBits & 0xFF));
+        nBits >>= 8;
+    }
+}
+
+template<typename T>
+static T ReadValue(const std::string& sBuffer, size_t nOffset)
+{
+    std::make_unsigned_t<T> nBits = 0;
+    for (size_t i = sizeof(T); i > 0; --i)
+        nBits = gsl::narrow_cast<std::make_unsigned_t<T>>((nBits << 8) | static_cast<uint8_t>(sBuffer.at(nOffset + i - 1)));
+
+    return static_cast<T>(nBits);
+}
+
+static void WriteLogRecord(std::string& sBuffer, unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration)
+{
+    const auto nOffset = sBuffer.size();
+    WriteValue(sBuffer, gsl::narrow_cast<uint32_t>(nGameId));
+    WriteValue(sBuffer, static_cast<int64_t>(tSessionStart));
+    WriteValue(sBuffer, gsl::narrow_cast<uint32_t>(tSessionDuration.count()));
+    WriteValue(sBuffer, Crc32(sBuffer, nOffset, LOG_RECORD_SIZE - sizeof(uint32_t)));
+}
+
+static bool ReadAll(ra::services::TextReader& pReader, std::string& sBuffer, size_t nBytes)
+{
+    sBuffer.resize(nBytes);
+    GSL_SUPPRESS_TYPE1 return (pReader.GetBytes(reinterpret_cast<uint8_t*>(sBuffer.data()), nBytes) == nBytes);
+}
+
 void SessionTracker::Initialize(const std::string& sUsername)
 {
     m_sUsername = ra::Widen(sUsername);
@@ -36,40 +116,209 @@ void SessionTracker::Initialize(const std::string& sUsername)
 void SessionTracker::LoadSessions()
 {
     m_vGameStats.clear();
+    m_nFileWritePosition = 0;
+
+    std::streamoff nIndexedLength = 0;
+    const bool bIndexLoaded = LoadSessionIndex(nIndexedLength);
 
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
-    auto pStatsFile = pLocalStorage.ReadText(ra::services::StorageItemType::SessionStats, m_sUsername);
+    auto pLog = pLocalStorage.ReadText(ra::services::StorageItemType::SessionLog, m_sUsername);
+    if (pLog == nullptr)
+    {
+        // no binary log - if there's no index either, this is the first time the user has logged in since the
+        // text format was replaced
+        if (!bIndexLoaded)
+            MigrateSessionStats();
 
-    if (pStatsFile != nullptr)
+        return;
+    }
+
+    const auto nLogSize = ra::to_signed(pLog->GetSize());
+    if (!bIndexLoaded || nIndexedLength < ra::to_signed(LOG_HEADER_SIZE) || nIndexedLength > nLogSize)
     {
-        // line format: <gameid>:<sessionstart>:<sessionlength>:<checksum>
-        std::string sLine;
-        while (pStatsFile->GetLine(sLine))
+        // index is missing or doesn't describe this log. rebuild it from the full history
+        m_vGameStats.clear();
+
+        std::string sHeader;
+        if (!ReadAll(*pLog, sHeader, LOG_HEADER_SIZE) ||
+            memcmp(sHeader.data(), LOG_SIGNATURE.data(), LOG_SIGNATURE.size()) != 0 ||
+            ReadValue<uint32_t>(sHeader, LOG_SIGNATURE.size()) != LOG_VERSION)
         {
-            ra::Tokenizer pTokenizer(sLine);
+            RA_LOG_WARN("Ignoring invalid session log for %s", m_sUsername);
+            return;
+        }
 
-            const auto nGameId = pTokenizer.ReadNumber();
-            if (!pTokenizer.Consume(':'))
-                continue;
+        RA_LOG_INFO("Rebuilding session index for %s", m_sUsername);
+        nIndexedLength = LOG_HEADER_SIZE;
+    }
 
-            const auto nSessionStart = pTokenizer.ReadNumber();
-            if (!pTokenizer.Consume(':'))
-                continue;
+    // only sessions written after the index was last updated (i.e. a session that was not ended cleanly) are replayed
+    m_nFileWritePosition = ReplaySessionLog(*pLog, nIndexedLength);
+    if (m_nFileWritePosition != nIndexedLength)
+        WriteSessionIndex();
+}
+
+bool SessionTracker::LoadSessionIndex(std::streamoff& nIndexedLength)
+{
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    auto pIndex = pLocalStorage.ReadText(ra::services::StorageItemType::SessionIndex, m_sUsername);
+    if (pIndex == nullptr)
+        return false;
+
+    std::string sBuffer;
+    if (!ReadAll(*pIndex, sBuffer, pIndex->GetSize()) || sBuffer.size() < INDEX_HEADER_SIZE + sizeof(uint32_t) ||
+        memcmp(sBuffer.data(), INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size()) != 0 ||
+        ReadValue<uint32_t>(sBuffer, INDEX_SIGNATURE.size()) != INDEX_VERSION)
+    {
+        RA_LOG_WARN("Ignoring invalid session index for %s", m_sUsername);
+        return false;
+    }
+
+    size_t nOffset = INDEX_SIGNATURE.size() + sizeof(uint32_t);
+    const auto nLogLength = ReadValue<int64_t>(sBuffer, nOffset);
+    nOffset += sizeof(int64_t);
+    const auto nCount = ReadValue<uint32_t>(sBuffer, nOffset);
+    nOffset += sizeof(uint32_t);
+
+    const auto nCrcOffset = INDEX_HEADER_SIZE + nCount * INDEX_ENTRY_SIZE;
+    if (sBuffer.size() != nCrcOffset + sizeof(uint32_t) ||
+        ReadValue<uint32_t>(sBuffer, nCrcOffset) != Crc32(sBuffer, 0, nCrcOffset))
+    {
+        RA_LOG_WARN("Ignoring corrupt session index for %s", m_sUsername);
+        return false;
+    }
+
+    m_vGameStats.reserve(nCount);
+    for (uint32_t i = 0; i < nCount; ++i)
+    {
+        GameStats& pStats = m_vGameStats.emplace_back();
+        pStats.GameId = ReadValue<uint32_t>(sBuffer, nOffset);
+        pStats.TotalPlayTime = std::chrono::seconds(ReadValue<int64_t>(sBuffer, nOffset + sizeof(uint32_t)));
+        pStats.LastSessionStart = std::chrono::system_clock::from_time_t(
+            gsl::narrow_cast<time_t>(ReadValue<int64_t>(sBuffer, nOffset + sizeof(uint32_t) + sizeof(int64_t))));
+        nOffset += INDEX_ENTRY_SIZE;
+    }
+
+    nIndexedLength = nLogLength;
+    return true;
+}
+
+std::streamoff SessionTracker::ReplaySessionLog(ra::services::TextReader& pLog, std::streamoff nStart)
+{
+    const auto nLogSize = ra::to_signed(pLog.GetSize());
+    std::streamoff nPosition = nStart;
+    if (nPosition + ra::to_signed(LOG_RECORD_SIZE) > nLogSize)
+        return nPosition;
+
+    pLog.SetPosition(nPosition);
+
+    size_t nReplayed = 0, nInvalid = 0;
+    std::string sBuffer;
+    while (nPosition + ra::to_signed(LOG_RECORD_SIZE) <= nLogSize)
+    {
+        const auto nRecords = std::min(gsl::narrow_cast<size_t>(nLogSize - nPosition) / LOG_RECORD_SIZE, LOG_RECORDS_PER_READ);
+        if (!ReadAll(pLog, sBuffer, nRecords * LOG_RECORD_SIZE))
+            break;
 
-            const auto nSessionLength = pTokenizer.ReadNumber();
-            if (!pTokenizer.Consume(':'))
+        for (size_t nOffset = 0; nOffset < sBuffer.size(); nOffset += LOG_RECORD_SIZE)
+        {
+            constexpr size_t nCrcOffset = LOG_RECORD_SIZE - sizeof(uint32_t);
+            if (ReadValue<uint32_t>(sBuffer, nOffset + nCrcOffset) != Crc32(sBuffer, nOffset, nCrcOffset))
+            {
+                // partially written or damaged record - skip it
+                ++nInvalid;
                 continue;
+            }
+
+            const auto nGameId = ReadValue<uint32_t>(sBuffer, nOffset);
+            const auto tSessionStart = gsl::narrow_cast<time_t>(ReadValue<int64_t>(sBuffer, nOffset + sizeof(uint32_t)));
+            const auto nSessionLength = ReadValue<uint32_t>(sBuffer, nOffset + sizeof(uint32_t) + sizeof(int64_t));
+            AddSession(nGameId, tSessionStart, std::chrono::seconds(nSessionLength));
+            ++nReplayed;
+        }
+
+        nPosition += ra::to_signed(sBuffer.size());
+    }
 
+    RA_LOG_INFO("Replayed %zu sessions for %s (%zu invalid)", nReplayed, m_sUsername, nInvalid);
+    return nPosition;
+}
 
-            const BYTE* pLine;
-            GSL_SUPPRESS_TYPE1{ pLine = reinterpret_cast<const BYTE*>(sLine.c_str()); }
-            const auto md5 = RAGenerateMD5(pLine, pTokenizer.CurrentPosition());
-            if (pTokenizer.Consume(md5.front()) && pTokenizer.Consume(md5.back()))
-                AddSession(nGameId, nSessionStart, std::chrono::seconds(nSessionLength));
+void SessionTracker::MigrateSessionStats()
+{
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    auto pStatsFile = pLocalStorage.ReadText(ra::services::StorageItemType::SessionStats, m_sUsername);
+    if (pStatsFile == nullptr)
+        return;
+
+    std::string sLog;
+    sLog.append(LOG_SIGNATURE.data(), LOG_SIGNATURE.size());
+    WriteValue(sLog, LOG_VERSION);
+
+    // line format: <gameid>:<sessionstart>:<sessionlength>:<checksum>
+    size_t nSessions = 0;
+    std::string sLine;
+    while (pStatsFile->GetLine(sLine))
+    {
+        ra::Tokenizer pTokenizer(sLine);
+
+        const auto nGameId = pTokenizer.ReadNumber();
+        if (!pTokenizer.Consume(':'))
+            continue;
+
+        const auto nSessionStart = pTokenizer.ReadNumber();
+        if (!pTokenizer.Consume(':'))
+            continue;
+
+        const auto nSessionLength = pTokenizer.ReadNumber();
+        if (!pTokenizer.Consume(':'))
+            continue;
+
+        const BYTE* pLine;
+        GSL_SUPPRESS_TYPE1{ pLine = reinterpret_cast<const BYTE*>(sLine.c_str()); }
+        const auto md5 = RAGenerateMD5(pLine, pTokenizer.CurrentPosition());
+        if (pTokenizer.Consume(md5.front()) && pTokenizer.Consume(md5.back()))
+        {
+            AddSession(nGameId, nSessionStart, std::chrono::seconds(nSessionLength));
+            WriteLogRecord(sLog, nGameId, nSessionStart, std::chrono::seconds(nSessionLength));
+            ++nSessions;
         }
+    }
+
+    auto pLog = pLocalStorage.WriteText(ra::services::StorageItemType::SessionLog, m_sUsername);
+    if (pLog == nullptr)
+        return;
+
+    pLog->Write(sLog);
+    m_nFileWritePosition = ra::to_signed(sLog.size());
 
-        m_nFileWritePosition = pStatsFile->GetPosition();
+    WriteSessionIndex();
+
+    RA_LOG_INFO("Migrated %zu sessions for %s", nSessions, m_sUsername);
+}
+
+void SessionTracker::WriteSessionIndex() const
+{
+    std::string sBuffer;
+    sBuffer.reserve(INDEX_HEADER_SIZE + m_vGameStats.size() * INDEX_ENTRY_SIZE + sizeof(uint32_t));
+    sBuffer.append(INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size());
+    WriteValue(sBuffer, INDEX_VERSION);
+    WriteValue(sBuffer, static_cast<int64_t>(m_nFileWritePosition));
+    WriteValue(sBuffer, gsl::narrow_cast<uint32_t>(m_vGameStats.size()));
+
+    for (const auto& pStats : m_vGameStats)
+    {
+        WriteValue(sBuffer, gsl::narrow_cast<uint32_t>(pStats.GameId));
+        WriteValue(sBuffer, static_cast<int64_t>(pStats.TotalPlayTime.count()));
+        WriteValue(sBuffer, static_cast<int64_t>(std::chrono::system_clock::to_time_t(pStats.LastSessionStart)));
     }
+
+    WriteValue(sBuffer, Crc32(sBuffer, 0, sBuffer.size()));
+
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    auto pIndex = pLocalStorage.WriteText(ra::services::StorageItemType::SessionIndex, m_sUsername);
+    if (pIndex != nullptr)
+        pIndex->Write(sBuffer);
 }
 
 void SessionTracker::AddSession(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration)
@@ -141,6 +390,7 @@ void SessionTracker::EndSession()
 
         // update the persisted play duration
         AddSession(m_nCurrentGameId, m_tSessionStart, tSessionDuration);
+        WriteSessionIndex();
     }
 
     m_nCurrentGameId = 0;
@@ -183,18 +433,25 @@ void SessionTracker::UpdateSession(time_t tSessionStart)
 std::streampos SessionTracker::WriteSessionStats(std::chrono::seconds tSessionDuration) const
 {
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
-    auto pStatsFile = pLocalStorage.AppendText(ra::services::StorageItemType::SessionStats, m_sUsername);
+    auto pLog = pLocalStorage.AppendText(ra::services::StorageItemType::SessionLog, m_sUsername);
+    if (pLog == nullptr)
+        return m_nFileWritePosition;
+
+    std::string sBuffer;
+    std::streamoff nPosition = m_nFileWritePosition;
+    if (nPosition < ra::to_signed(LOG_HEADER_SIZE))
+    {
+        sBuffer.append(LOG_SIGNATURE.data(), LOG_SIGNATURE.size());
+        WriteValue(sBuffer, LOG_VERSION);
+        nPosition = 0;
+    }
 
-    auto nSessionDuration = tSessionDuration.count();
-    auto sLine = ra::StringPrintf("%u:%ll:%ll:", m_nCurrentGameId, m_tSessionStart, nSessionDuration);
-    const auto sMD5 = RAGenerateMD5(sLine);
-    sLine.push_back(sMD5.front());
-    sLine.push_back(sMD5.back());
+    WriteLogRecord(sBuffer, m_nCurrentGameId, m_tSessionStart, tSessionDuration);
 
-    pStatsFile->SetPosition(m_nFileWritePosition);
-    pStatsFile->WriteLine(sLine);
+    pLog->SetPosition(nPosition);
+    pLog->Write(sBuffer);
 
-    return pStatsFile->GetPosition();
+    return pLog->GetPosition();
 }
 
 std::chrono::seconds SessionTracker::GetTotalPlaytime(unsigned int nGameId) const
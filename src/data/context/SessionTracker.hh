@@ -2,6 +2,8 @@
 #define RA_DATA_SESSIONTRACKER_HH
 #pragma once
 
+#include "services\TextReader.hh"
+
 #include <string>
 
 namespace ra {
@@ -56,6 +58,9 @@ public:
     const std::vector<GameStats>& SessionData() const noexcept { return m_vGameStats; }
 
 protected:
+    /// <summary>
+    /// Loads the per-game totals from the session index, replaying any sessions logged after the index was written.
+    /// </summary>
     virtual void LoadSessions();
     void AddSession(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration);
 
@@ -71,6 +76,11 @@ protected:
 private:
     void SortSessions();
 
+    bool LoadSessionIndex(std::streamoff& nIndexedLength);
+    std::streamoff ReplaySessionLog(ra::services::TextReader& pLog, std::streamoff nStart);
+    void MigrateSessionStats();
+    void WriteSessionIndex() const;
+
     std::chrono::steady_clock::time_point m_tpSessionStart{};
     time_t m_tSessionStart{};
 
@@ -190,6 +190,7 @@ bool AssetModelBase::ReadPossiblyQuoted(ra::Tokenizer& pTokenizer, std::wstring&
 void AssetModelBase::CreateServerCheckpoint()
 {
     Expects(m_pTransaction == nullptr);
+    ++m_nSerializationVersion;
     BeginTransaction();
 
     SetValue(ChangesProperty, ra::etoi(AssetChanges::None));
@@ -199,6 +200,7 @@ void AssetModelBase::CreateLocalCheckpoint()
 {
     Expects(m_pTransaction != nullptr);
     Expects(m_pTransaction->m_pNext == nullptr);
+    ++m_nSerializationVersion;
     const bool bModified = m_pTransaction->IsModified();
     BeginTransaction();       // start transaction for in-memory changes
 
@@ -294,16 +296,20 @@ bool AssetModelBase::IsUpdating() const
 
 void AssetModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
 {
+    ++m_nSerializationVersion;
     DataModelBase::OnValueChanged(args);
 }
 
 void AssetModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 {
+    ++m_nSerializationVersion;
     DataModelBase::OnValueChanged(args);
 }
 
 void AssetModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 {
+    ++m_nSerializationVersion;
+
     // if IsUpdating is true, we're either setting up the object or updating the checkpoints.
     // the Changes state will be updated appropriately later.
     if (!IsUpdating())
@@ -492,6 +498,7 @@ void AssetModelBase::SetAssetDefinition(AssetDefinition& pAsset, const std::stri
 void AssetModelBase::CommitTransaction()
 {
     Expects(m_pTransaction != nullptr);
+    ++m_nSerializationVersion;
 
     if (m_pTransaction->m_pNext == nullptr)
     {
@@ -548,6 +555,8 @@ void AssetModelBase::CommitTransaction()
 
 void AssetModelBase::RevertTransaction()
 {
+    ++m_nSerializationVersion;
+
     // call before updating so TrackingProperties are reverted first
     DataModelBase::RevertTransaction();
 
@@ -261,6 +261,12 @@ public:
     virtual void Serialize(ra::services::TextWriter& pWriter) const = 0;
     virtual bool Deserialize(ra::Tokenizer& pTokenizer) = 0;
 
+    /// <summary>
+    /// Gets a value that changes whenever a property or checkpoint of the asset changes. If the value hasn't
+    /// changed, the output of <see cref="Serialize" /> hasn't changed either.
+    /// </summary>
+    unsigned GetSerializationVersion() const noexcept { return m_nSerializationVersion; }
+
     /// <summary>
     /// Captures the current state of the asset as a reflection of the state on the server.
     /// </summary>
@@ -360,6 +366,8 @@ protected:
     void RevertTransaction() override;
 
 private:
+    unsigned m_nSerializationVersion = 0;
+
     static const std::string& GetAssetDefinition(const AssetDefinition& pAsset, AssetChanges nState) noexcept;
     AssetChanges GetAssetDefinitionState(const AssetDefinition& pAsset) const;
     void UpdateAssetDefinitionVersion(const AssetDefinition&, AssetChanges nState);
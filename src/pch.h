@@ -42,8 +42,10 @@
 /* STL Stuff */
 #include <array> // algorithm, iterator, tuple
 #include <atomic>
+#include <charconv>
 #include <fstream>
 #include <iomanip>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex> // chrono (time.h), functional, thread, utility
@@ -52,6 +54,7 @@
 #include <sstream> // string
 #include <stack>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 #pragma warning(push)
@@ -34,6 +34,7 @@ void AchievementRuntime::ResetRuntime() noexcept
     {
         rc_runtime_destroy(&m_pRuntime);
         m_bInitialized = false;
+        m_bStateSnapshotStale = true;
     }
 }
 
@@ -43,6 +44,7 @@ void AchievementRuntime::ResetActiveAchievements()
     if (m_bInitialized)
     {
         rc_runtime_reset(&m_pRuntime);
+        m_bStateSnapshotStale = true;
         RA_LOG_INFO("Runtime reset");
     }
 }
@@ -55,6 +57,7 @@ int AchievementRuntime::ActivateAchievement(ra::AchievementID nId, const std::st
     // When an achievement is activated, it's set to Waiting. The state of the achievement must evaluate
     // to false for at least one frame before it is promoted to Active. This ensures achievements don't
     // trigger from uninitialized (or randomly initialized) memory when first starting a game.
+    m_bStateSnapshotStale = true;
     return rc_runtime_activate_achievement(&m_pRuntime, nId, sTrigger.c_str(), nullptr, 0);
 }
 
@@ -77,6 +80,9 @@ rc_trigger_t* AchievementRuntime::GetAchievementTrigger(ra::AchievementID nId, c
     {
         if (m_pRuntime.triggers[i].id == nId && memcmp(m_pRuntime.triggers[i].md5, md5, sizeof(md5)) == 0)
         {
+            // caller may modify the trigger
+            m_bStateSnapshotStale = true;
+
             if (m_pRuntime.triggers[i].trigger)
                 return m_pRuntime.triggers[i].trigger;
 
@@ -109,6 +115,7 @@ rc_trigger_t* AchievementRuntime::DetachAchievementTrigger(ra::AchievementID nId
             if (pTrigger)
             {
                 m_pRuntime.triggers[i].trigger = nullptr;
+                m_bStateSnapshotStale = true;
                 return pTrigger;
             }
         }
@@ -139,6 +146,7 @@ void AchievementRuntime::ReleaseAchievementTrigger(ra::AchievementID nId, _In_ r
                 if (--m_pRuntime.trigger_count > i)
                     memcpy(&m_pRuntime.triggers[i], &m_pRuntime.triggers[m_pRuntime.trigger_count], sizeof(rc_runtime_trigger_t));
 
+                m_bStateSnapshotStale = true;
             }
         }
     }
@@ -157,6 +165,8 @@ void AchievementRuntime::UpdateAchievementId(ra::AchievementID nOldId, ra::Achie
         if (m_pRuntime.triggers[i].id == nOldId)
             m_pRuntime.triggers[i].id = nNewId;
     }
+
+    m_bStateSnapshotStale = true;
 }
 
 int AchievementRuntime::ActivateLeaderboard(unsigned int nId, const std::string& sDefinition)
@@ -164,6 +174,7 @@ int AchievementRuntime::ActivateLeaderboard(unsigned int nId, const std::string&
     std::lock_guard<std::mutex> pLock(m_pMutex);
     EnsureInitialized();
 
+    m_bStateSnapshotStale = true;
     return rc_runtime_activate_lboard(&m_pRuntime, nId, sDefinition.c_str(), nullptr, 0);
 }
 
@@ -396,12 +407,95 @@ _Use_decl_annotations_ void AchievementRuntime::Process(std::vector<Change>& cha
         g_pChanges = &changes;
         rc_runtime_do_frame(&m_pRuntime, map_event_to_change, rc_peek_callback, nullptr, nullptr);
         g_pChanges = nullptr;
+
+        // capture the state changes while the triggers are still in the cache. GetStateChanges will
+        // then only have to do work if something else modifies the runtime before it's called.
+        UpdateStateSnapshots();
     }
 
     if (!vLeaderboardPauseFlags.empty())
         CheckForLeaderboardPauseChanges(vLeaderboardPauseFlags, &m_pRuntime, changes);
 }
 
+template<typename TSnapshot>
+static void UpdateStateSnapshot(std::vector<TSnapshot>& vSnapshot, size_t nIndex, unsigned int nId, char nState,
+                                std::vector<unsigned int>& vChangedIds)
+{
+    if (nIndex >= vSnapshot.size())
+    {
+        vSnapshot.push_back({nId, nState});
+        vChangedIds.push_back(nId);
+        return;
+    }
+
+    auto& pSnapshot = vSnapshot.at(nIndex);
+    if (pSnapshot.nId != nId)
+    {
+        // items are moved when another item is deactivated. assume both have changed.
+        vChangedIds.push_back(pSnapshot.nId);
+        vChangedIds.push_back(nId);
+        pSnapshot.nId = nId;
+        pSnapshot.nState = nState;
+    }
+    else if (pSnapshot.nState != nState)
+    {
+        vChangedIds.push_back(nId);
+        pSnapshot.nState = nState;
+    }
+}
+
+template<typename TSnapshot>
+static void TrimStateSnapshot(std::vector<TSnapshot>& vSnapshot, size_t nCount, std::vector<unsigned int>& vChangedIds)
+{
+    // anything past the end of the list was deactivated
+    for (size_t nIndex = nCount; nIndex < vSnapshot.size(); ++nIndex)
+        vChangedIds.push_back(vSnapshot.at(nIndex).nId);
+
+    if (vSnapshot.size() > nCount)
+        vSnapshot.resize(nCount);
+}
+
+void AchievementRuntime::UpdateStateSnapshots()
+{
+    // clear the flag before scanning so a change made during the scan is picked up by the next one
+    m_bStateSnapshotStale = false;
+
+    const size_t nTriggerCount = m_bInitialized ? m_pRuntime.trigger_count : 0;
+    for (size_t nIndex = 0; nIndex < nTriggerCount; ++nIndex)
+    {
+        const auto& pRuntimeTrigger = m_pRuntime.triggers[nIndex];
+
+        // detached triggers are treated as inactive
+        const char nState = pRuntimeTrigger.trigger ? pRuntimeTrigger.trigger->state : RC_TRIGGER_STATE_INACTIVE;
+        UpdateStateSnapshot(m_vAchievementStates, nIndex, pRuntimeTrigger.id, nState, m_vChangedAchievementIds);
+    }
+    TrimStateSnapshot(m_vAchievementStates, nTriggerCount, m_vChangedAchievementIds);
+
+    const size_t nLeaderboardCount = m_bInitialized ? m_pRuntime.lboard_count : 0;
+    for (size_t nIndex = 0; nIndex < nLeaderboardCount; ++nIndex)
+    {
+        const auto& pRuntimeLeaderboard = m_pRuntime.lboards[nIndex];
+        const char nState = pRuntimeLeaderboard.lboard ? pRuntimeLeaderboard.lboard->state : RC_LBOARD_STATE_INACTIVE;
+        UpdateStateSnapshot(m_vLeaderboardStates, nIndex, pRuntimeLeaderboard.id, nState, m_vChangedLeaderboardIds);
+    }
+    TrimStateSnapshot(m_vLeaderboardStates, nLeaderboardCount, m_vChangedLeaderboardIds);
+}
+
+_Use_decl_annotations_ void AchievementRuntime::GetStateChanges(std::vector<ra::AchievementID>& vAchievementIds,
+                                                                std::vector<ra::LeaderboardID>& vLeaderboardIds)
+{
+    std::lock_guard<std::mutex> pLock(m_pMutex);
+
+    if (m_bStateSnapshotStale)
+        UpdateStateSnapshots();
+
+    vAchievementIds.clear();
+    vAchievementIds.swap(m_vChangedAchievementIds);
+
+    vLeaderboardIds.clear();
+    vLeaderboardIds.swap(m_vChangedLeaderboardIds);
+}
+
 _NODISCARD static _CONSTANT_FN ComparisonSizeToPrefix(_In_ char nSize) noexcept
 {
     switch (nSize)
@@ -778,6 +872,7 @@ bool AchievementRuntime::LoadProgressFromFile(const char* sLoadStateFilename)
         return true;
 
     std::lock_guard<std::mutex> pLock(m_pMutex);
+    m_bStateSnapshotStale = true;
 
     // clear out any captured hits for active achievements so they get re-evaluated from the runtime
     auto& pGameContext = ra::services::ServiceLocator::GetMutable<ra::data::context::GameContext>();
@@ -881,6 +976,7 @@ bool AchievementRuntime::LoadProgressFromBuffer(const char* pBuffer)
         return true;
 
     std::lock_guard<std::mutex> pLock(m_pMutex);
+    m_bStateSnapshotStale = true;
 
     // reset the runtime state, then apply state from file
     rc_runtime_reset(&m_pRuntime);
@@ -972,6 +1068,7 @@ void AchievementRuntime::InvalidateAddress(ra::ByteAddress nAddress) noexcept
     // both of which aquire the lock, so we shouldn't try to acquire it here.
     // we can also avoid checking m_bInitialized
     rc_runtime_invalidate_address(&m_pRuntime, nAddress);
+    m_bStateSnapshotStale = true;
 }
 
 #pragma warning(push)
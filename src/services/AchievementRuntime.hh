@@ -58,6 +58,8 @@ public:
         if (!m_bInitialized)
             return nullptr;
 
+        // caller may modify the trigger
+        m_bStateSnapshotStale = true;
         return rc_runtime_get_achievement(&m_pRuntime, nId);
     }
 
@@ -98,7 +100,10 @@ public:
     void DeactivateLeaderboard(unsigned int nId) noexcept
     {
         if (m_bInitialized)
+        {
             rc_runtime_deactivate_lboard(&m_pRuntime, nId);
+            m_bStateSnapshotStale = true;
+        }
     }
 
     /// <summary>
@@ -109,6 +114,8 @@ public:
         if (!m_bInitialized)
             return nullptr;
 
+        // caller may modify the leaderboard
+        m_bStateSnapshotStale = true;
         return rc_runtime_get_lboard(&m_pRuntime, nId);
     }
 
@@ -194,6 +201,16 @@ public:
     /// </summary>
     virtual void Process(_Inout_ std::vector<Change>& changes);
 
+    /// <summary>
+    /// Gets the IDs of the achievements and leaderboards whose state in the runtime has changed since the last call.
+    /// </summary>
+    /// <remarks>
+    /// States are compared against the values seen by the previous call, so models only need to be synchronized
+    /// for the returned IDs. An ID may be returned more than once.
+    /// </remarks>
+    void GetStateChanges(_Inout_ std::vector<ra::AchievementID>& vAchievementIds,
+                         _Inout_ std::vector<ra::LeaderboardID>& vLeaderboardIds);
+
     /// <summary>
     /// Loads HitCount data for active achievements from a save state file.
     /// </summary>
@@ -258,6 +275,22 @@ private:
     bool LoadProgressV2(ra::services::TextReader& pFile, std::set<unsigned int>& vProcessedAchievementIds);
 
     void EnsureInitialized() noexcept;
+    void UpdateStateSnapshots();
+
+    struct AssetStateSnapshot
+    {
+        unsigned int nId;
+        char nState;
+    };
+
+    // state of each item in m_pRuntime.triggers/m_pRuntime.lboards as of the last UpdateStateSnapshots
+    std::vector<AssetStateSnapshot> m_vAchievementStates;
+    std::vector<AssetStateSnapshot> m_vLeaderboardStates;
+    std::vector<ra::AchievementID> m_vChangedAchievementIds;
+    std::vector<ra::LeaderboardID> m_vChangedLeaderboardIds;
+
+    // set when the runtime may have been modified outside of Process. some callers don't hold m_pMutex.
+    std::atomic<bool> m_bStateSnapshotStale{ false };
 
     int m_nRichPresenceParseResult = RC_OK;
     int m_nRichPresenceErrorLine = 0;
@@ -0,0 +1,272 @@
+#include "FileHasher.hh"
+
+#include "RA_Log.h"
+#include "RA_md5factory.h"
+
+#include "services\IFileSystem.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+
+// XXH64 with a seed of 0. see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+static constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static constexpr uint64_t RotateLeft(uint64_t nValue, int nBits) noexcept
+{
+    return (nValue << nBits) | (nValue >> (64 - nBits));
+}
+
+static constexpr uint64_t XXH64Round(uint64_t nAccumulator, uint64_t nInput) noexcept
+{
+    return RotateLeft(nAccumulator + nInput * XXH_PRIME64_2, 31) * XXH_PRIME64_1;
+}
+
+static constexpr uint64_t XXH64MergeRound(uint64_t nAccumulator, uint64_t nValue) noexcept
+{
+    return (nAccumulator ^ XXH64Round(0, nValue)) * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+template<typename T>
+static T ReadLittleEndian(const uint8_t* pData) noexcept
+{
+    T nValue;
+    memcpy(&nValue, pData, sizeof(T)); // the DLL only targets little-endian platforms
+    return nValue;
+}
+
+static void XXH64Stripe(std::array<uint64_t, 4>& nAccumulators, const uint8_t* pData) noexcept
+{
+    GSL_SUPPRESS_BOUNDS1
+    for (size_t i = 0; i < nAccumulators.size(); ++i)
+        nAccumulators.at(i) = XXH64Round(nAccumulators.at(i), ReadLittleEndian<uint64_t>(pData + i * 8));
+}
+
+FileHasher::FileHasher(HashAlgorithm nAlgorithms) noexcept
+    : m_nAlgorithms(nAlgorithms)
+{
+    using namespace ra::bitwise_ops;
+
+    if ((m_nAlgorithms & HashAlgorithm::MD5) != HashAlgorithm::None)
+        md5_init(&m_pMD5State);
+
+    m_pXXH64State.nAccumulators = {
+        XXH_PRIME64_1 + XXH_PRIME64_2, XXH_PRIME64_2, 0, 0 - XXH_PRIME64_1
+    };
+}
+
+void FileHasher::Append(const uint8_t* pData, size_t nSize) noexcept
+{
+    using namespace ra::bitwise_ops;
+
+    m_nBytesHashed += nSize;
+
+    if ((m_nAlgorithms & HashAlgorithm::MD5) != HashAlgorithm::None)
+    {
+        // md5_append takes an int, so very large buffers have to be split up
+        constexpr size_t nMaxChunk = 0x40000000;
+        const uint8_t* pChunk = pData;
+        size_t nRemaining = nSize;
+        while (nRemaining > nMaxChunk)
+        {
+            md5_append(&m_pMD5State, pChunk, gsl::narrow_cast<int>(nMaxChunk));
+            GSL_SUPPRESS_BOUNDS1 pChunk += nMaxChunk;
+            nRemaining -= nMaxChunk;
+        }
+
+        md5_append(&m_pMD5State, pChunk, gsl::narrow_cast<int>(nRemaining));
+    }
+
+    if ((m_nAlgorithms & HashAlgorithm::XXH64) != HashAlgorithm::None)
+        AppendXXH64(pData, nSize);
+}
+
+GSL_SUPPRESS_BOUNDS1
+void FileHasher::AppendXXH64(const uint8_t* pData, size_t nSize) noexcept
+{
+    auto& pState = m_pXXH64State;
+    const uint8_t* pEnd = pData + nSize;
+
+    // top off any partial stripe from the previous call
+    if (pState.nPending > 0)
+    {
+        const size_t nNeeded = std::min(pState.pPending.size() - pState.nPending, nSize);
+        memcpy(pState.pPending.data() + pState.nPending, pData, nNeeded);
+        pState.nPending += nNeeded;
+        pData += nNeeded;
+
+        if (pState.nPending < pState.pPending.size())
+            return;
+
+        XXH64Stripe(pState.nAccumulators, pState.pPending.data());
+        pState.nPending = 0;
+    }
+
+    // process full stripes directly from the input
+    while (pEnd - pData >= gsl::narrow_cast<ptrdiff_t>(pState.pPending.size()))
+    {
+        XXH64Stripe(pState.nAccumulators, pData);
+        pData += pState.pPending.size();
+    }
+
+    // hold on to whatever is left until more data arrives
+    pState.nPending = gsl::narrow_cast<size_t>(pEnd - pData);
+    if (pState.nPending > 0)
+        memcpy(pState.pPending.data(), pData, pState.nPending);
+}
+
+// reading a mapped view raises EXCEPTION_IN_PAGE_ERROR instead of returning an error if the file can't be
+// read (i.e. removable or network media was disconnected). __try can't be used in a function that has objects
+// with destructors, so the reads are isolated here.
+static bool TryAppendMapped(FileHasher& pHasher, const uint8_t* pData, size_t nSize) noexcept
+{
+    __try
+    {
+        pHasher.Append(pData, nSize);
+        return true;
+    }
+    __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+    {
+        return false;
+    }
+}
+
+bool FileHasher::AppendFile(const std::wstring& sPath, std::vector<uint8_t>& vBuffer)
+{
+    const auto& pFileSystem = ServiceLocator::Get<IFileSystem>();
+
+    // hash directly out of the page cache if possible, avoiding a copy into a local buffer
+    {
+        const auto pMappedFile = pFileSystem.MapFile(sPath);
+        if (pMappedFile != nullptr)
+        {
+            const FileHasher pInitialState(*this);
+
+            const uint8_t* pData = pMappedFile->GetData();
+            size_t nRemaining = pMappedFile->GetSize();
+            while (nRemaining > 0)
+            {
+                if (IsCancelled())
+                    return false;
+
+                const auto nChunk = std::min(nRemaining, StreamBufferSize);
+                if (!TryAppendMapped(*this, pData, nChunk))
+                    break;
+
+                GSL_SUPPRESS_BOUNDS1 pData += nChunk;
+                nRemaining -= nChunk;
+            }
+
+            if (nRemaining == 0)
+                return true;
+
+            // discard whatever was hashed from the mapped view and try again with regular reads, which
+            // report errors instead of raising an exception
+            RA_LOG_WARN("Error reading mapped file \"%s\", retrying without mapping", ra::Narrow(sPath).c_str());
+            *this = pInitialState;
+        }
+    }
+
+    auto pFile = pFileSystem.OpenTextFile(sPath);
+    if (pFile == nullptr)
+        return false;
+
+    if (vBuffer.size() < StreamBufferSize)
+        vBuffer.resize(StreamBufferSize);
+
+    do
+    {
+        if (IsCancelled())
+            return false;
+
+        const auto nBytes = pFile->GetBytes(vBuffer.data(), vBuffer.size());
+        if (nBytes == 0)
+            break;
+
+        Append(vBuffer.data(), nBytes);
+    } while (true);
+
+    return true;
+}
+
+std::string FileHasher::GetMD5() const
+{
+    using namespace ra::bitwise_ops;
+
+    if ((m_nAlgorithms & HashAlgorithm::MD5) == HashAlgorithm::None)
+        return "";
+
+    // finishing modifies the state, so work on a copy
+    md5_state_t pState = m_pMD5State;
+    md5_byte_t digest[16]{};
+    md5_finish(&pState, digest);
+
+    return RAFormatMD5(digest);
+}
+
+GSL_SUPPRESS_BOUNDS1
+uint64_t FileHasher::GetXXH64() const noexcept
+{
+    using namespace ra::bitwise_ops;
+
+    if ((m_nAlgorithms & HashAlgorithm::XXH64) == HashAlgorithm::None)
+        return 0;
+
+    const auto& pState = m_pXXH64State;
+    const auto& nAcc = pState.nAccumulators;
+
+    uint64_t nHash = 0;
+    if (m_nBytesHashed >= pState.pPending.size())
+    {
+        nHash = RotateLeft(nAcc.at(0), 1) + RotateLeft(nAcc.at(1), 7) +
+                RotateLeft(nAcc.at(2), 12) + RotateLeft(nAcc.at(3), 18);
+        for (const auto nValue : nAcc)
+            nHash = XXH64MergeRound(nHash, nValue);
+    }
+    else
+    {
+        nHash = XXH_PRIME64_5;
+    }
+
+    nHash += m_nBytesHashed;
+
+    const uint8_t* pData = pState.pPending.data();
+    size_t nRemaining = pState.nPending;
+    while (nRemaining >= 8)
+    {
+        nHash ^= XXH64Round(0, ReadLittleEndian<uint64_t>(pData));
+        nHash = RotateLeft(nHash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        pData += 8;
+        nRemaining -= 8;
+    }
+
+    if (nRemaining >= 4)
+    {
+        nHash ^= ReadLittleEndian<uint32_t>(pData) * XXH_PRIME64_1;
+        nHash = RotateLeft(nHash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        pData += 4;
+        nRemaining -= 4;
+    }
+
+    while (nRemaining > 0)
+    {
+        nHash ^= *pData * XXH_PRIME64_5;
+        nHash = RotateLeft(nHash, 11) * XXH_PRIME64_1;
+        ++pData;
+        --nRemaining;
+    }
+
+    nHash ^= nHash >> 33;
+    nHash *= XXH_PRIME64_2;
+    nHash ^= nHash >> 29;
+    nHash *= XXH_PRIME64_3;
+    nHash ^= nHash >> 32;
+    return nHash;
+}
+
+} // namespace services
+} // namespace ra
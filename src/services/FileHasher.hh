@@ -0,0 +1,98 @@
+#ifndef RA_SERVICES_FILEHASHER_HH
+#define RA_SERVICES_FILEHASHER_HH
+#pragma once
+
+#include <rcheevos\src\rhash\md5.h>
+
+namespace ra {
+namespace services {
+
+enum class HashAlgorithm : uint8_t
+{
+    None = 0x00,
+    MD5 = 0x01,   // matches the hashes used by the server
+    XXH64 = 0x02, // much faster than MD5, only suitable for local caching
+};
+
+/// <summary>
+/// Calculates one or more hashes of the same data in a single pass.
+/// </summary>
+class FileHasher
+{
+public:
+    explicit FileHasher(HashAlgorithm nAlgorithms) noexcept;
+
+    /// <summary>
+    /// Adds <paramref name="nSize" /> bytes from <paramref name="pData" /> to each of the hashes.
+    /// </summary>
+    void Append(const uint8_t* pData, size_t nSize) noexcept;
+
+    /// <summary>
+    /// Adds the contents of a file to each of the hashes.
+    /// </summary>
+    /// <remarks>
+    /// The file is memory mapped and hashed in place when possible. Otherwise, it's streamed through
+    /// <paramref name="vBuffer" />, which will be grown to <see cref="StreamBufferSize" /> if it's smaller.
+    /// </remarks>
+    /// <returns><c>true</c> if the entire file was hashed, <c>false</c> if it could not be opened or the hash was cancelled.</returns>
+    bool AppendFile(const std::wstring& sPath, std::vector<uint8_t>& vBuffer);
+
+    /// <summary>
+    /// Adds the contents of a file to each of the hashes.
+    /// </summary>
+    bool AppendFile(const std::wstring& sPath)
+    {
+        std::vector<uint8_t> vBuffer;
+        return AppendFile(sPath, vBuffer);
+    }
+
+    /// <summary>
+    /// Sets a flag that will abort <see cref="AppendFile" /> when set.
+    /// </summary>
+    void SetCancelFlag(const std::atomic<bool>* pCancel) noexcept { m_pCancel = pCancel; }
+
+    /// <summary>
+    /// Gets the number of bytes that have been hashed.
+    /// </summary>
+    uint64_t GetBytesHashed() const noexcept { return m_nBytesHashed; }
+
+    /// <summary>
+    /// Gets the MD5 of the data as a 32-character hex string.
+    /// </summary>
+    /// <remarks>Returns an empty string if <see cref="HashAlgorithm::MD5" /> was not requested.</remarks>
+    std::string GetMD5() const;
+
+    /// <summary>
+    /// Gets the XXH64 of the data.
+    /// </summary>
+    /// <remarks>Returns <c>0</c> if <see cref="HashAlgorithm::XXH64" /> was not requested.</remarks>
+    uint64_t GetXXH64() const noexcept;
+
+    /// <summary>
+    /// The amount of data handed to the hash algorithms at a time.
+    /// </summary>
+    static constexpr size_t StreamBufferSize = 1024 * 1024;
+
+private:
+    bool IsCancelled() const noexcept { return m_pCancel != nullptr && *m_pCancel; }
+
+    struct XXH64State
+    {
+        std::array<uint64_t, 4> nAccumulators{};
+        std::array<uint8_t, 32> pPending{};
+        size_t nPending = 0;
+    };
+
+    void AppendXXH64(const uint8_t* pData, size_t nSize) noexcept;
+
+    HashAlgorithm m_nAlgorithms;
+    uint64_t m_nBytesHashed = 0;
+    const std::atomic<bool>* m_pCancel = nullptr;
+    md5_state_t m_pMD5State{};
+    XXH64State m_pXXH64State;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_FILEHASHER_HH
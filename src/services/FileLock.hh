@@ -0,0 +1,27 @@
+#ifndef RA_SERVICES_FILELOCK
+#define RA_SERVICES_FILELOCK
+#pragma once
+
+namespace ra {
+namespace services {
+
+/// <summary>
+/// Exclusive access to a file that is shared with other processes. The lock is held until the object is destroyed.
+/// </summary>
+class FileLock
+{
+public:
+    virtual ~FileLock() noexcept = default;
+    FileLock(const FileLock&) noexcept = delete;
+    FileLock& operator=(const FileLock&) noexcept = delete;
+    FileLock(FileLock&&) noexcept = delete;
+    FileLock& operator=(FileLock&&) noexcept = delete;
+
+protected:
+    FileLock() noexcept = default;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_FILELOCK
@@ -15,7 +15,6 @@
 
 #include "services\IAudioSystem.hh"
 #include "services\IConfiguration.hh"
-#include "services\ILocalStorage.hh"
 #include "services\ServiceLocator.hh"
 
 #include "ui\viewmodels\MessageBoxViewModel.hh"
@@ -26,8 +25,6 @@
 namespace ra {
 namespace services {
 
-static constexpr const wchar_t* KNOWN_HASHES_KEY = L"Hashes";
-
 unsigned int GameIdentifier::IdentifyGame(const BYTE* pROM, size_t nROMSize)
 {
     m_nPendingMode = ra::data::context::GameContext::Mode::Normal;
@@ -59,15 +56,16 @@ unsigned int GameIdentifier::IdentifyHash(const std::string& sHash)
         if (ra::services::ServiceLocator::Get<ra::services::IConfiguration>().
                 IsFeatureEnabled(ra::services::Feature::Offline))
         {
-            LoadKnownHashes(m_mKnownHashes);
-
-            if (m_mKnownHashes.find(sHash) == m_mKnownHashes.end())
+            const auto nKnownGameId = m_pKnownHashes.Find(sHash);
+            if (nKnownGameId == 0U)
             {
                 ra::ui::viewmodels::MessageBoxViewModel::ShowErrorMessage(
                     L"Cannot load achievements",
                     L"This game was not previously identified and requires a connection to identify it.");
                 return 0U;
             }
+
+            m_mResolvedHashes.insert_or_assign(sHash, nKnownGameId);
         }
         else
         {
@@ -81,8 +79,8 @@ unsigned int GameIdentifier::IdentifyHash(const std::string& sHash)
     unsigned int nGameId = 0U;
     m_nPendingMode = ra::data::context::GameContext::Mode::Normal;
 
-    const auto pIter = m_mKnownHashes.find(sHash);
-    if (pIter != m_mKnownHashes.end())
+    const auto pIter = m_mResolvedHashes.find(sHash);
+    if (pIter != m_mResolvedHashes.end())
     {
         RA_LOG_INFO("Using previously looked up game ID %u for hash %s", nGameId, sHash);
         nGameId = pIter->second;
@@ -120,7 +118,8 @@ unsigned int GameIdentifier::IdentifyHash(const std::string& sHash)
             else
             {
                 RA_LOG_INFO("Successfully looked up game with ID %u", nGameId);
-                m_mKnownHashes.insert_or_assign(sHash, nGameId);
+                m_mResolvedHashes.insert_or_assign(sHash, nGameId);
+                m_pKnownHashes.Add(sHash, nGameId);
             }
         }
         else
@@ -239,63 +238,9 @@ void GameIdentifier::IdentifyAndActivateGame(const BYTE* pROM, size_t nROMSize)
     }
 }
 
-void GameIdentifier::LoadKnownHashes(std::map<std::string, unsigned>& mHashes)
-{
-    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
-    auto pFile = pLocalStorage.ReadText(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY);
-    if (pFile != nullptr)
-    {
-        std::string sLine;
-        while (pFile->GetLine(sLine))
-        {
-            ra::Tokenizer pTokenizer(sLine);
-            auto sHash = pTokenizer.ReadTo('=');
-            if (sHash.length() == 32)
-            {
-                pTokenizer.Advance(); // '='
-                auto nID = pTokenizer.ReadNumber();
-                mHashes[sHash] = nID;
-            }
-        }
-    }
-}
-
-void GameIdentifier::SaveKnownHashes(std::map<std::string, unsigned>& mHashes)
-{
-    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
-    auto pFile = pLocalStorage.WriteText(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY);
-    if (pFile != nullptr)
-    {
-        std::string sLine;
-        for (const auto& pPair : mHashes)
-        {
-            sLine = ra::StringPrintf("%s=%u", pPair.first, pPair.second);
-            pFile->WriteLine(sLine);
-        }
-    }
-}
-
-void GameIdentifier::SaveKnownHashes() const
+void GameIdentifier::SaveKnownHashes()
 {
-    if (m_mKnownHashes.empty())
-        return;
-
-    bool bChanged = false;
-    std::map<std::string, unsigned> mHashes;
-    LoadKnownHashes(mHashes);
-
-    for (const auto& pPair : m_mKnownHashes)
-    {
-        const auto pIter = mHashes.find(pPair.first);
-        if (pIter == mHashes.end() || pIter->second != pPair.second)
-        {
-            mHashes[pPair.first] = pPair.second;
-            bChanged = true;
-        }
-    }
-
-    if (bChanged)
-        SaveKnownHashes(mHashes);
+    m_pKnownHashes.Compact();
 }
 
 } // namespace services
@@ -4,6 +4,8 @@
 
 #include "data\context\GameContext.hh"
 
+#include "services\KnownHashStore.hh"
+
 namespace ra {
 namespace services {
 
@@ -37,18 +39,16 @@ public:
     void ActivateGame(unsigned int nGameId);
 
     /// <summary>
-    /// Flushes the known hashes to disk.
+    /// Merges any newly identified hashes into the known hash index.
     /// </summary>
-    void SaveKnownHashes() const;
+    void SaveKnownHashes();
 
 private:
-    static void LoadKnownHashes(std::map<std::string, unsigned>& mHashes);
-    static void SaveKnownHashes(std::map<std::string, unsigned>& mHashes);
-
     std::string m_sPendingHash;
     unsigned int m_nPendingGameId{};
     ra::data::context::GameContext::Mode m_nPendingMode{};
-    std::map<std::string, unsigned> m_mKnownHashes;
+    std::map<std::string, unsigned> m_mResolvedHashes; // hashes identified during this session
+    KnownHashStore m_pKnownHashes{ L"Hashes" };
 };
 
 } // namespace services
@@ -2,6 +2,8 @@
 #define RA_SERVICES_ICONFIGURATION
 #pragma once
 
+#include "services\ILogger.hh"
+
 #include "ui\Types.hh"
 #include "ui\viewmodels\PopupViewModelBase.hh"
 
@@ -75,6 +77,11 @@ public:
     /// </summary>
     virtual unsigned int GetNumBackgroundThreads() const = 0;
 
+    /// <summary>
+    /// Gets the least severe level of message that should be written to the log.
+    /// </summary>
+    virtual LogLevel GetLogLevel() const = 0;
+
     virtual const std::wstring& GetRomDirectory() const = 0;
     virtual void SetRomDirectory(const std::wstring& sValue) = 0;
 
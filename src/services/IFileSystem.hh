@@ -2,6 +2,8 @@
 #define RA_SERVICES_IFILESYSTEM
 #pragma once
 
+#include "services/FileLock.hh"
+#include "services/MappedFile.hh"
 #include "services/TextReader.hh"
 #include "services/TextWriter.hh"
 
@@ -46,6 +48,15 @@ public:
     /// <returns>Number of files added to <paramref name="vResults" /></returns>
     virtual size_t GetFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const = 0;
 
+    /// <summary>
+    /// Gets the files in a directory that are not empty.
+    /// </summary>
+    /// <param name="sDirectory">The directory to enumerate.</param>
+    /// <param name="vResults">The vector to populate with the matching files.</param>
+    /// <returns>Number of files added to <paramref name="vResults" /></returns>
+    /// <remarks>The sizes come from the directory listing, so the files don't have to be checked individually.</remarks>
+    virtual size_t GetNonEmptyFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const = 0;
+
     /// <summary>
     /// Gets the size of the file (in bytes).
     /// </summary>
@@ -96,6 +107,20 @@ public:
     /// <remarks>Will create the file if it doesn't already exist.</remarks>
     virtual std::unique_ptr<TextWriter> AppendTextFile(const std::wstring& sPath) const = 0;
 
+    /// <summary>
+    /// Maps the specified file into memory for reading.
+    /// </summary>
+    /// <returns>Pointer to a <see cref="MappedFile" /> for accessing the contents of the file. <c>nullptr</c> if the file could not be mapped.</returns>
+    /// <remarks>Empty files cannot be mapped. Callers should fall back to <see cref="OpenTextFile" /> if this fails.</remarks>
+    virtual std::unique_ptr<MappedFile> MapFile(const std::wstring& sPath) const = 0;
+
+    /// <summary>
+    /// Waits for exclusive access to the specified lock file, which is shared with other processes.
+    /// </summary>
+    /// <returns>Pointer to a <see cref="FileLock" /> that holds the lock. <c>nullptr</c> if the lock could not be obtained.</returns>
+    /// <remarks>Will create the file if it doesn't already exist.</remarks>
+    virtual std::unique_ptr<FileLock> LockFile(const std::wstring& sPath) const = 0;
+
     /// <summary>
     /// Gets the filename portion of a path.
     /// </summary>
@@ -2,6 +2,8 @@
 #define RA_SERVICES_ILOCALSTORAGE_HH
 #pragma once
 
+#include "FileLock.hh"
+#include "MappedFile.hh"
 #include "TextReader.hh"
 #include "TextWriter.hh"
 
@@ -18,8 +20,13 @@ enum class StorageItemType
     Badge,
     UserPic,
     SessionStats,
+    SessionLog,
+    SessionIndex,
     Bookmarks,
     HashMapping,
+    KnownHashIndex,
+    KnownHashJournal,
+    SubmissionJournal,
 };
 
 class ILocalStorage
@@ -59,6 +66,23 @@ public:
     /// </returns>
     virtual std::unique_ptr<TextWriter> AppendText(StorageItemType nType, const std::wstring& sKey) = 0;
 
+    /// <summary>
+    ///   Maps stored data for the specified <paramref name="nType" /> and <paramref name="sKey" /> into memory.
+    /// </summary>
+    /// <returns>
+    ///   <see cref="MappedFile" /> for accessing the data, <c>nullptr</c> if not found or the data cannot be mapped.
+    /// </returns>
+    virtual std::unique_ptr<MappedFile> MapData(StorageItemType nType, const std::wstring& sKey) = 0;
+
+    /// <summary>
+    ///   Waits for exclusive access to the stored data for the specified <paramref name="nType" /> and
+    ///   <paramref name="sKey" />. Other processes that lock the same data will wait until the lock is released.
+    /// </summary>
+    /// <returns>
+    ///   <see cref="FileLock" /> that holds the lock until destroyed, <c>nullptr</c> if the lock could not be obtained.
+    /// </returns>
+    virtual std::unique_ptr<FileLock> LockData(StorageItemType nType, const std::wstring& sKey) = 0;
+
 protected:
     ILocalStorage() noexcept = default;
 };
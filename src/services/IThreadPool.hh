@@ -14,15 +14,53 @@ public:
     IThreadPool(IThreadPool&&) noexcept = delete;
     IThreadPool& operator=(IThreadPool&&) noexcept = delete;
 
+    enum class TaskPriority
+    {
+        /// <summary>
+        /// Work the user is waiting on (server requests, images, UI updates).
+        /// </summary>
+        Interactive = 0,
+
+        /// <summary>
+        /// Long running work that can be delayed while interactive work is pending (file scanning, cleanup).
+        /// </summary>
+        Background,
+    };
+
     /// <summary>
     /// Queues work for a background thread
     /// </summary>
-    virtual void RunAsync(std::function<void()>&& f) = 0;
+    void RunAsync(std::function<void()>&& f) { RunAsync(TaskPriority::Interactive, std::move(f)); }
+
+    /// <summary>
+    /// Queues work for a background thread with the specified priority
+    /// </summary>
+    virtual void RunAsync(TaskPriority nPriority, std::function<void()>&& f) = 0;
+
+    /// <summary>
+    /// Identifies a task queued by <see cref="ScheduleAsync" />.
+    /// </summary>
+    using ScheduledTaskId = uint64_t;
 
     /// <summary>
     /// Queues work for a background thread to be run after a period of time
     /// </summary>
-    virtual void ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) = 0;
+    /// <returns>
+    /// Identifier that can be passed to <see cref="CancelScheduledTask" />. Zero if the task was not queued.
+    /// </returns>
+    virtual ScheduledTaskId ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) = 0;
+
+    /// <summary>
+    /// Prevents a task queued by <see cref="ScheduleAsync" /> from running.
+    /// </summary>
+    /// <returns>
+    /// <c>true</c> if the task was cancelled, <c>false</c> if its delay has already elapsed or it was not found.
+    /// </returns>
+    /// <remarks>
+    /// Use this when a scheduled task has been superseded (i.e. debounced updates) instead of letting it run and
+    /// detecting that it's no longer needed.
+    /// </remarks>
+    virtual bool CancelScheduledTask(ScheduledTaskId nId) = 0;
 
     /// <summary>
     /// Sets the <see ref="IsShutdownRequested" /> flag so threads can start winding down.
@@ -39,6 +77,79 @@ public:
     /// <remarks>Long running background threads should occasionally check this and terminate early.</remarks>
     virtual bool IsShutdownRequested() const noexcept = 0;
 
+    /// <summary>
+    /// Calls <paramref name="fBody" /> with consecutive ranges of indices that cover [0, <paramref name="nCount" />),
+    /// distributing the ranges across the background threads. Returns when all ranges have been processed.
+    /// </summary>
+    /// <param name="nGrainSize">The maximum number of indices to pass to a single call.</param>
+    /// <param name="fBody">Called with the first index and one past the last index of each range.</param>
+    /// <remarks>
+    /// The calling thread also processes ranges, so the work completes even if every background thread is busy.
+    /// If any call throws an exception, the remaining ranges are still processed and the first exception is
+    /// rethrown on the calling thread.
+    /// </remarks>
+    void ParallelFor(size_t nCount, size_t nGrainSize, const std::function<void(size_t, size_t)>& fBody)
+    {
+        if (nGrainSize == 0)
+            nGrainSize = 1;
+
+        const size_t nRanges = (nCount + nGrainSize - 1) / nGrainSize;
+        if (nRanges <= 1)
+        {
+            if (nCount > 0)
+                fBody(0, nCount);
+            return;
+        }
+
+        // helpers may not start until after this function returns, so the shared state is reference counted. they
+        // only reference fBody after claiming a range, which can't happen once every range has been completed.
+        struct ParallelForState
+        {
+            std::atomic<size_t> nNextRange{ 0 };
+            size_t nCompletedRanges = 0;
+            std::exception_ptr pException;
+            std::mutex oMutex;
+            std::condition_variable cvCompleted;
+        };
+        auto pState = std::make_shared<ParallelForState>();
+
+        const auto fProcessRanges = [pState, pBody = &fBody, nCount, nGrainSize, nRanges]() {
+            size_t nRange;
+            while ((nRange = pState->nNextRange++) < nRanges)
+            {
+                const size_t nFirst = nRange * nGrainSize;
+                std::exception_ptr pException;
+                try
+                {
+                    (*pBody)(nFirst, std::min(nFirst + nGrainSize, nCount));
+                }
+                catch (...)
+                {
+                    pException = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(pState->oMutex);
+                if (pException && !pState->pException)
+                    pState->pException = pException;
+
+                if (++pState->nCompletedRanges == nRanges)
+                    pState->cvCompleted.notify_all();
+            }
+        };
+
+        const size_t nHelpers = std::min<size_t>(nRanges - 1, std::max(std::thread::hardware_concurrency(), 1U));
+        for (size_t i = 0; i < nHelpers; ++i)
+            RunAsync(TaskPriority::Interactive, fProcessRanges);
+
+        fProcessRanges();
+
+        std::unique_lock<std::mutex> lock(pState->oMutex);
+        pState->cvCompleted.wait(lock, [&pState, nRanges]() noexcept { return pState->nCompletedRanges == nRanges; });
+
+        if (pState->pException)
+            std::rethrow_exception(pState->pException);
+    }
+
 protected:
     IThreadPool() noexcept = default;
 };
@@ -13,6 +13,7 @@
 #include "services\GameIdentifier.hh"
 #include "services\PerformanceCounter.hh"
 #include "services\ServiceLocator.hh"
+#include "services\SubmissionOutbox.hh"
 #include "services\impl\Clock.hh"
 #include "services\impl\FileLocalStorage.hh"
 #include "services\impl\JsonFileConfiguration.hh"
@@ -129,6 +130,15 @@ void Initialization::RegisterServices(EmulatorID nEmulatorId, const char* sClien
     pThreadPool->Initialize(pConfiguration->GetNumBackgroundThreads());
     ra::services::ServiceLocator::Provide<ra::services::IThreadPool>(std::move(pThreadPool));
 
+    // now that we're not in DllMain, messages can be written from a background thread
+    auto* pLogger = dynamic_cast<ra::services::impl::FileLogger*>(
+        &ra::services::ServiceLocator::GetMutable<ra::services::ILogger>());
+    if (pLogger != nullptr)
+    {
+        pLogger->SetMinimumLevel(pConfiguration->GetLogLevel());
+        pLogger->StartBackgroundWriter();
+    }
+
     auto pHttpRequester = std::make_unique<ra::services::impl::WindowsHttpRequester>();
     ra::services::ServiceLocator::Provide<ra::services::IHttpRequester>(std::move(pHttpRequester));
 
@@ -146,6 +156,9 @@ void Initialization::RegisterServices(EmulatorID nEmulatorId, const char* sClien
     auto pSessionTracker = std::make_unique<ra::data::context::SessionTracker>();
     ra::services::ServiceLocator::Provide<ra::data::context::SessionTracker>(std::move(pSessionTracker));
 
+    auto pSubmissionOutbox = std::make_unique<ra::services::SubmissionOutbox>();
+    ra::services::ServiceLocator::Provide<ra::services::SubmissionOutbox>(std::move(pSubmissionOutbox));
+
     auto pAchievementRuntime = std::make_unique<ra::services::AchievementRuntime>();
     ra::services::ServiceLocator::Provide<ra::services::AchievementRuntime>(std::move(pAchievementRuntime));
 
@@ -215,6 +228,12 @@ void Initialization::Shutdown()
 
     ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().Shutdown(true);
 
+    // write any pending log messages and go back to writing them immediately
+    auto* pLogger = dynamic_cast<ra::services::impl::FileLogger*>(
+        &ra::services::ServiceLocator::GetMutable<ra::services::ILogger>());
+    if (pLogger != nullptr)
+        pLogger->StopBackgroundWriter();
+
     // ImageReference destructors will try to use the IImageRepository if they think it still exists.
     // explicitly deregister it to prevent exceptions when closing down the application.
     ra::services::ServiceLocator::Provide<ra::ui::IImageRepository>(nullptr);
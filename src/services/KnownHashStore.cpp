@@ -0,0 +1,352 @@
+#include "KnownHashStore.hh"
+
+#include "RA_Log.h"
+#include "RA_StringUtils.h"
+
+#include "services\ILocalStorage.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+
+// index layout: "RAKH", version (uint32), entry count (uint32), then entries sorted by hash
+// entry layout (index and journal): hash (16 bytes), game id (uint32)
+static constexpr std::array<char, 4> INDEX_SIGNATURE{ 'R', 'A', 'K', 'H' };
+static constexpr uint32_t INDEX_VERSION = 1;
+static constexpr size_t INDEX_HEADER_SIZE = INDEX_SIGNATURE.size() + sizeof(uint32_t) * 2;
+static constexpr size_t HASH_SIZE = 16;
+static constexpr size_t ENTRY_SIZE = HASH_SIZE + sizeof(uint32_t);
+
+static void WriteUInt32(std::string& sBuffer, uint32_t nValue)
+{
+    for (size_t i = 0; i < sizeof(nValue); ++i)
+    {
+        sBuffer.push_back(gsl::narrow_cast<char>(nValue & 0xFF));
+        nValue >>= 8;
+    }
+}
+
+static uint32_t ReadUInt32(const uint8_t* pData) noexcept
+{
+    uint32_t nValue = 0;
+    for (size_t i = sizeof(nValue); i > 0; --i)
+        GSL_SUPPRESS_BOUNDS1 nValue = (nValue << 8) | pData[i - 1];
+
+    return nValue;
+}
+
+static void WriteEntry(std::string& sBuffer, const std::array<uint8_t, HASH_SIZE>& pKey, unsigned int nGameId)
+{
+    GSL_SUPPRESS_TYPE1 sBuffer.append(reinterpret_cast<const char*>(pKey.data()), pKey.size());
+    WriteUInt32(sBuffer, nGameId);
+}
+
+static bool ReadAll(TextReader& pReader, std::string& sBuffer)
+{
+    sBuffer.resize(pReader.GetSize());
+    GSL_SUPPRESS_TYPE1 return (pReader.GetBytes(reinterpret_cast<uint8_t*>(sBuffer.data()), sBuffer.size()) == sBuffer.size());
+}
+
+bool KnownHashStore::ParseHash(const std::string& sHash, HashKey& pKey) noexcept
+{
+    if (sHash.length() != pKey.size() * 2)
+        return false;
+
+    for (size_t i = 0; i < sHash.length(); ++i)
+    {
+        const char c = sHash.at(i);
+        uint8_t nNibble = 0;
+        if (c >= '0' && c <= '9')
+            nNibble = gsl::narrow_cast<uint8_t>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            nNibble = gsl::narrow_cast<uint8_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            nNibble = gsl::narrow_cast<uint8_t>(c - 'A' + 10);
+        else
+            return false;
+
+        auto& nByte = pKey.at(i / 2);
+        nByte = gsl::narrow_cast<uint8_t>((i & 1) ? (nByte | nNibble) : (nNibble << 4));
+    }
+
+    return true;
+}
+
+void KnownHashStore::Open()
+{
+    if (m_bOpened)
+        return;
+
+    m_bOpened = true;
+
+    OpenIndex();
+    LoadJournal();
+
+    if (m_pIndexEntries == nullptr && m_mJournal.empty())
+        MigrateTextFile();
+}
+
+void KnownHashStore::OpenIndex()
+{
+    CloseIndex();
+
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    const uint8_t* pData = nullptr;
+    size_t nSize = 0;
+
+    m_pIndexFile = pLocalStorage.MapData(StorageItemType::KnownHashIndex, m_sKey);
+    if (m_pIndexFile != nullptr)
+    {
+        pData = m_pIndexFile->GetData();
+        nSize = m_pIndexFile->GetSize();
+    }
+    else
+    {
+        auto pFile = pLocalStorage.ReadText(StorageItemType::KnownHashIndex, m_sKey);
+        if (pFile == nullptr || !ReadAll(*pFile, m_sIndexBuffer))
+            return;
+
+        GSL_SUPPRESS_TYPE1 pData = reinterpret_cast<const uint8_t*>(m_sIndexBuffer.data());
+        nSize = m_sIndexBuffer.size();
+    }
+
+    GSL_SUPPRESS_BOUNDS1
+    if (nSize < INDEX_HEADER_SIZE || memcmp(pData, INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size()) != 0 ||
+        ReadUInt32(pData + INDEX_SIGNATURE.size()) != INDEX_VERSION)
+    {
+        RA_LOG_WARN("Ignoring invalid known hash index");
+        CloseIndex();
+        return;
+    }
+
+    GSL_SUPPRESS_BOUNDS1 const size_t nCount = ReadUInt32(pData + INDEX_SIGNATURE.size() + sizeof(uint32_t));
+    if (nCount > (nSize - INDEX_HEADER_SIZE) / ENTRY_SIZE)
+    {
+        RA_LOG_WARN("Ignoring truncated known hash index");
+        CloseIndex();
+        return;
+    }
+
+    GSL_SUPPRESS_BOUNDS1 m_pIndexEntries = pData + INDEX_HEADER_SIZE;
+    m_nIndexEntries = nCount;
+}
+
+void KnownHashStore::LoadJournal()
+{
+    m_mJournal.clear();
+
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    auto pFile = pLocalStorage.ReadText(StorageItemType::KnownHashJournal, m_sKey);
+    if (pFile == nullptr)
+        return;
+
+    // entries are appended as they're discovered, so later entries replace earlier ones. an incomplete
+    // entry at the end of the file indicates a write was interrupted and is ignored.
+    std::array<uint8_t, ENTRY_SIZE> pEntry{};
+    while (pFile->GetBytes(pEntry.data(), pEntry.size()) == pEntry.size())
+    {
+        HashKey pKey{};
+        std::copy_n(pEntry.begin(), pKey.size(), pKey.begin());
+        GSL_SUPPRESS_BOUNDS1 m_mJournal.insert_or_assign(pKey, ReadUInt32(pEntry.data() + HASH_SIZE));
+    }
+}
+
+void KnownHashStore::MigrateTextFile()
+{
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    auto pFile = pLocalStorage.ReadText(StorageItemType::HashMapping, m_sKey);
+    if (pFile == nullptr)
+        return;
+
+    std::string sLine;
+    while (pFile->GetLine(sLine))
+    {
+        ra::Tokenizer pTokenizer(sLine);
+        const auto sHash = pTokenizer.ReadTo('=');
+
+        HashKey pKey{};
+        if (ParseHash(sHash, pKey))
+        {
+            pTokenizer.Advance(); // '='
+            m_mJournal.insert_or_assign(pKey, pTokenizer.ReadNumber());
+        }
+    }
+
+    pFile.reset();
+
+    RA_LOG_INFO("Migrating %zu known hashes to index", m_mJournal.size());
+    Compact();
+}
+
+void KnownHashStore::CloseIndex() noexcept
+{
+    m_pIndexFile.reset();
+    m_sIndexBuffer.clear();
+    m_pIndexEntries = nullptr;
+    m_nIndexEntries = 0;
+}
+
+unsigned int KnownHashStore::FindInIndex(const HashKey& pKey) const noexcept
+{
+    size_t nLow = 0;
+    size_t nHigh = m_nIndexEntries;
+    while (nLow < nHigh)
+    {
+        const size_t nMid = nLow + (nHigh - nLow) / 2;
+        const uint8_t* pEntry = nullptr;
+        GSL_SUPPRESS_BOUNDS1 pEntry = m_pIndexEntries + nMid * ENTRY_SIZE;
+
+        const int nCompare = memcmp(pEntry, pKey.data(), pKey.size());
+        if (nCompare == 0)
+            GSL_SUPPRESS_BOUNDS1 return ReadUInt32(pEntry + HASH_SIZE);
+
+        if (nCompare < 0)
+            nLow = nMid + 1;
+        else
+            nHigh = nMid;
+    }
+
+    return 0U;
+}
+
+unsigned int KnownHashStore::Find(const std::string& sHash)
+{
+    HashKey pKey{};
+    if (!ParseHash(sHash, pKey))
+        return 0U;
+
+    Open();
+
+    const auto pIter = m_mJournal.find(pKey);
+    if (pIter != m_mJournal.end())
+        return pIter->second;
+
+    return FindInIndex(pKey);
+}
+
+bool KnownHashStore::Add(const std::string& sHash, unsigned int nGameId)
+{
+    HashKey pKey{};
+    if (!ParseHash(sHash, pKey))
+        return false;
+
+    if (Find(sHash) == nGameId)
+        return false;
+
+    m_mJournal.insert_or_assign(pKey, nGameId);
+
+    {
+        // don't append while another process is compacting the journal, or the entry may be truncated
+        // after the journal was read.
+        auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+        const auto pLock = pLocalStorage.LockData(StorageItemType::KnownHashJournal, m_sKey);
+        auto pFile = pLocalStorage.AppendText(StorageItemType::KnownHashJournal, m_sKey);
+        if (pFile != nullptr)
+        {
+            std::string sEntry;
+            WriteEntry(sEntry, pKey, nGameId);
+            pFile->Write(sEntry);
+        }
+    }
+
+    if (m_mJournal.size() >= MaxJournalEntries)
+        Compact();
+
+    return true;
+}
+
+void KnownHashStore::Compact()
+{
+    if (m_mJournal.empty())
+        return;
+
+    // other processes may have appended to the journal, or merged it into the index, since they were loaded.
+    // hold the lock while reloading both so nothing can be appended between reading and truncating the journal.
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    const auto pLock = pLocalStorage.LockData(StorageItemType::KnownHashJournal, m_sKey);
+    if (pLock == nullptr)
+    {
+        RA_LOG_WARN("Could not lock known hash journal");
+        return;
+    }
+
+    {
+        auto mJournal = std::move(m_mJournal);
+        OpenIndex();
+        LoadJournal();
+
+        // the journal file has the most recent value for anything written to it. entries that could not be
+        // written to it (or were migrated from the text file) only exist in memory.
+        for (const auto& pEntry : mJournal)
+            m_mJournal.emplace(pEntry.first, pEntry.second);
+    }
+
+    const size_t nMaxEntries = m_nIndexEntries + m_mJournal.size();
+    std::string sBuffer;
+    sBuffer.reserve(INDEX_HEADER_SIZE + nMaxEntries * ENTRY_SIZE);
+    sBuffer.append(INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size());
+    WriteUInt32(sBuffer, INDEX_VERSION);
+    WriteUInt32(sBuffer, 0); // count will be filled in after merging
+
+    // both sources are sorted, so they can be merged in a single pass. journal entries replace index entries.
+    uint32_t nCount = 0;
+    size_t nIndex = 0;
+    auto pJournalIter = m_mJournal.begin();
+    while (nIndex < m_nIndexEntries || pJournalIter != m_mJournal.end())
+    {
+        const uint8_t* pIndexEntry = nullptr;
+        int nCompare = 1;
+        if (nIndex < m_nIndexEntries)
+        {
+            GSL_SUPPRESS_BOUNDS1 pIndexEntry = m_pIndexEntries + nIndex * ENTRY_SIZE;
+            nCompare = (pJournalIter == m_mJournal.end()) ? -1 :
+                memcmp(pIndexEntry, pJournalIter->first.data(), HASH_SIZE);
+        }
+
+        if (nCompare < 0)
+        {
+            GSL_SUPPRESS_TYPE1 sBuffer.append(reinterpret_cast<const char*>(pIndexEntry), ENTRY_SIZE);
+            ++nIndex;
+        }
+        else
+        {
+            WriteEntry(sBuffer, pJournalIter->first, pJournalIter->second);
+            ++pJournalIter;
+            if (nCompare == 0)
+                ++nIndex;
+        }
+
+        ++nCount;
+    }
+
+    std::string sCount;
+    WriteUInt32(sCount, nCount);
+    sBuffer.replace(INDEX_SIGNATURE.size() + sizeof(uint32_t), sCount.length(), sCount);
+
+    // the mapping has to be released before the file can be rewritten
+    CloseIndex();
+
+    {
+        auto pFile = pLocalStorage.WriteText(StorageItemType::KnownHashIndex, m_sKey);
+        if (pFile == nullptr)
+        {
+            RA_LOG_WARN("Could not write known hash index");
+            OpenIndex();
+            return;
+        }
+
+        pFile->Write(sBuffer);
+    }
+
+    // the index now contains everything in the journal, so it can be truncated
+    pLocalStorage.WriteText(StorageItemType::KnownHashJournal, m_sKey);
+    m_mJournal.clear();
+
+    // the new index is already in memory - use it until the next time the store is opened
+    m_sIndexBuffer.swap(sBuffer);
+    GSL_SUPPRESS_TYPE1 m_pIndexEntries = reinterpret_cast<const uint8_t*>(m_sIndexBuffer.data()) + INDEX_HEADER_SIZE;
+    m_nIndexEntries = nCount;
+}
+
+} // namespace services
+} // namespace ra
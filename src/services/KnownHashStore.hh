@@ -0,0 +1,85 @@
+#ifndef RA_SERVICES_KNOWNHASHSTORE_HH
+#define RA_SERVICES_KNOWNHASHSTORE_HH
+#pragma once
+
+#include "services\MappedFile.hh"
+
+namespace ra {
+namespace services {
+
+/// <summary>
+/// Persistent mapping of game hashes to game IDs.
+/// </summary>
+/// <remarks>
+/// Entries are kept in a sorted index of fixed-width binary records that can be searched without being loaded.
+/// New entries are appended to a journal, which is merged into the index by <see cref="Compact" />.
+/// </remarks>
+class KnownHashStore
+{
+public:
+    explicit KnownHashStore(const std::wstring& sKey) : m_sKey(sKey) {}
+    ~KnownHashStore() noexcept = default;
+    KnownHashStore(const KnownHashStore&) noexcept = delete;
+    KnownHashStore& operator=(const KnownHashStore&) noexcept = delete;
+    KnownHashStore(KnownHashStore&&) noexcept = delete;
+    KnownHashStore& operator=(KnownHashStore&&) noexcept = delete;
+
+    /// <summary>
+    /// Gets the game ID associated to <paramref name="sHash" />.
+    /// </summary>
+    /// <returns>The game ID, <c>0</c> if the hash is not known.</returns>
+    unsigned int Find(const std::string& sHash);
+
+    /// <summary>
+    /// Associates <paramref name="sHash" /> to <paramref name="nGameId" />.
+    /// </summary>
+    /// <returns><c>true</c> if the association was added or changed, <c>false</c> if it was already known.</returns>
+    bool Add(const std::string& sHash, unsigned int nGameId);
+
+    /// <summary>
+    /// Merges the journal, including any entries appended by other processes, into the index.
+    /// </summary>
+    void Compact();
+
+    /// <summary>
+    /// Gets the number of entries in the index (not including the journal).
+    /// </summary>
+    size_t GetIndexSize() const noexcept { return m_nIndexEntries; }
+
+    /// <summary>
+    /// Gets the number of entries that have not been merged into the index.
+    /// </summary>
+    size_t GetJournalSize() const noexcept { return m_mJournal.size(); }
+
+    /// <summary>
+    /// The number of journal entries that will cause <see cref="Add" /> to compact the store.
+    /// </summary>
+    static constexpr size_t MaxJournalEntries = 256;
+
+private:
+    using HashKey = std::array<uint8_t, 16>;
+
+    static bool ParseHash(const std::string& sHash, HashKey& pKey) noexcept;
+
+    void Open();
+    void OpenIndex();
+    void LoadJournal();
+    void MigrateTextFile();
+    void CloseIndex() noexcept;
+    unsigned int FindInIndex(const HashKey& pKey) const noexcept;
+
+    std::wstring m_sKey;
+    bool m_bOpened = false;
+
+    std::unique_ptr<MappedFile> m_pIndexFile;
+    std::string m_sIndexBuffer; // used when the index cannot be mapped
+    const uint8_t* m_pIndexEntries = nullptr;
+    size_t m_nIndexEntries = 0;
+
+    std::map<HashKey, unsigned int> m_mJournal;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_KNOWNHASHSTORE_HH
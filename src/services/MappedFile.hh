@@ -0,0 +1,35 @@
+#ifndef RA_SERVICES_MAPPEDFILE
+#define RA_SERVICES_MAPPEDFILE
+#pragma once
+
+namespace ra {
+namespace services {
+
+class MappedFile
+{
+public:
+    virtual ~MappedFile() noexcept = default;
+    MappedFile(const MappedFile&) noexcept = delete;
+    MappedFile& operator=(const MappedFile&) noexcept = delete;
+    MappedFile(MappedFile&&) noexcept = delete;
+    MappedFile& operator=(MappedFile&&) noexcept = delete;
+
+    /// <summary>
+    /// Gets a pointer to the contents of the file.
+    /// </summary>
+    /// <remarks>Only valid for the lifetime of the <see cref="MappedFile" />.</remarks>
+    virtual const uint8_t* GetData() const noexcept = 0;
+
+    /// <summary>
+    /// Gets the size of the file.
+    /// </summary>
+    virtual size_t GetSize() const noexcept = 0;
+
+protected:
+    MappedFile() noexcept = default;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_MAPPEDFILE
@@ -0,0 +1,342 @@
+#include "RomLibraryScanner.hh"
+
+#include "RA_Log.h"
+#include "RA_StringUtils.h"
+
+#include "services\FileHasher.hh"
+#include "services\IClock.hh"
+#include "services\IConfiguration.hh"
+#include "services\IFileSystem.hh"
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+
+// index layout: "RALI", version (uint32), entry count (uint32), then for each entry:
+//   path length (uint16), path (UTF-8), size (int64), last modified (int64 seconds), XXH64 (uint64),
+//   hash (32 hex characters)
+static constexpr std::array<char, 4> INDEX_SIGNATURE{ 'R', 'A', 'L', 'I' };
+static constexpr uint32_t INDEX_VERSION = 2;
+static constexpr size_t HASH_LENGTH = 32;
+
+template<typename T>
+static void WriteValue(std::string& sBuffer, T nValue)
+{
+    // values are always written little-endian
+    auto nBits = static_cast<std::make_unsigned_t<T>>(nValue);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        sBuffer.push_back(gsl::narrow_cast<char>(nBits & 0xFF));
+        nBits >>= 8;
+    }
+}
+
+template<typename T>
+static bool ReadValue(TextReader& pReader, T& nValue)
+{
+    std::array<uint8_t, sizeof(T)> pBytes{};
+    if (pReader.GetBytes(pBytes.data(), pBytes.size()) != pBytes.size())
+        return false;
+
+    std::make_unsigned_t<T> nBits = 0;
+    for (size_t i = sizeof(T); i > 0; --i)
+        nBits = gsl::narrow_cast<std::make_unsigned_t<T>>((nBits << 8) | pBytes.at(i - 1));
+
+    nValue = static_cast<T>(nBits);
+    return true;
+}
+
+static bool ReadString(TextReader& pReader, std::string& sValue, size_t nLength)
+{
+    sValue.resize(nLength);
+    GSL_SUPPRESS_TYPE1 return (pReader.GetBytes(reinterpret_cast<uint8_t*>(sValue.data()), nLength) == nLength);
+}
+
+static int64_t GetLastModifiedSeconds(const IFileSystem& pFileSystem, const std::wstring& sPath)
+{
+    const auto tLastModified = pFileSystem.GetLastModified(sPath);
+    return std::chrono::duration_cast<std::chrono::seconds>(tLastModified.time_since_epoch()).count();
+}
+
+GSL_SUPPRESS_F6
+RomLibraryScanner::~RomLibraryScanner() noexcept
+{
+    CancelAndWait();
+}
+
+bool RomLibraryScanner::LoadIndex(const std::wstring& sPath)
+{
+    const auto& pFileSystem = ServiceLocator::Get<IFileSystem>();
+    auto pFile = pFileSystem.OpenTextFile(sPath);
+    if (pFile == nullptr)
+        return false;
+
+    std::string sSignature;
+    uint32_t nVersion = 0, nCount = 0;
+    if (!ReadString(*pFile, sSignature, INDEX_SIGNATURE.size()) ||
+        memcmp(sSignature.data(), INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size()) != 0 ||
+        !ReadValue(*pFile, nVersion) || nVersion != INDEX_VERSION || !ReadValue(*pFile, nCount))
+    {
+        RA_LOG_WARN("Ignoring invalid library index %s", sPath);
+        return false;
+    }
+
+    std::map<std::wstring, IndexEntry> mIndex;
+    std::string sFilePath;
+    for (uint32_t i = 0; i < nCount; ++i)
+    {
+        uint16_t nPathLength = 0;
+        IndexEntry pEntry;
+        if (!ReadValue(*pFile, nPathLength) || !ReadString(*pFile, sFilePath, nPathLength) ||
+            !ReadValue(*pFile, pEntry.nSize) || !ReadValue(*pFile, pEntry.nLastModified) ||
+            !ReadValue(*pFile, pEntry.nXXH64) || !ReadString(*pFile, pEntry.sHash, HASH_LENGTH))
+        {
+            RA_LOG_WARN("Library index %s truncated after %u entries", sPath, i);
+            break;
+        }
+
+        mIndex.insert_or_assign(ra::Widen(sFilePath), std::move(pEntry));
+    }
+
+    std::lock_guard<std::mutex> pGuard(m_oMutex);
+    m_mIndex.swap(mIndex);
+    return true;
+}
+
+bool RomLibraryScanner::SaveIndex(const std::wstring& sPath) const
+{
+    std::string sBuffer;
+    sBuffer.append(INDEX_SIGNATURE.data(), INDEX_SIGNATURE.size());
+    WriteValue(sBuffer, INDEX_VERSION);
+
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        sBuffer.reserve(sBuffer.size() + sizeof(uint32_t) + m_mIndex.size() * 128);
+        WriteValue(sBuffer, gsl::narrow_cast<uint32_t>(m_mIndex.size()));
+
+        for (const auto& pPair : m_mIndex)
+        {
+            const auto sFilePath = ra::Narrow(pPair.first);
+            WriteValue(sBuffer, gsl::narrow_cast<uint16_t>(sFilePath.length()));
+            sBuffer.append(sFilePath);
+            WriteValue(sBuffer, pPair.second.nSize);
+            WriteValue(sBuffer, pPair.second.nLastModified);
+            WriteValue(sBuffer, pPair.second.nXXH64);
+            sBuffer.append(pPair.second.sHash);
+            sBuffer.resize(sBuffer.length() + HASH_LENGTH - pPair.second.sHash.length(), '0');
+        }
+    }
+
+    const auto& pFileSystem = ServiceLocator::Get<IFileSystem>();
+    auto pFile = pFileSystem.CreateTextFile(sPath);
+    if (pFile == nullptr)
+        return false;
+
+    pFile->Write(sBuffer);
+    return true;
+}
+
+void RomLibraryScanner::AddHash(const std::wstring& sPath, const std::string& sHash)
+{
+    IndexEntry pEntry;
+    pEntry.sHash = sHash;
+
+    std::lock_guard<std::mutex> pGuard(m_oMutex);
+    m_mIndex.try_emplace(sPath, std::move(pEntry));
+}
+
+void RomLibraryScanner::CancelAndWait() noexcept
+{
+    m_bCancelRequested = true;
+
+    // running workers check the cancel flag and will stop shortly. workers that the thread pool discarded when
+    // it shut down are released without ever running.
+    while (m_nRunningWorkers > 0)
+    {
+        RA_LOG_INFO("Waiting for library scan to stop...");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    // any worker that didn't finish was discarded
+    m_nActiveWorkers = 0;
+}
+
+void RomLibraryScanner::Scan(std::vector<std::wstring>&& vFiles)
+{
+    CancelAndWait();
+
+    m_vFilesToScan = std::move(vFiles);
+    m_nNextFile = 0;
+    m_nFilesProcessed = 0;
+    m_nFilesSkipped = 0;
+    m_nBytesHashed = 0;
+    m_bCancelRequested = false;
+
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        m_tScanStart = ServiceLocator::Get<IClock>().UpTime();
+        m_tScanEnd = {};
+    }
+
+    // leave one background thread free for other work (like downloading badges)
+    const auto nBackgroundThreads = ServiceLocator::Get<IConfiguration>().GetNumBackgroundThreads();
+    size_t nWorkers = (nBackgroundThreads > 1) ? nBackgroundThreads - 1 : 1;
+    nWorkers = std::max<size_t>(std::min(nWorkers, m_vFilesToScan.size()), 1);
+
+    RA_LOG_INFO("Scanning %zu files with %zu workers", m_vFilesToScan.size(), nWorkers);
+
+    m_nActiveWorkers = gsl::narrow_cast<unsigned int>(nWorkers);
+    m_nRunningWorkers = gsl::narrow_cast<unsigned int>(nWorkers);
+    auto& pThreadPool = ServiceLocator::GetMutable<IThreadPool>();
+    for (size_t i = 0; i < nWorkers; ++i)
+    {
+        // the worker is released when the thread pool destroys the task, whether it ran it or discarded it.
+        // that's the last time the scanner is accessed on behalf of the worker.
+        std::shared_ptr<void> pRunning(nullptr, [this](void*) noexcept { --m_nRunningWorkers; });
+        pThreadPool.RunAsync(IThreadPool::TaskPriority::Background,
+            [this, pRunning = std::move(pRunning)]() { ScanFiles(); });
+    }
+}
+
+void RomLibraryScanner::ScanFiles()
+{
+    // files that can't be memory mapped are streamed through the same buffer, so memory use doesn't depend
+    // on the number or size of the files being scanned
+    std::vector<uint8_t> vBuffer;
+
+    const auto& pThreadPool = ServiceLocator::Get<IThreadPool>();
+    while (!m_bCancelRequested && !pThreadPool.IsShutdownRequested())
+    {
+        // the file list doesn't change during a scan, so claiming the next file only requires an atomic increment
+        const auto nIndex = m_nNextFile.fetch_add(1);
+        if (nIndex >= m_vFilesToScan.size())
+            break;
+
+        ProcessFile(m_vFilesToScan.at(nIndex), vBuffer);
+        ++m_nFilesProcessed;
+
+        if (m_fProgressHandler)
+            m_fProgressHandler();
+    }
+
+    // the last worker to finish records the end of the scan
+    if (--m_nActiveWorkers == 0)
+    {
+        {
+            std::lock_guard<std::mutex> pGuard(m_oMutex);
+            m_tScanEnd = ServiceLocator::Get<IClock>().UpTime();
+        }
+
+        const auto pProgress = GetProgress();
+        RA_LOG_INFO("Scanned %zu/%zu files (%zu unchanged), %0.1f files/s, %0.1f MB/s", pProgress.nFilesProcessed,
+            pProgress.nFilesTotal, pProgress.nFilesSkipped, pProgress.fFilesPerSecond, pProgress.fMegabytesPerSecond);
+
+        if (m_fProgressHandler)
+            m_fProgressHandler();
+    }
+}
+
+void RomLibraryScanner::ProcessFile(const std::wstring& sPath, std::vector<uint8_t>& vBuffer)
+{
+    const auto& pFileSystem = ServiceLocator::Get<IFileSystem>();
+    const auto nSize = pFileSystem.GetFileSize(sPath);
+    if (nSize < 0)
+        return;
+
+    const auto nLastModified = GetLastModifiedSeconds(pFileSystem, sPath);
+    uint64_t nKnownXXH64 = 0;
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        const auto pIter = m_mIndex.find(sPath);
+        if (pIter != m_mIndex.end() && pIter->second.nSize == nSize)
+        {
+            if (pIter->second.nLastModified == nLastModified)
+            {
+                ++m_nFilesSkipped;
+                return;
+            }
+
+            nKnownXXH64 = pIter->second.nXXH64;
+        }
+    }
+
+    // a file that was touched without changing size (i.e. copied or restored from a backup) usually has the
+    // same content. XXH64 is much faster than MD5, so use it to check before recalculating the MD5.
+    if (nKnownXXH64 != 0)
+    {
+        FileHasher pChecker(HashAlgorithm::XXH64);
+        pChecker.SetCancelFlag(&m_bCancelRequested);
+        const bool bChecked = pChecker.AppendFile(sPath, vBuffer);
+        m_nBytesHashed += pChecker.GetBytesHashed();
+        if (!bChecked)
+            return;
+
+        if (pChecker.GetXXH64() == nKnownXXH64)
+        {
+            std::lock_guard<std::mutex> pGuard(m_oMutex);
+            const auto pIter = m_mIndex.find(sPath);
+            if (pIter != m_mIndex.end())
+                pIter->second.nLastModified = nLastModified;
+
+            ++m_nFilesSkipped;
+            return;
+        }
+    }
+
+    using namespace ra::bitwise_ops;
+    FileHasher pHasher(HashAlgorithm::MD5 | HashAlgorithm::XXH64);
+    pHasher.SetCancelFlag(&m_bCancelRequested);
+    const bool bHashed = pHasher.AppendFile(sPath, vBuffer);
+    m_nBytesHashed += pHasher.GetBytesHashed();
+    if (!bHashed)
+        return;
+
+    IndexEntry pEntry;
+    pEntry.nSize = nSize;
+    pEntry.nLastModified = nLastModified;
+    pEntry.nXXH64 = pHasher.GetXXH64();
+    pEntry.sHash = pHasher.GetMD5();
+
+    std::lock_guard<std::mutex> pGuard(m_oMutex);
+    m_mIndex.insert_or_assign(sPath, std::move(pEntry));
+}
+
+RomLibraryScanner::Progress RomLibraryScanner::GetProgress() const
+{
+    Progress pProgress;
+    pProgress.nFilesTotal = m_vFilesToScan.size();
+    pProgress.nFilesProcessed = m_nFilesProcessed;
+    pProgress.nFilesSkipped = m_nFilesSkipped;
+    pProgress.nBytesHashed = m_nBytesHashed;
+    pProgress.bComplete = (m_nActiveWorkers == 0);
+
+    std::chrono::steady_clock::time_point tEnd;
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        tEnd = pProgress.bComplete ? m_tScanEnd : ServiceLocator::Get<IClock>().UpTime();
+        const auto nElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(tEnd - m_tScanStart).count();
+        if (nElapsed > 0)
+        {
+            const double fSeconds = nElapsed / 1000.0;
+            pProgress.fFilesPerSecond = pProgress.nFilesProcessed / fSeconds;
+            pProgress.fMegabytesPerSecond = pProgress.nBytesHashed / (1024.0 * 1024.0) / fSeconds;
+        }
+    }
+
+    return pProgress;
+}
+
+std::map<std::wstring, std::string> RomLibraryScanner::GetHashes() const
+{
+    std::map<std::wstring, std::string> mHashes;
+
+    std::lock_guard<std::mutex> pGuard(m_oMutex);
+    for (const auto& pPair : m_mIndex)
+        mHashes.emplace(pPair.first, pPair.second.sHash);
+
+    return mHashes;
+}
+
+} // namespace services
+} // namespace ra
@@ -0,0 +1,124 @@
+#ifndef RA_SERVICES_ROMLIBRARYSCANNER_HH
+#define RA_SERVICES_ROMLIBRARYSCANNER_HH
+#pragma once
+
+namespace ra {
+namespace services {
+
+class RomLibraryScanner
+{
+public:
+    RomLibraryScanner() noexcept = default;
+    ~RomLibraryScanner() noexcept;
+    RomLibraryScanner(const RomLibraryScanner&) noexcept = delete;
+    RomLibraryScanner& operator=(const RomLibraryScanner&) noexcept = delete;
+    RomLibraryScanner(RomLibraryScanner&&) noexcept = delete;
+    RomLibraryScanner& operator=(RomLibraryScanner&&) noexcept = delete;
+
+    struct Progress
+    {
+        size_t nFilesTotal = 0;
+        size_t nFilesProcessed = 0;
+        size_t nFilesSkipped = 0;
+        uint64_t nBytesHashed = 0;
+        double fFilesPerSecond = 0.0;
+        double fMegabytesPerSecond = 0.0;
+        bool bComplete = false;
+    };
+
+    /// <summary>
+    /// Loads previously calculated hashes from the binary index at <paramref name="sPath" />.
+    /// </summary>
+    /// <returns><c>true</c> if the index was loaded, <c>false</c> if it doesn't exist or is not valid.</returns>
+    bool LoadIndex(const std::wstring& sPath);
+
+    /// <summary>
+    /// Writes the calculated hashes to the binary index at <paramref name="sPath" />.
+    /// </summary>
+    /// <returns><c>true</c> if the index was written, <c>false</c> if not.</returns>
+    bool SaveIndex(const std::wstring& sPath) const;
+
+    /// <summary>
+    /// Adds a hash for a file whose size and modification time are not known.
+    /// </summary>
+    /// <remarks>
+    /// Used when migrating data from the old text format. The file will be rehashed the next time it's scanned.
+    /// </remarks>
+    void AddHash(const std::wstring& sPath, const std::string& sHash);
+
+    /// <summary>
+    /// Starts hashing <paramref name="vFiles" /> on the background threads.
+    /// </summary>
+    /// <remarks>
+    /// Files whose size and modification time match the index are not rehashed. Any scan already in progress is
+    /// cancelled first.
+    /// </remarks>
+    void Scan(std::vector<std::wstring>&& vFiles);
+
+    /// <summary>
+    /// Requests that the current scan stop after the files currently being hashed.
+    /// </summary>
+    void Cancel() noexcept { m_bCancelRequested = true; }
+
+    /// <summary>
+    /// Cancels the current scan and waits for the background threads to finish with it.
+    /// </summary>
+    /// <remarks>
+    /// Waits until the thread pool has released every worker, including any it discarded without running
+    /// because it was shutting down.
+    /// </remarks>
+    void CancelAndWait() noexcept;
+
+    /// <summary>
+    /// Determines if a scan is in progress.
+    /// </summary>
+    bool IsScanning() const noexcept { return m_nActiveWorkers > 0; }
+
+    /// <summary>
+    /// Gets the progress and throughput of the current (or most recent) scan.
+    /// </summary>
+    Progress GetProgress() const;
+
+    /// <summary>
+    /// Gets the hash of every file that has been scanned, keyed by path.
+    /// </summary>
+    std::map<std::wstring, std::string> GetHashes() const;
+
+    /// <summary>
+    /// Sets a function to call whenever a file has been processed or the scan completes.
+    /// </summary>
+    /// <remarks>Will be called from the background threads. Must be set before calling <see cref="Scan" />.</remarks>
+    void SetProgressHandler(std::function<void()>&& fHandler) { m_fProgressHandler = std::move(fHandler); }
+
+private:
+    struct IndexEntry
+    {
+        int64_t nSize = -1;
+        int64_t nLastModified = 0;
+        uint64_t nXXH64 = 0; // used to detect that a touched file hasn't changed without recalculating the MD5
+        std::string sHash;
+    };
+
+    void ScanFiles();
+    void ProcessFile(const std::wstring& sPath, std::vector<uint8_t>& vBuffer);
+
+    std::vector<std::wstring> m_vFilesToScan;
+    std::atomic<size_t> m_nNextFile{ 0 };
+    std::atomic<size_t> m_nFilesProcessed{ 0 };
+    std::atomic<size_t> m_nFilesSkipped{ 0 };
+    std::atomic<uint64_t> m_nBytesHashed{ 0 };
+    std::atomic<unsigned int> m_nActiveWorkers{ 0 };  // workers that haven't finished scanning
+    std::atomic<unsigned int> m_nRunningWorkers{ 0 }; // workers the thread pool hasn't released
+    std::atomic<bool> m_bCancelRequested{ false };
+    std::function<void()> m_fProgressHandler;
+
+    mutable std::mutex m_oMutex;
+    std::map<std::wstring, IndexEntry> m_mIndex;
+    std::chrono::steady_clock::time_point m_tScanStart{};
+    std::chrono::steady_clock::time_point m_tScanEnd{};
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_ROMLIBRARYSCANNER_HH
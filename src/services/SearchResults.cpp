@@ -7,6 +7,7 @@
 
 #include "data\context\EmulatorContext.hh"
 
+#include "services\IThreadPool.hh"
 #include "services\ServiceLocator.hh"
 
 #include <algorithm>
@@ -22,6 +23,9 @@ namespace services {
 
 namespace impl {
 
+// results with less memory than this are filtered on the calling thread
+_CONSTANT_VAR PARALLEL_FILTER_BYTES = 64U * 1024;
+
 template<typename T>
 _NODISCARD static constexpr bool CompareValues(_In_ T nLeft, _In_ T nRight, _In_ ComparisonType nCompareType) noexcept
 {
@@ -139,16 +143,26 @@ public:
     // populates a vector of addresses that match the specified filter when applied to a previous search result
     virtual void ApplyFilter(SearchResults& srNew, const SearchResults& srPrevious) const
     {
-        unsigned int nLargestBlock = 0U;
-        for (auto& block : srPrevious.m_vBlocks)
+        // memory has to be read from the emulator on this thread, but comparing it to the previous results
+        // doesn't depend on the emulator. capture all of the memory, then compare the blocks in parallel.
+        const auto& vBlocks = srPrevious.m_vBlocks;
+        std::vector<size_t> vOffsets;
+        vOffsets.reserve(vBlocks.size());
+        size_t nTotalBytes = 0;
+        for (const auto& block : vBlocks)
         {
-            if (block.GetBytesSize() > nLargestBlock)
-                nLargestBlock = block.GetBytesSize();
+            vOffsets.push_back(nTotalBytes);
+            nTotalBytes += block.GetBytesSize();
         }
 
-        std::vector<unsigned char> vMemory(nLargestBlock);
-        std::vector<ra::ByteAddress> vMatches;
+        std::vector<unsigned char> vMemory(nTotalBytes);
         const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
+        for (size_t nIndex = 0; nIndex < vBlocks.size(); ++nIndex)
+        {
+            const auto& block = vBlocks.at(nIndex);
+            pEmulatorContext.ReadMemory(ConvertToRealAddress(block.GetFirstAddress()),
+                vMemory.data() + vOffsets.at(nIndex), block.GetBytesSize());
+        }
 
         unsigned int nAdjustment = 0;
         switch (srNew.GetFilterType())
@@ -163,66 +177,51 @@ public:
                 break;
         }
 
-        for (auto& block : srPrevious.m_vBlocks)
-        {
-            pEmulatorContext.ReadMemory(ConvertToRealAddress(block.GetFirstAddress()), vMemory.data(), block.GetBytesSize());
+        std::vector<BlockFilterResult> vResults(vBlocks.size());
+        const auto fFilterBlocks = [this, &vBlocks, &vMemory, &vOffsets, &vResults, &srNew, nAdjustment](size_t nFirst, size_t nLast) {
+            for (size_t nIndex = nFirst; nIndex < nLast; ++nIndex)
+            {
+                FilterBlock(vBlocks.at(nIndex), vMemory.data() + vOffsets.at(nIndex), srNew, nAdjustment,
+                            vResults.at(nIndex));
+            }
+        };
 
-            const auto nStop = block.GetBytesSize() - GetPadding();
+        // small result sets aren't worth the cost of dispatching to other threads
+        if (nTotalBytes < PARALLEL_FILTER_BYTES || !ra::services::ServiceLocator::Exists<ra::services::IThreadPool>())
+        {
+            fFilterBlocks(0, vBlocks.size());
+        }
+        else
+        {
+            // split the blocks into up to 64 ranges so threads that finish early can pick up more work
+            const auto nGrainSize = std::max<size_t>(vBlocks.size() / 64, 1);
+            auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+            pThreadPool.ParallelFor(vBlocks.size(), nGrainSize, fFilterBlocks);
+        }
 
-            switch (srNew.GetFilterType())
+        // build the new blocks in order
+        for (size_t nIndex = 0; nIndex < vBlocks.size(); ++nIndex)
+        {
+            const auto& block = vBlocks.at(nIndex);
+            auto& pResult = vResults.at(nIndex);
+            switch (pResult.nAction)
             {
-                case SearchFilterType::Constant:
-                    ApplyConstantFilter(vMemory.data(), vMemory.data() + nStop, block,
-                        srNew.GetFilterComparison(), srNew.GetFilterValue(), vMatches);
+                case BlockFilterAction::Copy:
+                {
+                    // entire block matches, copy the old block
+                    MemBlock& newBlock = AddBlock(srNew, block.GetFirstAddress(), block.GetBytesSize(), block.GetMaxAddresses());
+                    memcpy(newBlock.GetBytes(), block.GetBytes(), block.GetBytesSize());
+                    newBlock.CopyMatchingAddresses(block);
                     break;
+                }
 
-                default:
-                    // if an entire block is unchanged, everything in it is equal to the LastKnownValue
-                    // or InitialValue and we don't have to check every address.
-                    if (memcmp(vMemory.data(), block.GetBytes(), block.GetBytesSize()) == 0)
-                    {
-                        switch (srNew.GetFilterComparison())
-                        {
-                            case ComparisonType::Equals:
-                            case ComparisonType::GreaterThanOrEqual:
-                            case ComparisonType::LessThanOrEqual:
-                                if (nAdjustment == 0)
-                                {
-                                    // entire block matches, copy the old block
-                                    MemBlock& newBlock = AddBlock(srNew, block.GetFirstAddress(), block.GetBytesSize(), block.GetMaxAddresses());
-                                    memcpy(newBlock.GetBytes(), block.GetBytes(), block.GetBytesSize());
-                                    newBlock.CopyMatchingAddresses(block);
-                                    continue;
-                                }
-                                else if (srNew.GetFilterComparison() == ComparisonType::Equals)
-                                {
-                                    // entire block matches, so adjustment won't match. discard the block
-                                    continue;
-                                }
-                                break;
-
-                            default:
-                                if (nAdjustment == 0)
-                                {
-                                    // entire block matches, discard it
-                                    continue;
-                                }
-                                break;
-                        }
-
-                        // have to check individual addresses to see if adjustment matches
-                    }
-
-                    // per-address comparison
-                    ApplyCompareFilter(vMemory.data(), vMemory.data() + nStop, block,
-                        srNew.GetFilterComparison(), nAdjustment, vMatches);
+                case BlockFilterAction::Matches:
+                    if (!pResult.vMatches.empty())
+                        AddBlocks(srNew, pResult.vMatches, vMemory.data() + vOffsets.at(nIndex), block.GetFirstAddress(), GetPadding());
                     break;
-            }
 
-            if (!vMatches.empty())
-            {
-                AddBlocks(srNew, vMatches, vMemory, block.GetFirstAddress(), GetPadding());
-                vMatches.clear();
+                default:
+                    break;
             }
         }
     }
@@ -339,6 +338,77 @@ public:
     }
 
 protected:
+    enum class BlockFilterAction
+    {
+        Discard,
+        Copy,
+        Matches,
+    };
+
+    struct BlockFilterResult
+    {
+        BlockFilterAction nAction = BlockFilterAction::Discard;
+        std::vector<ra::ByteAddress> vMatches;
+    };
+
+    // determines which addresses in a previous block match the filter. called from multiple threads
+    // concurrently, so must not modify srNew.
+    void FilterBlock(const MemBlock& block, const unsigned char* pMemory, const SearchResults& srNew,
+                     unsigned int nAdjustment, BlockFilterResult& pResult) const
+    {
+        const auto nStop = block.GetBytesSize() - GetPadding();
+
+        switch (srNew.GetFilterType())
+        {
+            case SearchFilterType::Constant:
+                ApplyConstantFilter(pMemory, pMemory + nStop, block,
+                    srNew.GetFilterComparison(), srNew.GetFilterValue(), pResult.vMatches);
+                break;
+
+            default:
+                // if an entire block is unchanged, everything in it is equal to the LastKnownValue
+                // or InitialValue and we don't have to check every address.
+                if (memcmp(pMemory, block.GetBytes(), block.GetBytesSize()) == 0)
+                {
+                    switch (srNew.GetFilterComparison())
+                    {
+                        case ComparisonType::Equals:
+                        case ComparisonType::GreaterThanOrEqual:
+                        case ComparisonType::LessThanOrEqual:
+                            if (nAdjustment == 0)
+                            {
+                                // entire block matches, copy the old block
+                                pResult.nAction = BlockFilterAction::Copy;
+                                return;
+                            }
+                            else if (srNew.GetFilterComparison() == ComparisonType::Equals)
+                            {
+                                // entire block matches, so adjustment won't match. discard the block
+                                return;
+                            }
+                            break;
+
+                        default:
+                            if (nAdjustment == 0)
+                            {
+                                // entire block matches, discard it
+                                return;
+                            }
+                            break;
+                    }
+
+                    // have to check individual addresses to see if adjustment matches
+                }
+
+                // per-address comparison
+                ApplyCompareFilter(pMemory, pMemory + nStop, block,
+                    srNew.GetFilterComparison(), nAdjustment, pResult.vMatches);
+                break;
+        }
+
+        pResult.nAction = BlockFilterAction::Matches;
+    }
+
     // generic implementation for less used search types
     virtual void ApplyConstantFilter(const uint8_t* pBytes, const uint8_t* pBytesStop,
         const MemBlock& pPreviousBlock, ComparisonType nComparison, unsigned nConstantValue,
@@ -577,7 +647,7 @@ protected:
     }
 
     void AddBlocks(SearchResults& srNew, std::vector<ra::ByteAddress>& vMatches,
-        std::vector<unsigned char>& vMemory, ra::ByteAddress nPreviousBlockFirstAddress, unsigned int nPadding) const
+        const unsigned char* pMemory, ra::ByteAddress nPreviousBlockFirstAddress, unsigned int nPadding) const
     {
         const gsl::index nStopIndex = gsl::narrow_cast<gsl::index>(vMatches.size()) - 1;
         gsl::index nFirstIndex = 0;
@@ -604,7 +674,7 @@ protected:
 
             // capture the subset of data that corresponds to the subset of matches
             const auto nOffset = nFirstRealAddress - ConvertToRealAddress(nPreviousBlockFirstAddress);
-            memcpy(block.GetBytes(), &vMemory.at(nOffset), nBlockSize);
+            GSL_SUPPRESS_BOUNDS1 memcpy(block.GetBytes(), pMemory + nOffset, nBlockSize);
 
             // capture the matched addresses
             block.SetMatchingAddresses(vMatches, nFirstIndex, nLastIndex);
@@ -1116,7 +1186,7 @@ public:
             {
                 // adjust the block size to account for the length of the string to ensure
                 // the block contains the whole string
-                AddBlocks(srNew, vMatches, vMemory, block.GetFirstAddress(), gsl::narrow_cast<unsigned int>(nCompareLength - 1));
+                AddBlocks(srNew, vMatches, vMemory.data(), block.GetFirstAddress(), gsl::narrow_cast<unsigned int>(nCompareLength - 1));
                 vMatches.clear();
             }
         }
@@ -0,0 +1,370 @@
+#include "SubmissionOutbox.hh"
+
+#include "RA_Log.h"
+#include "RA_StringUtils.h"
+
+#include "services\IClock.hh"
+#include "services\ILocalStorage.hh"
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+
+// journal records (one per line):
+//   "U:<sequence>:<achievement id>:<hardcore>:<game hash>:" - unlock queued
+//   "L:<sequence>:<leaderboard id>:<score>:<game hash>:"    - leaderboard entry queued
+//   "D:<sequence>:"                                        - submission delivered
+// every record ends with a colon so a record that was only partially written can be detected and ignored.
+
+std::string SubmissionOutbox::FormatRecord(const Entry& pEntry)
+{
+    if (pEntry.nType == EntryType::Unlock)
+    {
+        return ra::StringPrintf("U:%u:%u:%d:%s:", pEntry.nSequence, pEntry.pUnlock.AchievementId,
+            pEntry.pUnlock.Hardcore ? 1 : 0, pEntry.pUnlock.GameHash);
+    }
+
+    return ra::StringPrintf("L:%u:%u:%d:%s:", pEntry.nSequence, pEntry.pLeaderboardEntry.LeaderboardId,
+        pEntry.pLeaderboardEntry.Score, pEntry.pLeaderboardEntry.GameHash);
+}
+
+bool SubmissionOutbox::ParseRecord(const std::string& sRecord, Entry& pEntry, uint32_t& nDelivered)
+{
+    ra::Tokenizer pTokenizer(sRecord);
+    const char cType = pTokenizer.PeekChar();
+    pTokenizer.Advance();
+    if (!pTokenizer.Consume(':'))
+        return false;
+
+    const auto nSequence = pTokenizer.ReadNumber();
+    if (!pTokenizer.Consume(':'))
+        return false;
+
+    nDelivered = 0;
+    switch (cType)
+    {
+        case 'D':
+            nDelivered = nSequence;
+            return pTokenizer.EndOfString();
+
+        case 'U':
+            pEntry.nType = EntryType::Unlock;
+            pEntry.pUnlock.AchievementId = pTokenizer.ReadNumber();
+            if (!pTokenizer.Consume(':'))
+                return false;
+            pEntry.pUnlock.Hardcore = (pTokenizer.ReadNumber() != 0);
+            if (!pTokenizer.Consume(':'))
+                return false;
+            pEntry.pUnlock.GameHash = pTokenizer.ReadTo(':');
+            break;
+
+        case 'L':
+        {
+            pEntry.nType = EntryType::LeaderboardEntry;
+            pEntry.pLeaderboardEntry.LeaderboardId = pTokenizer.ReadNumber();
+            if (!pTokenizer.Consume(':'))
+                return false;
+            const bool bNegative = pTokenizer.Consume('-');
+            const auto nScore = gsl::narrow_cast<int>(pTokenizer.ReadNumber());
+            pEntry.pLeaderboardEntry.Score = bNegative ? -nScore : nScore;
+            if (!pTokenizer.Consume(':'))
+                return false;
+            pEntry.pLeaderboardEntry.GameHash = pTokenizer.ReadTo(':');
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    pEntry.nSequence = nSequence;
+    return pTokenizer.Consume(':') && pTokenizer.EndOfString();
+}
+
+void SubmissionOutbox::Initialize(const std::string& sUsername)
+{
+    std::unique_lock<std::mutex> lock(m_oMutex);
+
+    auto sKey = ra::Widen(sUsername);
+    if (sKey == m_sUsername)
+        return;
+
+    if (!m_sUsername.empty())
+    {
+        // anything pending belongs to the previous user. make sure it's in their journal so it's sent the next
+        // time they log in, then forget about it so it isn't sent or journaled for the new user. submissions that
+        // are already in flight are identified by their sequence number if they have to be requeued.
+        CompactJournal();
+        m_vQueued.clear();
+        m_mUndelivered.clear();
+        m_nFirstSequence = m_nNextSequence;
+    }
+
+    m_sUsername = std::move(sKey);
+    if (m_sUsername.empty())
+        return;
+
+    std::vector<Entry> vRecovered;
+    LoadJournal(vRecovered);
+
+    if (!vRecovered.empty())
+    {
+        RA_LOG_INFO("Resending %zu undelivered submissions", vRecovered.size());
+
+        // the recovered submissions are renumbered so they can't conflict with anything queued before the
+        // journal was opened. the journal is rewritten below, so the old numbers aren't needed.
+        const auto tNow = ServiceLocator::Get<IClock>().UpTime();
+        for (auto& pEntry : vRecovered)
+        {
+            pEntry.nSequence = m_nNextSequence++;
+            pEntry.tQueued = tNow;
+            m_mUndelivered.insert_or_assign(pEntry.nSequence, FormatRecord(pEntry));
+            m_vQueued.push_back(std::move(pEntry));
+        }
+    }
+
+    // rewrite the journal so it only contains the undelivered submissions, including any that were queued before
+    // the journal was opened.
+    CompactJournal();
+
+    SendQueued(lock);
+}
+
+void SubmissionOutbox::LoadJournal(std::vector<Entry>& vRecovered)
+{
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    auto pFile = pLocalStorage.ReadText(StorageItemType::SubmissionJournal, m_sUsername);
+    if (pFile == nullptr)
+        return;
+
+    std::map<uint32_t, Entry> mEntries;
+    std::string sLine;
+    while (pFile->GetLine(sLine))
+    {
+        Entry pEntry;
+        uint32_t nDelivered = 0;
+        if (!ParseRecord(sLine, pEntry, nDelivered))
+        {
+            RA_LOG_WARN("Ignoring invalid submission journal record: %s", sLine);
+            continue;
+        }
+
+        if (nDelivered != 0)
+            mEntries.erase(nDelivered);
+        else
+            mEntries.insert_or_assign(pEntry.nSequence, std::move(pEntry));
+    }
+
+    for (auto& pPair : mEntries)
+        vRecovered.push_back(std::move(pPair.second));
+}
+
+void SubmissionOutbox::AppendJournal(const std::string& sRecord)
+{
+    if (m_sUsername.empty())
+        return;
+
+    // only rewrite the journal once enough of it is obsolete
+    if (m_nJournalRecords >= m_mUndelivered.size() + MaxJournalRecords)
+        CompactJournal();
+
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    auto pFile = pLocalStorage.AppendText(StorageItemType::SubmissionJournal, m_sUsername);
+    if (pFile == nullptr)
+    {
+        RA_LOG_WARN("Could not write submission journal");
+        return;
+    }
+
+    pFile->WriteLine(sRecord);
+    ++m_nJournalRecords;
+}
+
+void SubmissionOutbox::CompactJournal()
+{
+    if (m_sUsername.empty())
+        return;
+
+    auto& pLocalStorage = ServiceLocator::GetMutable<ILocalStorage>();
+    auto pFile = pLocalStorage.WriteText(StorageItemType::SubmissionJournal, m_sUsername);
+    if (pFile == nullptr)
+    {
+        RA_LOG_WARN("Could not write submission journal");
+        return;
+    }
+
+    for (const auto& pPair : m_mUndelivered)
+        pFile->WriteLine(pPair.second);
+
+    m_nJournalRecords = m_mUndelivered.size();
+}
+
+void SubmissionOutbox::QueueUnlock(const ra::api::AwardAchievement::Request& pRequest,
+    ra::api::AwardAchievement::Request::Callback&& fCallback)
+{
+    Entry pEntry;
+    pEntry.nType = EntryType::Unlock;
+    pEntry.pUnlock = pRequest;
+    pEntry.fUnlockCallback = std::move(fCallback);
+    Queue(std::move(pEntry));
+}
+
+void SubmissionOutbox::QueueLeaderboardEntry(const ra::api::SubmitLeaderboardEntry::Request& pRequest,
+    ra::api::SubmitLeaderboardEntry::Request::Callback&& fCallback)
+{
+    Entry pEntry;
+    pEntry.nType = EntryType::LeaderboardEntry;
+    pEntry.pLeaderboardEntry = pRequest;
+    pEntry.fLeaderboardEntryCallback = std::move(fCallback);
+    Queue(std::move(pEntry));
+}
+
+void SubmissionOutbox::Queue(Entry&& pEntry)
+{
+    pEntry.tQueued = ServiceLocator::Get<IClock>().UpTime();
+
+    std::unique_lock<std::mutex> lock(m_oMutex);
+    pEntry.nSequence = m_nNextSequence++;
+
+    // write the submission to the journal before trying to send it, so it isn't lost if the process exits
+    auto sRecord = FormatRecord(pEntry);
+    AppendJournal(sRecord);
+    m_mUndelivered.insert_or_assign(pEntry.nSequence, std::move(sRecord));
+
+    m_vQueued.push_back(std::move(pEntry));
+    SendQueued(lock);
+}
+
+void SubmissionOutbox::SendQueued(std::unique_lock<std::mutex>& lock)
+{
+    // if the server couldn't be reached, wait for the retry instead of sending more requests that will also fail
+    if (m_bRetryScheduled)
+        return;
+
+    std::vector<Entry> vEntries;
+    while (m_nInFlight < MaxInFlight && !m_vQueued.empty())
+    {
+        ++m_nInFlight;
+        vEntries.push_back(std::move(m_vQueued.front()));
+        m_vQueued.pop_front();
+    }
+
+    if (vEntries.empty())
+        return;
+
+    // the thread pool may run the task immediately, so don't hold the lock while queueing them
+    lock.unlock();
+
+    auto& pThreadPool = ServiceLocator::GetMutable<IThreadPool>();
+    for (auto& pEntry : vEntries)
+        pThreadPool.RunAsync([this, pEntry = std::move(pEntry)]() mutable { Send(pEntry); });
+}
+
+void SubmissionOutbox::Send(Entry& pEntry)
+{
+    if (pEntry.nType == EntryType::Unlock)
+    {
+        const auto pResponse = pEntry.pUnlock.Call();
+        if (pResponse.Result == ra::api::ApiResult::Incomplete)
+        {
+            Requeue(std::move(pEntry));
+            return;
+        }
+
+        MarkDelivered(pEntry);
+
+        if (pEntry.fUnlockCallback)
+            pEntry.fUnlockCallback(pResponse);
+        else if (!pResponse.Succeeded())
+            RA_LOG_WARN("Resent unlock for achievement %u failed: %s", pEntry.pUnlock.AchievementId, pResponse.ErrorMessage);
+    }
+    else
+    {
+        const auto pResponse = pEntry.pLeaderboardEntry.Call();
+        if (pResponse.Result == ra::api::ApiResult::Incomplete)
+        {
+            Requeue(std::move(pEntry));
+            return;
+        }
+
+        MarkDelivered(pEntry);
+
+        if (pEntry.fLeaderboardEntryCallback)
+            pEntry.fLeaderboardEntryCallback(pResponse);
+        else if (!pResponse.Succeeded())
+            RA_LOG_WARN("Resent entry for leaderboard %u failed: %s", pEntry.pLeaderboardEntry.LeaderboardId, pResponse.ErrorMessage);
+    }
+}
+
+void SubmissionOutbox::Requeue(Entry&& pEntry)
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+    --m_nInFlight;
+
+    // submitted for a previous user. it's still in their journal and will be resent when they log in again.
+    if (pEntry.nSequence < m_nFirstSequence)
+        return;
+
+    ++m_pStatistics.nRetries;
+
+    // keep the queue in the order the submissions were made
+    const auto pIter = std::lower_bound(m_vQueued.begin(), m_vQueued.end(), pEntry.nSequence,
+        [](const Entry& pQueued, uint32_t nSequence) noexcept { return pQueued.nSequence < nSequence; });
+    m_vQueued.insert(pIter, std::move(pEntry));
+
+    if (m_bRetryScheduled)
+        return;
+
+    if (m_tRetryDelay < std::chrono::milliseconds(500))
+    {
+        m_tRetryDelay = std::chrono::milliseconds(500);
+    }
+    else
+    {
+        m_tRetryDelay += m_tRetryDelay;
+        if (m_tRetryDelay > std::chrono::minutes(2))
+            m_tRetryDelay = std::chrono::minutes(2);
+    }
+
+    m_bRetryScheduled = true;
+    ServiceLocator::GetMutable<IThreadPool>().ScheduleAsync(m_tRetryDelay, [this]()
+    {
+        std::unique_lock<std::mutex> lock(m_oMutex);
+        m_bRetryScheduled = false;
+        SendQueued(lock);
+    });
+}
+
+void SubmissionOutbox::MarkDelivered(const Entry& pEntry)
+{
+    const auto tLatency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        ServiceLocator::Get<IClock>().UpTime() - pEntry.tQueued);
+
+    std::unique_lock<std::mutex> lock(m_oMutex);
+    --m_nInFlight;
+    m_tRetryDelay = std::chrono::milliseconds(0);
+
+    ++m_pStatistics.nDelivered;
+    m_pStatistics.tTotalLatency += tLatency;
+    if (tLatency > m_pStatistics.tMaxLatency)
+        m_pStatistics.tMaxLatency = tLatency;
+
+    if (m_mUndelivered.erase(pEntry.nSequence) != 0)
+        AppendJournal(ra::StringPrintf("D:%u:", pEntry.nSequence));
+
+    SendQueued(lock);
+}
+
+SubmissionOutbox::Statistics SubmissionOutbox::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+
+    Statistics pStatistics = m_pStatistics;
+    pStatistics.nQueued = m_vQueued.size();
+    pStatistics.nInFlight = m_nInFlight;
+    return pStatistics;
+}
+
+} // namespace services
+} // namespace ra
@@ -0,0 +1,137 @@
+#ifndef RA_SERVICES_SUBMISSION_OUTBOX_HH
+#define RA_SERVICES_SUBMISSION_OUTBOX_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+#include "api\AwardAchievement.hh"
+#include "api\SubmitLeaderboardEntry.hh"
+
+namespace ra {
+namespace services {
+
+/// <summary>
+/// Persistent queue of unlocks and leaderboard entries waiting to be sent to the server.
+/// </summary>
+/// <remarks>
+/// Each submission is appended to a journal before it's sent, and marked as delivered once the server has
+/// responded. Submissions that were not delivered when the process exited are sent again by
+/// <see cref="Initialize" />. Resending is safe: the server reports an unlock it already has as an error that
+/// is treated as delivered, and only keeps the best score for a leaderboard.
+///
+/// Up to <see cref="MaxInFlight" /> submissions are sent concurrently. If the server can't be reached, the
+/// submission is put back in the queue and sending is paused with an exponential backoff, so a flaky
+/// connection doesn't result in a flood of requests.
+/// </remarks>
+class SubmissionOutbox
+{
+public:
+    GSL_SUPPRESS_F6 SubmissionOutbox() = default;
+    virtual ~SubmissionOutbox() noexcept = default;
+    SubmissionOutbox(const SubmissionOutbox&) noexcept = delete;
+    SubmissionOutbox& operator=(const SubmissionOutbox&) noexcept = delete;
+    SubmissionOutbox(SubmissionOutbox&&) noexcept = delete;
+    SubmissionOutbox& operator=(SubmissionOutbox&&) noexcept = delete;
+
+    /// <summary>
+    /// Opens the journal for <paramref name="sUsername" /> and resends anything that wasn't delivered.
+    /// </summary>
+    /// <remarks>
+    /// Does nothing if the journal for the user is already open. Until this is called, submissions are
+    /// still sent, but not journaled. If a different user's journal was open, anything that user hadn't
+    /// delivered is left in their journal and is not sent for the new user.
+    /// </remarks>
+    void Initialize(const std::string& sUsername);
+
+    /// <summary>
+    /// Queues an unlock to be sent to the server.
+    /// </summary>
+    /// <param name="fCallback">Called with the server's response once the unlock has been delivered.</param>
+    void QueueUnlock(const ra::api::AwardAchievement::Request& pRequest,
+        ra::api::AwardAchievement::Request::Callback&& fCallback);
+
+    /// <summary>
+    /// Queues a leaderboard entry to be sent to the server.
+    /// </summary>
+    /// <param name="fCallback">Called with the server's response once the entry has been delivered.</param>
+    void QueueLeaderboardEntry(const ra::api::SubmitLeaderboardEntry::Request& pRequest,
+        ra::api::SubmitLeaderboardEntry::Request::Callback&& fCallback);
+
+    struct Statistics
+    {
+        size_t nQueued = 0;     // waiting to be sent
+        size_t nInFlight = 0;   // waiting for a response
+        size_t nDelivered = 0;  // total delivered
+        size_t nRetries = 0;    // total times a submission had to be put back in the queue
+        std::chrono::milliseconds tTotalLatency{ 0 }; // total time from queueing to delivery
+        std::chrono::milliseconds tMaxLatency{ 0 };   // longest time from queueing to delivery
+    };
+
+    /// <summary>
+    /// Gets counters for monitoring the queue.
+    /// </summary>
+    Statistics GetStatistics() const;
+
+    /// <summary>
+    /// The maximum number of submissions that will be sent at the same time.
+    /// </summary>
+    static constexpr size_t MaxInFlight = 4;
+
+    /// <summary>
+    /// The number of records in the journal that will cause it to be rewritten with only the undelivered
+    /// submissions.
+    /// </summary>
+    static constexpr size_t MaxJournalRecords = 64;
+
+private:
+    enum class EntryType
+    {
+        Unlock,
+        LeaderboardEntry,
+    };
+
+    struct Entry
+    {
+        uint32_t nSequence = 0;
+        EntryType nType = EntryType::Unlock;
+        std::chrono::steady_clock::time_point tQueued;
+
+        ra::api::AwardAchievement::Request pUnlock;
+        ra::api::AwardAchievement::Request::Callback fUnlockCallback;
+        ra::api::SubmitLeaderboardEntry::Request pLeaderboardEntry;
+        ra::api::SubmitLeaderboardEntry::Request::Callback fLeaderboardEntryCallback;
+    };
+
+    void Queue(Entry&& pEntry);
+    void SendQueued(std::unique_lock<std::mutex>& lock); // unlocks the lock if anything is sent
+    void Send(Entry& pEntry);
+    void Requeue(Entry&& pEntry);
+    void MarkDelivered(const Entry& pEntry);
+
+    // m_oMutex must be locked for these
+    void LoadJournal(std::vector<Entry>& vRecovered);
+    void AppendJournal(const std::string& sRecord);
+    void CompactJournal();
+    static std::string FormatRecord(const Entry& pEntry);
+    static bool ParseRecord(const std::string& sRecord, Entry& pEntry, uint32_t& nDelivered);
+
+    std::wstring m_sUsername;
+    uint32_t m_nNextSequence = 1;
+    uint32_t m_nFirstSequence = 1; // submissions before this were made for a previous user
+
+    std::deque<Entry> m_vQueued; // sorted by sequence
+    size_t m_nInFlight = 0;
+
+    std::map<uint32_t, std::string> m_mUndelivered; // journal records for queued and in flight submissions
+    size_t m_nJournalRecords = 0;
+    std::chrono::milliseconds m_tRetryDelay{ 0 };
+    bool m_bRetryScheduled = false;
+
+    Statistics m_pStatistics;
+    mutable std::mutex m_oMutex;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_SUBMISSION_OUTBOX_HH
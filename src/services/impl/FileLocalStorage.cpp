@@ -111,6 +111,18 @@ std::wstring FileLocalStorage::GetPath(StorageItemType nType, const std::wstring
             sPath.append(L"-history.txt");
             break;
 
+        case StorageItemType::SessionLog:
+            sPath.append(RA_DIR_BASE);
+            sPath.append(sKey);
+            sPath.append(L"-history.bin");
+            break;
+
+        case StorageItemType::SessionIndex:
+            sPath.append(RA_DIR_BASE);
+            sPath.append(sKey);
+            sPath.append(L"-history.idx");
+            break;
+
         case StorageItemType::Bookmarks:
             sPath.append(RA_DIR_BOOKMARKS);
             sPath.append(sKey);
@@ -123,6 +135,24 @@ std::wstring FileLocalStorage::GetPath(StorageItemType nType, const std::wstring
             sPath.append(L".txt");
             break;
 
+        case StorageItemType::KnownHashIndex:
+            sPath.append(RA_DIR_DATA);
+            sPath.append(sKey);
+            sPath.append(L".idx");
+            break;
+
+        case StorageItemType::KnownHashJournal:
+            sPath.append(RA_DIR_DATA);
+            sPath.append(sKey);
+            sPath.append(L".jnl");
+            break;
+
+        case StorageItemType::SubmissionJournal:
+            sPath.append(RA_DIR_BASE);
+            sPath.append(sKey);
+            sPath.append(L"-outbox.txt");
+            break;
+
         default:
             assert(!"unhandled StorageItemType");
             sPath.append(RA_DIR_DATA);
@@ -158,6 +188,19 @@ std::unique_ptr<TextWriter> FileLocalStorage::AppendText(StorageItemType nType,
     return m_pFileSystem.AppendTextFile(GetPath(nType, sKey));
 }
 
+std::unique_ptr<MappedFile> FileLocalStorage::MapData(StorageItemType nType, const std::wstring& sKey)
+{
+    return m_pFileSystem.MapFile(GetPath(nType, sKey));
+}
+
+std::unique_ptr<FileLock> FileLocalStorage::LockData(StorageItemType nType, const std::wstring& sKey)
+{
+    // lock a separate file so the data file can still be opened while the lock is held
+    std::wstring sPath = GetPath(nType, sKey);
+    sPath.append(L".lock");
+    return m_pFileSystem.LockFile(sPath);
+}
+
 } // namespace impl
 } // namespace services
 } // namespace ra
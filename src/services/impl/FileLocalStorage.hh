@@ -19,6 +19,8 @@ public:
     std::unique_ptr<TextReader> ReadText(StorageItemType nType, const std::wstring& sKey) override;
     std::unique_ptr<TextWriter> WriteText(StorageItemType nType, const std::wstring& sKey) override;
     std::unique_ptr<TextWriter> AppendText(StorageItemType nType, const std::wstring& sKey) override;
+    std::unique_ptr<MappedFile> MapData(StorageItemType nType, const std::wstring& sKey) override;
+    std::unique_ptr<FileLock> LockData(StorageItemType nType, const std::wstring& sKey) override;
 
     std::wstring GetPath(StorageItemType nType, const std::wstring& sKey) const;
 
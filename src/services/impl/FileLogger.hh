@@ -9,6 +9,7 @@
 #include "services\ServiceLocator.hh"
 #include "services\TextWriter.hh"
 #include "services\impl\FileTextWriter.hh"
+#include "services\impl\MpscRingBuffer.hh"
 
 namespace ra {
 namespace services {
@@ -18,36 +19,182 @@ class FileLogger : public ra::services::ILogger
 {
 public:
     explicit FileLogger(const ra::services::IFileSystem& pFileSystem)
+        : m_pFileSystem(pFileSystem),
+          m_sLogFilePath(ra::BuildWString(pFileSystem.BaseDirectory().c_str(), L"RACache\\RALog.txt"))
     {
-        const std::wstring sLogFilePath = ra::BuildWString(pFileSystem.BaseDirectory().c_str(), L"RACache\\RALog.txt");
-
         // if the file is over 1MB, rename it and start a new one
-        const int64_t nLogSize = pFileSystem.GetFileSize(sLogFilePath);
-        if (nLogSize > 1024 * 1024)
+        const int64_t nLogSize = pFileSystem.GetFileSize(m_sLogFilePath);
+        if (nLogSize > MaxLogSize)
         {
-            const std::wstring sOldLogFilePath = ra::BuildWString(pFileSystem.BaseDirectory().c_str(), L"RACache\\RALog-old.txt");
-            pFileSystem.DeleteFile(sOldLogFilePath);
-            pFileSystem.MoveFile(sLogFilePath, sOldLogFilePath);
+            RotateLogFile();
         }
-        else if (nLogSize < 0)
+        else
         {
-            const std::wstring sCacheDirectory = ra::BuildWString(pFileSystem.BaseDirectory().c_str(), L"RACache");
-            if (!pFileSystem.DirectoryExists(sCacheDirectory))
-                pFileSystem.CreateDirectory(sCacheDirectory);
+            if (nLogSize < 0)
+            {
+                const std::wstring sCacheDirectory = ra::BuildWString(pFileSystem.BaseDirectory().c_str(), L"RACache");
+                if (!pFileSystem.DirectoryExists(sCacheDirectory))
+                    pFileSystem.CreateDirectory(sCacheDirectory);
+            }
+            else
+            {
+                m_nLogSize = nLogSize;
+            }
+
+            m_pWriter = pFileSystem.AppendTextFile(m_sLogFilePath);
         }
 
-        m_pWriter = pFileSystem.AppendTextFile(sLogFilePath);
         if (m_pWriter != nullptr)
+        {
             m_pWriter->WriteLine();
+            ++m_nLogSize;
+        }
+    }
+
+    ~FileLogger() noexcept
+    {
+        StopBackgroundWriter();
     }
 
-    bool IsEnabled([[maybe_unused]] LogLevel level) const noexcept override { return true; }
+    FileLogger(const FileLogger&) noexcept = delete;
+    FileLogger& operator=(const FileLogger&) noexcept = delete;
+    FileLogger(FileLogger&&) noexcept = delete;
+    FileLogger& operator=(FileLogger&&) noexcept = delete;
+
+    /// <summary>
+    /// The size the log file is allowed to reach before it's moved to RALog-old.txt and a new log is started.
+    /// </summary>
+    static constexpr int64_t MaxLogSize = 1024 * 1024;
+
+    /// <summary>
+    /// The number of characters of a message that will be written. Longer messages are truncated.
+    /// </summary>
+    static constexpr size_t MaxMessageLength = 4096;
+
+    /// <summary>
+    /// The number of messages that can be waiting for the background writer. Messages logged while the queue is
+    /// full are discarded.
+    /// </summary>
+    static constexpr size_t QueueCapacity = 1024;
+
+    bool IsEnabled(LogLevel level) const noexcept override { return (level >= m_nMinimumLevel); }
+
+    /// <summary>
+    /// Sets the least severe level of messages that should be written.
+    /// </summary>
+    void SetMinimumLevel(LogLevel level) noexcept { m_nMinimumLevel = level; }
 
     void LogMessage(LogLevel level, const std::string& sMessage) const override
     {
-        if (m_pWriter == nullptr)
+        std::string sRecord = FormatRecord(level, sMessage);
+
+        // StopBackgroundWriter waits for any thread that has seen the background writer as active to finish
+        // queueing its message before it does the final flush, so the message isn't left in the queue.
+        ++m_nQueueingThreads;
+        if (m_bBackgroundWriterActive)
+        {
+            // never block the caller on file I/O. if the writer can't keep up, the message is dropped.
+            if (!m_pQueue->TryPush(std::move(sRecord)))
+                ++m_nDroppedMessages;
+
+            --m_nQueueingThreads;
             return;
+        }
+        --m_nQueueingThreads;
 
+        // WinXP hangs if we try to acquire a mutex while the DLL in initializing. Since DllMain writes
+        // a header block to the log file, we have to do that without using a mutex. Luckily, we're not
+        // going to have multiple threads trying to write to the file, so it'll be safe, and we can
+        // use the presence (or lack thereof) of the ThreadPool implementation to determine if we're
+        // being called from DllMain.
+        if (ServiceLocator::Exists<IThreadPool>())
+        {
+            std::scoped_lock<std::mutex> oLock(m_oMutex);
+            Write(sRecord);
+        }
+        else
+        {
+            Write(sRecord);
+        }
+    }
+
+    /// <summary>
+    /// Starts a thread that writes messages to the file in batches. After this is called,
+    /// <see cref="LogMessage" /> only queues the message.
+    /// </summary>
+    /// <remarks>Must not be called from DllMain.</remarks>
+    void StartBackgroundWriter()
+    {
+        if (m_bBackgroundWriterActive || m_pWriter == nullptr)
+            return;
+
+        if (m_pQueue == nullptr)
+            m_pQueue = std::make_unique<MpscRingBuffer<std::string>>(QueueCapacity);
+
+        m_bStopRequested = false;
+        m_bBackgroundWriterActive = true;
+        m_pWriterThread = std::thread(&FileLogger::RunBackgroundWriter, this);
+    }
+
+    /// <summary>
+    /// Writes any queued messages, stops the background writer, and returns to writing messages immediately.
+    /// </summary>
+    void StopBackgroundWriter() noexcept
+    {
+        if (!m_pWriterThread.joinable())
+            return;
+
+        {
+            std::scoped_lock<std::mutex> oLock(m_oWakeMutex);
+            m_bStopRequested = true;
+        }
+        m_cvWake.notify_one();
+
+        m_pWriterThread.join();
+
+        // new messages will be written immediately. wait for any message that's already being queued, then
+        // write anything queued after the writer thread's final flush.
+        m_bBackgroundWriterActive = false;
+        while (m_nQueueingThreads > 0)
+            std::this_thread::yield();
+
+        GSL_SUPPRESS_F6 FlushQueue();
+    }
+
+    /// <summary>
+    /// Writes any queued messages to the file.
+    /// </summary>
+    void FlushQueue() const
+    {
+        if (m_pQueue == nullptr)
+            return;
+
+        std::scoped_lock<std::mutex> oLock(m_oMutex);
+
+        std::string sBatch, sRecord;
+        while (m_pQueue->TryPop(sRecord))
+        {
+            sBatch.append(sRecord);
+            if (sBatch.length() >= MaxBatchSize)
+            {
+                Write(sBatch);
+                sBatch.clear();
+            }
+        }
+
+        const auto nDroppedMessages = m_nDroppedMessages.exchange(0);
+        if (nDroppedMessages > 0)
+            sBatch.append(FormatRecord(LogLevel::Warn, std::to_string(nDroppedMessages) + " messages dropped"));
+
+        if (!sBatch.empty())
+            Write(sBatch);
+    }
+
+protected:
+    static constexpr size_t MaxBatchSize = 64 * 1024;
+
+    static std::string FormatRecord(LogLevel level, const std::string& sMessage)
+    {
         // write a timestamp
         time_t tTime{};
         unsigned int tMilliseconds{};
@@ -71,57 +218,108 @@ public:
         strftime(sBuffer, sizeof(sBuffer), "%H%M%S", &tTimeStruct);
         sprintf_s(&sBuffer[6], sizeof(sBuffer) - 6, ".%03u|", tMilliseconds);
 
-        // WinXP hangs if we try to acquire a mutex while the DLL in initializing. Since DllMain writes
-        // a header block to the log file, we have to do that without using a mutex. Luckily, we're not
-        // going to have multiple threads trying to write to the file, so it'll be safe, and we can
-        // use the presence (or lack thereof) of the ThreadPool implementation to determine if we're
-        // being called from DllMain.
-        if (ServiceLocator::Exists<IThreadPool>())
-        {
-            std::scoped_lock<std::mutex> oLock(m_oMutex);
-            LogMessage(*m_pWriter, sBuffer, level, sMessage);
-        }
-        else
-        {
-            LogMessage(*m_pWriter, sBuffer, level, sMessage);
-        }
-
-        // if writing to a file, flush immediately
-        auto* pFileWriter = dynamic_cast<ra::services::impl::FileTextWriter*>(m_pWriter.get());
-        if (pFileWriter != nullptr)
-            pFileWriter->GetFStream().flush();
-    }
+        const bool bTruncate = (sMessage.length() > MaxMessageLength);
 
-private:
-    static void LogMessage(ra::services::TextWriter& pWriter, const char* const sTimestamp, LogLevel level,
-                           const std::string& sMessage)
-    {
-        pWriter.Write(sTimestamp);
+        std::string sRecord;
+        sRecord.reserve(16 + (bTruncate ? MaxMessageLength + 32 : sMessage.length()));
+        sRecord.append(sBuffer);
 
         // mark the level
         switch (level)
         {
             case LogLevel::Info:
-                pWriter.Write("INFO");
+                sRecord.append("INFO");
                 break;
             case LogLevel::Warn:
-                pWriter.Write("WARN");
+                sRecord.append("WARN");
                 break;
             case LogLevel::Error:
-                pWriter.Write("ERR ");
+                sRecord.append("ERR ");
                 break;
         }
-        pWriter.Write("| ");
+        sRecord.append("| ");
 
         // write the message
-        pWriter.Write(sMessage);
+        if (bTruncate)
+        {
+            sRecord.append(sMessage, 0, MaxMessageLength);
+            sRecord.append("... (");
+            sRecord.append(std::to_string(sMessage.length()));
+            sRecord.append(" bytes)");
+        }
+        else
+        {
+            sRecord.append(sMessage);
+        }
 
         // newline
-        pWriter.WriteLine();
+        sRecord.push_back('\n');
+
+        return sRecord;
+    }
+
+private:
+    void RunBackgroundWriter()
+    {
+        // write whatever has been queued every 100ms. producers don't signal the writer so logging never
+        // has to acquire a lock.
+        while (!m_bStopRequested)
+        {
+            {
+                std::unique_lock<std::mutex> oLock(m_oWakeMutex);
+                m_cvWake.wait_for(oLock, std::chrono::milliseconds(100), [this]() noexcept { return m_bStopRequested.load(); });
+            }
+
+            FlushQueue();
+        }
+    }
+
+    void Write(const std::string& sText) const
+    {
+        if (m_pWriter == nullptr)
+            return;
+
+        m_pWriter->Write(sText);
+
+        // if writing to a file, flush immediately
+        auto* pFileWriter = dynamic_cast<ra::services::impl::FileTextWriter*>(m_pWriter.get());
+        if (pFileWriter != nullptr)
+            pFileWriter->GetFStream().flush();
+
+        m_nLogSize += ra::to_signed(sText.length());
+        if (m_nLogSize > MaxLogSize)
+            RotateLogFile();
+    }
+
+    void RotateLogFile() const
+    {
+        m_pWriter.reset();
+
+        const std::wstring sOldLogFilePath = ra::BuildWString(m_pFileSystem.BaseDirectory().c_str(), L"RACache\\RALog-old.txt");
+        m_pFileSystem.DeleteFile(sOldLogFilePath);
+        m_pFileSystem.MoveFile(m_sLogFilePath, sOldLogFilePath);
+
+        m_pWriter = m_pFileSystem.AppendTextFile(m_sLogFilePath);
+        m_nLogSize = 0;
     }
 
-    std::unique_ptr<ra::services::TextWriter> m_pWriter;
+    const ra::services::IFileSystem& m_pFileSystem;
+    const std::wstring m_sLogFilePath;
+
+    mutable std::unique_ptr<ra::services::TextWriter> m_pWriter;
+    mutable int64_t m_nLogSize = 0;
     mutable std::mutex m_oMutex;
+
+    std::atomic<LogLevel> m_nMinimumLevel{ LogLevel::Info };
+
+    std::unique_ptr<MpscRingBuffer<std::string>> m_pQueue;
+    mutable std::atomic<size_t> m_nDroppedMessages{ 0 };
+    mutable std::atomic<unsigned int> m_nQueueingThreads{ 0 };
+    std::atomic<bool> m_bBackgroundWriterActive{ false };
+    std::atomic<bool> m_bStopRequested{ false };
+    std::mutex m_oWakeMutex;
+    std::condition_variable m_cvWake;
+    std::thread m_pWriterThread;
 };
 
 } // namespace impl
@@ -73,6 +73,7 @@ bool JsonFileConfiguration::Load(const std::wstring& sFilename)
     m_sRomDirectory.clear();
     m_mWindowPositions.clear();
     m_nBackgroundThreads = 8;
+    m_nLogLevel = LogLevel::Info;
     m_vEnabledFeatures =
         (1 << static_cast<int>(Feature::Hardcore)) |
         (1 << static_cast<int>(Feature::Leaderboards));
@@ -130,6 +131,16 @@ bool JsonFileConfiguration::Load(const std::wstring& sFilename)
 
     if (doc.HasMember("Num Background Threads"))
         m_nBackgroundThreads = doc["Num Background Threads"].GetUint();
+    if (doc.HasMember("Log Level") && doc["Log Level"].IsString())
+    {
+        const std::string sLogLevel = doc["Log Level"].GetString();
+        if (sLogLevel == "Warn")
+            m_nLogLevel = LogLevel::Warn;
+        else if (sLogLevel == "Error")
+            m_nLogLevel = LogLevel::Error;
+        else
+            m_nLogLevel = LogLevel::Info;
+    }
     if (doc.HasMember("ROM Directory"))
         m_sRomDirectory = ra::Widen(doc["ROM Directory"].GetString());
 
@@ -219,6 +230,19 @@ void JsonFileConfiguration::Save() const
     doc.AddMember("Prefer Decimal", IsFeatureEnabled(Feature::PreferDecimal), a);
     doc.AddMember("Num Background Threads", m_nBackgroundThreads, a);
 
+    switch (m_nLogLevel)
+    {
+        case LogLevel::Warn:
+            doc.AddMember("Log Level", "Warn", a);
+            break;
+        case LogLevel::Error:
+            doc.AddMember("Log Level", "Error", a);
+            break;
+        default:
+            doc.AddMember("Log Level", "Info", a);
+            break;
+    }
+
     if (!m_sRomDirectory.empty())
         doc.AddMember("ROM Directory", ra::Narrow(m_sRomDirectory), a);
 
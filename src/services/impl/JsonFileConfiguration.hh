@@ -25,6 +25,7 @@ public:
     void SetPopupLocation(ra::ui::viewmodels::Popup nPopup, ra::ui::viewmodels::PopupLocation nPopupLocation) override;
 
     unsigned int GetNumBackgroundThreads() const noexcept override { return m_nBackgroundThreads; }
+    LogLevel GetLogLevel() const noexcept override { return m_nLogLevel; }
 
     const std::wstring& GetRomDirectory() const noexcept override { return m_sRomDirectory; }
     void SetRomDirectory(const std::wstring& sValue) override { m_sRomDirectory = sValue; }
@@ -56,6 +57,7 @@ private:
     std::array<ra::ui::viewmodels::PopupLocation, ra::etoi(ra::ui::viewmodels::Popup::NumPopups)> m_vPopupLocations = {};
 
     unsigned int m_nBackgroundThreads = 8;
+    LogLevel m_nLogLevel = LogLevel::Info;
     std::wstring m_sRomDirectory;
     std::wstring m_sScreenshotDirectory;
 
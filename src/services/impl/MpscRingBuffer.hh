@@ -0,0 +1,116 @@
+#ifndef RA_SERVICES_MPSC_RING_BUFFER_HH
+#define RA_SERVICES_MPSC_RING_BUFFER_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+/// <summary>
+/// Fixed-capacity queue that any number of threads can push into without locking, and a single thread can pop from.
+/// </summary>
+/// <remarks>
+/// Each slot carries a sequence number that tells producers and the consumer whose turn it is to use the slot.
+/// Producers claim a slot by advancing the enqueue position with a compare-exchange, so a full buffer causes
+/// <see cref="TryPush" /> to fail rather than wait.
+/// </remarks>
+template<typename T>
+class MpscRingBuffer
+{
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="MpscRingBuffer" /> class.
+    /// </summary>
+    /// <param name="nCapacity">The number of items the buffer can hold. Must be a power of two.</param>
+    GSL_SUPPRESS_F6 explicit MpscRingBuffer(size_t nCapacity)
+        : m_vSlots(nCapacity), m_nMask(nCapacity - 1)
+    {
+        Expects(nCapacity > 0 && (nCapacity & m_nMask) == 0);
+
+        for (size_t i = 0; i < nCapacity; ++i)
+            m_vSlots.at(i).nSequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpscRingBuffer() noexcept = default;
+    MpscRingBuffer(const MpscRingBuffer&) noexcept = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) noexcept = delete;
+    MpscRingBuffer(MpscRingBuffer&&) noexcept = delete;
+    MpscRingBuffer& operator=(MpscRingBuffer&&) noexcept = delete;
+
+    /// <summary>
+    /// Adds an item to the buffer. May be called from any thread.
+    /// </summary>
+    /// <returns><c>true</c> if the item was added, <c>false</c> if the buffer is full.</returns>
+    bool TryPush(T&& pItem)
+    {
+        size_t nPosition = m_nEnqueuePosition.load(std::memory_order_relaxed);
+        do
+        {
+            auto& pSlot = m_vSlots.at(nPosition & m_nMask);
+            const size_t nSequence = pSlot.nSequence.load(std::memory_order_acquire);
+            const auto nDifference = static_cast<std::ptrdiff_t>(nSequence - nPosition);
+            if (nDifference == 0)
+            {
+                // slot is free, try to claim it. if another thread claimed it first, nPosition is updated and we
+                // try again with the next slot
+                if (m_nEnqueuePosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+                {
+                    pSlot.pItem = std::move(pItem);
+                    pSlot.nSequence.store(nPosition + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (nDifference < 0)
+            {
+                // slot still holds the item from the previous pass through the buffer - the buffer is full
+                return false;
+            }
+            else
+            {
+                // another thread claimed the slot, reload the position
+                nPosition = m_nEnqueuePosition.load(std::memory_order_relaxed);
+            }
+        } while (true);
+    }
+
+    /// <summary>
+    /// Removes the oldest item from the buffer. Must only be called from one thread at a time.
+    /// </summary>
+    /// <returns><c>true</c> if an item was removed, <c>false</c> if the buffer is empty.</returns>
+    bool TryPop(T& pItem)
+    {
+        auto& pSlot = m_vSlots.at(m_nDequeuePosition & m_nMask);
+        if (pSlot.nSequence.load(std::memory_order_acquire) != m_nDequeuePosition + 1)
+            return false;
+
+        pItem = std::move(pSlot.pItem);
+        pSlot.nSequence.store(m_nDequeuePosition + m_vSlots.size(), std::memory_order_release);
+        ++m_nDequeuePosition;
+        return true;
+    }
+
+    /// <summary>
+    /// Gets the number of items the buffer can hold.
+    /// </summary>
+    size_t Capacity() const noexcept { return m_vSlots.size(); }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> nSequence{ 0 };
+        T pItem{};
+    };
+
+    std::vector<Slot> m_vSlots;
+    const size_t m_nMask;
+    std::atomic<size_t> m_nEnqueuePosition{ 0 };
+    size_t m_nDequeuePosition = 0;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_MPSC_RING_BUFFER_HH
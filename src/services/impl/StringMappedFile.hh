@@ -0,0 +1,34 @@
+#ifndef RA_SERVICES_STRINGMAPPEDFILE
+#define RA_SERVICES_STRINGMAPPEDFILE
+#pragma once
+
+#include "services\MappedFile.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+class StringMappedFile : public ra::services::MappedFile
+{
+public:
+    explicit StringMappedFile(const std::string& sContents) noexcept
+        : m_sContents(sContents)
+    {
+    }
+
+    GSL_SUPPRESS_TYPE1 const uint8_t* GetData() const noexcept override
+    {
+        return reinterpret_cast<const uint8_t*>(m_sContents.data());
+    }
+
+    size_t GetSize() const noexcept override { return m_sContents.size(); }
+
+private:
+    const std::string& m_sContents;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_STRINGMAPPEDFILE
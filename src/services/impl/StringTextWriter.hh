@@ -28,7 +28,7 @@ public:
     {
         if (gsl::narrow_cast<std::size_t>(m_nWritePosition) < m_sOutput.length())
         {
-            m_sOutput.replace(gsl::narrow_cast<std::size_t>(m_nWritePosition), sText.length(), sText.c_str());
+            m_sOutput.replace(gsl::narrow_cast<std::size_t>(m_nWritePosition), sText.length(), sText);
             m_nWritePosition += sText.length();
         }
         else
@@ -15,31 +15,182 @@ void ThreadPool::Initialize(size_t nThreads) noexcept
 {
     assert(m_vThreads.empty());
 
-    // require at least two threads. that way if one thread is reserved for processing timed events, another is still available to execute them.
+    // require at least two threads. that way one long running task can't prevent other work from being started.
     if (nThreads < 2)
         nThreads = 2; 
 
     RA_LOG_INFO("Initializing %zu worker threads", nThreads);
 
+    // all workers must exist before any thread starts looking for work to steal
     for (size_t i = 0; i < nThreads; ++i)
-        m_vThreads.emplace_back(&ThreadPool::RunThread, this);
+        m_vWorkers.emplace_back(std::make_unique<Worker>());
+
+    for (size_t i = 0; i < nThreads; ++i)
+        m_vThreads.emplace_back(&ThreadPool::RunThread, this, i);
+
+    // each worker records its own thread id. wait for all of them so GetCurrentWorker can be used once we return.
+    {
+        std::unique_lock<std::mutex> lock(m_oMutex);
+        m_cvStarted.wait(lock, [this]() noexcept { return m_nStartedThreads == m_vWorkers.size(); });
+    }
+
+    m_pTimerThread = std::thread(&ThreadPool::RunTimerThread, this);
+}
+
+void ThreadPool::RunAsync(TaskPriority nPriority, std::function<void()>&& f)
+{
+    if (m_bShutdownInitiated)
+        return;
+
+    assert(!m_vThreads.empty());
+
+    Enqueue(nPriority, std::move(f));
 }
 
-void ThreadPool::RunThread()
+ThreadPool::Worker* ThreadPool::GetCurrentWorker() const noexcept
 {
-    do
+    // thread_local variables are not supported in dynamically loaded DLLs on WinXP, so find the worker by its thread id
+    const auto nThreadId = std::this_thread::get_id();
+    for (const auto& pWorker : m_vWorkers)
+    {
+        if (pWorker->nThreadId == nThreadId)
+            return pWorker.get();
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::Enqueue(TaskPriority nPriority, std::function<void()>&& f)
+{
+    auto* pWorker = (nPriority == TaskPriority::Interactive) ? GetCurrentWorker() : nullptr;
+    if (pWorker != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(pWorker->oMutex);
+        pWorker->vTasks.PushBack(std::move(f));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_oInjectionMutex);
+        if (nPriority == TaskPriority::Background)
+            m_vBackgroundTasks.PushBack(std::move(f));
+        else
+            m_vInteractiveTasks.PushBack(std::move(f));
+    }
+
+    ++m_nPendingTasks;
+    NotifyWork(1);
+}
+
+void ThreadPool::NotifyWork(size_t nTasks)
+{
+    // every thread is busy. they'll find the new work before they go back to sleep.
+    if (m_nIdleThreads == 0)
+        return;
+
+    // a worker is already being woken. when it finds a task, it'll wake another worker if there's more work, so
+    // queueing a burst of tasks doesn't wake (and context switch to) a worker for each one.
+    if (nTasks == 1 && m_bWakingThread.exchange(true))
+        return;
+
+    // a worker may have seen no pending tasks and be about to wait. acquiring the mutex ensures it's either
+    // waiting (and will be woken) or hasn't checked m_nPendingTasks yet (and will see the new work).
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+    }
+
+    if (nTasks == 1)
+        m_cvWork.notify_one();
+    else
+        m_cvWork.notify_all();
+}
+
+bool ThreadPool::TryGetInjectedTask(TaskQueue& vQueue, std::function<void()>& fTask)
+{
+    if (vQueue.IsEmpty())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_oInjectionMutex);
+    return vQueue.PopFront(fTask);
+}
+
+bool ThreadPool::TryGetTask(size_t nWorkerIndex, std::function<void()>& fTask)
+{
+    if (m_nPendingTasks == 0)
+        return false;
+
+    auto& pWorker = *m_vWorkers.at(nWorkerIndex);
+
+    // periodically let a background task run even if interactive work is available
+    if (++pWorker.nTasksSinceBackground >= BackgroundTaskInterval)
+    {
+        pWorker.nTasksSinceBackground = 0;
+        if (TryGetInjectedTask(m_vBackgroundTasks, fTask))
+            return true;
+    }
+
+    // most recently queued task from this worker. it's most likely to still have its data in the cache.
+    if (!pWorker.vTasks.IsEmpty())
+    {
+        std::lock_guard<std::mutex> lock(pWorker.oMutex);
+        if (pWorker.vTasks.PopBack(fTask))
+            return true;
+    }
+
+    if (TryGetInjectedTask(m_vInteractiveTasks, fTask))
+        return true;
+
+    // steal the oldest task from another worker
+    const auto nWorkers = m_vWorkers.size();
+    for (size_t i = 1; i < nWorkers; ++i)
+    {
+        auto& pVictim = *m_vWorkers.at((nWorkerIndex + i) % nWorkers);
+        if (pVictim.vTasks.IsEmpty())
+            continue;
+
+        std::lock_guard<std::mutex> lock(pVictim.oMutex);
+        if (pVictim.vTasks.PopFront(fTask))
+            return true;
+    }
+
+    if (TryGetInjectedTask(m_vBackgroundTasks, fTask))
+    {
+        pWorker.nTasksSinceBackground = 0;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::RunThread(size_t nWorkerIndex)
+{
+    // don't look at any queue until every worker has recorded its thread id. GetCurrentWorker reads all of them.
+    {
+        std::unique_lock<std::mutex> lock(m_oMutex);
+        m_vWorkers.at(nWorkerIndex)->nThreadId = std::this_thread::get_id();
+
+        if (++m_nStartedThreads == m_vWorkers.size())
+            m_cvStarted.notify_all();
+        else
+            m_cvStarted.wait(lock, [this]() noexcept { return m_nStartedThreads == m_vWorkers.size(); });
+    }
+
+    std::function<void()> pNext;
+    bool bWoken = false;
+
+    while (!m_bShutdownInitiated)
     {
         // check for work
-        do
+        if (TryGetTask(nWorkerIndex, pNext))
         {
-            std::function<void()> pNext;
-            {
-                std::unique_lock<std::mutex> lock(m_oMutex);
-                if (m_vQueue.empty())
-                    break;
+            --m_nPendingTasks;
 
-                pNext = std::move(m_vQueue.front());
-                m_vQueue.pop_front();
+            if (bWoken)
+            {
+                // allow the next queued task to wake another worker, and wake one now if there's more work
+                bWoken = false;
+                m_bWakingThread = false;
+                if (m_nPendingTasks > 0)
+                    NotifyWork(1);
             }
 
             // do work
@@ -52,75 +203,116 @@ void ThreadPool::RunThread()
             {
                 RA_LOG_ERR("Exception on background thread: %s", ex.what());
             }
-        } while (!m_bShutdownInitiated);
 
-        // wait for work
-        if (!m_bShutdownInitiated)
-        {
-            std::unique_lock<std::mutex> lock(m_oMutex);
-            m_cvWork.wait(lock);
+            // release anything captured by the task
+            pNext = nullptr;
+            continue;
         }
-    } while (!m_bShutdownInitiated);
+
+        // wait for work
+        std::unique_lock<std::mutex> lock(m_oMutex);
+        ++m_nIdleThreads;
+        m_bWakingThread = false;
+        m_cvWork.wait(lock, [this]() noexcept { return m_nPendingTasks > 0 || m_bShutdownInitiated; });
+        --m_nIdleThreads;
+        bWoken = true;
+    }
 }
 
-void ThreadPool::ProcessDelayedTasks()
+IThreadPool::ScheduledTaskId ThreadPool::ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f)
 {
-    auto& pClock = ServiceLocator::Get<IClock>();
-    constexpr auto tZeroMilliseconds = std::chrono::milliseconds(0);
+    if (m_bShutdownInitiated)
+        return 0;
 
-    // check for work
-    while (!m_bShutdownInitiated)
+    assert(!m_vThreads.empty());
+
+    const auto tNow = ServiceLocator::Get<IClock>().UpTime();
+    const auto tWhen = tNow + nDelay;
+
+    ScheduledTaskId nId = 0;
+    bool bWakeTimerThread = false;
     {
-        // move any work that needs to occur now to the work queue
-        size_t nReadyTasks = 0U;
-        {
-            std::unique_lock<std::mutex> lock(m_oMutex);
+        std::lock_guard<std::mutex> lock(m_oTimerMutex);
 
-            const auto tNow = pClock.UpTime();
-            while (!m_vDelayedTasks.empty() && m_vDelayedTasks.front().tWhen <= tNow)
-            {
-                m_vQueue.emplace_front(std::move(m_vDelayedTasks.front().fTask));
-                m_vDelayedTasks.pop_front();
+        if (m_pTimers == nullptr)
+            m_pTimers = std::make_unique<TimerWheel>(tNow);
 
-                ++nReadyTasks;
-            }
-        }
+        // if the new task is due before the timer thread was going to wake up, wake it so it can recalculate the
+        // wait time
+        TimerWheel::TimePoint tNext;
+        bWakeTimerThread = (!m_pTimers->GetNextEventTime(tNext) || tWhen < tNext);
 
-        if (m_bShutdownInitiated)
-            break;
+        nId = m_pTimers->Schedule(tWhen, std::move(f));
+    }
 
-        // wake up other threads to do the work
-        if (nReadyTasks >= m_nThreads - 1) // we're using one thread
-        {
-            m_cvWork.notify_all();
-        }
-        else
+    if (bWakeTimerThread)
+        m_cvTimer.notify_one();
+
+    return nId;
+}
+
+bool ThreadPool::CancelScheduledTask(ScheduledTaskId nId)
+{
+    std::lock_guard<std::mutex> lock(m_oTimerMutex);
+    return (m_pTimers != nullptr && m_pTimers->Cancel(nId));
+}
+
+void ThreadPool::RunTimerThread()
+{
+    std::vector<std::function<void()>> vReadyTasks;
+
+    std::unique_lock<std::mutex> lock(m_oTimerMutex);
+    while (!m_bShutdownInitiated)
+    {
+        TimerWheel::TimePoint tNext;
+        if (m_pTimers == nullptr || !m_pTimers->GetNextEventTime(tNext))
         {
-            while (nReadyTasks--)
-                m_cvWork.notify_one();
+            // nothing scheduled. wait for ScheduleAsync or Shutdown to wake us.
+            m_cvTimer.wait(lock);
+            continue;
         }
 
-
         // sleep until it's time to do the next work. use a wait_for instead of a sleep so we can can be woken
         // early if new work gets added that needs to occur sooner that we were expecting.
+        const auto tNow = ServiceLocator::Get<IClock>().UpTime();
+        if (tNext > tNow)
         {
-            std::unique_lock<std::mutex> lock(m_oMutex);
+            m_cvTimer.wait_for(lock, tNext - tNow);
+            continue;
+        }
 
-            // no more delayed tasks, free up the thread for other work
-            if (m_vDelayedTasks.empty())
-                break;
+        // move any work that needs to occur now to the work queue
+        m_pTimers->Advance(tNow, vReadyTasks);
+        if (vReadyTasks.empty())
+            continue;
 
-            const auto tNext = m_vDelayedTasks.front().tWhen - pClock.UpTime();
-            if (tNext > tZeroMilliseconds)
-                m_cvDelayedWork.wait_for(lock, tNext);
+        lock.unlock();
+        {
+            {
+                std::lock_guard<std::mutex> oInjectionLock(m_oInjectionMutex);
+                for (auto& fTask : vReadyTasks)
+                    m_vInteractiveTasks.PushBack(std::move(fTask));
+            }
+
+            // wake up the workers to do the work
+            m_nPendingTasks += vReadyTasks.size();
+            NotifyWork(vReadyTasks.size());
+            vReadyTasks.clear();
         }
+        lock.lock();
     }
 }
 
 void ThreadPool::Shutdown(bool bWait) noexcept
 {
     m_bShutdownInitiated = true;
-    m_cvDelayedWork.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_oTimerMutex);
+    }
+    m_cvTimer.notify_all();
     m_cvWork.notify_all();
 
     if (bWait && !m_vThreads.empty())
@@ -133,6 +325,9 @@ void ThreadPool::Shutdown(bool bWait) noexcept
         RA_LOG_INFO("Background threads finished");
 
         m_vThreads.clear();
+
+        if (m_pTimerThread.joinable())
+            m_pTimerThread.join();
     }
 
 }
@@ -7,11 +7,25 @@
 #include "services\IClock.hh"
 #include "services\IThreadPool.hh"
 #include "services\ServiceLocator.hh"
+#include "services\impl\TimerWheel.hh"
 
 namespace ra {
 namespace services {
 namespace impl {
 
+/// <summary>
+/// Work-stealing thread pool.
+/// </summary>
+/// <remarks>
+/// Each worker has its own queue. Interactive tasks queued by a worker are placed in its own queue so they don't
+/// contend with the other threads, and idle workers steal the oldest tasks from busy workers. Tasks queued from
+/// other threads go into a shared injection queue for their priority. Background tasks are only started when
+/// there's no interactive work available, except that each worker periodically starts one anyway so they can't
+/// be starved indefinitely.
+///
+/// Scheduled tasks are tracked by a <see cref="TimerWheel" /> on a dedicated timer thread, which moves them to
+/// the interactive injection queue when they're due.
+/// </remarks>
 class ThreadPool : public IThreadPool
 {
 public:
@@ -29,101 +43,141 @@ public:
 
     GSL_SUPPRESS_F6 void Initialize(size_t nThreads) noexcept;
 
-    void RunAsync(std::function<void()>&& f) override
-    {
-        if (m_bShutdownInitiated)
-            return;
+    using IThreadPool::RunAsync;
 
-        assert(!m_vThreads.empty());
+    void RunAsync(TaskPriority nPriority, std::function<void()>&& f) override;
 
-        {
-            std::unique_lock<std::mutex> lock(m_oMutex);
-            m_vQueue.push_back(std::move(f));
-        }
+    ScheduledTaskId ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) override;
+
+    bool CancelScheduledTask(ScheduledTaskId nId) override;
+
+    GSL_SUPPRESS_F6 void Shutdown(bool bWait) noexcept override;
+
+    bool IsShutdownRequested() const noexcept override { return m_bShutdownInitiated; }
 
-        m_cvWork.notify_one();
-    }
+    /// <summary>
+    /// The number of tasks a worker will start before it starts a background task, even if interactive tasks
+    /// are available.
+    /// </summary>
+    static constexpr unsigned int BackgroundTaskInterval = 16;
 
-    void ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) override
+private:
+    /// <summary>
+    /// Double-ended queue of tasks stored in a ring buffer.
+    /// </summary>
+    /// <remarks>
+    /// std::deque allocates a block for every one or two std::function objects, so a ring buffer is used instead.
+    /// Slots are reused once the buffer has grown to fit the workload, so queueing a task doesn't allocate memory.
+    ///
+    /// The queue must be modified while holding its owner's mutex, but <see cref="IsEmpty" /> may be called without
+    /// it so empty queues can be skipped without contending for the mutex.
+    /// </remarks>
+    class TaskQueue
     {
-        if (m_bShutdownInitiated)
-            return;
+    public:
+        bool IsEmpty() const noexcept { return (m_nCount.load(std::memory_order_relaxed) == 0); }
 
-        assert(!m_vThreads.empty());
+        void PushBack(std::function<void()>&& f)
+        {
+            if (m_nCount == m_vSlots.size())
+                Grow();
 
-        const auto tWhen = ServiceLocator::Get<IClock>().UpTime() + nDelay;
+            const size_t nCount = m_nCount.load(std::memory_order_relaxed);
+            m_vSlots.at((m_nHead + nCount) & (m_vSlots.size() - 1)) = std::move(f);
+            m_nCount.store(nCount + 1, std::memory_order_relaxed);
+        }
 
-        bool bStartScheduler = false;
-        bool bNewPriority    = false;
+        bool PopFront(std::function<void()>& f)
         {
-            std::unique_lock<std::mutex> lock(m_oMutex);
-
-            auto iter = m_vDelayedTasks.begin();
-
-            if (m_vDelayedTasks.empty())
-            {
-                // first scheduled task - dedicate one of the background threads to timed events
-                m_vQueue.push_front([this]() { ProcessDelayedTasks(); });
-                bStartScheduler = true;
-            }
-            else if (tWhen < iter->tWhen)
-            {
-                // sooner than the next scheduled task, we'll need to wake the timed events thread to reset the wait
-                // time
-                bNewPriority = true;
-            }
-            else
-            {
-                // after the next scheduled task, find where to insert it
-                do
-                {
-                    ++iter;
-                } while (iter != m_vDelayedTasks.end() && iter->tWhen < tWhen);
-            }
-
-            m_vDelayedTasks.emplace(iter, tWhen, std::move(f));
+            const size_t nCount = m_nCount.load(std::memory_order_relaxed);
+            if (nCount == 0)
+                return false;
+
+            auto& pSlot = m_vSlots.at(m_nHead);
+            f = std::move(pSlot);
+            pSlot = nullptr;
+
+            m_nHead = (m_nHead + 1) & (m_vSlots.size() - 1);
+            m_nCount.store(nCount - 1, std::memory_order_relaxed);
+            return true;
         }
 
-        if (bStartScheduler)
+        bool PopBack(std::function<void()>& f)
         {
-            // wake one of the background threads to process the timed events
-            m_cvWork.notify_one();
+            const size_t nCount = m_nCount.load(std::memory_order_relaxed);
+            if (nCount == 0)
+                return false;
+
+            auto& pSlot = m_vSlots.at((m_nHead + nCount - 1) & (m_vSlots.size() - 1));
+            f = std::move(pSlot);
+            pSlot = nullptr;
+
+            m_nCount.store(nCount - 1, std::memory_order_relaxed);
+            return true;
         }
 
-        if (bNewPriority)
+    private:
+        void Grow()
         {
-            // wake the timed events thread to recalculate the time until the next event
-            m_cvDelayedWork.notify_one();
+            std::vector<std::function<void()>> vSlots(m_vSlots.empty() ? 16 : m_vSlots.size() * 2);
+            const size_t nCount = m_nCount.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < nCount; ++i)
+                vSlots.at(i) = std::move(m_vSlots.at((m_nHead + i) & (m_vSlots.size() - 1)));
+
+            m_vSlots.swap(vSlots);
+            m_nHead = 0;
         }
-    }
 
-    GSL_SUPPRESS_F6 void Shutdown(bool bWait) noexcept override;
+        std::vector<std::function<void()>> m_vSlots; // size is always zero or a power of two
+        size_t m_nHead = 0;
+        std::atomic<size_t> m_nCount{0U}; // only modified under the owner's mutex
+    };
 
-    bool IsShutdownRequested() const noexcept override { return m_bShutdownInitiated; }
+    struct Worker
+    {
+        std::thread::id nThreadId;
+        TaskQueue vTasks;
+        std::mutex oMutex;
+        unsigned int nTasksSinceBackground = 0;
+    };
 
-private:
-    void RunThread();
-    void ProcessDelayedTasks();
+    void RunThread(size_t nWorkerIndex);
+    void RunTimerThread();
+
+    void Enqueue(TaskPriority nPriority, std::function<void()>&& f);
+    bool TryGetTask(size_t nWorkerIndex, std::function<void()>& fTask);
+    bool TryGetInjectedTask(TaskQueue& vQueue, std::function<void()>& fTask);
+    void NotifyWork(size_t nTasks);
+    Worker* GetCurrentWorker() const noexcept;
 
     std::vector<std::thread> m_vThreads;
-    size_t m_nThreads{0U};
-    bool m_bShutdownInitiated{false};
+    std::vector<std::unique_ptr<Worker>> m_vWorkers;
+    std::atomic<bool> m_bShutdownInitiated{false};
 
-    struct DelayedTask
-    {
-        DelayedTask(std::chrono::steady_clock::time_point tWhen, std::function<void()> fTask) :
-            tWhen(tWhen),
-            fTask(fTask){};
+    // created when the first task is scheduled
+    std::unique_ptr<TimerWheel> m_pTimers;
+    std::mutex m_oTimerMutex;
+    std::condition_variable m_cvTimer;
+    std::thread m_pTimerThread;
 
-        std::chrono::steady_clock::time_point tWhen;
-        std::function<void()> fTask;
-    };
-    std::deque<DelayedTask> m_vDelayedTasks;
+    // tasks queued from threads that aren't workers
+    TaskQueue m_vInteractiveTasks;
+    TaskQueue m_vBackgroundTasks;
+    std::mutex m_oInjectionMutex;
+
+    // number of tasks in all queues. idle workers sleep until this is non-zero.
+    std::atomic<size_t> m_nPendingTasks{0U};
+    std::atomic<size_t> m_nIdleThreads{0U};
+
+    // set when a worker has been woken but hasn't found a task yet
+    std::atomic<bool> m_bWakingThread{false};
 
-    std::deque<std::function<void()>> m_vQueue;
     std::mutex m_oMutex;
     std::condition_variable m_cvWork;
-    std::condition_variable m_cvDelayedWork;
+
+    // number of workers that have recorded their thread id. guarded by m_oMutex.
+    size_t m_nStartedThreads = 0;
+    std::condition_variable m_cvStarted;
 };
 
 } // namespace impl
@@ -0,0 +1,224 @@
+#include "TimerWheel.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+uint64_t TimerWheel::ToTick(TimePoint tWhen, bool bRoundUp) const noexcept
+{
+    if (tWhen <= m_tStart)
+        return 0;
+
+    constexpr int64_t NanosecondsPerTick = 1000000;
+    const auto nNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(tWhen - m_tStart).count();
+    if (bRoundUp)
+        return gsl::narrow_cast<uint64_t>((nNanoseconds + NanosecondsPerTick - 1) / NanosecondsPerTick);
+
+    return gsl::narrow_cast<uint64_t>(nNanoseconds / NanosecondsPerTick);
+}
+
+unsigned int TimerWheel::FindNextSlot(uint64_t nOccupied, unsigned int nStart) noexcept
+{
+    if (nStart >= SlotsPerLevel)
+        return SlotsPerLevel;
+
+    uint64_t nMask = nOccupied & (~uint64_t(0) << nStart);
+    if (nMask == 0)
+        return SlotsPerLevel;
+
+    // count the trailing zeros. _BitScanForward64 isn't available in 32-bit builds.
+    unsigned int nSlot = 0;
+    for (unsigned int nBits = 32; nBits > 0; nBits >>= 1)
+    {
+        if ((nMask & ((uint64_t(1) << nBits) - 1)) == 0)
+        {
+            nSlot += nBits;
+            nMask >>= nBits;
+        }
+    }
+
+    return nSlot;
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(TimePoint tWhen, std::function<void()>&& fTask)
+{
+    const auto nId = m_nNextId++;
+    auto& pTimer = m_mTimers[nId];
+
+    // tasks that are already due will be returned by the next call to Advance
+    pTimer.nTick = std::max(ToTick(tWhen, true), m_nCurrentTick);
+    pTimer.fTask = std::move(fTask);
+    Place(nId, pTimer);
+
+    return nId;
+}
+
+void TimerWheel::Place(TimerId nId, Timer& pTimer)
+{
+    // a timer goes in the lowest level where it's in the same lap as the current tick. that guarantees its slot
+    // in that level is after the current slot, so it'll be reached before the timer is due.
+    uint64_t nTick = pTimer.nTick;
+    unsigned int nLevel = 0;
+    while (nLevel < NumLevels && (nTick >> (SlotBits * (nLevel + 1))) != (m_nCurrentTick >> (SlotBits * (nLevel + 1))))
+        ++nLevel;
+
+    if (nLevel == NumLevels)
+    {
+        // beyond the range of the wheel. put it in the first slot of the highest level, which is processed at the
+        // start of the next lap of the wheel. it'll be placed again then.
+        nLevel = NumLevels - 1;
+        nTick = 0;
+    }
+
+    const auto nSlot = gsl::narrow_cast<unsigned int>((nTick >> (SlotBits * nLevel)) & SlotMask);
+    pTimer.nLevel = nLevel;
+    pTimer.nSlot = nSlot;
+
+    auto& pLevel = m_vLevels.at(nLevel);
+    auto& pSlot = pLevel.vSlots.at(nSlot);
+    pSlot.vTimers.push_back(nId);
+    ++pSlot.nActive;
+    pLevel.nOccupied |= (uint64_t(1) << nSlot);
+}
+
+bool TimerWheel::Cancel(TimerId nId)
+{
+    const auto pIter = m_mTimers.find(nId);
+    if (pIter == m_mTimers.end())
+        return false;
+
+    auto& pLevel = m_vLevels.at(pIter->second.nLevel);
+    auto& pSlot = pLevel.vSlots.at(pIter->second.nSlot);
+    if (--pSlot.nActive == 0)
+    {
+        pSlot.vTimers.clear();
+        pLevel.nOccupied &= ~(uint64_t(1) << pIter->second.nSlot);
+    }
+    // otherwise, the ID is left in the slot and ignored when the slot is processed
+
+    m_mTimers.erase(pIter);
+    return true;
+}
+
+void TimerWheel::ProcessSlot(unsigned int nLevel, unsigned int nSlot, std::vector<std::function<void()>>* vExpired)
+{
+    auto& pLevel = m_vLevels.at(nLevel);
+    if ((pLevel.nOccupied & (uint64_t(1) << nSlot)) == 0)
+        return;
+
+    pLevel.nOccupied &= ~(uint64_t(1) << nSlot);
+
+    auto& pSlot = pLevel.vSlots.at(nSlot);
+    std::vector<TimerId> vTimers;
+    vTimers.swap(pSlot.vTimers);
+    pSlot.nActive = 0;
+
+    for (const auto nId : vTimers)
+    {
+        const auto pIter = m_mTimers.find(nId);
+        if (pIter == m_mTimers.end()) // cancelled
+            continue;
+
+        if (vExpired != nullptr)
+        {
+            vExpired->push_back(std::move(pIter->second.fTask));
+            m_mTimers.erase(pIter);
+        }
+        else
+        {
+            // higher level slot has been reached - move the timer closer to the first level
+            Place(nId, pIter->second);
+        }
+    }
+
+    // keep the allocated space for the next time the slot is used
+    if (pSlot.vTimers.empty())
+    {
+        vTimers.clear();
+        pSlot.vTimers.swap(vTimers);
+    }
+}
+
+void TimerWheel::Advance(TimePoint tNow, std::vector<std::function<void()>>& vExpired)
+{
+    const auto nTargetTick = ToTick(tNow, false);
+
+    while (m_nCurrentTick <= nTargetTick)
+    {
+        if (m_mTimers.empty())
+        {
+            m_nCurrentTick = nTargetTick + 1;
+            break;
+        }
+
+        const auto nIndex = gsl::narrow_cast<unsigned int>(m_nCurrentTick & SlotMask);
+        if (nIndex == 0)
+        {
+            // the start of a new first level lap is also the start of a slot in the next level. if that's also the
+            // first slot of its level, it's the start of a slot in the level above that, and so on.
+            unsigned int nHighestLevel = 1;
+            while (nHighestLevel < NumLevels - 1 && ((m_nCurrentTick >> (SlotBits * nHighestLevel)) & SlotMask) == 0)
+                ++nHighestLevel;
+
+            for (unsigned int nLevel = nHighestLevel; nLevel > 0; --nLevel)
+            {
+                const auto nSlot = gsl::narrow_cast<unsigned int>((m_nCurrentTick >> (SlotBits * nLevel)) & SlotMask);
+                ProcessSlot(nLevel, nSlot, nullptr);
+            }
+        }
+
+        ProcessSlot(0, nIndex, &vExpired);
+
+        // skip ahead to the next occupied slot in the current lap, or the start of the next lap
+        const auto nNextIndex = FindNextSlot(m_vLevels.front().nOccupied, nIndex + 1);
+        m_nCurrentTick = std::min(m_nCurrentTick - nIndex + nNextIndex, nTargetTick + 1);
+    }
+}
+
+bool TimerWheel::GetNextEventTime(TimePoint& tNext) const noexcept
+{
+    if (m_mTimers.empty())
+        return false;
+
+    uint64_t nNextTick = ~uint64_t(0);
+
+    // first level slots are due at the corresponding tick of the current lap, or the next lap if the slot has
+    // already been passed
+    const auto& pFirstLevel = m_vLevels.front();
+    if (pFirstLevel.nOccupied != 0)
+    {
+        const auto nIndex = gsl::narrow_cast<unsigned int>(m_nCurrentTick & SlotMask);
+        auto nSlot = FindNextSlot(pFirstLevel.nOccupied, nIndex);
+        if (nSlot < SlotsPerLevel)
+            nNextTick = m_nCurrentTick - nIndex + nSlot;
+        else
+            nNextTick = m_nCurrentTick - nIndex + SlotsPerLevel + FindNextSlot(pFirstLevel.nOccupied, 0);
+    }
+
+    // higher level slots need to be redistributed when the start of the slot is reached
+    for (unsigned int nLevel = 1; nLevel < NumLevels; ++nLevel)
+    {
+        const auto& pLevel = m_vLevels.at(nLevel);
+        if (pLevel.nOccupied == 0)
+            continue;
+
+        const auto nShift = SlotBits * nLevel;
+        const auto nIndex = gsl::narrow_cast<unsigned int>((m_nCurrentTick >> nShift) & SlotMask);
+        auto nSlot = FindNextSlot(pLevel.nOccupied, nIndex + 1);
+        uint64_t nDistance = 0;
+        if (nSlot < SlotsPerLevel)
+            nDistance = nSlot - nIndex;
+        else
+            nDistance = FindNextSlot(pLevel.nOccupied, 0) + SlotsPerLevel - nIndex;
+
+        const auto nSlotTick = ((m_nCurrentTick >> nShift) + nDistance) << nShift;
+        nNextTick = std::min(nNextTick, nSlotTick);
+    }
+
+    tNext = m_tStart + std::chrono::milliseconds(nNextTick);
+    return true;
+}
+
+} // namespace impl
+} // namespace services
+} // namespace ra
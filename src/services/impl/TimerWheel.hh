@@ -0,0 +1,110 @@
+#ifndef RA_SERVICES_TIMER_WHEEL_HH
+#define RA_SERVICES_TIMER_WHEEL_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+/// <summary>
+/// Hierarchical timer wheel for tracking tasks that should run at a later time.
+/// </summary>
+/// <remarks>
+/// Time is divided into one millisecond ticks. The first level of the wheel has a slot for each of the next 64
+/// ticks, and each higher level has slots that each cover 64 slots of the level below it. Scheduling a task
+/// places it in a slot based on how far in the future it is. When time reaches the start of a higher level
+/// slot, its tasks are redistributed to the lower levels. Scheduling and cancelling are constant time
+/// operations, and finding the next slot with work uses a bitmask of the occupied slots for each level.
+/// Not thread-safe.
+/// </remarks>
+class TimerWheel
+{
+public:
+    using TimerId = uint64_t;
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="TimerWheel" /> class.
+    /// </summary>
+    /// <param name="tStart">The time to measure ticks from.</param>
+    explicit TimerWheel(TimePoint tStart) noexcept : m_tStart(tStart) {}
+
+    /// <summary>
+    /// Schedules a task to be returned by <see cref="Advance" /> once <paramref name="tWhen" /> has been reached.
+    /// Tasks that are already due are returned on the next tick.
+    /// </summary>
+    /// <returns>Identifier that can be passed to <see cref="Cancel" />. Never zero.</returns>
+    TimerId Schedule(TimePoint tWhen, std::function<void()>&& fTask);
+
+    /// <summary>
+    /// Removes a task that hasn't been returned by <see cref="Advance" /> yet.
+    /// </summary>
+    /// <returns><c>true</c> if the task was removed, <c>false</c> if it was not found.</returns>
+    bool Cancel(TimerId nId);
+
+    /// <summary>
+    /// Advances the wheel to <paramref name="tNow" />, appending the tasks that are due to
+    /// <paramref name="vExpired" /> in the order they're due.
+    /// </summary>
+    void Advance(TimePoint tNow, std::vector<std::function<void()>>& vExpired);
+
+    /// <summary>
+    /// Gets the next time <see cref="Advance" /> needs to be called.
+    /// </summary>
+    /// <returns><c>false</c> if there are no scheduled tasks.</returns>
+    /// <remarks>
+    /// If all of the scheduled tasks are more than 64ms away, this returns the time when the next of them needs to be
+    /// moved to a lower level, which may be before any of them are due.
+    /// </remarks>
+    bool GetNextEventTime(TimePoint& tNext) const noexcept;
+
+    /// <summary>
+    /// Gets the number of scheduled tasks.
+    /// </summary>
+    size_t Count() const noexcept { return m_mTimers.size(); }
+
+private:
+    static constexpr unsigned int SlotBits = 6;
+    static constexpr unsigned int SlotsPerLevel = 1 << SlotBits;
+    static constexpr unsigned int NumLevels = 4;
+    static constexpr uint64_t SlotMask = SlotsPerLevel - 1;
+
+    struct Timer
+    {
+        uint64_t nTick = 0;
+        unsigned int nLevel = 0;
+        unsigned int nSlot = 0;
+        std::function<void()> fTask;
+    };
+
+    struct Slot
+    {
+        std::vector<TimerId> vTimers; // may contain cancelled timers
+        size_t nActive = 0;
+    };
+
+    struct Level
+    {
+        std::array<Slot, SlotsPerLevel> vSlots;
+        uint64_t nOccupied = 0; // bit set for each slot where nActive is non-zero
+    };
+
+    uint64_t ToTick(TimePoint tWhen, bool bRoundUp) const noexcept;
+    void Place(TimerId nId, Timer& pTimer);
+    void ProcessSlot(unsigned int nLevel, unsigned int nSlot, std::vector<std::function<void()>>* vExpired);
+    static unsigned int FindNextSlot(uint64_t nOccupied, unsigned int nStart) noexcept;
+
+    TimePoint m_tStart;
+    uint64_t m_nCurrentTick = 0; // the next tick to be processed
+    TimerId m_nNextId = 1;
+    std::array<Level, NumLevels> m_vLevels;
+    std::unordered_map<TimerId, Timer> m_mTimers;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_TIMER_WHEEL_HH
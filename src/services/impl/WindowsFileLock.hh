@@ -0,0 +1,55 @@
+#ifndef RA_SERVICES_WINDOWSFILELOCK
+#define RA_SERVICES_WINDOWSFILELOCK
+#pragma once
+
+#include "services\FileLock.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+class WindowsFileLock : public ra::services::FileLock
+{
+public:
+    explicit WindowsFileLock(const std::wstring& sFilename) noexcept
+    {
+        // the lock file is never read or written, so any process can open it. LockFileEx blocks until
+        // every other process has released its lock.
+        m_hFile = CreateFileW(sFilename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+            return;
+
+        OVERLAPPED pOverlapped{};
+        m_bLocked = (LockFileEx(m_hFile, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &pOverlapped) != FALSE);
+    }
+
+    ~WindowsFileLock() noexcept
+    {
+        if (m_bLocked)
+        {
+            OVERLAPPED pOverlapped{};
+            UnlockFileEx(m_hFile, 0, 1, 0, &pOverlapped);
+        }
+
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+    }
+
+    WindowsFileLock(const WindowsFileLock&) noexcept = delete;
+    WindowsFileLock& operator=(const WindowsFileLock&) noexcept = delete;
+    WindowsFileLock(WindowsFileLock&&) noexcept = delete;
+    WindowsFileLock& operator=(WindowsFileLock&&) noexcept = delete;
+
+    bool IsLocked() const noexcept { return m_bLocked; }
+
+private:
+    HANDLE m_hFile = INVALID_HANDLE_VALUE;
+    bool m_bLocked = false;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_WINDOWSFILELOCK
@@ -5,6 +5,8 @@
 
 #include "services\impl\FileTextReader.hh"
 #include "services\impl\FileTextWriter.hh"
+#include "services\impl\WindowsFileLock.hh"
+#include "services\impl\WindowsMappedFile.hh"
 
 #undef DeleteFile
 #undef MoveFile
@@ -80,12 +82,8 @@ bool WindowsFileSystem::CreateDirectory(const std::wstring& sDirectory) const no
     return (CreateDirectoryW(sAbsolutePath.c_str(), nullptr) != 0);
 }
 
-size_t WindowsFileSystem::GetFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const
+static size_t GetFilesInDirectory(const std::wstring& sSearchString, bool bNonEmptyOnly, _Inout_ std::vector<std::wstring>& vResults)
 {
-    std::wstring sBuffer;
-    std::wstring sSearchString = MakeAbsolute(sBuffer, sDirectory);
-    sSearchString += L"\\*";
-
     WIN32_FIND_DATAW ffdFile;
     HANDLE hFind = FindFirstFileW(sSearchString.c_str(), &ffdFile);
     if (hFind == INVALID_HANDLE_VALUE)
@@ -94,14 +92,37 @@ size_t WindowsFileSystem::GetFilesInDirectory(const std::wstring& sDirectory, _I
     const size_t nInitialSize = vResults.size();
     do
     {
-        if (!(ffdFile.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-            vResults.emplace_back(ffdFile.cFileName);
+        if (ffdFile.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            continue;
+
+        if (bNonEmptyOnly && ffdFile.nFileSizeLow == 0 && ffdFile.nFileSizeHigh == 0)
+            continue;
+
+        vResults.emplace_back(ffdFile.cFileName);
     } while (FindNextFileW(hFind, &ffdFile) != 0);
 
     FindClose(hFind);
     return vResults.size() - nInitialSize;
 }
 
+size_t WindowsFileSystem::GetFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const
+{
+    std::wstring sBuffer;
+    std::wstring sSearchString = MakeAbsolute(sBuffer, sDirectory);
+    sSearchString += L"\\*";
+
+    return ra::services::impl::GetFilesInDirectory(sSearchString, false, vResults);
+}
+
+size_t WindowsFileSystem::GetNonEmptyFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const
+{
+    std::wstring sBuffer;
+    std::wstring sSearchString = MakeAbsolute(sBuffer, sDirectory);
+    sSearchString += L"\\*";
+
+    return ra::services::impl::GetFilesInDirectory(sSearchString, true, vResults);
+}
+
 bool WindowsFileSystem::DeleteFile(const std::wstring& sPath) const noexcept
 {
     std::wstring sBuffer;
@@ -241,6 +262,35 @@ std::unique_ptr<TextWriter> WindowsFileSystem::AppendTextFile(const std::wstring
     return std::unique_ptr<TextWriter>(pWriter.release());
 }
 
+std::unique_ptr<MappedFile> WindowsFileSystem::MapFile(const std::wstring& sPath) const
+{
+    std::wstring sBuffer;
+    const auto& sAbsolutePath = MakeAbsolute(sBuffer, sPath);
+
+    // files that can't be mapped (empty files, large files in 32-bit builds) are expected to be streamed
+    // by the caller, so there's nothing worth logging
+    auto pMappedFile = std::make_unique<WindowsMappedFile>(sAbsolutePath);
+    if (!pMappedFile->IsMapped())
+        return std::unique_ptr<MappedFile>();
+
+    return std::unique_ptr<MappedFile>(pMappedFile.release());
+}
+
+std::unique_ptr<FileLock> WindowsFileSystem::LockFile(const std::wstring& sPath) const
+{
+    std::wstring sBuffer;
+    const auto& sAbsolutePath = MakeAbsolute(sBuffer, sPath);
+
+    auto pFileLock = std::make_unique<WindowsFileLock>(sAbsolutePath);
+    if (!pFileLock->IsLocked())
+    {
+        RA_LOG_WARN("Failed to lock \"%s\": %d", ra::Narrow(sPath).c_str(), GetLastError());
+        return std::unique_ptr<FileLock>();
+    }
+
+    return std::unique_ptr<FileLock>(pFileLock.release());
+}
+
 } // namespace impl
 } // namespace services
 } // namespace ra
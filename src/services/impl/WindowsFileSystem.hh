@@ -25,6 +25,8 @@ public:
     bool CreateDirectory(const std::wstring& sDirectory) const noexcept override;
     size_t GetFilesInDirectory(const std::wstring& sDirectory,
                                _Inout_ std::vector<std::wstring>& vResults) const override;
+    size_t GetNonEmptyFilesInDirectory(const std::wstring& sDirectory,
+                                       _Inout_ std::vector<std::wstring>& vResults) const override;
     bool DeleteFile(const std::wstring& sPath) const noexcept override;
     bool MoveFile(const std::wstring& sOldPath, const std::wstring& sNewPath) const noexcept override;
     bool CopyFile(const std::wstring& sSourcePath, const std::wstring& sNewPath) const noexcept override;
@@ -33,6 +35,8 @@ public:
     std::unique_ptr<TextReader> OpenTextFile(const std::wstring& sPath) const override;
     std::unique_ptr<TextWriter> CreateTextFile(const std::wstring& sPath) const override;
     std::unique_ptr<TextWriter> AppendTextFile(const std::wstring& sPath) const override;
+    std::unique_ptr<MappedFile> MapFile(const std::wstring& sPath) const override;
+    std::unique_ptr<FileLock> LockFile(const std::wstring& sPath) const override;
 
     std::wstring GetFileName(const std::wstring& sPath) const override;
     std::wstring GetExtension(const std::wstring& sPath) const override;
@@ -0,0 +1,77 @@
+#ifndef RA_SERVICES_WINDOWSMAPPEDFILE
+#define RA_SERVICES_WINDOWSMAPPEDFILE
+#pragma once
+
+#include "services\MappedFile.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+class WindowsMappedFile : public ra::services::MappedFile
+{
+public:
+    explicit WindowsMappedFile(const std::wstring& sFilename) noexcept
+    {
+        m_hFile = CreateFileW(sFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER nSize{};
+        if (!GetFileSizeEx(m_hFile, &nSize) || nSize.QuadPart == 0 ||
+            ra::to_unsigned(nSize.QuadPart) > MaxMappedSize)
+        {
+            // empty files cannot be mapped, and large files must be streamed
+            return;
+        }
+
+        m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_hMapping == nullptr)
+            return;
+
+        GSL_SUPPRESS_TYPE1 m_pData = static_cast<const uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_pData != nullptr)
+            m_nSize = gsl::narrow_cast<size_t>(nSize.QuadPart);
+    }
+
+    ~WindowsMappedFile() noexcept
+    {
+        if (m_pData != nullptr)
+            UnmapViewOfFile(m_pData);
+        if (m_hMapping != nullptr)
+            CloseHandle(m_hMapping);
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+    }
+
+    WindowsMappedFile(const WindowsMappedFile&) noexcept = delete;
+    WindowsMappedFile& operator=(const WindowsMappedFile&) noexcept = delete;
+    WindowsMappedFile(WindowsMappedFile&&) noexcept = delete;
+    WindowsMappedFile& operator=(WindowsMappedFile&&) noexcept = delete;
+
+    const uint8_t* GetData() const noexcept override { return m_pData; }
+    size_t GetSize() const noexcept override { return m_nSize; }
+
+    bool IsMapped() const noexcept { return m_pData != nullptr; }
+
+private:
+#ifdef _WIN64
+    static constexpr uint64_t MaxMappedSize = std::numeric_limits<size_t>::max();
+#else
+    // a 32-bit process shares its 2GB of address space with the emulator. mapping a multi-gigabyte
+    // file would fail or leave the emulator unable to allocate memory.
+    static constexpr uint64_t MaxMappedSize = 256 * 1024 * 1024;
+#endif
+
+    HANDLE m_hFile = INVALID_HANDLE_VALUE;
+    HANDLE m_hMapping = nullptr;
+    const uint8_t* m_pData = nullptr;
+    size_t m_nSize = 0;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_WINDOWSMAPPEDFILE
@@ -49,6 +49,16 @@ public:
     /// <param name="sName">Name of the image.</param>
     virtual void FetchImage(ImageType nType, const std::string& sName) = 0;
 
+    /// <summary>
+    /// Ensures a collection of images is available locally.
+    /// </summary>
+    /// <param name="nType">Type of the images.</param>
+    /// <param name="vNames">Names of the images, in the order they should be fetched.</param>
+    /// <param name="bPriority">
+    ///   <c>true</c> to fetch the images before any previously queued images that haven't started downloading.
+    /// </param>
+    virtual void FetchImages(ImageType nType, const std::vector<std::string>& vNames, bool bPriority) = 0;
+
     /// <summary>
     /// Store an image locally.
     /// </summary>
@@ -90,6 +100,7 @@ public:
         NotifyTarget& operator=(NotifyTarget&&) noexcept = default;
 
         virtual void OnImageChanged([[maybe_unused]] ImageType nType, [[maybe_unused]] const std::string& sName) noexcept(false) {}
+        virtual void OnImageFetchProgress([[maybe_unused]] size_t nCompleted, [[maybe_unused]] size_t nTotal) noexcept(false) {}
     };
 
     void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
@@ -109,6 +120,17 @@ protected:
         }
     }
 
+    void OnImageFetchProgress(size_t nCompleted, size_t nTotal)
+    {
+        // create a copy of the list of pointers in case it's modified by one of the callbacks
+        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
+        for (NotifyTarget* target : vNotifyTargets)
+        {
+            Expects(target != nullptr);
+            target->OnImageFetchProgress(nCompleted, nTotal);
+        }
+    }
+
 private:
     using NotifyTargetSet = std::set<NotifyTarget*>;
     NotifyTargetSet m_vNotifyTargets;
@@ -17,6 +17,50 @@ struct Size
     int Height{};
 };
 
+struct Rect
+{
+    int X{};
+    int Y{};
+    int Width{};
+    int Height{};
+
+    bool IsEmpty() const noexcept { return (Width <= 0 || Height <= 0); }
+
+    int Right() const noexcept { return X + Width; }
+    int Bottom() const noexcept { return Y + Height; }
+
+    bool Intersects(const Rect& rcOther) const noexcept
+    {
+        return !IsEmpty() && !rcOther.IsEmpty() &&
+            X < rcOther.Right() && rcOther.X < Right() &&
+            Y < rcOther.Bottom() && rcOther.Y < Bottom();
+    }
+
+    Rect Intersection(const Rect& rcOther) const noexcept
+    {
+        const int nLeft = std::max(X, rcOther.X);
+        const int nTop = std::max(Y, rcOther.Y);
+        const int nRight = std::min(Right(), rcOther.Right());
+        const int nBottom = std::min(Bottom(), rcOther.Bottom());
+        if (nRight <= nLeft || nBottom <= nTop)
+            return {};
+
+        return { nLeft, nTop, nRight - nLeft, nBottom - nTop };
+    }
+
+    Rect Union(const Rect& rcOther) const noexcept
+    {
+        if (IsEmpty())
+            return rcOther;
+        if (rcOther.IsEmpty())
+            return *this;
+
+        const int nLeft = std::min(X, rcOther.X);
+        const int nTop = std::min(Y, rcOther.Y);
+        return { nLeft, nTop, std::max(Right(), rcOther.Right()) - nLeft, std::max(Bottom(), rcOther.Bottom()) - nTop };
+    }
+};
+
 enum class FontStyles
 {
     Normal        = 0x00,
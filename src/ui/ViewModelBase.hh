@@ -5,6 +5,7 @@
 #include "ra_fwd.h"
 
 #include "data\ModelBase.hh"
+#include "data\NotifyTargetSet.hh"
 
 namespace ra {
 namespace ui {
@@ -31,19 +32,16 @@ public:
         virtual void OnViewModelIntValueChanged([[maybe_unused]] const IntModelProperty::ChangeArgs& args) noexcept(false) {}
     };
 
-    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
+    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Add(pTarget); }
 
     void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept
     {
 #ifdef RA_UTEST
         GSL_SUPPRESS_F6 Expects(!m_bDestructed);
 #endif
-        GSL_SUPPRESS_F6 m_vNotifyTargets.erase(&pTarget);
+        m_vNotifyTargets.Remove(pTarget);
     }
 
-private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
-
 protected:
     GSL_SUPPRESS_F6 ViewModelBase() = default;
 
@@ -72,11 +70,7 @@ protected:
     friend class ViewModelCollectionBase;
 
 private:
-    /// <summary>
-    /// A collection of pointers to other objects. These are not allocated object and do not need to be free'd. It's
-    /// impossible to create a set of <c>NotifyTarget</c> references.
-    /// </summary>
-    NotifyTargetSet m_vNotifyTargets;
+    ra::data::NotifyTargetSet<NotifyTarget> m_vNotifyTargets;
 };
 
 } // namespace ui
@@ -114,6 +114,37 @@ public:
     /// <param name="nAlpha">The new opacity (0.0-1.0).</param>
     virtual void SetOpacity(double fAlpha) = 0;
 
+    /// <summary>
+    /// Resets the specified regions to transparent.
+    /// </summary>
+    /// <param name="vRegions">The regions to clear.</param>
+    virtual void ClearRegions(const std::vector<ra::ui::Rect>& vRegions)
+    {
+        for (const auto& rcRegion : vRegions)
+            FillRectangle(rcRegion.X, rcRegion.Y, rcRegion.Width, rcRegion.Height, Color::Transparent);
+    }
+
+    /// <summary>
+    /// Draws the parts of a secondary surface that intersect the specified regions onto the surface.
+    /// </summary>
+    /// <param name="nX">The x coordinate to draw at.</param>
+    /// <param name="nY">The y coordinate to draw at.</param>
+    /// <param name="pSurface">The surface to draw.</param>
+    /// <param name="vRegions">The regions to redraw.</param>
+    virtual void DrawSurfaceRegions(int nX, int nY, const ISurface& pSurface, const std::vector<ra::ui::Rect>& vRegions)
+    {
+        const ra::ui::Rect rcSurface{ nX, nY, ra::to_signed(pSurface.GetWidth()), ra::to_signed(pSurface.GetHeight()) };
+        for (const auto& rcRegion : vRegions)
+        {
+            const auto rcVisible = rcSurface.Intersection(rcRegion);
+            if (!rcVisible.IsEmpty())
+            {
+                DrawSurface(rcVisible.X, rcVisible.Y, pSurface, rcVisible.X - nX, rcVisible.Y - nY,
+                    rcVisible.Width, rcVisible.Height);
+            }
+        }
+    }
+
 protected:
     ISurface() noexcept = default;
 };
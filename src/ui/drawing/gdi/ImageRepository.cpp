@@ -64,14 +64,17 @@ bool ImageRepository::Initialize()
 
 ImageRepository::~ImageRepository() noexcept
 {
-    // clean up anything that's still referenced
-    for (auto& badge : m_mBadges)
-        DeleteBitmap(badge.second.m_hBitmap);
-    m_mBadges.clear();
-
-    for (auto& userPic : m_mUserPics)
-        DeleteBitmap(userPic.second.m_hBitmap);
-    m_mUserPics.clear();
+    // clean up anything that's still cached
+    for (auto* mMap : { &m_mBadges, &m_mUserPics, &m_mLocal, &m_mIcons })
+    {
+        for (auto& pImage : *mMap)
+        {
+            if (pImage.second.m_hBitmap)
+                DeleteBitmap(pImage.second.m_hBitmap);
+        }
+        mMap->clear();
+    }
+    m_vLru.clear();
 
     if (g_pIWICFactory != nullptr)
         g_pIWICFactory->Release();
@@ -140,7 +143,11 @@ bool ImageRepository::IsImageAvailable(ImageType nType, const std::string& sName
         std::lock_guard<std::mutex> lock(m_oMutex);
         const HBitmapMap::iterator iter = mMap->find(sName);
         if (iter != mMap->end())
-            return true;
+        {
+            // an image that failed to decode won't become available by waiting for it, so
+            // only report images that are still being decoded as unavailable.
+            return !iter->second.m_bDecoding;
+        }
     }
 
     std::wstring sFilename = GetFilename(nType, sName);
@@ -151,7 +158,18 @@ bool ImageRepository::IsImageAvailable(ImageType nType, const std::string& sName
     }
 
     const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    return (pFileSystem.GetFileSize(sFilename) > 0);
+    if (pFileSystem.GetFileSize(sFilename) <= 0)
+        return false;
+
+    // local images are decoded synchronously when requested
+    if (nType == ImageType::Local)
+        return true;
+
+    // other images are decoded in the background. the file may not have been decoded yet, or may have been
+    // evicted from the cache. start decoding it so the caller isn't waiting for something that won't happen.
+    // a notification will be raised when it's available.
+    GSL_SUPPRESS_TYPE3 const_cast<ImageRepository*>(this)->BeginDecode(nType, sName, sFilename);
+    return false;
 }
 
 void ImageRepository::FetchImage(ImageType nType, const std::string& sName)
@@ -164,20 +182,62 @@ void ImageRepository::FetchImage(ImageType nType, const std::string& sName)
     if (pFileSystem.GetFileSize(sFilename) > 0)
         return;
 
-    // check to see if it's already queued
+    // an individually requested image is typically needed for display right now, so put it at
+    // the front of the queue.
+    std::vector<PendingFetch> vFetches;
+    vFetches.push_back({ nType, sName, std::move(sFilename) });
+    QueueFetches(std::move(vFetches), true);
+}
+
+void ImageRepository::FetchImages(ImageType nType, const std::vector<std::string>& vNames, bool bPriority)
+{
+    if (vNames.empty())
+        return;
+
+    // use a single directory listing to determine which images are already available instead
+    // of checking each file individually. a failed download may have left an empty file behind,
+    // so only files with content are considered available. images in subdirectories
+    // (i.e. "local\") are not in the listing and will be checked individually.
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    std::wstring sDirectory = GetFilename(nType, "_");
+    sDirectory.resize(sDirectory.find_last_of(L'\\') + 1);
+
+    std::vector<std::wstring> vFiles;
+    pFileSystem.GetNonEmptyFilesInDirectory(sDirectory, vFiles);
+    const std::set<std::wstring> vAvailableFiles(vFiles.begin(), vFiles.end());
+
+    std::vector<PendingFetch> vFetches;
+    std::set<std::string> vQueuedNames;
+    for (const auto& sName : vNames)
     {
-        std::lock_guard<std::mutex> lock(m_oMutex);
-        if (m_vRequestedImages.find(sFilename) != m_vRequestedImages.end())
-            return;
+        if (sName.empty() || !vQueuedNames.insert(sName).second)
+            continue;
+
+        std::wstring sFilename = GetFilename(nType, sName);
+        const bool bInDirectory = sFilename.length() > sDirectory.length() &&
+            sFilename.compare(0, sDirectory.length(), sDirectory) == 0 &&
+            sFilename.find(L'\\', sDirectory.length()) == std::wstring::npos;
 
-        m_vRequestedImages.emplace(sFilename);
+        if (bInDirectory)
+        {
+            if (vAvailableFiles.find(sFilename.substr(sDirectory.length())) != vAvailableFiles.end())
+                continue;
+        }
+        else if (pFileSystem.GetFileSize(sFilename) > 0)
+        {
+            continue;
+        }
+
+        vFetches.push_back({ nType, sName, std::move(sFilename) });
     }
 
+    QueueFetches(std::move(vFetches), bPriority);
+}
+
+std::string ImageRepository::GetImageUrl(ImageType nType, const std::string& sName)
+{
     const auto& pConfiguration = ra::services::ServiceLocator::Get<ra::services::IConfiguration>();
-    if (pConfiguration.IsFeatureEnabled(ra::services::Feature::Offline))
-        return;
 
-    // fetch it
     std::string sUrl;
     switch (nType)
     {
@@ -195,35 +255,125 @@ void ImageRepository::FetchImage(ImageType nType, const std::string& sName)
             break;
         default:
             Expects(!"Unsupported image type");
-            return;
+            return sUrl;
     }
     sUrl += sName;
     sUrl += ".png";
 
-    RA_LOG_INFO("Downloading %s", sUrl.c_str());
+    return sUrl;
+}
+
+void ImageRepository::QueueFetches(std::vector<PendingFetch>&& vFetches, bool bPriority)
+{
+    if (vFetches.empty())
+        return;
+
+    const auto& pConfiguration = ra::services::ServiceLocator::Get<ra::services::IConfiguration>();
+    const bool bOffline = pConfiguration.IsFeatureEnabled(ra::services::Feature::Offline);
 
-    ra::services::Http::Request request(sUrl);
-    request.DownloadAsync(sFilename, [this,sFilename,sUrl,nType,sName](const ra::services::Http::Response& response)
     {
-        if (response.StatusCode() == ra::services::Http::StatusCode::OK)
-        {
-            auto nFileSize = ra::services::ServiceLocator::Get<ra::services::IFileSystem>().GetFileSize(sFilename);
-            RA_LOG_INFO("Wrote %lu bytes to %s", nFileSize, ra::Narrow(sFilename).c_str());
+        std::lock_guard<std::mutex> lock(m_oMutex);
 
-            // only remove the image from the request queue if successful. prevents repeated requests
-            {
-                std::lock_guard<std::mutex> lock(m_oMutex);
-                m_vRequestedImages.erase(sFilename);
-            }
+        // ignore anything that's already queued
+        std::vector<PendingFetch> vNewFetches;
+        vNewFetches.reserve(vFetches.size());
+        for (auto& pFetch : vFetches)
+        {
+            if (m_vRequestedImages.insert(pFetch.sFilename).second)
+                vNewFetches.push_back(std::move(pFetch));
         }
-        else
+
+        // when offline, the images are flagged as requested (so they aren't probed again),
+        // but not actually downloaded
+        if (vNewFetches.empty() || bOffline)
+            return;
+
+        m_nTotalFetches += vNewFetches.size();
+
+        const auto pInsertAt = bPriority ? m_vPendingFetches.begin() : m_vPendingFetches.end();
+        m_vPendingFetches.insert(pInsertAt, std::make_move_iterator(vNewFetches.begin()),
+                                 std::make_move_iterator(vNewFetches.end()));
+    }
+
+    StartPendingFetches();
+}
+
+void ImageRepository::StartPendingFetches()
+{
+    // only allow a few downloads at a time so the thread pool isn't flooded and
+    // higher priority requests can jump ahead of the ones that haven't started yet
+    std::vector<PendingFetch> vFetches;
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+        while (m_nActiveFetches < MAX_CONCURRENT_FETCHES && !m_vPendingFetches.empty())
         {
-            RA_LOG_WARN("Error %u fetching %s", response.StatusCode(), sUrl.c_str());
-            ra::services::ServiceLocator::Get<ra::services::IFileSystem>().DeleteFile(sFilename);
+            vFetches.push_back(std::move(m_vPendingFetches.front()));
+            m_vPendingFetches.pop_front();
+            ++m_nActiveFetches;
         }
+    }
 
-        OnImageChanged(nType, sName);
-    });
+    for (auto& pFetch : vFetches)
+    {
+        const auto sUrl = GetImageUrl(pFetch.nType, pFetch.sName);
+        RA_LOG_INFO("Downloading %s", sUrl.c_str());
+
+        ra::services::Http::Request request(sUrl);
+        request.DownloadAsync(pFetch.sFilename,
+            [this, sFilename = pFetch.sFilename, sUrl, nType = pFetch.nType, sName = pFetch.sName]
+            (const ra::services::Http::Response& response)
+        {
+            if (response.StatusCode() == ra::services::Http::StatusCode::OK)
+            {
+                auto nFileSize = ra::services::ServiceLocator::Get<ra::services::IFileSystem>().GetFileSize(sFilename);
+                RA_LOG_INFO("Wrote %lu bytes to %s", nFileSize, ra::Narrow(sFilename).c_str());
+
+                // only remove the image from the request queue if successful. prevents repeated requests
+                {
+                    std::lock_guard<std::mutex> lock(m_oMutex);
+                    m_vRequestedImages.erase(sFilename);
+
+                    // if a previous copy of the file couldn't be decoded, try again with the new copy
+                    HBitmapMap* mMap = GetBitmapMap(nType);
+                    if (mMap != nullptr)
+                    {
+                        const HBitmapMap::iterator iter = mMap->find(sName);
+                        if (iter != mMap->end() && iter->second.m_bDecodeFailed)
+                            mMap->erase(iter);
+                    }
+                }
+            }
+            else
+            {
+                RA_LOG_WARN("Error %u fetching %s", response.StatusCode(), sUrl.c_str());
+                ra::services::ServiceLocator::Get<ra::services::IFileSystem>().DeleteFile(sFilename);
+            }
+
+            OnImageChanged(nType, sName);
+            OnFetchCompleted();
+        });
+    }
+}
+
+void ImageRepository::OnFetchCompleted()
+{
+    size_t nCompleted = 0;
+    size_t nTotal = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+        --m_nActiveFetches;
+        nCompleted = ++m_nCompletedFetches;
+        nTotal = m_nTotalFetches;
+
+        // reset the progress counters once everything has been fetched
+        if (m_nActiveFetches == 0 && m_vPendingFetches.empty())
+            m_nCompletedFetches = m_nTotalFetches = 0;
+    }
+
+    OnImageFetchProgress(nCompleted, nTotal);
+
+    if (!ra::services::ServiceLocator::Get<ra::services::IThreadPool>().IsShutdownRequested())
+        StartPendingFetches();
 }
 
 std::string ImageRepository::StoreImage(ImageType nType, const std::wstring& sPath)
@@ -260,10 +410,13 @@ HBITMAP ImageRepository::GetDefaultImage(ImageType nType)
     {
         case ImageType::Badge:
         case ImageType::Icon:
-            return GetImage(ImageType::Badge, DefaultBadge);
+            return GetImage(ImageType::Badge, DefaultBadge, false);
 
         case ImageType::UserPic:
-            return GetImage(ImageType::UserPic, DefaultUserPic);
+            return GetImage(ImageType::UserPic, DefaultUserPic, false);
+
+        case ImageType::Local:
+            return nullptr;
 
         default:
             Expects(!"Unsupported image type");
@@ -323,28 +476,46 @@ static HRESULT ConvertBitmapSource(_In_ RECT rcDest, _In_ IWICBitmapSource* pOri
     return hr;
 }
 
-static HRESULT CreateDIBFromBitmapSource(_In_ IWICBitmapSource* pToRenderBitmapSource,
-                                         _Inout_ HBITMAP& hBitmapInOut)
+static HRESULT CopyPixelsFromBitmapSource(_In_ IWICBitmapSource* pToRenderBitmapSource,
+                                          _Out_ UINT& nWidth, _Out_ UINT& nHeight,
+                                          _Inout_ std::vector<uint32_t>& vPixels)
 {
     Expects(pToRenderBitmapSource != nullptr);
-    // Get BitmapSource format and size
-    WICPixelFormatGUID pixelFormat{};
-    UINT nWidth = 0U;
-    UINT nHeight = 0U;
+    nWidth = 0U;
+    nHeight = 0U;
 
-    auto hr = pToRenderBitmapSource->GetPixelFormat(&pixelFormat);
+    auto hr = pToRenderBitmapSource->GetSize(&nWidth, &nHeight);
+
+    // Size of a scan line represented in bytes: 4 bytes each pixel
+    UINT cbStride = 0U;
     if (SUCCEEDED(hr))
-        hr = pToRenderBitmapSource->GetSize(&nWidth, &nHeight);
+        hr = UIntMult(nWidth, sizeof(UINT), &cbStride);
 
-    if (FAILED(hr))
-        return hr;
+    // Size of the image, represented in bytes
+    UINT cbImage = 0U;
+    if (SUCCEEDED(hr))
+        hr = UIntMult(cbStride, nHeight, &cbImage);
 
+    // Extract the image into the pixel buffer
+    if (SUCCEEDED(hr))
+    {
+        vPixels.resize(gsl::narrow_cast<size_t>(nWidth) * nHeight);
+
+        GSL_SUPPRESS_TYPE1
+        hr = pToRenderBitmapSource->CopyPixels(nullptr, cbStride, cbImage, reinterpret_cast<BYTE*>(vPixels.data()));
+    }
+
+    return hr;
+}
+
+HBITMAP ImageRepository::CreateHBitmap(const DecodedImage& pImage)
+{
     // Create a DIB section based on Bitmap Info
     // BITMAPINFO Struct must first be setup before a DIB can be created.
     // Note that the height is negative for top-down bitmaps
     BITMAPINFOHEADER info_header{sizeof(BITMAPINFOHEADER), // biSize
-                                 to_signed(nWidth),
-                                 -to_signed(nHeight),
+                                 to_signed(pImage.nWidth),
+                                 -to_signed(pImage.nHeight),
                                  WORD{1},  // biPlanes
                                  WORD{32}, // biBitCount
                                  DWORD{BI_RGB}};
@@ -356,61 +527,30 @@ static HRESULT CreateDIBFromBitmapSource(_In_ IWICBitmapSource* pToRenderBitmapS
         hWindow = GetParent(hWindow);
 
     // Get a DC for the full screen
+    HBITMAP hBitmap = nullptr;
     auto hdcScreen = GetDC(hWindow);
     if (hdcScreen)
     {
-        // Release the previously allocated bitmap 
-        if (hBitmapInOut)
-            DeleteBitmap(hBitmapInOut);
-
-        //	TBD: check this. As a handle this should just be as-is, right?
-        hBitmapInOut = CreateDIBSection(hdcScreen, &bminfo, DIB_RGB_COLORS, &pvImageBits, nullptr, DWORD{});
-
+        hBitmap = CreateDIBSection(hdcScreen, &bminfo, DIB_RGB_COLORS, &pvImageBits, nullptr, DWORD{});
         ReleaseDC(nullptr, hdcScreen);
-
-        hr = hBitmapInOut ? S_OK : E_FAIL;
     }
 
-    // Size of a scan line represented in bytes: 4 bytes each pixel
-    UINT cbStride = 0U;
-    if (SUCCEEDED(hr))
-        hr = UIntMult(nWidth, sizeof(UINT), &cbStride);
-
-    // Size of the image, represented in bytes
-    UINT cbImage = 0U;
-    if (SUCCEEDED(hr))
-        hr = UIntMult(cbStride, nHeight, &cbImage);
-
-    // Extract the image into the HBITMAP    
-    if (SUCCEEDED(hr) && pvImageBits)
-    {
-        hr = pToRenderBitmapSource->CopyPixels(
-            //hr = IWICBitmapSource_CopyPixels( pToRenderBitmapSource,
-            nullptr,
-            cbStride,
-            cbImage,
-            static_cast<BYTE*>(pvImageBits));
-    }
+    if (hBitmap && pvImageBits)
+        memcpy(pvImageBits, pImage.vPixels.data(), pImage.vPixels.size() * sizeof(uint32_t));
 
-    // Image Extraction failed, clear allocated memory
-    if (FAILED(hr) && hBitmapInOut)
-    {
-        DeleteBitmap(hBitmapInOut);
-        hBitmapInOut = nullptr;
-    }
-
-    return hr;
+    return hBitmap;
 }
 
 GSL_SUPPRESS_F23
-HBITMAP ImageRepository::LoadLocalPNG(const std::wstring& sFilename, unsigned int nWidth, unsigned int nHeight)
+std::unique_ptr<ImageRepository::DecodedImage> ImageRepository::DecodeImage(const std::wstring& sFilename,
+                                                                            unsigned int nWidth, unsigned int nHeight) const
 {
     if (g_pIWICFactory == nullptr)
         return nullptr;
 
     // Decode the source image to IWICBitmapSource
     IWICBitmapDecoder* pDecoder = nullptr;
-    HRESULT hr = g_pIWICFactory->CreateDecoderFromFilename(ra::Widen(sFilename).c_str(), // Image to be decoded
+    HRESULT hr = g_pIWICFactory->CreateDecoderFromFilename(sFilename.c_str(), // Image to be decoded
                                                            nullptr,      // Do not prefer a particular vendor
                                                            GENERIC_READ, // Desired read access to the file
                                                            WICDecodeMetadataCacheOnDemand, // Cache metadata when needed
@@ -440,10 +580,11 @@ HBITMAP ImageRepository::LoadLocalPNG(const std::wstring& sFilename, unsigned in
         hr = ConvertBitmapSource({0, 0, to_signed(nWidth), to_signed(nHeight)}, pOriginalBitmapSource,
                                  *&pToRenderBitmapSource);
 
-    // Create a DIB from the converted IWICBitmapSource
-    HBITMAP hBitmap = nullptr;
+    // Copy the converted IWICBitmapSource into memory
+    auto pDecodedImage = std::make_unique<DecodedImage>();
     if (SUCCEEDED(hr))
-        hr = CreateDIBFromBitmapSource(pToRenderBitmapSource, hBitmap);
+        hr = CopyPixelsFromBitmapSource(pToRenderBitmapSource, pDecodedImage->nWidth, pDecodedImage->nHeight,
+                                        pDecodedImage->vPixels);
 
     if (pToRenderBitmapSource != nullptr)
         pToRenderBitmapSource->Release();
@@ -457,7 +598,10 @@ HBITMAP ImageRepository::LoadLocalPNG(const std::wstring& sFilename, unsigned in
     if (pDecoder != nullptr)
         pDecoder->Release();
 
-    return hBitmap;
+    if (FAILED(hr))
+        return nullptr;
+
+    return pDecodedImage;
 }
 
 ImageRepository::HBitmapMap* ImageRepository::GetBitmapMap(ImageType nType) noexcept
@@ -482,7 +626,20 @@ ImageRepository::HBitmapMap* ImageRepository::GetBitmapMap(ImageType nType) noex
     }
 }
 
-HBITMAP ImageRepository::GetImage(ImageType nType, const std::string& sName)
+static bool IsDefaultImage(ImageType nType, const std::string& sName)
+{
+    switch (nType)
+    {
+        case ImageType::Badge:
+            return (sName == DefaultBadge);
+        case ImageType::UserPic:
+            return (sName == DefaultUserPic);
+        default:
+            return false;
+    }
+}
+
+HBITMAP ImageRepository::GetImage(ImageType nType, const std::string& sName, bool bAddReference)
 {
     if (sName.empty())
         return nullptr;
@@ -496,7 +653,37 @@ HBITMAP ImageRepository::GetImage(ImageType nType, const std::string& sName)
 
         const HBitmapMap::iterator iter = mMap->find(sName);
         if (iter != mMap->end())
-            return iter->second.m_hBitmap;
+        {
+            auto& pImage = iter->second;
+            if (pImage.m_bDecoding || pImage.m_bDecodeFailed)
+                return nullptr;
+
+            // the HBITMAP isn't created until the first time the image is rendered
+            if (pImage.m_hBitmap == nullptr && pImage.m_pDecodedImage != nullptr)
+            {
+                pImage.m_hBitmap = CreateHBitmap(*pImage.m_pDecodedImage);
+                pImage.m_pDecodedImage.reset();
+            }
+
+            if (pImage.m_hBitmap != nullptr)
+            {
+                ++m_nCacheHits;
+
+                if (bAddReference)
+                {
+                    if (pImage.m_nReferences++ == 0)
+                        RemoveFromLru(pImage);
+                }
+                else if (pImage.m_bInLru)
+                {
+                    m_vLru.splice(m_vLru.begin(), m_vLru, pImage.m_pLruEntry);
+                }
+
+                return pImage.m_hBitmap;
+            }
+        }
+
+        ++m_nCacheMisses;
     }
 
     std::wstring sFilename = GetFilename(nType, sName);
@@ -508,21 +695,184 @@ HBITMAP ImageRepository::GetImage(ImageType nType, const std::string& sName)
         return nullptr;
     }
 
-    const unsigned int nSize = (nType == ImageType::Local) ? 0 : 64;
-    HBITMAP hBitmap = LoadLocalPNG(sFilename, nSize, nSize);
+    if (nType != ImageType::Local)
+    {
+        // decode the image in the background. OnImageChanged will be raised when it's ready.
+        BeginDecode(nType, sName, sFilename);
+        return nullptr;
+    }
+
+    // local images are typically large one-off images (like the overlay background), whose
+    // consumers expect them to be immediately available.
+    auto pDecodedImage = DecodeImage(sFilename, 0, 0);
+    if (pDecodedImage == nullptr)
+        return nullptr;
+
+    HBITMAP hBitmap = CreateHBitmap(*pDecodedImage);
     if (hBitmap != nullptr)
     {
         std::lock_guard<std::mutex> lock(m_oMutex);
 
-        // bracket operator appears to be the only way to add an item to the map since
-        // std::atomic deleted its move and copy constructors.
-        auto& item = (*mMap)[sName];
-        item.m_hBitmap = hBitmap;
+        auto& pImage = (*mMap)[sName];
+        if (pImage.m_hBitmap != nullptr)
+        {
+            // another thread loaded the image while we were decoding it. use the other copy.
+            DeleteBitmap(hBitmap);
+            hBitmap = pImage.m_hBitmap;
+        }
+        else
+        {
+            pImage.m_hBitmap = hBitmap;
+            pImage.m_nBytes = pDecodedImage->vPixels.size() * sizeof(uint32_t);
+            m_nCacheBytesUsed += pImage.m_nBytes;
+        }
+
+        if (bAddReference)
+        {
+            if (pImage.m_nReferences++ == 0)
+                RemoveFromLru(pImage);
+        }
+        else if (pImage.m_nReferences == 0 && !pImage.m_bInLru)
+        {
+            AddToLru(nType, sName, pImage);
+            EvictImages();
+        }
     }
 
     return hBitmap;
 }
 
+void ImageRepository::BeginDecode(ImageType nType, const std::string& sName, const std::wstring& sFilename)
+{
+    HBitmapMap* mMap = GetBitmapMap(nType);
+    if (mMap == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+
+        // if the image is already loaded, or being decoded, there's nothing to do
+        if (mMap->find(sName) != mMap->end())
+            return;
+
+        auto& pImage = (*mMap)[sName];
+        pImage.m_bDecoding = true;
+        pImage.m_bPermanent = IsDefaultImage(nType, sName);
+    }
+
+    const unsigned int nSize = (nType == ImageType::Local) ? 0 : 64;
+    auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+    pThreadPool.RunAsync([this, nType, sName, sFilename, nSize]()
+    {
+        OnDecodeCompleted(nType, sName, DecodeImage(sFilename, nSize, nSize));
+    });
+}
+
+void ImageRepository::OnDecodeCompleted(ImageType nType, const std::string& sName, std::unique_ptr<DecodedImage>&& pDecodedImage)
+{
+    HBitmapMap* mMap = GetBitmapMap(nType);
+    if (mMap == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_oMutex);
+
+        const HBitmapMap::iterator iter = mMap->find(sName);
+        if (iter == mMap->end())
+            return;
+
+        if (pDecodedImage == nullptr)
+        {
+            // decode failed. remember the failure so the file isn't decoded again every time the image
+            // is requested. it will be attempted again if the file is downloaded again.
+            RA_LOG_WARN("Failed to decode %s", sName.c_str());
+            iter->second.m_bDecoding = false;
+            iter->second.m_bDecodeFailed = true;
+        }
+        else
+        {
+            auto& pImage = iter->second;
+            pImage.m_bDecoding = false;
+            pImage.m_nBytes = pDecodedImage->vPixels.size() * sizeof(uint32_t);
+            pImage.m_pDecodedImage = std::move(pDecodedImage);
+            m_nCacheBytesUsed += pImage.m_nBytes;
+
+            if (pImage.m_nReferences == 0)
+            {
+                AddToLru(nType, sName, pImage);
+                EvictImages();
+            }
+        }
+    }
+
+    OnImageChanged(nType, sName);
+}
+
+void ImageRepository::AddToLru(ImageType nType, const std::string& sName, CachedImage& pImage)
+{
+    if (pImage.m_bPermanent || pImage.m_bInLru)
+        return;
+
+    m_vLru.emplace_front(nType, sName);
+    pImage.m_pLruEntry = m_vLru.begin();
+    pImage.m_bInLru = true;
+}
+
+void ImageRepository::RemoveFromLru(CachedImage& pImage) noexcept
+{
+    if (pImage.m_bInLru)
+    {
+        m_vLru.erase(pImage.m_pLruEntry);
+        pImage.m_bInLru = false;
+    }
+}
+
+void ImageRepository::EvictImages() noexcept
+{
+    // only unreferenced images are in the LRU list, so anything in it can be evicted
+    while (m_nCacheBytesUsed > m_nCacheBudget && !m_vLru.empty())
+    {
+        const auto& pEntry = m_vLru.back();
+        HBitmapMap* mMap = GetBitmapMap(pEntry.first);
+        if (mMap != nullptr)
+        {
+            const HBitmapMap::iterator iter = mMap->find(pEntry.second);
+            if (iter != mMap->end())
+            {
+                if (iter->second.m_hBitmap != nullptr)
+                    DeleteBitmap(iter->second.m_hBitmap);
+
+                m_nCacheBytesUsed -= iter->second.m_nBytes;
+                mMap->erase(iter);
+                ++m_nCacheEvictions;
+            }
+        }
+
+        m_vLru.pop_back();
+    }
+}
+
+ImageRepository::CacheStatistics ImageRepository::GetCacheStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+
+    CacheStatistics pStatistics;
+    pStatistics.nHits = m_nCacheHits;
+    pStatistics.nMisses = m_nCacheMisses;
+    pStatistics.nEvictions = m_nCacheEvictions;
+    pStatistics.nImages = m_mBadges.size() + m_mUserPics.size() + m_mLocal.size() + m_mIcons.size();
+    pStatistics.nBytesUsed = m_nCacheBytesUsed;
+    pStatistics.nBytesBudget = m_nCacheBudget;
+    return pStatistics;
+}
+
+void ImageRepository::SetCacheBudget(size_t nBytes)
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+    m_nCacheBudget = nBytes;
+    EvictImages();
+}
+
 HBITMAP ImageRepository::GetHBitmap(const ImageReference& pImage)
 {
     HBITMAP hBitmap{};
@@ -533,14 +883,12 @@ HBITMAP ImageRepository::GetHBitmap(const ImageReference& pImage)
         auto pImageRepository = dynamic_cast<ImageRepository*>(&ra::services::ServiceLocator::GetMutable<IImageRepository>());
         if (pImageRepository != nullptr)
         {
-            hBitmap = pImageRepository->GetImage(pImage.Type(), pImage.Name());
+            // ImageReference will release the reference
+            hBitmap = pImageRepository->GetImage(pImage.Type(), pImage.Name(), true);
             if (hBitmap == nullptr)
                 return pImageRepository->GetDefaultImage(pImage.Type());
 
             GSL_SUPPRESS_TYPE1 pImage.m_nData = reinterpret_cast<unsigned long long>(hBitmap);
-
-            // ImageReference will release the reference
-            pImageRepository->AddReference(pImage);
         }
     }
 
@@ -562,7 +910,10 @@ void ImageRepository::AddReference(const ImageReference& pImage)
         const HBitmapMap::iterator iter = mMap->find(pImage.Name());
         Expects(iter != mMap->end()); // AddReference should only be called if an HBITMAP exists, which will be in the map
         if (iter != mMap->end())
-            ++iter->second.m_nReferences;
+        {
+            if (iter->second.m_nReferences++ == 0)
+                RemoveFromLru(iter->second);
+        }
     }
 }
 
@@ -578,15 +929,13 @@ void ImageRepository::ReleaseReference(ImageReference& pImage) noexcept
         std::lock_guard<std::mutex> lock(m_oMutex);
 
         const HBitmapMap::iterator iter = mMap->find(pImage.Name());
-
-        if(iter != mMap->end())
+        if (iter != mMap->end() && iter->second.m_nReferences > 0)
         {
-            HBITMAP hBitmap = iter->second.m_hBitmap;
-
-            if(--iter->second.m_nReferences == 0)
+            // unreferenced images stay in memory until the cache budget is exceeded
+            if (--iter->second.m_nReferences == 0)
             {
-                mMap->erase(iter);
-                DeleteObject(hBitmap);
+                GSL_SUPPRESS_F6 AddToLru(pImage.Type(), pImage.Name(), iter->second);
+                EvictImages();
             }
         }
     }
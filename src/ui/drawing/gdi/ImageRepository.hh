@@ -11,15 +11,37 @@ namespace gdi {
 
 class ImageRepository : public IImageRepository
 {
-    struct HBitmapReference
+protected:
+    /// <summary>
+    /// A decoded image that has not been converted to an <see cref="HBITMAP" /> yet.
+    /// </summary>
+    struct DecodedImage
+    {
+        unsigned int nWidth{};
+        unsigned int nHeight{};
+        std::vector<uint32_t> vPixels; // 32-bit pixels, same layout as ra::ui::Color
+    };
+
+private:
+    using LruList = std::list<std::pair<ImageType, std::string>>;
+
+    struct CachedImage
     {
         HBITMAP m_hBitmap{};
-        std::atomic<unsigned int> m_nReferences;
+        std::unique_ptr<DecodedImage> m_pDecodedImage;
+        size_t m_nBytes{};
+        unsigned int m_nReferences{};
+        bool m_bDecoding{};
+        bool m_bDecodeFailed{};
+        bool m_bPermanent{};
+        bool m_bInLru{};
+        LruList::iterator m_pLruEntry;
     };
 
-    using HBitmapMap = std::unordered_map<std::string, HBitmapReference>;
+    using HBitmapMap = std::unordered_map<std::string, CachedImage>;
 public:
     ImageRepository() noexcept(std::is_nothrow_default_constructible_v<HBitmapMap> &&
+                               std::is_nothrow_default_constructible_v<LruList> &&
                                std::is_nothrow_default_constructible_v<std::set<std::wstring>>) = default;
     GSL_SUPPRESS_F6 ~ImageRepository() noexcept;
     ImageRepository(const ImageRepository&) = delete;
@@ -37,9 +59,14 @@ public:
     /// </summary>
     static HBITMAP GetHBitmap(const ImageReference& pImage);
 
+    /// <remarks>
+    /// If the image file exists but hasn't been decoded (or was evicted from the cache), it's decoded in the
+    /// background and a notification is raised when it becomes available.
+    /// </remarks>
     bool IsImageAvailable(ImageType nType, const std::string& sName) const override;
 
     void FetchImage(ImageType nType, const std::string& sName) override;
+    void FetchImages(ImageType nType, const std::vector<std::string>& vNames, bool bPriority) override;
     std::string StoreImage(ImageType nType, const std::wstring& sPath) override;
 
     void AddReference(const ImageReference& pImage) override;
@@ -49,10 +76,44 @@ public:
 
     std::wstring GetFilename(ImageType nType, const std::string& sName) const override;
 
-private:
-    static HBITMAP LoadLocalPNG(const std::wstring& sFilename, unsigned int nWidth, unsigned int nHeight);
+    struct CacheStatistics
+    {
+        size_t nHits{};
+        size_t nMisses{};
+        size_t nEvictions{};
+        size_t nImages{};
+        size_t nBytesUsed{};
+        size_t nBytesBudget{};
+    };
+
+    /// <summary>
+    /// Gets statistics about the decoded image cache.
+    /// </summary>
+    CacheStatistics GetCacheStatistics() const;
 
-    HBITMAP GetImage(ImageType nType, const std::string& sName);
+    /// <summary>
+    /// Sets the maximum number of bytes of unreferenced decoded images to keep in memory.
+    /// </summary>
+    /// <remarks>Referenced images are never evicted, so memory use may exceed the budget.</remarks>
+    void SetCacheBudget(size_t nBytes);
+
+protected:
+    /// <summary>
+    /// Decodes an image file, scaling it to the requested size. If either dimension is 0, the image is not scaled.
+    /// </summary>
+    /// <returns>The decoded image, or <c>nullptr</c> if the file could not be decoded.</returns>
+    virtual std::unique_ptr<DecodedImage> DecodeImage(const std::wstring& sFilename, unsigned int nWidth, unsigned int nHeight) const;
+
+private:
+    static HBITMAP CreateHBitmap(const DecodedImage& pImage);
+
+    HBITMAP GetImage(ImageType nType, const std::string& sName, bool bAddReference);
+    void BeginDecode(ImageType nType, const std::string& sName, const std::wstring& sFilename);
+    void OnDecodeCompleted(ImageType nType, const std::string& sName, std::unique_ptr<DecodedImage>&& pDecodedImage);
+    void AddToLru(ImageType nType, const std::string& sName, CachedImage& pImage);
+    void RemoveFromLru(CachedImage& pImage) noexcept;
+    void EvictImages() noexcept;
+    static std::string GetImageUrl(ImageType nType, const std::string& sName);
     HBITMAP GetDefaultImage(ImageType nType);
 
     HBitmapMap m_mBadges;
@@ -64,6 +125,31 @@ private:
 
     mutable std::mutex m_oMutex;
     std::set<std::wstring> m_vRequestedImages;
+
+    static constexpr size_t DEFAULT_CACHE_BUDGET = 16 * 1024 * 1024;
+    LruList m_vLru; // unreferenced decoded images, most recently used first
+    size_t m_nCacheBudget = DEFAULT_CACHE_BUDGET;
+    size_t m_nCacheBytesUsed = 0;
+    mutable size_t m_nCacheHits = 0;
+    mutable size_t m_nCacheMisses = 0;
+    size_t m_nCacheEvictions = 0;
+
+    struct PendingFetch
+    {
+        ImageType nType;
+        std::string sName;
+        std::wstring sFilename;
+    };
+
+    void QueueFetches(std::vector<PendingFetch>&& vFetches, bool bPriority);
+    void StartPendingFetches();
+    void OnFetchCompleted();
+
+    static constexpr unsigned int MAX_CONCURRENT_FETCHES = 4;
+    std::deque<PendingFetch> m_vPendingFetches;
+    unsigned int m_nActiveFetches = 0;
+    size_t m_nCompletedFetches = 0;
+    size_t m_nTotalFetches = 0;
     bool m_bShutdownCOM = false;
 };
 
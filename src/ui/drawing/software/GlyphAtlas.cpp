@@ -0,0 +1,265 @@
+#include "GlyphAtlas.hh"
+
+#include "ra_math.h"
+#include "ra_utility.h"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace software {
+
+// 5x7 bitmap font for characters 0x20-0x7E. Each character is five columns, the least
+// significant bit of each column is the top row.
+static constexpr std::array<uint8_t, 95 * 5> FONT_5X7 = {
+    0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x5F, 0x00, 0x00, // '!'
+    0x00, 0x07, 0x00, 0x07, 0x00, // '"'
+    0x14, 0x7F, 0x14, 0x7F, 0x14, // '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, // '$'
+    0x23, 0x13, 0x08, 0x64, 0x62, // '%'
+    0x36, 0x49, 0x55, 0x22, 0x50, // '&'
+    0x00, 0x05, 0x03, 0x00, 0x00, // '''
+    0x00, 0x1C, 0x22, 0x41, 0x00, // '('
+    0x00, 0x41, 0x22, 0x1C, 0x00, // ')'
+    0x08, 0x2A, 0x1C, 0x2A, 0x08, // '*'
+    0x08, 0x08, 0x3E, 0x08, 0x08, // '+'
+    0x00, 0x50, 0x30, 0x00, 0x00, // ','
+    0x08, 0x08, 0x08, 0x08, 0x08, // '-'
+    0x00, 0x60, 0x60, 0x00, 0x00, // '.'
+    0x20, 0x10, 0x08, 0x04, 0x02, // '/'
+    0x3E, 0x51, 0x49, 0x45, 0x3E, // '0'
+    0x00, 0x42, 0x7F, 0x40, 0x00, // '1'
+    0x42, 0x61, 0x51, 0x49, 0x46, // '2'
+    0x21, 0x41, 0x45, 0x4B, 0x31, // '3'
+    0x18, 0x14, 0x12, 0x7F, 0x10, // '4'
+    0x27, 0x45, 0x45, 0x45, 0x39, // '5'
+    0x3C, 0x4A, 0x49, 0x49, 0x30, // '6'
+    0x01, 0x71, 0x09, 0x05, 0x03, // '7'
+    0x36, 0x49, 0x49, 0x49, 0x36, // '8'
+    0x06, 0x49, 0x49, 0x29, 0x1E, // '9'
+    0x00, 0x36, 0x36, 0x00, 0x00, // ':'
+    0x00, 0x56, 0x36, 0x00, 0x00, // ';'
+    0x08, 0x14, 0x22, 0x41, 0x00, // '<'
+    0x14, 0x14, 0x14, 0x14, 0x14, // '='
+    0x00, 0x41, 0x22, 0x14, 0x08, // '>'
+    0x02, 0x01, 0x51, 0x09, 0x06, // '?'
+    0x32, 0x49, 0x79, 0x41, 0x3E, // '@'
+    0x7E, 0x11, 0x11, 0x11, 0x7E, // 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36, // 'B'
+    0x3E, 0x41, 0x41, 0x41, 0x22, // 'C'
+    0x7F, 0x41, 0x41, 0x22, 0x1C, // 'D'
+    0x7F, 0x49, 0x49, 0x49, 0x41, // 'E'
+    0x7F, 0x09, 0x09, 0x01, 0x01, // 'F'
+    0x3E, 0x41, 0x41, 0x51, 0x32, // 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F, // 'H'
+    0x00, 0x41, 0x7F, 0x41, 0x00, // 'I'
+    0x20, 0x40, 0x41, 0x3F, 0x01, // 'J'
+    0x7F, 0x08, 0x14, 0x22, 0x41, // 'K'
+    0x7F, 0x40, 0x40, 0x40, 0x40, // 'L'
+    0x7F, 0x02, 0x04, 0x02, 0x7F, // 'M'
+    0x7F, 0x04, 0x08, 0x10, 0x7F, // 'N'
+    0x3E, 0x41, 0x41, 0x41, 0x3E, // 'O'
+    0x7F, 0x09, 0x09, 0x09, 0x06, // 'P'
+    0x3E, 0x41, 0x51, 0x21, 0x5E, // 'Q'
+    0x7F, 0x09, 0x19, 0x29, 0x46, // 'R'
+    0x46, 0x49, 0x49, 0x49, 0x31, // 'S'
+    0x01, 0x01, 0x7F, 0x01, 0x01, // 'T'
+    0x3F, 0x40, 0x40, 0x40, 0x3F, // 'U'
+    0x1F, 0x20, 0x40, 0x20, 0x1F, // 'V'
+    0x7F, 0x20, 0x18, 0x20, 0x7F, // 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63, // 'X'
+    0x03, 0x04, 0x78, 0x04, 0x03, // 'Y'
+    0x61, 0x51, 0x49, 0x45, 0x43, // 'Z'
+    0x00, 0x7F, 0x41, 0x41, 0x00, // '['
+    0x02, 0x04, 0x08, 0x10, 0x20, // '\'
+    0x00, 0x41, 0x41, 0x7F, 0x00, // ']'
+    0x04, 0x02, 0x01, 0x02, 0x04, // '^'
+    0x40, 0x40, 0x40, 0x40, 0x40, // '_'
+    0x00, 0x01, 0x02, 0x04, 0x00, // '`'
+    0x20, 0x54, 0x54, 0x54, 0x78, // 'a'
+    0x7F, 0x48, 0x44, 0x44, 0x38, // 'b'
+    0x38, 0x44, 0x44, 0x44, 0x20, // 'c'
+    0x38, 0x44, 0x44, 0x48, 0x7F, // 'd'
+    0x38, 0x54, 0x54, 0x54, 0x18, // 'e'
+    0x08, 0x7E, 0x09, 0x01, 0x02, // 'f'
+    0x08, 0x14, 0x54, 0x54, 0x3C, // 'g'
+    0x7F, 0x08, 0x04, 0x04, 0x78, // 'h'
+    0x00, 0x44, 0x7D, 0x40, 0x00, // 'i'
+    0x20, 0x40, 0x44, 0x3D, 0x00, // 'j'
+    0x00, 0x7F, 0x10, 0x28, 0x44, // 'k'
+    0x00, 0x41, 0x7F, 0x40, 0x00, // 'l'
+    0x7C, 0x04, 0x18, 0x04, 0x78, // 'm'
+    0x7C, 0x08, 0x04, 0x04, 0x78, // 'n'
+    0x38, 0x44, 0x44, 0x44, 0x38, // 'o'
+    0x7C, 0x14, 0x14, 0x14, 0x08, // 'p'
+    0x08, 0x14, 0x14, 0x18, 0x7C, // 'q'
+    0x7C, 0x08, 0x04, 0x04, 0x08, // 'r'
+    0x48, 0x54, 0x54, 0x54, 0x20, // 's'
+    0x04, 0x3F, 0x44, 0x40, 0x20, // 't'
+    0x3C, 0x40, 0x40, 0x20, 0x7C, // 'u'
+    0x1C, 0x20, 0x40, 0x20, 0x1C, // 'v'
+    0x3C, 0x40, 0x30, 0x40, 0x3C, // 'w'
+    0x44, 0x28, 0x10, 0x28, 0x44, // 'x'
+    0x0C, 0x50, 0x50, 0x50, 0x3C, // 'y'
+    0x44, 0x64, 0x54, 0x4C, 0x44, // 'z'
+    0x00, 0x08, 0x36, 0x41, 0x00, // '{'
+    0x00, 0x00, 0x7F, 0x00, 0x00, // '|'
+    0x00, 0x41, 0x36, 0x08, 0x00, // '}'
+    0x08, 0x04, 0x08, 0x10, 0x08, // '~'
+};
+
+// each character cell is six columns (five plus spacing) by eight rows (seven plus spacing)
+static constexpr int CELL_WIDTH = 6;
+static constexpr int CELL_HEIGHT = 8;
+static constexpr int SUPERSAMPLE = 4;
+
+static bool IsSourcePixelSet(wchar_t cChar, int nColumn, int nRow) noexcept
+{
+    if (nColumn < 0 || nColumn >= 5 || nRow < 0 || nRow >= 7)
+        return false;
+
+    if (cChar < 0x20 || cChar > 0x7E)
+        cChar = L'?';
+
+    const auto nIndex = gsl::narrow_cast<size_t>(cChar - 0x20) * 5 + nColumn;
+    GSL_SUPPRESS_BOUNDS4 return (FONT_5X7[nIndex] & (1 << nRow)) != 0;
+}
+
+int GlyphAtlas::LoadFont(const std::string& sFont, int nFontSize, FontStyles nStyle)
+{
+    if (nFontSize <= 0)
+        return 0;
+
+    int i = 1;
+    for (const auto& pFont : m_vFonts)
+    {
+        if (pFont.nFontSize == nFontSize && pFont.nStyle == nStyle && pFont.sFontName == sFont)
+            return i;
+        ++i;
+    }
+
+    m_vFonts.push_back({ sFont, nFontSize, nStyle });
+    return gsl::narrow_cast<int>(m_vFonts.size());
+}
+
+int GlyphAtlas::GetLineHeight(int nFont) const
+{
+    if (nFont <= 0 || ra::to_unsigned(nFont) > m_vFonts.size())
+        return 0;
+
+    return m_vFonts.at(gsl::narrow_cast<size_t>(nFont) - 1).nFontSize;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::GetGlyph(int nFont, wchar_t cChar)
+{
+    if (nFont <= 0 || ra::to_unsigned(nFont) > m_vFonts.size())
+        return nullptr;
+
+    const auto pKey = std::make_pair(nFont, cChar);
+    const auto pIter = m_mGlyphs.find(pKey);
+    if (pIter != m_mGlyphs.end())
+        return &pIter->second;
+
+    auto& pGlyph = m_mGlyphs[pKey];
+    RasterizeGlyph(m_vFonts.at(gsl::narrow_cast<size_t>(nFont) - 1), cChar, pGlyph);
+    return &pGlyph;
+}
+
+void GlyphAtlas::Allocate(int nWidth, int nHeight, Glyph& pGlyph)
+{
+    // simple shelf packing - glyphs for a font are all the same height, so there's very little waste
+    if (m_nShelfX + nWidth > ATLAS_WIDTH)
+    {
+        m_nShelfY += m_nShelfHeight;
+        m_nShelfX = 0;
+        m_nShelfHeight = 0;
+    }
+
+    pGlyph.nAtlasX = m_nShelfX;
+    pGlyph.nAtlasY = m_nShelfY;
+    m_nShelfX += nWidth;
+
+    if (nHeight > m_nShelfHeight)
+    {
+        m_nShelfHeight = nHeight;
+
+        const auto nRequiredSize = gsl::narrow_cast<size_t>(m_nShelfY + m_nShelfHeight) * ATLAS_WIDTH;
+        if (m_vCoverage.size() < nRequiredSize)
+            m_vCoverage.resize(nRequiredSize, 0);
+    }
+}
+
+void GlyphAtlas::RasterizeGlyph(const Font& pFont, wchar_t cChar, Glyph& pGlyph)
+{
+    using namespace ra::bitwise_ops;
+    const bool bBold = (pFont.nStyle & FontStyles::Bold) == FontStyles::Bold;
+    const bool bItalic = (pFont.nStyle & FontStyles::Italic) == FontStyles::Italic;
+    const bool bUnderline = (pFont.nStyle & FontStyles::Underline) == FontStyles::Underline;
+    const bool bStrikethrough = (pFont.nStyle & FontStyles::Strikethrough) == FontStyles::Strikethrough;
+
+    const double fScale = static_cast<double>(pFont.nFontSize) / CELL_HEIGHT;
+    const int nSlant = bItalic ? ra::ftoi(pFont.nFontSize * 0.2) : 0;
+
+    pGlyph.nHeight = pFont.nFontSize;
+    pGlyph.nAdvance = std::max(1, ra::ftoi(CELL_WIDTH * fScale)) + (bBold ? 1 : 0);
+    pGlyph.nWidth = pGlyph.nAdvance + nSlant;
+
+    if (cChar == L' ' || cChar == L'\t')
+    {
+        if (!bUnderline && !bStrikethrough)
+        {
+            pGlyph.nWidth = 0;
+            return;
+        }
+    }
+
+    Allocate(pGlyph.nWidth, pGlyph.nHeight, pGlyph);
+
+    const int nUnderlineRow = std::min(pGlyph.nHeight - 1, ra::ftoi(7.5 * fScale));
+    const int nStrikethroughRow = ra::ftoi(3.5 * fScale);
+    const int nBoldOffset = bBold ? 1 : 0;
+
+    for (int nY = 0; nY < pGlyph.nHeight; ++nY)
+    {
+        const int nRowSlant = (nSlant * (pGlyph.nHeight - nY)) / pGlyph.nHeight;
+        auto* pCoverage = &m_vCoverage.at(gsl::narrow_cast<size_t>(pGlyph.nAtlasY + nY) * ATLAS_WIDTH + pGlyph.nAtlasX);
+
+        for (int nX = 0; nX < pGlyph.nWidth; ++nX)
+        {
+            if ((bUnderline && nY == nUnderlineRow) || (bStrikethrough && nY == nStrikethroughRow))
+            {
+                GSL_SUPPRESS_BOUNDS1 pCoverage[nX] = 0xFF;
+                continue;
+            }
+
+            // supersample the source bitmap to generate anti-aliased coverage
+            int nSamples = 0;
+            for (int j = 0; j < SUPERSAMPLE; ++j)
+            {
+                const double fSourceY = (nY + (j + 0.5) / SUPERSAMPLE) / fScale;
+                const int nSourceRow = static_cast<int>(fSourceY);
+
+                for (int i = 0; i < SUPERSAMPLE; ++i)
+                {
+                    const double fSourceX = (nX - nRowSlant + (i + 0.5) / SUPERSAMPLE) / fScale;
+                    const int nSourceColumn = static_cast<int>(fSourceX);
+                    if (fSourceX < 0.0)
+                        continue;
+
+                    if (IsSourcePixelSet(cChar, nSourceColumn, nSourceRow) ||
+                        (nBoldOffset && IsSourcePixelSet(cChar, static_cast<int>(fSourceX - nBoldOffset / fScale), nSourceRow)))
+                    {
+                        ++nSamples;
+                    }
+                }
+            }
+
+            GSL_SUPPRESS_BOUNDS1 pCoverage[nX] = gsl::narrow_cast<uint8_t>((nSamples * 255) / (SUPERSAMPLE * SUPERSAMPLE));
+        }
+    }
+}
+
+} // namespace software
+} // namespace drawing
+} // namespace ui
+} // namespace ra
@@ -0,0 +1,96 @@
+#ifndef RA_UI_DRAWING_SOFTWARE_GLYPHATLAS_HH
+#define RA_UI_DRAWING_SOFTWARE_GLYPHATLAS_HH
+#pragma once
+
+#include "ui\Types.hh"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace software {
+
+/// <summary>
+/// Rasterizes glyphs into a shared 8-bit coverage texture so text can be drawn without any platform
+/// font APIs.
+/// </summary>
+/// <remarks>
+/// Glyphs are generated from a built-in 5x7 bitmap font, which is supersampled to the requested
+/// font size to produce anti-aliased coverage values. The font name is recorded, but not used.
+/// </remarks>
+class GlyphAtlas
+{
+public:
+    GlyphAtlas() noexcept = default;
+    ~GlyphAtlas() noexcept = default;
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    GlyphAtlas(GlyphAtlas&&) = delete;
+    GlyphAtlas& operator=(GlyphAtlas&&) = delete;
+
+    struct Glyph
+    {
+        int nAtlasX{};  // location of the glyph in the atlas
+        int nAtlasY{};
+        int nWidth{};   // size of the glyph in the atlas
+        int nHeight{};
+        int nAdvance{}; // horizontal distance to the next glyph
+    };
+
+    /// <summary>
+    /// Registers a font.
+    /// </summary>
+    /// <returns>Unique identifier for the font, <c>0</c> if the font could not be loaded.</returns>
+    int LoadFont(const std::string& sFont, int nFontSize, FontStyles nStyle);
+
+    /// <summary>
+    /// Gets the height of a line of text for the specified font.
+    /// </summary>
+    int GetLineHeight(int nFont) const;
+
+    /// <summary>
+    /// Gets the glyph for a character, rasterizing it into the atlas if necessary.
+    /// </summary>
+    /// <returns>Pointer to the glyph, <c>nullptr</c> if the font is not valid.</returns>
+    const Glyph* GetGlyph(int nFont, wchar_t cChar);
+
+    /// <summary>
+    /// Gets the coverage values for the atlas.
+    /// </summary>
+    const uint8_t* GetCoverage() const noexcept { return m_vCoverage.data(); }
+
+    /// <summary>
+    /// Gets the width (and stride) of the atlas.
+    /// </summary>
+    static constexpr int ATLAS_WIDTH = 512;
+
+    /// <summary>
+    /// Gets the number of glyphs that have been rasterized.
+    /// </summary>
+    size_t GetGlyphCount() const noexcept { return m_mGlyphs.size(); }
+
+private:
+    struct Font
+    {
+        std::string sFontName;
+        int nFontSize{};
+        FontStyles nStyle{};
+    };
+
+    void RasterizeGlyph(const Font& pFont, wchar_t cChar, Glyph& pGlyph);
+    void Allocate(int nWidth, int nHeight, Glyph& pGlyph);
+
+    std::vector<Font> m_vFonts;
+    std::map<std::pair<int, wchar_t>, Glyph> m_mGlyphs;
+
+    std::vector<uint8_t> m_vCoverage;
+    int m_nShelfX = 0;
+    int m_nShelfY = 0;
+    int m_nShelfHeight = 0;
+};
+
+} // namespace software
+} // namespace drawing
+} // namespace ui
+} // namespace ra
+
+#endif // !RA_UI_DRAWING_SOFTWARE_GLYPHATLAS_HH
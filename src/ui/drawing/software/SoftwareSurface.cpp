@@ -0,0 +1,487 @@
+#include "SoftwareSurface.hh"
+
+#include "RA_Log.h"
+
+#include "services\IFileSystem.hh"
+#include "services\ServiceLocator.hh"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define RA_SOFTWARE_SURFACE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace software {
+
+SoftwareSurface::SoftwareSurface(int nWidth, int nHeight, bool bTransparent, SoftwareResourceRepository& pResourceRepository)
+    : m_nWidth(ra::to_unsigned(std::max(nWidth, 0))),
+      m_nHeight(ra::to_unsigned(std::max(nHeight, 0))),
+      m_bTransparent(bTransparent),
+      m_pResourceRepository(pResourceRepository)
+{
+    // opaque surfaces start black, transparent surfaces start fully transparent
+    m_vPixels.resize(gsl::narrow_cast<size_t>(m_nWidth) * m_nHeight, bTransparent ? 0x00000000U : 0xFF000000U);
+}
+
+bool SoftwareSurface::Clip(int& nX, int& nY, int& nWidth, int& nHeight) const noexcept
+{
+    if (nX < 0)
+    {
+        nWidth += nX;
+        nX = 0;
+    }
+    if (nY < 0)
+    {
+        nHeight += nY;
+        nY = 0;
+    }
+
+    const auto nMaxWidth = ra::to_signed(m_nWidth) - nX;
+    if (nWidth > nMaxWidth)
+        nWidth = nMaxWidth;
+
+    const auto nMaxHeight = ra::to_signed(m_nHeight) - nY;
+    if (nHeight > nMaxHeight)
+        nHeight = nMaxHeight;
+
+    return (nWidth > 0 && nHeight > 0);
+}
+
+void SoftwareSurface::MarkDirty(int nX, int nY, int nWidth, int nHeight) noexcept
+{
+    m_rcDirty = m_rcDirty.Union({ nX, nY, nWidth, nHeight });
+}
+
+void SoftwareSurface::FillRectangle(int nX, int nY, int nWidth, int nHeight, Color nColor) noexcept
+{
+    if (!Clip(nX, nY, nWidth, nHeight))
+        return;
+
+    MarkDirty(nX, nY, nWidth, nHeight);
+
+    auto* pBits = m_vPixels.data() + gsl::narrow_cast<size_t>(nY) * m_nWidth + nX;
+    if (ra::to_unsigned(nWidth) == m_nWidth)
+    {
+        // doing full scanlines, just bulk fill
+        std::fill_n(pBits, gsl::narrow_cast<size_t>(nWidth) * nHeight, nColor.ARGB);
+    }
+    else
+    {
+        // partial scanlines, have to fill in strips
+        while (nHeight--)
+        {
+            std::fill_n(pBits, nWidth, nColor.ARGB);
+            pBits += m_nWidth;
+        }
+    }
+}
+
+int SoftwareSurface::LoadFont(const std::string& sFont, int nFontSize, FontStyles nStyle)
+{
+    return m_pResourceRepository.Glyphs().LoadFont(sFont, nFontSize, nStyle);
+}
+
+ra::ui::Size SoftwareSurface::MeasureText(int nFont, const std::wstring& sText) const
+{
+    auto& pGlyphs = m_pResourceRepository.Glyphs();
+
+    ra::ui::Size szText{ 0, pGlyphs.GetLineHeight(nFont) };
+    for (const auto cChar : sText)
+    {
+        const auto* pGlyph = pGlyphs.GetGlyph(nFont, cChar);
+        if (pGlyph != nullptr)
+            szText.Width += pGlyph->nAdvance;
+    }
+
+    return szText;
+}
+
+static uint32_t BlendPixel(uint32_t nDst, uint32_t nSrc) noexcept
+{
+    // treat 255 as 256 so fully opaque pixels are copied exactly
+    uint32_t nAlpha = nSrc >> 24;
+    nAlpha += nAlpha >> 7;
+    const uint32_t nInverse = 256 - nAlpha;
+
+    // process red and blue together as they're separated by eight bits
+    const uint32_t nRB = ((((nSrc & 0x00FF00FF) * nAlpha) + ((nDst & 0x00FF00FF) * nInverse)) >> 8) & 0x00FF00FF;
+    const uint32_t nG = ((((nSrc & 0x0000FF00) * nAlpha) + ((nDst & 0x0000FF00) * nInverse)) >> 8) & 0x0000FF00;
+    return (nDst & 0xFF000000) | nRB | nG;
+}
+
+void SoftwareSurface::BlendPixels(uint32_t* pDst, const uint32_t* pSrc, size_t nCount) noexcept
+{
+    size_t i = 0;
+
+#ifdef RA_SOFTWARE_SURFACE_SSE2
+    const __m128i nZero = _mm_setzero_si128();
+    const __m128i nAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i n256 = _mm_set1_epi16(256);
+
+    for (; i + 4 <= nCount; i += 4)
+    {
+        GSL_SUPPRESS_TYPE1 const __m128i nSrc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        const __m128i nSrcAlpha = _mm_and_si128(nSrc, nAlphaMask);
+
+        // skip blocks of fully transparent pixels
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(nSrcAlpha, nZero)) == 0xFFFF)
+            continue;
+
+        GSL_SUPPRESS_TYPE1 const __m128i nDst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+        __m128i nResult;
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(nSrcAlpha, nAlphaMask)) == 0xFFFF)
+        {
+            // block of fully opaque pixels
+            nResult = nSrc;
+        }
+        else
+        {
+            // expand to 16-bits per channel (two pixels per register)
+            const __m128i nSrcLo = _mm_unpacklo_epi8(nSrc, nZero);
+            const __m128i nSrcHi = _mm_unpackhi_epi8(nSrc, nZero);
+            const __m128i nDstLo = _mm_unpacklo_epi8(nDst, nZero);
+            const __m128i nDstHi = _mm_unpackhi_epi8(nDst, nZero);
+
+            // broadcast the alpha of each pixel to all of its channels, and map 255 to 256
+            __m128i nAlphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(nSrcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i nAlphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(nSrcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            nAlphaLo = _mm_add_epi16(nAlphaLo, _mm_srli_epi16(nAlphaLo, 7));
+            nAlphaHi = _mm_add_epi16(nAlphaHi, _mm_srli_epi16(nAlphaHi, 7));
+
+            // (src * alpha + dst * (256 - alpha)) / 256
+            const __m128i nBlendLo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(nSrcLo, nAlphaLo),
+                _mm_mullo_epi16(nDstLo, _mm_sub_epi16(n256, nAlphaLo))), 8);
+            const __m128i nBlendHi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(nSrcHi, nAlphaHi),
+                _mm_mullo_epi16(nDstHi, _mm_sub_epi16(n256, nAlphaHi))), 8);
+
+            nResult = _mm_packus_epi16(nBlendLo, nBlendHi);
+        }
+
+        // keep the destination alpha
+        nResult = _mm_or_si128(_mm_andnot_si128(nAlphaMask, nResult), _mm_and_si128(nDst, nAlphaMask));
+        GSL_SUPPRESS_TYPE1 _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), nResult);
+    }
+#endif
+
+    for (; i < nCount; ++i)
+    {
+        GSL_SUPPRESS_BOUNDS1
+        {
+            const auto nSrc = pSrc[i];
+            if (nSrc & 0xFF000000)
+                pDst[i] = BlendPixel(pDst[i], nSrc);
+        }
+    }
+}
+
+void SoftwareSurface::WriteText(int nX, int nY, int nFont, Color nColor, const std::wstring& sText)
+{
+    if (sText.empty())
+        return;
+
+    auto& pGlyphs = m_pResourceRepository.Glyphs();
+    const auto nTextAlpha = nColor.Channel.A;
+    const auto nRGB = nColor.ARGB & 0x00FFFFFF;
+
+    int nLeft = nX;
+    for (const auto cChar : sText)
+    {
+        const auto* pGlyph = pGlyphs.GetGlyph(nFont, cChar);
+        if (pGlyph == nullptr)
+            return;
+
+        int nGlyphX = nLeft;
+        int nGlyphY = nY;
+        int nWidth = pGlyph->nWidth;
+        int nHeight = pGlyph->nHeight;
+        nLeft += pGlyph->nAdvance;
+
+        if (!Clip(nGlyphX, nGlyphY, nWidth, nHeight))
+            continue;
+
+        MarkDirty(nGlyphX, nGlyphY, nWidth, nHeight);
+
+        // copy the glyph coverage onto the surface using the coverage as the alpha for antialiasing
+        const auto* pCoverage = pGlyphs.GetCoverage() +
+            gsl::narrow_cast<size_t>(pGlyph->nAtlasY + (nGlyphY - nY)) * GlyphAtlas::ATLAS_WIDTH +
+            pGlyph->nAtlasX + (nGlyphX - (nLeft - pGlyph->nAdvance));
+        auto* pBits = m_vPixels.data() + gsl::narrow_cast<size_t>(nGlyphY) * m_nWidth + nGlyphX;
+
+        for (int j = 0; j < nHeight; ++j)
+        {
+            for (int i = 0; i < nWidth; ++i)
+            {
+                GSL_SUPPRESS_BOUNDS1
+                {
+                    const auto nCoverage = pCoverage[i];
+                    if (nCoverage == 0xFF && nTextAlpha == 0xFF)
+                    {
+                        pBits[i] = nColor.ARGB;
+                    }
+                    else if (nCoverage != 0)
+                    {
+                        const uint32_t nAlpha = (nCoverage * nTextAlpha) / 255;
+                        pBits[i] = BlendPixel(pBits[i], (nAlpha << 24) | nRGB);
+                    }
+                }
+            }
+
+            pCoverage += GlyphAtlas::ATLAS_WIDTH;
+            pBits += m_nWidth;
+        }
+    }
+}
+
+void SoftwareSurface::CopyPixels(int nX, int nY, const SoftwareSurface& pSource,
+                                 int nSourceX, int nSourceY, int nWidth, int nHeight) noexcept
+{
+    // clip to source
+    if (nSourceX < 0)
+    {
+        nX -= nSourceX;
+        nWidth += nSourceX;
+        nSourceX = 0;
+    }
+    if (nSourceY < 0)
+    {
+        nY -= nSourceY;
+        nHeight += nSourceY;
+        nSourceY = 0;
+    }
+    nWidth = std::min(nWidth, ra::to_signed(pSource.m_nWidth) - nSourceX);
+    nHeight = std::min(nHeight, ra::to_signed(pSource.m_nHeight) - nSourceY);
+
+    // clip to destination
+    const int nOriginalX = nX;
+    const int nOriginalY = nY;
+    if (!Clip(nX, nY, nWidth, nHeight))
+        return;
+
+    nSourceX += (nX - nOriginalX);
+    nSourceY += (nY - nOriginalY);
+
+    MarkDirty(nX, nY, nWidth, nHeight);
+
+    const auto* pSrcBits = pSource.m_vPixels.data() + gsl::narrow_cast<size_t>(nSourceY) * pSource.m_nWidth + nSourceX;
+    auto* pBits = m_vPixels.data() + gsl::narrow_cast<size_t>(nY) * m_nWidth + nX;
+
+    while (nHeight--)
+    {
+        if (pSource.m_bTransparent)
+            BlendPixels(pBits, pSrcBits, nWidth);
+        else
+            memcpy(pBits, pSrcBits, gsl::narrow_cast<size_t>(nWidth) * sizeof(uint32_t));
+
+        pSrcBits += pSource.m_nWidth;
+        pBits += m_nWidth;
+    }
+}
+
+void SoftwareSurface::DrawImage(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage)
+{
+    const auto* pImageSurface = m_pResourceRepository.GetImage(pImage);
+    if (pImageSurface != nullptr)
+        CopyPixels(nX, nY, *pImageSurface, 0, 0, nWidth, nHeight);
+}
+
+void SoftwareSurface::DrawImageStretched(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage)
+{
+    const auto* pImageSurface = m_pResourceRepository.GetImage(pImage);
+    if (pImageSurface == nullptr || pImageSurface->m_nWidth == 0 || pImageSurface->m_nHeight == 0)
+        return;
+
+    if (ra::to_unsigned(nWidth) == pImageSurface->m_nWidth && ra::to_unsigned(nHeight) == pImageSurface->m_nHeight)
+    {
+        CopyPixels(nX, nY, *pImageSurface, 0, 0, nWidth, nHeight);
+        return;
+    }
+
+    const int nOriginalX = nX;
+    const int nOriginalY = nY;
+    const int nOriginalWidth = nWidth;
+    const int nOriginalHeight = nHeight;
+    if (!Clip(nX, nY, nWidth, nHeight))
+        return;
+
+    MarkDirty(nX, nY, nWidth, nHeight);
+
+    // nearest neighbor scaling
+    std::vector<uint32_t> vRow(gsl::narrow_cast<size_t>(nWidth));
+    for (int j = 0; j < nHeight; ++j)
+    {
+        const auto nSourceY = gsl::narrow_cast<size_t>(j + nY - nOriginalY) * pImageSurface->m_nHeight / nOriginalHeight;
+        const auto* pSrcBits = pImageSurface->m_vPixels.data() + nSourceY * pImageSurface->m_nWidth;
+        for (int i = 0; i < nWidth; ++i)
+        {
+            const auto nSourceX = gsl::narrow_cast<size_t>(i + nX - nOriginalX) * pImageSurface->m_nWidth / nOriginalWidth;
+            GSL_SUPPRESS_BOUNDS1 vRow.at(i) = pSrcBits[nSourceX];
+        }
+
+        auto* pBits = m_vPixels.data() + gsl::narrow_cast<size_t>(nY + j) * m_nWidth + nX;
+        if (pImageSurface->m_bTransparent)
+            BlendPixels(pBits, vRow.data(), nWidth);
+        else
+            memcpy(pBits, vRow.data(), gsl::narrow_cast<size_t>(nWidth) * sizeof(uint32_t));
+    }
+}
+
+void SoftwareSurface::DrawSurface(int nX, int nY, const ISurface& pSurface)
+{
+    DrawSurface(nX, nY, pSurface, 0, 0, ra::to_signed(pSurface.GetWidth()), ra::to_signed(pSurface.GetHeight()));
+}
+
+void SoftwareSurface::DrawSurface(int nX, int nY, const ISurface& pSurface, int nSurfaceX, int nSurfaceY, int nWidth, int nHeight)
+{
+    const auto* pSoftwareSurface = dynamic_cast<const SoftwareSurface*>(&pSurface);
+    assert(pSoftwareSurface != nullptr);
+
+    if (pSoftwareSurface != nullptr)
+        CopyPixels(nX, nY, *pSoftwareSurface, nSurfaceX, nSurfaceY, nWidth, nHeight);
+}
+
+void SoftwareSurface::SetOpacity(double fAlpha)
+{
+    assert(m_bTransparent);
+    assert(fAlpha >= 0.0 && fAlpha <= 1.0);
+    const auto nAlpha = static_cast<std::uint8_t>(255 * fAlpha);
+    Expects(nAlpha > 0); // setting opacity to 0 is irreversible - caller should just not draw it
+
+    const uint32_t nAlphaBits = gsl::narrow_cast<uint32_t>(nAlpha) << 24;
+    for (auto& nPixel : m_vPixels)
+    {
+        // only update the alpha for non-transparent pixels
+        if (nPixel & 0xFF000000)
+            nPixel = (nPixel & 0x00FFFFFF) | nAlphaBits;
+    }
+
+    MarkDirty(0, 0, ra::to_signed(m_nWidth), ra::to_signed(m_nHeight));
+}
+
+static constexpr std::array<uint32_t, 256> BuildCrcTable() noexcept
+{
+    std::array<uint32_t, 256> pTable{};
+    for (uint32_t n = 0; n < 256; ++n)
+    {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+
+        GSL_SUPPRESS_BOUNDS4 pTable[n] = c;
+    }
+    return pTable;
+}
+
+static constexpr std::array<uint32_t, 256> CRC_TABLE = BuildCrcTable();
+
+static uint32_t UpdateCrc(uint32_t nCrc, const char* pData, size_t nLength) noexcept
+{
+    while (nLength--)
+    {
+        GSL_SUPPRESS_BOUNDS4 nCrc = CRC_TABLE[(nCrc ^ gsl::narrow_cast<uint8_t>(*pData++)) & 0xFF] ^ (nCrc >> 8);
+    }
+    return nCrc;
+}
+
+static void AppendUInt32(std::string& sBuffer, uint32_t nValue)
+{
+    sBuffer.push_back(gsl::narrow_cast<char>(nValue >> 24));
+    sBuffer.push_back(gsl::narrow_cast<char>(nValue >> 16));
+    sBuffer.push_back(gsl::narrow_cast<char>(nValue >> 8));
+    sBuffer.push_back(gsl::narrow_cast<char>(nValue));
+}
+
+static void AppendChunk(std::string& sPng, const char* sType, const std::string& sData)
+{
+    AppendUInt32(sPng, gsl::narrow_cast<uint32_t>(sData.size()));
+
+    const auto nTypeOffset = sPng.size();
+    sPng.append(sType, 4);
+    sPng.append(sData);
+
+    const auto nCrc = UpdateCrc(0xFFFFFFFFU, sPng.data() + nTypeOffset, sPng.size() - nTypeOffset) ^ 0xFFFFFFFFU;
+    AppendUInt32(sPng, nCrc);
+}
+
+std::string SoftwareSurfaceFactory::EncodePng(const uint32_t* pPixels, unsigned int nWidth, unsigned int nHeight)
+{
+    // PNG signature
+    std::string sPng("\x89PNG\r\n\x1A\n", 8);
+
+    // header: 8-bit RGB, no interlacing
+    std::string sHeader;
+    AppendUInt32(sHeader, nWidth);
+    AppendUInt32(sHeader, nHeight);
+    sHeader.append("\x08\x02\x00\x00\x00", 5);
+    AppendChunk(sPng, "IHDR", sHeader);
+
+    // raw scanlines, each prefixed with a filter type of 0 (none)
+    std::string sRaw;
+    sRaw.reserve(gsl::narrow_cast<size_t>(nWidth * 3 + 1) * nHeight);
+    for (unsigned int nY = 0; nY < nHeight; ++nY)
+    {
+        sRaw.push_back('\0');
+        for (unsigned int nX = 0; nX < nWidth; ++nX)
+        {
+            GSL_SUPPRESS_BOUNDS1 const Color nColor(*pPixels++);
+            sRaw.push_back(gsl::narrow_cast<char>(nColor.Channel.R));
+            sRaw.push_back(gsl::narrow_cast<char>(nColor.Channel.G));
+            sRaw.push_back(gsl::narrow_cast<char>(nColor.Channel.B));
+        }
+    }
+
+    // zlib stream using uncompressed deflate blocks. screenshots are written in the background, so
+    // size is less important than not needing a compression library.
+    std::string sData("\x78\x01", 2);
+    constexpr size_t MAX_BLOCK_SIZE = 65535;
+    size_t nOffset = 0;
+    do
+    {
+        const auto nBlockSize = std::min(MAX_BLOCK_SIZE, sRaw.size() - nOffset);
+        const bool bFinal = (nOffset + nBlockSize == sRaw.size());
+        sData.push_back(bFinal ? '\x01' : '\x00');
+        sData.push_back(gsl::narrow_cast<char>(nBlockSize & 0xFF));
+        sData.push_back(gsl::narrow_cast<char>(nBlockSize >> 8));
+        sData.push_back(gsl::narrow_cast<char>(~nBlockSize & 0xFF));
+        sData.push_back(gsl::narrow_cast<char>((~nBlockSize >> 8) & 0xFF));
+        sData.append(sRaw, nOffset, nBlockSize);
+        nOffset += nBlockSize;
+    } while (nOffset < sRaw.size());
+
+    uint32_t nAdlerA = 1, nAdlerB = 0;
+    for (const auto c : sRaw)
+    {
+        nAdlerA = (nAdlerA + gsl::narrow_cast<uint8_t>(c)) % 65521;
+        nAdlerB = (nAdlerB + nAdlerA) % 65521;
+    }
+    AppendUInt32(sData, (nAdlerB << 16) | nAdlerA);
+    AppendChunk(sPng, "IDAT", sData);
+
+    AppendChunk(sPng, "IEND", "");
+    return sPng;
+}
+
+bool SoftwareSurfaceFactory::SaveImage(const ISurface& pSurface, const std::wstring& sPath) const
+{
+    const auto* pSoftwareSurface = dynamic_cast<const SoftwareSurface*>(&pSurface);
+    if (pSoftwareSurface == nullptr)
+        return false;
+
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.CreateTextFile(sPath);
+    if (pFile == nullptr)
+    {
+        RA_LOG_WARN("Could not create %s", ra::Narrow(sPath).c_str());
+        return false;
+    }
+
+    pFile->Write(EncodePng(pSoftwareSurface->GetPixels(), pSurface.GetWidth(), pSurface.GetHeight()));
+    return true;
+}
+
+} // namespace software
+} // namespace drawing
+} // namespace ui
+} // namespace ra
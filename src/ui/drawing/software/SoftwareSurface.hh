@@ -0,0 +1,144 @@
+#ifndef RA_UI_DRAWING_SOFTWARE_SURFACE_HH
+#define RA_UI_DRAWING_SOFTWARE_SURFACE_HH
+#pragma once
+
+#include "ui\drawing\ISurface.hh"
+#include "ui\drawing\software\GlyphAtlas.hh"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace software {
+
+class SoftwareSurface;
+
+/// <summary>
+/// Resources shared by all surfaces created by a <see cref="SoftwareSurfaceFactory" />.
+/// </summary>
+class SoftwareResourceRepository
+{
+public:
+    /// <summary>
+    /// Callback to get the pixels for an image. The returned surface must remain valid until
+    /// the draw call completes. Return <c>nullptr</c> if the image is not available.
+    /// </summary>
+    using ImageProvider = std::function<const SoftwareSurface*(const ImageReference&)>;
+
+    GlyphAtlas& Glyphs() noexcept { return m_oGlyphAtlas; }
+
+    void SetImageProvider(ImageProvider&& fImageProvider) noexcept { m_fImageProvider = std::move(fImageProvider); }
+    const SoftwareSurface* GetImage(const ImageReference& pImage) const
+    {
+        return m_fImageProvider ? m_fImageProvider(pImage) : nullptr;
+    }
+
+private:
+    GlyphAtlas m_oGlyphAtlas;
+    ImageProvider m_fImageProvider;
+};
+
+/// <summary>
+/// An <see cref="ISurface" /> that renders into a 32-bit BGRA (<see cref="ra::ui::Color" />) buffer
+/// on the CPU. Does not require any platform APIs.
+/// </summary>
+class SoftwareSurface : public ISurface
+{
+public:
+    explicit SoftwareSurface(int nWidth, int nHeight, bool bTransparent, SoftwareResourceRepository& pResourceRepository);
+
+    SoftwareSurface(const SoftwareSurface&) noexcept = delete;
+    SoftwareSurface& operator=(const SoftwareSurface&) noexcept = delete;
+    SoftwareSurface(SoftwareSurface&&) noexcept = delete;
+    SoftwareSurface& operator=(SoftwareSurface&&) noexcept = delete;
+    ~SoftwareSurface() noexcept = default;
+
+    unsigned int GetWidth() const noexcept override { return m_nWidth; }
+    unsigned int GetHeight() const noexcept override { return m_nHeight; }
+
+    void FillRectangle(int nX, int nY, int nWidth, int nHeight, Color nColor) noexcept override;
+
+    int LoadFont(const std::string& sFont, int nFontSize, FontStyles nStyle) override;
+    ra::ui::Size MeasureText(int nFont, const std::wstring& sText) const override;
+    void WriteText(int nX, int nY, int nFont, Color nColor, const std::wstring& sText) override;
+
+    void DrawImage(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) override;
+    void DrawImageStretched(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) override;
+    void DrawSurface(int nX, int nY, const ISurface& pSurface) override;
+    void DrawSurface(int nX, int nY, const ISurface& pSurface, int nSurfaceX, int nSurfaceY, int nWidth, int nHeight) override;
+
+    void SetOpacity(double fAlpha) override;
+
+    /// <summary>
+    /// Determines if the surface has an alpha channel.
+    /// </summary>
+    bool IsTransparent() const noexcept { return m_bTransparent; }
+
+    /// <summary>
+    /// Gets the pixel buffer. Pixels are stored top-down with a stride of <see cref="GetWidth" />.
+    /// </summary>
+    const uint32_t* GetPixels() const noexcept { return m_vPixels.data(); }
+    uint32_t* GetPixels() noexcept { return m_vPixels.data(); }
+
+    /// <summary>
+    /// Gets the bounding rectangle of everything that has been drawn since the last call
+    /// to <see cref="ResetDirtyRect" />.
+    /// </summary>
+    const ra::ui::Rect& GetDirtyRect() const noexcept { return m_rcDirty; }
+
+    /// <summary>
+    /// Clears the dirty rectangle.
+    /// </summary>
+    void ResetDirtyRect() noexcept { m_rcDirty = {}; }
+
+    /// <summary>
+    /// Blends <paramref name="nCount" /> source pixels onto the destination pixels using the source alpha.
+    /// The destination alpha is not modified.
+    /// </summary>
+    static void BlendPixels(_Inout_ uint32_t* pDst, _In_ const uint32_t* pSrc, size_t nCount) noexcept;
+
+private:
+    bool Clip(int& nX, int& nY, int& nWidth, int& nHeight) const noexcept;
+    void MarkDirty(int nX, int nY, int nWidth, int nHeight) noexcept;
+    void CopyPixels(int nX, int nY, const SoftwareSurface& pSource, int nSourceX, int nSourceY, int nWidth, int nHeight) noexcept;
+
+    unsigned int m_nWidth{};
+    unsigned int m_nHeight{};
+    bool m_bTransparent{};
+    std::vector<uint32_t> m_vPixels;
+    ra::ui::Rect m_rcDirty;
+
+    SoftwareResourceRepository& m_pResourceRepository;
+};
+
+class SoftwareSurfaceFactory : public ISurfaceFactory
+{
+public:
+    std::unique_ptr<ISurface> CreateSurface(int nWidth, int nHeight) const override
+    {
+        return std::make_unique<SoftwareSurface>(nWidth, nHeight, false, m_oResourceRepository);
+    }
+
+    std::unique_ptr<ISurface> CreateTransparentSurface(int nWidth, int nHeight) const override
+    {
+        return std::make_unique<SoftwareSurface>(nWidth, nHeight, true, m_oResourceRepository);
+    }
+
+    bool SaveImage(const ISurface& pSurface, const std::wstring& sPath) const override;
+
+    /// <summary>
+    /// Encodes 32-bit BGRA pixels (stored top-down) as a PNG image.
+    /// </summary>
+    static std::string EncodePng(const uint32_t* pPixels, unsigned int nWidth, unsigned int nHeight);
+
+    SoftwareResourceRepository& Resources() const noexcept { return m_oResourceRepository; }
+
+private:
+    mutable SoftwareResourceRepository m_oResourceRepository;
+};
+
+} // namespace software
+} // namespace drawing
+} // namespace ui
+} // namespace ra
+
+#endif // !RA_UI_DRAWING_SOFTWARE_SURFACE_HH
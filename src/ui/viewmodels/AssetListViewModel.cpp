@@ -88,7 +88,9 @@ AssetListViewModel::AssetListViewModel() noexcept
 
 AssetListViewModel::~AssetListViewModel()
 {
-    m_bNeedToUpdateButtons.store(false);
+    std::lock_guard<std::mutex> lock(m_oUpdateButtonsMutex);
+    if (m_nUpdateButtonsTaskId != 0 && ra::services::ServiceLocator::Exists<ra::services::IThreadPool>())
+        ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().CancelScheduledTask(m_nUpdateButtonsTaskId);
 }
 
 void AssetListViewModel::InitializeNotifyTargets()
@@ -154,11 +156,10 @@ void AssetListViewModel::OnDataModelIntValueChanged(gsl::index nIndex, const Int
         const auto* pAsset = pGameContext.Assets().GetItemAt(nIndex);
         Expects(pAsset != nullptr);
         const auto* pAchievement = dynamic_cast<const ra::data::models::AchievementModel*>(pAsset);
-        if (pAchievement != nullptr && GetFilteredAssetIndex(*pAsset) >= 0)
+        if (pAchievement != nullptr && FindFilteredAsset(pAsset->GetType(), ra::to_signed(pAsset->GetID())) != nullptr)
         {
-            auto nPoints = GetTotalPoints();
-            nPoints += args.tNewValue - args.tOldValue;
-            SetValue(TotalPointsProperty, nPoints);
+            m_nFilteredPoints += args.tNewValue - args.tOldValue;
+            SetValue(TotalPointsProperty, m_nFilteredPoints);
         }
     }
     else if (args.Property == ra::data::models::AssetModelBase::StateProperty)
@@ -255,69 +256,100 @@ void AssetListViewModel::OnDataModelIntValueChanged(gsl::index nIndex, const Int
         const auto* pAsset = pGameContext.Assets().GetItemAt(nIndex);
         if (pAsset != nullptr)
         {
-            gsl::index nFilteredIndex = -1;
             const auto nType = pAsset->GetType();
 
             RA_LOG_INFO("%s %u ID changed from %d to %d", ra::data::models::AssetModelBase::GetAssetTypeString(pAsset->GetType()), pAsset->GetID(), args.tOldValue, args.tNewValue);
 
+            if (nIndex < gsl::narrow_cast<gsl::index>(m_vAssetKeys.size()))
+                m_vAssetKeys.at(nIndex).second = args.tNewValue;
+
             // have to find the filtered item using the old ID
-            for (gsl::index nScanIndex = 0; nScanIndex < gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()); ++nScanIndex)
+            const auto pIter = m_mFilteredAssetIndex.find({ nType, args.tOldValue });
+            if (pIter != m_mFilteredAssetIndex.end())
             {
-                auto* pItem = m_vFilteredAssets.GetItemAt(nScanIndex);
-                if (pItem != nullptr && pItem->GetId() == args.tOldValue && pItem->GetType() == nType)
-                {
-                    nFilteredIndex = nScanIndex;
-                    break;
-                }
-            }
+                auto* pItem = pIter->second;
+                m_mFilteredAssetIndex.erase(pIter);
+                m_mFilteredAssetIndex.insert_or_assign({ nType, args.tNewValue }, pItem);
 
-            if (nFilteredIndex != -1)
-                m_vFilteredAssets.SetItemValue(nFilteredIndex, AssetSummaryViewModel::IdProperty, args.tNewValue);
+                const auto nFilteredIndex = m_vFilteredAssets.FindItemIndex(*pItem);
+                if (nFilteredIndex != -1)
+                    m_vFilteredAssets.SetItemValue(nFilteredIndex, AssetSummaryViewModel::IdProperty, args.tNewValue);
+            }
         }
     }
 }
 
-void AssetListViewModel::OnDataModelAdded(_UNUSED gsl::index nIndex)
+void AssetListViewModel::OnDataModelAdded(gsl::index nIndex)
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
     if (!pGameContext.Assets().IsUpdating())
+    {
+        const auto* pAsset = pGameContext.Assets().GetItemAt(nIndex);
+        if (pAsset != nullptr && nIndex <= gsl::narrow_cast<gsl::index>(m_vAssetKeys.size()))
+            m_vAssetKeys.insert(m_vAssetKeys.begin() + nIndex, { pAsset->GetType(), ra::to_signed(pAsset->GetID()) });
+
         AddOrRemoveFilteredItem(nIndex);
+    }
 }
 
-void AssetListViewModel::OnDataModelRemoved(_UNUSED gsl::index nIndex)
+void AssetListViewModel::OnDataModelRemoved(gsl::index nIndex)
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
     if (!pGameContext.Assets().IsUpdating())
     {
         // the item has already been removed from the vAssets collection, and all we know about it
-        // is the index where it was located. scan through the vFilteredAssets collection and remove 
-        // any that no longer exist in the vAssets collection.
-        for (gsl::index nFilteredIndex = 0; nFilteredIndex < gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()); ++nFilteredIndex)
+        // is the index where it was located. m_vAssetKeys mirrors the vAssets collection, so use it
+        // to identify the removed asset and find its filtered item in the index.
+        gsl::index nFilteredIndex = -1;
+        if (m_vAssetKeys.size() == pGameContext.Assets().Count() + 1)
         {
-            auto* pItem = m_vFilteredAssets.GetItemAt(nFilteredIndex);
+            const auto pKey = m_vAssetKeys.at(nIndex);
+            m_vAssetKeys.erase(m_vAssetKeys.begin() + nIndex);
+
+            const auto* pItem = FindFilteredAsset(pKey.first, pKey.second);
             if (pItem != nullptr)
+                nFilteredIndex = m_vFilteredAssets.FindItemIndex(*pItem);
+        }
+        else
+        {
+            // mirror is out of sync. scan through the vFilteredAssets collection for the item
+            // that no longer exists in the vAssets collection, and rebuild the mirror.
+            for (gsl::index nScanIndex = 0; nScanIndex < gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()); ++nScanIndex)
             {
-                if (!pGameContext.Assets().FindAsset(pItem->GetType(), pItem->GetId()))
+                const auto* pItem = m_vFilteredAssets.GetItemAt(nScanIndex);
+                if (pItem != nullptr && !pGameContext.Assets().FindAsset(pItem->GetType(), pItem->GetId()))
                 {
-                    m_vFilteredAssets.RemoveAt(nFilteredIndex);
-                    UpdateButtons();
+                    nFilteredIndex = nScanIndex;
                     break;
                 }
             }
+
+            UpdateAssetKeys();
+        }
+
+        if (nFilteredIndex != -1)
+        {
+            RemoveFilteredAsset(nFilteredIndex);
+            UpdateButtons();
         }
 
         UpdateTotals();
     }
 }
 
-void AssetListViewModel::OnDataModelChanged(_UNUSED gsl::index nIndex)
+void AssetListViewModel::OnDataModelChanged(gsl::index nIndex)
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
     if (!pGameContext.Assets().IsUpdating())
     {
         const auto* pAsset = pGameContext.Assets().GetItemAt(nIndex);
         if (pAsset != nullptr)
+        {
+            if (nIndex < gsl::narrow_cast<gsl::index>(m_vAssetKeys.size()))
+                m_vAssetKeys.at(nIndex) = { pAsset->GetType(), ra::to_signed(pAsset->GetID()) };
+
             AddOrRemoveFilteredItem(*pAsset);
+        }
 
         UpdateTotals();
     }
@@ -330,21 +362,9 @@ void AssetListViewModel::OnEndDataModelCollectionUpdate()
 
 void AssetListViewModel::UpdateTotals()
 {
-    int nAchievementCount = 0;
-    int nTotalPoints = 0;
-
-    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()); ++nIndex)
-    {
-        auto* pAsset = m_vFilteredAssets.GetItemAt(nIndex);
-        if (pAsset && pAsset->GetType() == ra::data::models::AssetType::Achievement)
-        {
-            ++nAchievementCount;
-            nTotalPoints += pAsset->GetPoints();
-        }
-    }
-
-    SetValue(AchievementCountProperty, nAchievementCount);
-    SetValue(TotalPointsProperty, nTotalPoints);
+    // the totals are maintained as items are added to and removed from the filtered list
+    SetValue(AchievementCountProperty, m_nFilteredAchievementCount);
+    SetValue(TotalPointsProperty, m_nFilteredPoints);
 }
 
 void AssetListViewModel::OnValueChanged(const IntModelProperty::ChangeArgs& args)
@@ -383,13 +403,17 @@ void AssetListViewModel::ApplyFilter()
     m_vFilteredAssets.BeginUpdate();
 
     // first pass: remove any filtered items no longer in the source collection
+    UpdateAssetKeys();
+    auto vSortedKeys = m_vAssetKeys;
+    std::sort(vSortedKeys.begin(), vSortedKeys.end());
+
     for (gsl::index nIndex = gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()) -1; nIndex >= 0; --nIndex)
     {
         auto* pItem = m_vFilteredAssets.GetItemAt(nIndex);
         if (pItem != nullptr)
         {
-            if (!pGameContext.Assets().FindAsset(pItem->GetType(), pItem->GetId()))
-                m_vFilteredAssets.RemoveAt(nIndex);
+            if (!std::binary_search(vSortedKeys.begin(), vSortedKeys.end(), FilteredAssetKey{ pItem->GetType(), pItem->GetId() }))
+                RemoveFilteredAsset(nIndex);
         }
     }
 
@@ -407,6 +431,22 @@ void AssetListViewModel::ApplyFilter()
     UpdateButtons();
 }
 
+void AssetListViewModel::UpdateAssetKeys()
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+
+    m_vAssetKeys.clear();
+    m_vAssetKeys.reserve(pGameContext.Assets().Count());
+    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(pGameContext.Assets().Count()); ++nIndex)
+    {
+        const auto* pAsset = pGameContext.Assets().GetItemAt(nIndex);
+        if (pAsset != nullptr)
+            m_vAssetKeys.emplace_back(pAsset->GetType(), ra::to_signed(pAsset->GetID()));
+        else
+            m_vAssetKeys.emplace_back(ra::data::models::AssetType::None, 0);
+    }
+}
+
 void AssetListViewModel::EnsureAppearsInFilteredList(const ra::data::models::AssetModelBase& pAsset)
 {
     // if the filter category is not all, ensure it matches the asset
@@ -514,7 +554,7 @@ bool AssetListViewModel::AddOrRemoveFilteredItem(const ra::data::models::AssetMo
             else
                 pSummary->SetPoints(0);
 
-            m_vFilteredAssets.Append(std::move(pSummary));
+            AppendFilteredAsset(std::move(pSummary));
             return true;
         }
     }
@@ -522,7 +562,7 @@ bool AssetListViewModel::AddOrRemoveFilteredItem(const ra::data::models::AssetMo
     {
         if (nIndex >= 0)
         {
-            m_vFilteredAssets.RemoveAt(nIndex);
+            RemoveFilteredAsset(nIndex);
             return true;
         }
     }
@@ -532,17 +572,99 @@ bool AssetListViewModel::AddOrRemoveFilteredItem(const ra::data::models::AssetMo
 
 gsl::index AssetListViewModel::GetFilteredAssetIndex(const ra::data::models::AssetModelBase& pAsset) const
 {
-    const auto nId = ra::to_signed(pAsset.GetID());
-    const auto nType = pAsset.GetType();
+    const auto* pItem = FindFilteredAsset(pAsset.GetType(), ra::to_signed(pAsset.GetID()));
+    if (pItem == nullptr)
+        return -1;
 
-    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(m_vFilteredAssets.Count()); ++nIndex)
+    return m_vFilteredAssets.FindItemIndex(*pItem);
+}
+
+AssetListViewModel::AssetSummaryViewModel* AssetListViewModel::FindFilteredAsset(ra::data::models::AssetType nType, int nId) const
+{
+    const auto pIter = m_mFilteredAssetIndex.find({ nType, nId });
+    return (pIter != m_mFilteredAssetIndex.end()) ? pIter->second : nullptr;
+}
+
+void AssetListViewModel::AppendFilteredAsset(std::unique_ptr<AssetSummaryViewModel> pSummary)
+{
+    if (pSummary->GetType() == ra::data::models::AssetType::Achievement)
     {
-        auto* pItem = m_vFilteredAssets.GetItemAt(nIndex);
-        if (pItem != nullptr && pItem->GetId() == nId && pItem->GetType() == nType)
-            return nIndex;
+        ++m_nFilteredAchievementCount;
+        m_nFilteredPoints += pSummary->GetPoints();
+    }
+
+    CountFilteredAsset(*pSummary, 1);
+
+    m_mFilteredAssetIndex.insert_or_assign({ pSummary->GetType(), pSummary->GetId() }, pSummary.get());
+    m_vFilteredAssets.Append(std::move(pSummary));
+}
+
+void AssetListViewModel::RemoveFilteredAsset(gsl::index nIndex)
+{
+    const auto* pItem = m_vFilteredAssets.GetItemAt(nIndex);
+    if (pItem == nullptr)
+        return;
+
+    if (pItem->GetType() == ra::data::models::AssetType::Achievement)
+    {
+        --m_nFilteredAchievementCount;
+        m_nFilteredPoints -= pItem->GetPoints();
     }
 
-    return -1;
+    CountFilteredAsset(*pItem, -1);
+
+    m_mFilteredAssetIndex.erase({ pItem->GetType(), pItem->GetId() });
+    m_vFilteredAssets.RemoveAt(nIndex);
+}
+
+void AssetListViewModel::CountFilteredAsset(const AssetSummaryViewModel& pItem, int nDelta) noexcept
+{
+    CountFilteredAsset(pItem.GetType(), pItem.GetCategory(), pItem.GetState(), pItem.GetChanges(), pItem.IsSelected(), nDelta);
+}
+
+void AssetListViewModel::CountFilteredAsset(ra::data::models::AssetType nType, ra::data::models::AssetCategory nCategory,
+    ra::data::models::AssetState nState, ra::data::models::AssetChanges nChanges, bool bSelected, int nDelta) noexcept
+{
+    auto& pCounts = bSelected ? m_pSelectedCounts : m_pUnselectedCounts;
+    pCounts.nTotal += nDelta;
+
+    switch (nCategory)
+    {
+        case ra::data::models::AssetCategory::Core:
+            pCounts.nCore += nDelta;
+            break;
+        case ra::data::models::AssetCategory::Unofficial:
+            pCounts.nUnofficial += nDelta;
+            break;
+        case ra::data::models::AssetCategory::Local:
+            pCounts.nLocal += nDelta;
+            break;
+        default:
+            break;
+    }
+
+    if (ra::data::models::AssetModelBase::IsActive(nState))
+        pCounts.nActive += nDelta;
+    else
+        pCounts.nInactive += nDelta;
+
+    switch (nChanges)
+    {
+        case ra::data::models::AssetChanges::Modified:
+            pCounts.nModified += nDelta;
+            break;
+        case ra::data::models::AssetChanges::New:
+            pCounts.nNew += nDelta;
+            break;
+        case ra::data::models::AssetChanges::Unpublished:
+            pCounts.nUnpublished += nDelta;
+            break;
+        default:
+            break;
+    }
+
+    if (nType == ra::data::models::AssetType::RichPresence)
+        pCounts.nRichPresence += nDelta;
 }
 
 void AssetListViewModel::OpenEditor(const AssetSummaryViewModel* pAsset)
@@ -592,10 +714,17 @@ bool AssetListViewModel::HasSelection(ra::data::models::AssetType nAssetType) co
     return false;
 }
 
-void AssetListViewModel::FilteredListMonitor::OnViewModelBoolValueChanged(_UNUSED gsl::index nIndex, const BoolModelProperty::ChangeArgs& args)
+void AssetListViewModel::FilteredListMonitor::OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args)
 {
     if (args.Property == AssetSummaryViewModel::IsSelectedProperty)
     {
+        const auto* pItem = m_pOwner->m_vFilteredAssets.GetItemAt(nIndex);
+        if (pItem != nullptr)
+        {
+            m_pOwner->CountFilteredAsset(pItem->GetType(), pItem->GetCategory(), pItem->GetState(), pItem->GetChanges(), args.tOldValue, -1);
+            m_pOwner->CountFilteredAsset(*pItem, 1);
+        }
+
         if (m_pOwner->FilteredAssets().IsUpdating())
             m_bUpdateButtonsPending = true;
         else
@@ -603,6 +732,31 @@ void AssetListViewModel::FilteredListMonitor::OnViewModelBoolValueChanged(_UNUSE
     }
 }
 
+void AssetListViewModel::FilteredListMonitor::OnViewModelIntValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args)
+{
+    if (args.Property == ra::data::models::AssetModelBase::CategoryProperty ||
+        args.Property == ra::data::models::AssetModelBase::StateProperty ||
+        args.Property == ra::data::models::AssetModelBase::ChangesProperty)
+    {
+        const auto* pItem = m_pOwner->m_vFilteredAssets.GetItemAt(nIndex);
+        if (pItem != nullptr)
+        {
+            auto nOldCategory = pItem->GetCategory();
+            auto nOldState = pItem->GetState();
+            auto nOldChanges = pItem->GetChanges();
+            if (args.Property == ra::data::models::AssetModelBase::CategoryProperty)
+                nOldCategory = ra::itoe<ra::data::models::AssetCategory>(args.tOldValue);
+            else if (args.Property == ra::data::models::AssetModelBase::StateProperty)
+                nOldState = ra::itoe<ra::data::models::AssetState>(args.tOldValue);
+            else
+                nOldChanges = ra::itoe<ra::data::models::AssetChanges>(args.tOldValue);
+
+            m_pOwner->CountFilteredAsset(pItem->GetType(), nOldCategory, nOldState, nOldChanges, pItem->IsSelected(), -1);
+            m_pOwner->CountFilteredAsset(*pItem, 1);
+        }
+    }
+}
+
 void AssetListViewModel::FilteredListMonitor::OnBeginViewModelCollectionUpdate() noexcept
 {
     m_bUpdateButtonsPending = false;
@@ -619,41 +773,54 @@ void AssetListViewModel::FilteredListMonitor::OnEndViewModelCollectionUpdate()
 
 void AssetListViewModel::UpdateButtons()
 {
-    if (m_bNeedToUpdateButtons.exchange(true) == false)
+    auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+
+    std::lock_guard<std::mutex> lock(m_oUpdateButtonsMutex);
+
+    // wait 300ms before updating the buttons in case more changes are coming. if an update is
+    // already pending, drop it so the buttons are only updated once after the last change.
+    if (m_nUpdateButtonsTaskId != 0)
+        pThreadPool.CancelScheduledTask(m_nUpdateButtonsTaskId);
+
+    m_nUpdateButtonsTaskId = pThreadPool.ScheduleAsync(std::chrono::milliseconds(300), [this]()
     {
-        // wait 300ms before updating the buttons in case more changes are coming
-        ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().ScheduleAsync(
-            std::chrono::milliseconds(300), [this]()
         {
-            if (m_bNeedToUpdateButtons.exchange(false) == true)
-                DoUpdateButtons();
-        });
-    }
+            std::lock_guard<std::mutex> lock(m_oUpdateButtonsMutex);
+            m_nUpdateButtonsTaskId = 0;
+        }
+
+        DoUpdateButtons();
+    });
 }
 
 void AssetListViewModel::DoUpdateButtons()
 {
-    bool bHasCoreSelection = false;
-    bool bHasUnofficialSelection = false;
-    bool bHasLocalSelection = false;
-    bool bHasActiveSelection = false;
-    bool bHasInactiveSelection = false;
-    bool bHasModifiedSelection = false;
-    bool bHasUnpublishedSelection = false;
-    bool bHasNonNewSelection = false;
-    bool bHasSelection = false;
-    bool bHasModified = false;
-    bool bHasUnpublished = false;
-    bool bHasUnofficial = false;
-    bool bHasCore = false;
-    bool bHasLocal = false;
-    gsl::index nRichPresenceSelectionIndex = -1;
-    bool bHasNonRichPresenceSelection = false;
+    // the filtered items are only considered when a game is loaded
+    const bool bGameLoaded = (GetGameId() != 0);
+    const FilteredAssetCounts pNoCounts;
+    const auto& pSelected = bGameLoaded ? m_pSelectedCounts : pNoCounts;
+    const auto& pUnselected = bGameLoaded ? m_pUnselectedCounts : pNoCounts;
+
+    const bool bHasSelection = (pSelected.nTotal > 0);
+    const bool bHasCoreSelection = (pSelected.nCore > 0);
+    const bool bHasUnofficialSelection = (pSelected.nUnofficial > 0);
+    const bool bHasLocalSelection = (pSelected.nLocal > 0);
+    const bool bHasActiveSelection = (pSelected.nActive > 0);
+    const bool bHasInactiveSelection = (pSelected.nInactive > 0);
+    const bool bHasModifiedSelection = (pSelected.nModified + pSelected.nNew > 0);
+    const bool bHasUnpublishedSelection = (pSelected.nUnpublished > 0);
+    const bool bHasNonNewSelection = (pSelected.nTotal > pSelected.nNew);
+    const bool bHasRichPresenceSelection = (pSelected.nRichPresence > 0);
+    const bool bHasNonRichPresenceSelection = (pSelected.nTotal > pSelected.nRichPresence);
+    const bool bHasModified = (pSelected.nModified + pSelected.nNew + pUnselected.nModified + pUnselected.nNew > 0);
+    const bool bHasUnpublished = (pSelected.nUnpublished + pUnselected.nUnpublished > 0);
+    const bool bHasUnofficial = (pSelected.nUnofficial + pUnselected.nUnofficial > 0);
+    const bool bHasCore = (pUnselected.nCore > 0);
+    const bool bHasLocal = (pUnselected.nLocal > 0);
 
     const bool bOffline = ra::services::ServiceLocator::Get<ra::services::IConfiguration>().
         IsFeatureEnabled(ra::services::Feature::Offline);
 
-    const bool bGameLoaded = (GetGameId() != 0);
     if (!bGameLoaded)
     {
         SetValue(CanCreateProperty, false);
@@ -664,100 +831,9 @@ void AssetListViewModel::DoUpdateButtons()
     {
         SetValue(CanCreateProperty, true);
         SetValue(CanActivateProperty, m_vFilteredAssets.Count() > 0);
-
-        for (size_t i = 0; i < m_vFilteredAssets.Count(); ++i)
-        {
-            const auto* pItem = m_vFilteredAssets.GetItemAt(i);
-            if (pItem != nullptr)
-            {
-                switch (pItem->GetChanges())
-                {
-                    case ra::data::models::AssetChanges::Modified:
-                    case ra::data::models::AssetChanges::New:
-                        bHasModified = true;
-                        break;
-                    case ra::data::models::AssetChanges::Unpublished:
-                        bHasUnpublished = true;
-                        break;
-                    default:
-                        break;
-                }
-
-                if (pItem->IsSelected())
-                {
-                    bHasSelection = true;
-
-                    switch (pItem->GetCategory())
-                    {
-                        case ra::data::models::AssetCategory::Core:
-                            bHasCoreSelection = true;
-                            break;
-                        case ra::data::models::AssetCategory::Unofficial:
-                            bHasUnofficial = true;
-                            bHasUnofficialSelection = true;
-                            break;
-                        case ra::data::models::AssetCategory::Local:
-                            bHasLocalSelection = true;
-                            break;
-                        default:
-                            break;
-                    }
-
-                    if (ra::data::models::AssetModelBase::IsActive(pItem->GetState()))
-                        bHasActiveSelection = true;
-                    else
-                        bHasInactiveSelection = true;
-
-                    switch (pItem->GetChanges())
-                    {
-                        case ra::data::models::AssetChanges::New:
-                            bHasModifiedSelection = true;
-                            break;
-                        case ra::data::models::AssetChanges::Modified:
-                            bHasNonNewSelection = true;
-                            bHasModifiedSelection = true;
-                            break;
-                        case ra::data::models::AssetChanges::Unpublished:
-                            bHasNonNewSelection = true;
-                            bHasUnpublishedSelection = true;
-                            break;
-                        default:
-                            bHasNonNewSelection = true;
-                            break;
-                    }
-
-                    switch (pItem->GetType())
-                    {
-                        case ra::data::models::AssetType::RichPresence:
-                            nRichPresenceSelectionIndex = i;
-                            break;
-                        default:
-                            bHasNonRichPresenceSelection = true;
-                            break;
-                    }
-                }
-                else
-                {
-                    switch (pItem->GetCategory())
-                    {
-                        case ra::data::models::AssetCategory::Core:
-                            bHasCore = true;
-                            break;
-                        case ra::data::models::AssetCategory::Unofficial:
-                            bHasUnofficial = true;
-                            break;
-                        case ra::data::models::AssetCategory::Local:
-                            bHasLocal = true;
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
-        }
     }
 
-    if (nRichPresenceSelectionIndex != -1)
+    if (bHasRichPresenceSelection)
     {
         SetValue(CanCreateProperty, true);
         SetValue(CanCloneProperty, false);
@@ -773,10 +849,8 @@ void AssetListViewModel::DoUpdateButtons()
 
         SetValue(RevertButtonTextProperty, L"Re&vert");
 
-        std::vector<AssetSummaryViewModel> vSelectedAssets;
-        SetValue(CanRevertProperty,
-                 (!bHasNonRichPresenceSelection &&
-                  m_vFilteredAssets.GetItemAt(nRichPresenceSelectionIndex)->GetCategory() == ra::data::models::AssetCategory::Core));
+        // when only the rich presence is selected, the core selection tally is for the rich presence
+        SetValue(CanRevertProperty, (!bHasNonRichPresenceSelection && bHasCoreSelection));
 
         return;
     }
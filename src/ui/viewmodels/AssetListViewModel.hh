@@ -12,6 +12,8 @@
 #include "data\models\AchievementModel.hh"
 #include "data\models\AssetModelBase.hh"
 
+#include "services\IThreadPool.hh"
+
 namespace ra {
 namespace ui {
 namespace viewmodels {
@@ -295,6 +297,7 @@ private:
         bool m_bUpdateButtonsPending = false;
 
         void OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args) override;
+        void OnViewModelIntValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args) override;
         void OnBeginViewModelCollectionUpdate() noexcept override;
         void OnEndViewModelCollectionUpdate() override;
     };
@@ -306,17 +309,53 @@ private:
 
     void UpdateTotals();
     void DoUpdateButtons();
-    std::atomic_bool m_bNeedToUpdateButtons = false;
+    ra::services::IThreadPool::ScheduledTaskId m_nUpdateButtonsTaskId = 0;
+    std::mutex m_oUpdateButtonsMutex;
 
+    void UpdateAssetKeys();
     void EnsureAppearsInFilteredList(const ra::data::models::AssetModelBase& pAsset);
     bool MatchesFilter(const ra::data::models::AssetModelBase& pAsset) const;
     void AddOrRemoveFilteredItem(gsl::index nAssetIndex);
     bool AddOrRemoveFilteredItem(const ra::data::models::AssetModelBase& pAsset);
     gsl::index GetFilteredAssetIndex(const ra::data::models::AssetModelBase& pAsset) const;
+    AssetSummaryViewModel* FindFilteredAsset(ra::data::models::AssetType nType, int nId) const;
+    void AppendFilteredAsset(std::unique_ptr<AssetSummaryViewModel> pSummary);
+    void RemoveFilteredAsset(gsl::index nIndex);
     void ApplyFilter();
 
     ViewModelCollection<AssetSummaryViewModel> m_vFilteredAssets;
 
+    // items in m_vFilteredAssets keyed by type and ID so changes to a single asset don't have to scan the list
+    using FilteredAssetKey = std::pair<ra::data::models::AssetType, int>;
+    std::map<FilteredAssetKey, AssetSummaryViewModel*> m_mFilteredAssetIndex;
+    int m_nFilteredAchievementCount = 0;
+    int m_nFilteredPoints = 0;
+
+    // type and ID of each item in GameContext.Assets(), in the same order, so a removed asset can be
+    // identified from its index without searching for the filtered item that no longer has an asset
+    std::vector<FilteredAssetKey> m_vAssetKeys;
+
+    // tallies of the items in m_vFilteredAssets so the buttons can be updated without scanning the list
+    struct FilteredAssetCounts
+    {
+        int nTotal = 0;
+        int nCore = 0;
+        int nUnofficial = 0;
+        int nLocal = 0;
+        int nActive = 0;
+        int nInactive = 0;
+        int nModified = 0;
+        int nNew = 0;
+        int nUnpublished = 0;
+        int nRichPresence = 0;
+    };
+    FilteredAssetCounts m_pUnselectedCounts;
+    FilteredAssetCounts m_pSelectedCounts;
+
+    void CountFilteredAsset(ra::data::models::AssetType nType, ra::data::models::AssetCategory nCategory,
+        ra::data::models::AssetState nState, ra::data::models::AssetChanges nChanges, bool bSelected, int nDelta) noexcept;
+    void CountFilteredAsset(const AssetSummaryViewModel& pItem, int nDelta) noexcept;
+
     ra::AchievementID m_nNextLocalId = FirstLocalId;
 
     LookupItemViewModelCollection m_vStates;
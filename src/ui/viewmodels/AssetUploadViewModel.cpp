@@ -66,7 +66,9 @@ void AssetUploadViewModel::QueueAchievement(ra::data::models::AchievementModel&
             }
         }
 
-        QueueTask([this, sBadge]()
+        // badges are uploaded before anything else so the achievements waiting on them can be uploaded in
+        // parallel with the remaining items.
+        QueuePriorityTask([this, sBadge]()
         {
             UploadBadge(sBadge);
         });
@@ -182,6 +184,7 @@ void AssetUploadViewModel::UploadBadge(const std::wstring& sBadge)
     request.ImageFilePath = sFilename;
 
     std::vector<ra::data::models::AchievementModel*> vAffectedAchievements;
+    bool bRetry = false;
     {
         // only allow one badge upload at a time to prevent a race condition on server that could
         // result in non-unique image IDs being returned.
@@ -203,6 +206,10 @@ void AssetUploadViewModel::UploadBadge(const std::wstring& sBadge)
                         pQueuedAchievement->SetBadge(ra::Widen(response.BadgeId));
                         vAffectedAchievements.push_back(pQueuedAchievement);
                     }
+                    else if (ShouldRetry(pItem, response.Result))
+                    {
+                        bRetry = true;
+                    }
                     else
                     {
                         pItem.sErrorMessage = response.ErrorMessage;
@@ -213,6 +220,16 @@ void AssetUploadViewModel::UploadBadge(const std::wstring& sBadge)
         }
     }
 
+    if (bRetry)
+    {
+        RA_LOG_WARN("Could not upload badge %s, retrying", ra::Narrow(sBadge));
+        QueuePriorityTask([this, sBadge]()
+        {
+            UploadBadge(sBadge);
+        });
+        return;
+    }
+
     // the affected achievements can be uploaded now - will be empty on failure
     for (auto* pAchievement : vAffectedAchievements)
     {
@@ -259,16 +276,32 @@ void AssetUploadViewModel::UploadAchievement(ra::data::models::AchievementModel&
     }
 
     // update the queue
-    std::lock_guard<std::mutex> pLock(m_pMutex);
-    for (auto& pScan : m_vUploadQueue)
+    bool bRetry = false;
     {
-        if (pScan.pAsset == &pAchievement)
+        std::lock_guard<std::mutex> pLock(m_pMutex);
+        for (auto& pScan : m_vUploadQueue)
         {
-            pScan.sErrorMessage = response.ErrorMessage;
-            pScan.nState = response.Succeeded() ? UploadState::Success : UploadState::Failed;
-            break;
+            if (pScan.pAsset == &pAchievement)
+            {
+                bRetry = ShouldRetry(pScan, response.Result);
+                if (!bRetry)
+                {
+                    pScan.sErrorMessage = response.ErrorMessage;
+                    pScan.nState = response.Succeeded() ? UploadState::Success : UploadState::Failed;
+                }
+                break;
+            }
         }
     }
+
+    if (bRetry)
+    {
+        RA_LOG_WARN("Could not upload achievement %u, retrying", pAchievement.GetID());
+        QueueTask([this, pAchievement = &pAchievement]()
+        {
+            UploadAchievement(*pAchievement);
+        });
+    }
 }
 
 void AssetUploadViewModel::UploadLeaderboard(ra::data::models::LeaderboardModel& pLeaderboard)
@@ -303,22 +336,39 @@ void AssetUploadViewModel::UploadLeaderboard(ra::data::models::LeaderboardModel&
     }
 
     // update the queue
-    std::lock_guard<std::mutex> pLock(m_pMutex);
-    for (auto& pScan : m_vUploadQueue)
+    bool bRetry = false;
     {
-        if (pScan.pAsset == &pLeaderboard)
+        std::lock_guard<std::mutex> pLock(m_pMutex);
+        for (auto& pScan : m_vUploadQueue)
         {
-            pScan.sErrorMessage = response.ErrorMessage;
-            pScan.nState = response.Succeeded() ? UploadState::Success : UploadState::Failed;
-            break;
+            if (pScan.pAsset == &pLeaderboard)
+            {
+                bRetry = ShouldRetry(pScan, response.Result);
+                if (!bRetry)
+                {
+                    pScan.sErrorMessage = response.ErrorMessage;
+                    pScan.nState = response.Succeeded() ? UploadState::Success : UploadState::Failed;
+                }
+                break;
+            }
         }
     }
+
+    if (bRetry)
+    {
+        RA_LOG_WARN("Could not upload leaderboard %u, retrying", pLeaderboard.GetID());
+        QueueTask([this, pLeaderboard = &pLeaderboard]()
+        {
+            UploadLeaderboard(*pLeaderboard);
+        });
+    }
 }
 
 void AssetUploadViewModel::UploadCodeNote(ra::data::models::CodeNotesModel& pNotes, ra::ByteAddress nAddress)
 {
     std::string sErrorMessage;
     UploadState nState = UploadState::Failed;
+    ra::api::ApiResult nResult = ra::api::ApiResult::None;
 
     const auto* pNote = pNotes.FindCodeNote(nAddress);
     if (pNote == nullptr || pNote->empty())
@@ -336,6 +386,7 @@ void AssetUploadViewModel::UploadCodeNote(ra::data::models::CodeNotesModel& pNot
         }
 
         sErrorMessage = response.ErrorMessage;
+        nResult = response.Result;
     }
     else
     {
@@ -353,19 +404,46 @@ void AssetUploadViewModel::UploadCodeNote(ra::data::models::CodeNotesModel& pNot
         }
 
         sErrorMessage = response.ErrorMessage;
+        nResult = response.Result;
     }
 
     // update the queue
-    std::lock_guard<std::mutex> pLock(m_pMutex);
-    for (auto& pScan : m_vUploadQueue)
+    bool bRetry = false;
     {
-        if (pScan.pAsset == &pNotes && pScan.nExtra == gsl::narrow_cast<int>(nAddress))
+        std::lock_guard<std::mutex> pLock(m_pMutex);
+        for (auto& pScan : m_vUploadQueue)
         {
-            pScan.sErrorMessage = sErrorMessage;
-            pScan.nState = nState;
-            break;
+            if (pScan.pAsset == &pNotes && pScan.nExtra == gsl::narrow_cast<int>(nAddress))
+            {
+                bRetry = ShouldRetry(pScan, nResult);
+                if (!bRetry)
+                {
+                    pScan.sErrorMessage = sErrorMessage;
+                    pScan.nState = nState;
+                }
+                break;
+            }
         }
     }
+
+    if (bRetry)
+    {
+        RA_LOG_WARN("Could not upload code note for address %s, retrying", ra::ByteAddressToString(nAddress));
+        QueueTask([this, pNotes = &pNotes, nAddress]()
+        {
+            UploadCodeNote(*pNotes, nAddress);
+        });
+    }
+}
+
+bool AssetUploadViewModel::ShouldRetry(UploadItem& pItem, ra::api::ApiResult nResult) noexcept
+{
+    // Incomplete indicates the server could not be reached (or asked us to try again later). anything else is a
+    // final answer from the server.
+    if (nResult != ra::api::ApiResult::Incomplete)
+        return false;
+
+    return (++pItem.nAttempts < MaxUploadAttempts);
 }
 
 void AssetUploadViewModel::ShowResults() const
@@ -4,6 +4,8 @@
 
 #include "ProgressViewModel.hh"
 
+#include "api\ApiCall.hh"
+
 #include "data\models\AchievementModel.hh"
 #include "data\models\CodeNotesModel.hh"
 #include "data\models\LeaderboardModel.hh"
@@ -43,9 +45,17 @@ private:
         ra::data::models::AssetModelBase* pAsset = nullptr;
         std::string sErrorMessage;
         int nExtra = 0;
+        int nAttempts = 0;
         UploadState nState = UploadState::None;
     };
 
+    /// <summary>
+    /// The number of times an upload will be attempted if the server could not be reached.
+    /// </summary>
+    static constexpr int MaxUploadAttempts = 3;
+
+    static bool ShouldRetry(UploadItem& pItem, ra::api::ApiResult nResult) noexcept;
+
     void UploadBadge(const std::wstring& sBadge);
     void UploadAchievement(ra::data::models::AchievementModel& pAchievement);
     void UploadLeaderboard(ra::data::models::LeaderboardModel& pLeaderboard);
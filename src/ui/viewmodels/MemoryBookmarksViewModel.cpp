@@ -46,6 +46,14 @@ const StringModelProperty MemoryBookmarksViewModel::FreezeButtonTextProperty("Me
 
 constexpr int MaxTextBookmarkLength = 8;
 
+// bookmarks separated by no more than this many bytes are read from the emulator with a single call
+constexpr unsigned int MaxReadSpanGap = 8;
+
+static constexpr unsigned int GetBookmarkBytes(MemSize nSize)
+{
+    return (nSize == MemSize::Text) ? MaxTextBookmarkLength : ra::data::MemSizeBytes(nSize);
+}
+
 MemoryBookmarksViewModel::MemoryBookmarksViewModel() noexcept
 {
     SetWindowTitle(L"Memory Bookmarks");
@@ -179,19 +187,29 @@ unsigned MemoryBookmarksViewModel::MemoryBookmarkViewModel::ReadValue() const
     const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
     if (m_nSize == MemSize::Text)
     {
-        // only have 32 bits to store the value in. generate a hash for the string
-        std::array<uint8_t, MaxTextBookmarkLength + 1> pBuffer;
-        pEmulatorContext.ReadMemory(m_nAddress, &pBuffer.at(0), pBuffer.size() - 1);
-        pBuffer.at(pBuffer.size() - 1) = '\0';
+        std::array<uint8_t, MaxTextBookmarkLength> pBuffer;
+        pEmulatorContext.ReadMemory(m_nAddress, pBuffer.data(), pBuffer.size());
+        return ReadValue(pBuffer.data());
+    }
 
-        const char* pText;
-        GSL_SUPPRESS_TYPE1 pText = reinterpret_cast<char*>(&pBuffer.at(0));
-        std::string sText(pText);
+    return pEmulatorContext.ReadMemory(m_nAddress, m_nSize);
+}
 
+_Use_decl_annotations_
+unsigned MemoryBookmarksViewModel::MemoryBookmarkViewModel::ReadValue(const uint8_t pMemory[]) const
+{
+    if (m_nSize == MemSize::Text)
+    {
+        // only have 32 bits to store the value in. generate a hash for the string
+        std::array<char, MaxTextBookmarkLength + 1> pText;
+        memcpy(pText.data(), pMemory, MaxTextBookmarkLength);
+        pText.at(MaxTextBookmarkLength) = '\0';
+
+        const std::string sText(pText.data());
         return ra::StringHash(sText);
     }
 
-    return pEmulatorContext.ReadMemory(m_nAddress, m_nSize);
+    return ra::data::context::EmulatorContext::DecodeMemoryValue(pMemory, m_nSize);
 }
 
 void MemoryBookmarksViewModel::MemoryBookmarkViewModel::EndInitialization()
@@ -208,18 +226,15 @@ void MemoryBookmarksViewModel::MemoryBookmarkViewModel::EndInitialization()
     m_bInitialized = true;
 }
 
-bool MemoryBookmarksViewModel::MemoryBookmarkViewModel::MemoryChanged()
+_Use_decl_annotations_
+bool MemoryBookmarksViewModel::MemoryBookmarkViewModel::MemoryChanged(const uint8_t pMemory[])
 {
-    const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
-    const auto nValue = ReadValue();
+    const auto nValue = ReadValue(pMemory);
     if (nValue == m_nValue)
         return false;
 
     if (GetBehavior() == BookmarkBehavior::Frozen)
-    {
-        pEmulatorContext.WriteMemory(m_nAddress, m_nSize, m_nValue);
-        return false;
-    }
+        return true;
 
     m_nValue = nValue;
     OnValueChanged();
@@ -227,6 +242,12 @@ bool MemoryBookmarksViewModel::MemoryBookmarkViewModel::MemoryChanged()
     return true;
 }
 
+void MemoryBookmarksViewModel::MemoryBookmarkViewModel::WriteFrozenValue() const
+{
+    const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
+    pEmulatorContext.WriteMemory(m_nAddress, m_nSize, m_nValue);
+}
+
 void MemoryBookmarksViewModel::MemoryBookmarkViewModel::OnValueChanged()
 {
     const std::wstring sValue = BuildCurrentValue();
@@ -542,8 +563,7 @@ void MemoryBookmarksViewModel::OnByteWritten(ra::ByteAddress nAddress, uint8_t)
         if (nAddress < nBookmarkAddress)
             continue;
 
-        const auto nSize = pBookmark.GetSize();
-        const auto nBytes = (nSize == MemSize::Text) ? MaxTextBookmarkLength : ra::data::MemSizeBytes(nSize);
+        const auto nBytes = GetBookmarkBytes(pBookmark.GetSize());
         if (nAddress >= nBookmarkAddress + nBytes)
             continue;
 
@@ -570,15 +590,132 @@ void MemoryBookmarksViewModel::EndWritingMemory()
     }
 }
 
+void MemoryBookmarksViewModel::OnTotalMemorySizeChanged()
+{
+    // the memory blocks changed. rebuild the read plan so spans don't cross into a block that can't be read.
+    m_vBookmarkReads.clear();
+}
+
+bool MemoryBookmarksViewModel::IsReadPlanValid() const
+{
+    if (m_vBookmarkReads.size() != m_vBookmarks.Count())
+        return false;
+
+    for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
+    {
+        const auto* pBookmark = m_vBookmarks.GetItemAt(nIndex);
+        const auto& pRead = m_vBookmarkReads.at(nIndex);
+        if (pBookmark == nullptr || pBookmark->GetAddress() != pRead.nAddress || pBookmark->GetSize() != pRead.nSize)
+            return false;
+    }
+
+    return true;
+}
+
+void MemoryBookmarksViewModel::BuildReadPlan()
+{
+    std::vector<gsl::index> vOrder;
+    vOrder.reserve(m_vBookmarks.Count());
+
+    m_vBookmarkReads.resize(m_vBookmarks.Count());
+    for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
+    {
+        const auto& pBookmark = *m_vBookmarks.GetItemAt(nIndex);
+        auto& pRead = m_vBookmarkReads.at(nIndex);
+        pRead.nAddress = pBookmark.GetAddress();
+        pRead.nSize = pBookmark.GetSize();
+        pRead.nOffset = 0;
+
+        vOrder.push_back(nIndex);
+    }
+
+    std::sort(vOrder.begin(), vOrder.end(), [this](gsl::index nLeft, gsl::index nRight)
+    {
+        return m_vBookmarkReads.at(nLeft).nAddress < m_vBookmarkReads.at(nRight).nAddress;
+    });
+
+    // merge bookmarks that overlap or are close together into a single read. a read that reaches an unreadable
+    // address disables any achievement that uses the start of the read, so a span never leaves the readable block
+    // it starts in. a bookmark that isn't entirely readable is read by itself.
+    const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
+    ra::ByteAddress nSpanLimit = 0;
+    m_vReadSpans.clear();
+    for (const auto nIndex : vOrder)
+    {
+        auto& pRead = m_vBookmarkReads.at(nIndex);
+        const auto nBytes = GetBookmarkBytes(pRead.nSize);
+
+        unsigned int nOffset = 0;
+        if (!m_vReadSpans.empty())
+        {
+            auto& pSpan = m_vReadSpans.back();
+            const auto nSpanEnd = pSpan.nAddress + pSpan.nBytes;
+            if ((pRead.nAddress <= nSpanEnd || pRead.nAddress - nSpanEnd <= MaxReadSpanGap) &&
+                pRead.nAddress + nBytes <= nSpanLimit)
+            {
+                pSpan.nBytes = std::max(nSpanEnd, pRead.nAddress + nBytes) - pSpan.nAddress;
+                pRead.nOffset = pSpan.nOffset + (pRead.nAddress - pSpan.nAddress);
+                continue;
+            }
+
+            nOffset = pSpan.nOffset + pSpan.nBytes;
+        }
+
+        m_vReadSpans.push_back({ pRead.nAddress, nBytes, nOffset });
+        pRead.nOffset = nOffset;
+
+        const auto nReadable = pEmulatorContext.GetReadableBytes(pRead.nAddress);
+        nSpanLimit = (nReadable >= nBytes) ? pRead.nAddress + gsl::narrow_cast<ra::ByteAddress>(nReadable) : 0;
+    }
+
+    const auto nBufferSize = m_vReadSpans.empty() ? 0 : m_vReadSpans.back().nOffset + m_vReadSpans.back().nBytes;
+    m_vReadBuffer.resize(nBufferSize);
+}
+
 void MemoryBookmarksViewModel::DoFrame()
 {
+    if (!IsReadPlanValid())
+        BuildReadPlan();
+
     auto& pEmulatorContext = ra::services::ServiceLocator::GetMutable<ra::data::context::EmulatorContext>();
-    pEmulatorContext.RemoveNotifyTarget(*this);
+    for (const auto& pSpan : m_vReadSpans)
+        pEmulatorContext.ReadMemory(pSpan.nAddress, &m_vReadBuffer.at(pSpan.nOffset), pSpan.nBytes);
+
+    // restore any frozen values first so other bookmarks at the same address see the frozen value
+    for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
+    {
+        auto& pBookmark = *m_vBookmarks.GetItemAt(nIndex);
+        if (pBookmark.GetBehavior() == BookmarkBehavior::Frozen &&
+            pBookmark.MemoryChanged(&m_vReadBuffer.at(m_vBookmarkReads.at(nIndex).nOffset)))
+        {
+            m_vFrozenBookmarks.push_back(nIndex);
+        }
+    }
+
+    if (!m_vFrozenBookmarks.empty())
+    {
+        // we already know the frozen values, don't need to be notified that they were written
+        pEmulatorContext.RemoveNotifyTarget(*this);
+
+        for (const auto nIndex : m_vFrozenBookmarks)
+        {
+            m_vBookmarks.GetItemAt(nIndex)->WriteFrozenValue();
+
+            const auto& pRead = m_vBookmarkReads.at(nIndex);
+            pEmulatorContext.ReadMemory(pRead.nAddress, &m_vReadBuffer.at(pRead.nOffset), GetBookmarkBytes(pRead.nSize));
+        }
+
+        pEmulatorContext.AddNotifyTarget(*this);
+        m_vFrozenBookmarks.clear();
+    }
 
     for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
     {
         auto& pBookmark = *m_vBookmarks.GetItemAt(nIndex);
-        if (pBookmark.MemoryChanged())
+        if (pBookmark.GetBehavior() == BookmarkBehavior::Frozen)
+            continue;
+
+        if (pBookmark.MemoryChanged(&m_vReadBuffer.at(m_vBookmarkReads.at(nIndex).nOffset)))
         {
             if (pBookmark.GetBehavior() == BookmarkBehavior::PauseOnChange)
             {
@@ -625,8 +762,6 @@ void MemoryBookmarksViewModel::DoFrame()
             pBookmark.SetRowColor(ra::ui::Color(ra::to_unsigned(MemoryBookmarkViewModel::RowColorProperty.GetDefaultValue())));
         }
     }
-
-    pEmulatorContext.AddNotifyTarget(*this);
 }
 
 bool MemoryBookmarksViewModel::HasBookmark(ra::ByteAddress nAddress) const
@@ -223,8 +223,17 @@ public:
         /// <summary>
         /// Determines if the bookmarked memory has changed since the last time MemoryChanged was called.
         /// </summary>
+        /// <param name="pMemory">The memory at the bookmarked address.</param>
         /// <returns><c>true</c> if the memory has changed, <c>false</c> if not.</returns>
-        bool MemoryChanged();
+        /// <remarks>
+        /// The value of a frozen bookmark is not updated. Call <see cref="WriteFrozenValue" /> to restore it.
+        /// </remarks>
+        bool MemoryChanged(_In_ const uint8_t pMemory[]);
+
+        /// <summary>
+        /// Writes the current value of the bookmark back to memory.
+        /// </summary>
+        void WriteFrozenValue() const;
 
         /// <summary>
         /// Starts initialization of the bookmark.
@@ -263,6 +272,7 @@ public:
         void OnValueChanged();
 
         unsigned ReadValue() const;
+        unsigned ReadValue(_In_ const uint8_t pMemory[]) const;
 
     private:
         std::wstring BuildCurrentValue() const;
@@ -382,6 +392,7 @@ protected:
 
     // ra::data::context::EmulatorContext::NotifyTarget
     void OnByteWritten(ra::ByteAddress, uint8_t) override;
+    void OnTotalMemorySizeChanged() override;
 
     // ra::ui::ViewModelCollectionBase::NotifyTarget
     void OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args) override;
@@ -395,6 +406,29 @@ private:
     bool ShouldFreeze() const;
     void UpdateFreezeButtonText();
 
+    bool IsReadPlanValid() const;
+    void BuildReadPlan();
+
+    // bookmarks near each other in the same memory block are read from the emulator with a single call
+    struct MemoryReadSpan
+    {
+        ra::ByteAddress nAddress;
+        unsigned int nBytes;
+        unsigned int nOffset;
+    };
+    std::vector<MemoryReadSpan> m_vReadSpans;
+
+    // where each bookmark's memory is in m_vReadBuffer (index-aligned with m_vBookmarks)
+    struct BookmarkRead
+    {
+        ra::ByteAddress nAddress;
+        MemSize nSize;
+        unsigned int nOffset;
+    };
+    std::vector<BookmarkRead> m_vBookmarkReads;
+    std::vector<uint8_t> m_vReadBuffer;
+    std::vector<gsl::index> m_vFrozenBookmarks;
+
     ViewModelCollection<MemoryBookmarkViewModel> m_vBookmarks;
     LookupItemViewModelCollection m_vSizes;
     LookupItemViewModelCollection m_vFormats;
@@ -718,6 +718,9 @@ void MemorySearchViewModel::UpdateResults()
     m_vResults.RemoveNotifyTarget(*this);
     m_vResults.BeginUpdate();
 
+    // reused for each row to avoid allocating a new string per row
+    std::wstring sAddressBuffer;
+
     unsigned int nRow = 0;
     while (nRow < SEARCH_ROWS_DISPLAYED)
     {
@@ -733,21 +736,23 @@ void MemorySearchViewModel::UpdateResults()
 
         pRow->nAddress = pResult.nAddress;
 
-        auto sAddress = ra::ByteAddressToString(pResult.nAddress);
+        ra::FixedString<wchar_t, 11> sAddress;
+        ra::AppendByteAddress(sAddress, pResult.nAddress);
         switch (pResult.nSize)
         {
             case MemSize::Nibble_Lower:
-                sAddress.push_back('L');
+                sAddress.Append(L'L');
                 pRow->nAddress <<= 1;
                 break;
 
             case MemSize::Nibble_Upper:
-                sAddress.push_back('U');
+                sAddress.Append(L'U');
                 pRow->nAddress = (pRow->nAddress << 1) | 1;
                 break;
         }
 
-        pRow->SetAddress(ra::Widen(sAddress));
+        sAddressBuffer.assign(sAddress.View());
+        pRow->SetAddress(sAddressBuffer);
 
         UpdateResult(*pRow, pCurrentResults.pResults, pResult, true, pEmulatorContext);
 
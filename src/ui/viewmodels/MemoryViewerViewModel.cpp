@@ -176,16 +176,32 @@ void MemoryViewerViewModel::UpdateColors()
     const auto nVisibleLines = GetNumVisibleLines();
     const auto nFirstAddress = GetFirstAddress();
 
-    // identify bookmarks
-    const auto& pBookmarksViewModel = ra::services::ServiceLocator::Get<ra::ui::viewmodels::WindowManager>().MemoryBookmarks;
-    for (int i = 0; i < nVisibleLines * 16; ++i)
-        m_pColor[i] = STALE_COLOR | gsl::narrow_cast<uint8_t>(ra::etoi(GetColor(nFirstAddress + i, pBookmarksViewModel, pGameContext, false)));
+    memset(m_pColor, STALE_COLOR | gsl::narrow_cast<uint8_t>(ra::etoi(TextColor::Default)), gsl::narrow_cast<size_t>(nVisibleLines) * 16);
+
+    // identify bookmarks. walk the bookmark list once rather than searching it for every visible byte
+    const auto nStopAddress = nFirstAddress + nVisibleLines * 16;
+    const auto& pBookmarks = ra::services::ServiceLocator::Get<ra::ui::viewmodels::WindowManager>().MemoryBookmarks.Bookmarks();
+    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(pBookmarks.Count()); ++nIndex)
+    {
+        const auto* pBookmark = pBookmarks.GetItemAt(nIndex);
+        if (pBookmark == nullptr)
+            continue;
+
+        const auto nAddress = pBookmark->GetAddress();
+        if (nAddress < nFirstAddress || nAddress >= nStopAddress)
+            continue;
+
+        auto& nColor = m_pColor[nAddress - nFirstAddress];
+        if (pBookmark->GetBehavior() == MemoryBookmarksViewModel::BookmarkBehavior::Frozen)
+            nColor = STALE_COLOR | gsl::narrow_cast<uint8_t>(ra::etoi(TextColor::Frozen));
+        else if ((nColor & 0x0F) != ra::etoi(TextColor::Frozen))
+            nColor = STALE_COLOR | gsl::narrow_cast<uint8_t>(ra::etoi(TextColor::HasBookmark));
+    }
 
     // apply code notes
     const auto* pCodeNotes = pGameContext.Assets().FindCodeNotes();
     if (pCodeNotes != nullptr)
     {
-        const auto nStopAddress = nFirstAddress + nVisibleLines * 16;
         pCodeNotes->EnumerateCodeNotes([nFirstAddress, nStopAddress, this](ra::ByteAddress nAddress, unsigned nBytes, const std::wstring&) {
             if (nAddress + nBytes <= nFirstAddress)
                 return true;
@@ -986,6 +1002,23 @@ void MemoryViewerViewModel::BuildFontSurface()
             m_pFontSurface->WriteText(j * m_szChar.Width, i * m_szChar.Height - 1, m_nFont, nColor, sHexChar);
         }
     }
+
+    // pre-compose both nibbles of every byte value (plus the invalid "--" tile) so the common case of drawing
+    // a byte where both nibbles share a color is a single blit.
+    const int nTileWidth = m_szChar.Width * 2;
+    m_pByteSurface = pSurfaceFactory.CreateSurface(nTileWidth * (256 + 1), m_szChar.Height * ra::etoi(TextColor::NumColors));
+    for (int i = 0; i < ra::etoi(TextColor::NumColors); ++i)
+    {
+        const int nY = i * m_szChar.Height;
+        for (int j = 0; j < 256; ++j)
+        {
+            m_pByteSurface->DrawSurface(j * nTileWidth, nY, *m_pFontSurface, (j >> 4) * m_szChar.Width, nY, m_szChar.Width, m_szChar.Height);
+            m_pByteSurface->DrawSurface(j * nTileWidth + m_szChar.Width, nY, *m_pFontSurface, (j & 0x0F) * m_szChar.Width, nY, m_szChar.Width, m_szChar.Height);
+        }
+
+        m_pByteSurface->DrawSurface(256 * nTileWidth, nY, *m_pFontSurface, 16 * m_szChar.Width, nY, m_szChar.Width, m_szChar.Height);
+        m_pByteSurface->DrawSurface(256 * nTileWidth + m_szChar.Width, nY, *m_pFontSurface, 16 * m_szChar.Width, nY, m_szChar.Width, m_szChar.Height);
+    }
 }
 
 #pragma warning(push)
@@ -1037,10 +1070,26 @@ void MemoryViewerViewModel::RenderMemory()
     if (nFirstAddress + nVisibleLines * 16 > m_nTotalMemorySize)
         nVisibleLines = (m_nTotalMemorySize - nFirstAddress) / 16;
 
+    constexpr uint64_t STALE_MASK = 0x8080808080808080ULL;
+    constexpr int nStride = sizeof(STALE_MASK);
+
     const int nWordSpacing = NibblesPerWord() + 1;
     const int nBytesPerWord = nWordSpacing / 2;
     for (int i = 0; i < nVisibleLines * 16; ++i)
     {
+        if ((i % nStride) == 0)
+        {
+            // most cells don't change from frame to frame. check the stale bits of a whole group of cells at
+            // once and skip the group if none of them need to be redrawn.
+            uint64_t nGroup = 0;
+            memcpy(&nGroup, &m_pColor[i], nStride);
+            if ((nGroup & STALE_MASK) == 0)
+            {
+                i += nStride - 1;
+                continue;
+            }
+        }
+
         if (!(m_pColor[i] & STALE_COLOR))
             continue;
 
@@ -1080,7 +1129,12 @@ void MemoryViewerViewModel::RenderMemory()
             }
         }
 
-        if (m_pInvalid[i])
+        if (nColorUpper == nColorLower)
+        {
+            constexpr int INVALID_BYTE = 256;
+            WriteByte(nX, nY, nColorUpper, m_pInvalid[i] ? INVALID_BYTE : m_pMemory[i]);
+        }
+        else if (m_pInvalid[i])
         {
             constexpr int INVALID_CHAR = 16;
             WriteChar(nX, nY, nColorUpper, INVALID_CHAR);
@@ -1102,6 +1156,12 @@ void MemoryViewerViewModel::WriteChar(int nX, int nY, TextColor nColor, int hexC
     m_pSurface->DrawSurface(nX, nY, *m_pFontSurface, hexChar * m_szChar.Width, ra::etoi(nColor) * m_szChar.Height, m_szChar.Width, m_szChar.Height);
 }
 
+void MemoryViewerViewModel::WriteByte(int nX, int nY, TextColor nColor, int nByte)
+{
+    const int nTileWidth = m_szChar.Width * 2;
+    m_pSurface->DrawSurface(nX, nY, *m_pByteSurface, nByte * nTileWidth, ra::etoi(nColor) * m_szChar.Height, nTileWidth, m_szChar.Height);
+}
+
 void MemoryViewerViewModel::RenderAddresses()
 {
     auto nVisibleLines = GetNumVisibleLines();
@@ -216,6 +216,7 @@ private:
     void RenderHeader();
     void RenderMemory();
     void WriteChar(int nX, int nY, TextColor nColor, int hexChar);
+    void WriteByte(int nX, int nY, TextColor nColor, int nByte);
 
     void UpdateColor(ra::ByteAddress nAddress);
     void UpdateColors();
@@ -227,6 +228,7 @@ private:
 
     std::unique_ptr<ra::ui::drawing::ISurface> m_pSurface;
     std::unique_ptr<ra::ui::drawing::ISurface> m_pFontSurface;
+    std::unique_ptr<ra::ui::drawing::ISurface> m_pByteSurface; // both nibbles of every byte value in every color
     std::unique_ptr<uint8_t[]> m_pBuffer;
 
     int m_nFont = 0;
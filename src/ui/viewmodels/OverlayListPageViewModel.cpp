@@ -228,9 +228,12 @@ void OverlayListPageViewModel::RenderList(ra::ui::drawing::ISurface& pSurface, i
 
                 const auto nProgressFont = pSurface.LoadFont(pTheme.FontOverlay(), 14, ra::ui::FontStyles::Normal);
                 const auto nProgressBarPercent = gsl::narrow_cast<int>(static_cast<long long>(nValue) * 100 / nTarget);
-                const std::wstring sProgress = pItem->IsProgressPercentage() ?
-                    ra::StringPrintf(L"%d%%", nProgressBarPercent) :
-                    ra::StringPrintf(L"%u/%u", nValue, nTarget);
+                ra::FixedString<wchar_t, 24> sProgressText;
+                if (pItem->IsProgressPercentage())
+                    sProgressText.AppendDecimal(nProgressBarPercent).Append(L'%');
+                else
+                    sProgressText.AppendDecimal(nValue).Append(L'/').AppendDecimal(nTarget);
+                const std::wstring sProgress(sProgressText.View());
                 const auto szProgress = pSurface.MeasureText(nProgressFont, sProgress);
                 pSurface.WriteText(nTextX + 12 + nProgressBarWidth + 6, nY + 1 + 26 + 25 + 4 - (szProgress.Height / 2) - 1, nProgressFont, nSubTextColor, sProgress);
             }
@@ -26,18 +26,15 @@ static void RenderPopup(ra::ui::drawing::ISurface& pSurface, const PopupViewMode
     pSurface.DrawSurface(nX, nY, vmPopup.GetRenderImage());
 }
 
-static void RenderPopupClippedX(ra::ui::drawing::ISurface& pSurface, const PopupViewModelBase& vmPopup, int nClipX)
+static void RenderPopupRegions(ra::ui::drawing::ISurface& pSurface, const PopupViewModelBase& vmPopup,
+    const std::vector<ra::ui::Rect>& vRegions)
 {
     if (!vmPopup.IsAnimationStarted())
         return;
 
     const auto nX = vmPopup.GetRenderLocationX();
     const auto nY = vmPopup.GetRenderLocationY();
-
-    const auto& pImage = vmPopup.GetRenderImage();
-    const int nVisibleWidth = nX + ra::to_signed(pImage.GetWidth()) - nClipX;
-    if (nVisibleWidth > 0)
-        pSurface.DrawSurface(nClipX, nY, pImage, pImage.GetWidth() - nVisibleWidth, 0, nVisibleWidth, pImage.GetHeight());
+    pSurface.DrawSurfaceRegions(nX, nY, vmPopup.GetRenderImage(), vRegions);
 }
 
 void OverlayManager::InitializeNotifyTargets()
@@ -172,18 +169,9 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
             UpdateChallengeIndicators(pSurface, pPopupLocations, fElapsed);
 
         // if anything changed, or caller requested a repaint, do so now
-        if (m_bRedrawAll)
+        if (m_bRedrawAll || !m_vDirtyRegions.empty())
         {
-            // render pass - items that should appear over other items should be drawn last
-            if (!m_vScoreboards.empty())
-                RenderPopup(pSurface, m_vScoreboards.front());
-            for (const auto& pScoreTracker : m_vScoreTrackers)
-                RenderPopup(pSurface, *pScoreTracker);
-            for (const auto& pChallengeIndicator : m_vChallengeIndicators)
-                RenderPopup(pSurface, *pChallengeIndicator);
-            if (!m_vPopupMessages.empty())
-                RenderPopup(pSurface, *m_vPopupMessages.front());
-
+            RenderPopups(pSurface);
             bRequestRender = true;
         }
     }
@@ -198,6 +186,7 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
     // update state now, in case handlers cause recursion
     m_tLastRender = tNow;
     m_bRedrawAll = false;
+    m_vDirtyRegions.clear();
 
     if (bRequestRender)
     {
@@ -217,6 +206,35 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
     }
 }
 
+void OverlayManager::RenderPopups(ra::ui::drawing::ISurface& pSurface)
+{
+    // erase anything that moved or changed
+    if (!m_vDirtyRegions.empty())
+        pSurface.ClearRegions(m_vDirtyRegions);
+
+    // render pass - items that should appear over other items should be drawn last. if only part of the
+    // surface changed, only redraw the portions of each popup that intersect the changed areas. popups
+    // that don't intersect a changed area keep the image already on the surface.
+    const auto fRender = [this, &pSurface](const PopupViewModelBase& vmPopup)
+    {
+        if (m_bRedrawAll)
+            RenderPopup(pSurface, vmPopup);
+        else
+            RenderPopupRegions(pSurface, vmPopup, m_vDirtyRegions);
+    };
+
+    if (!m_vScoreboards.empty())
+        fRender(m_vScoreboards.front());
+    for (const auto& pScoreTracker : m_vScoreTrackers)
+        fRender(*pScoreTracker);
+    for (const auto& pChallengeIndicator : m_vChallengeIndicators)
+        fRender(*pChallengeIndicator);
+    if (!m_vPopupMessages.empty())
+        fRender(*m_vPopupMessages.front());
+
+    m_vDirtyRegions.clear();
+}
+
 ScoreTrackerViewModel& OverlayManager::AddScoreTracker(ra::LeaderboardID nLeaderboardId)
 {
     ScoreTrackerViewModel* vmTracker;
@@ -411,6 +429,44 @@ ra::ui::Position OverlayManager::GetRenderLocation(const ra::ui::viewmodels::Pop
     return nPos;
 }
 
+void OverlayManager::AddDirtyRegion(const ra::ui::Rect& rcRegion)
+{
+    if (rcRegion.IsEmpty())
+        return;
+
+    // merge with any overlapping regions so overlapping areas aren't drawn multiple times
+    ra::ui::Rect rcMerged = rcRegion;
+    auto pIter = m_vDirtyRegions.begin();
+    while (pIter != m_vDirtyRegions.end())
+    {
+        if (pIter->Intersects(rcMerged))
+        {
+            rcMerged = rcMerged.Union(*pIter);
+            m_vDirtyRegions.erase(pIter);
+
+            // the merged region may now overlap regions that were previously checked
+            pIter = m_vDirtyRegions.begin();
+        }
+        else
+        {
+            ++pIter;
+        }
+    }
+
+    // popups stack in at most six locations. if there are more regions than that, just use
+    // the bounding rectangle of all of them.
+    constexpr size_t nMaxRegions = 8;
+    if (m_vDirtyRegions.size() == nMaxRegions)
+    {
+        for (const auto& rcDirty : m_vDirtyRegions)
+            rcMerged = rcMerged.Union(rcDirty);
+
+        m_vDirtyRegions.clear();
+    }
+
+    m_vDirtyRegions.push_back(rcMerged);
+}
+
 void OverlayManager::UpdatePopup(ra::ui::drawing::ISurface& pSurface, const PopupLocations& pPopupLocations, double fElapsed, ra::ui::viewmodels::PopupViewModelBase& vmPopup)
 {
     constexpr int nFudge = 4;
@@ -437,55 +493,41 @@ void OverlayManager::UpdatePopup(ra::ui::drawing::ISurface& pSurface, const Popu
 
     if (vmPopup.IsDestroyPending())
     {
-        pSurface.FillRectangle(nOldX, nOldY, nOldWidth, nOldHeight, ra::ui::Color::Transparent);
-        m_bRedrawAll = true;
+        AddDirtyRegion({ nOldX, nOldY, ra::to_signed(nOldWidth), ra::to_signed(nOldHeight) });
         return;
     }
 
-    m_bRedrawAll |= vmPopup.UpdateRenderImage(fElapsed);
+    const bool bImageChanged = vmPopup.UpdateRenderImage(fElapsed);
 
     const auto& pNewImage = vmPopup.GetRenderImage();
+    const int nNewWidth = ra::to_signed(pNewImage.GetWidth());
+    const int nNewHeight = ra::to_signed(pNewImage.GetHeight());
 
     const auto nNewPos = GetRenderLocation(vmPopup, vmPopup.GetHorizontalOffset(),
         vmPopup.GetVerticalOffset(), pSurface, pPopupLocations);
 
-    // eliminate any excess to the left or right of the popup
-    if (nOldX != nNewPos.X || nOldWidth != pNewImage.GetWidth())
+    const bool bMoved = (nOldX != nNewPos.X || nOldY != nNewPos.Y);
+    if (bMoved)
     {
         vmPopup.SetRenderLocationX(nNewPos.X);
+        vmPopup.SetRenderLocationY(nNewPos.Y);
+    }
 
+    if (bMoved || nOldWidth != pNewImage.GetWidth() || nOldHeight != pNewImage.GetHeight())
+    {
+        // eliminate anything left behind by the old image. the old area is slightly expanded
+        // to account for rounding when the popup was moving.
         if (nOldWidth != 0)
         {
-            const int nHeight = pNewImage.GetHeight() + std::abs(nNewPos.Y - nOldY);
-            if (nNewPos.X > nOldX)
-                pSurface.FillRectangle(nOldX - nFudge, nOldY, nNewPos.X - nOldX + nFudge, nHeight, ra::ui::Color::Transparent);
-
-            const int nOldRightBound = nOldX + nOldWidth;
-            const int nNewRightBound = nNewPos.X + pNewImage.GetWidth();
-            if (nNewRightBound < nOldRightBound)
-                pSurface.FillRectangle(nNewRightBound, nOldY, nOldRightBound - nNewRightBound + nFudge, nHeight, ra::ui::Color::Transparent);
+            AddDirtyRegion({ nOldX - nFudge, nOldY - nFudge,
+                ra::to_signed(nOldWidth) + nFudge * 2, ra::to_signed(nOldHeight) + nFudge * 2 });
         }
 
-        m_bRedrawAll = true;
+        AddDirtyRegion({ nNewPos.X, nNewPos.Y, nNewWidth, nNewHeight });
     }
-
-    // eliminate any excess above or below the popup
-    if (nOldY != nNewPos.Y || nOldHeight != pNewImage.GetHeight())
+    else if (bImageChanged)
     {
-        vmPopup.SetRenderLocationY(nNewPos.Y);
-
-        if (nOldHeight != 0)
-        {
-            if (nNewPos.Y > nOldY)
-                pSurface.FillRectangle(nNewPos.X, nOldY - nFudge, pNewImage.GetWidth(), nNewPos.Y - nOldY + nFudge, ra::ui::Color::Transparent);
-
-            const int nOldLowerBound = nOldY + nOldHeight;
-            const int nNewLowerBound = nNewPos.Y + pNewImage.GetHeight();
-            if (nNewLowerBound < nOldLowerBound)
-                pSurface.FillRectangle(nNewPos.X, nNewLowerBound, pNewImage.GetWidth(), nOldLowerBound - nNewLowerBound + nFudge, ra::ui::Color::Transparent);
-        }
-
-        m_bRedrawAll = true;
+        AddDirtyRegion({ nNewPos.X, nNewPos.Y, nNewWidth, nNewHeight });
     }
 }
 
@@ -649,28 +691,15 @@ void OverlayManager::UpdateOverlay(ra::ui::drawing::ISurface& pSurface, double f
         m_vmOverlay.Resize(pSurface.GetWidth(), pSurface.GetHeight());
     }
 
-    if (m_vmOverlay.CurrentState() == OverlayViewModel::State::FadeOut)
+    UpdatePopup(pSurface, pPopupLocations, fElapsed, m_vmOverlay);
+    if (!m_vDirtyRegions.empty())
     {
-        // when fading out, have to redraw the popups that were obscured by the overlay
-        const int nOverlayRight = m_vmOverlay.GetHorizontalOffset() +
-            m_vmOverlay.GetRenderImage().GetWidth();
-
-        for (const auto& pChallengeIndicator : m_vChallengeIndicators)
-            RenderPopupClippedX(pSurface, *pChallengeIndicator, nOverlayRight);
-
-        for (const auto& pTracker : m_vScoreTrackers)
-            RenderPopupClippedX(pSurface, *pTracker, nOverlayRight);
-
-        if (!m_vScoreboards.empty())
-            RenderPopupClippedX(pSurface, m_vScoreboards.front(), nOverlayRight);
-
-        if (!m_vPopupMessages.empty())
-            RenderPopupClippedX(pSurface, *m_vPopupMessages.front(), nOverlayRight);
-
+        // erase anything left behind by the overlay's previous position and redraw the parts of any
+        // popups that were obscured by the overlay. the overlay will be drawn over them.
+        RenderPopups(pSurface);
         m_bRedrawAll = true;
     }
 
-    UpdatePopup(pSurface, pPopupLocations, fElapsed, m_vmOverlay);
     if (m_bRedrawAll)
         RenderPopup(pSurface, m_vmOverlay);
 
@@ -692,6 +721,11 @@ void OverlayManager::UpdateOverlay(ra::ui::drawing::ISurface& pSurface, double f
 
 void OverlayManager::CaptureScreenshot(int nMessageId, const std::wstring& sPath)
 {
+    // this is called on the emulator thread while the achievement is being processed. only copy the
+    // client area here. composing, encoding, and writing the image are done on background threads.
+    const auto& pClock = ra::services::ServiceLocator::Get<ra::services::IClock>();
+    const auto tStart = pClock.UpTime();
+
     {
         std::lock_guard<std::mutex> pGuard(m_pScreenshotQueueMutex);
 
@@ -709,7 +743,9 @@ void OverlayManager::CaptureScreenshot(int nMessageId, const std::wstring& sPath
         const auto& pDesktop = ra::services::ServiceLocator::Get<ra::ui::IDesktop>();
         pScreenshot.pScreen = pDesktop.CaptureClientArea(pWindowManager.Emulator);
 
-        RA_LOG_INFO("Queued screenshot %s", sPath);
+        const auto tCaptureTime = std::chrono::duration_cast<std::chrono::microseconds>(pClock.UpTime() - tStart);
+        m_nLastScreenshotCaptureMicroseconds = tCaptureTime.count();
+        RA_LOG_INFO("Queued screenshot %s (%dus)", sPath, gsl::narrow_cast<int>(tCaptureTime.count()));
 
         if (m_bProcessingScreenshots)
             return;
@@ -728,6 +764,12 @@ void OverlayManager::ProcessScreenshots()
     std::map<std::wstring, std::unique_ptr<ra::ui::drawing::ISurface>> mReady;
     const auto& pImageRepository = ra::services::ServiceLocator::Get<ra::ui::IImageRepository>();
 
+    size_t nAvailableSaveSlots = 0;
+    {
+        std::lock_guard<std::mutex> pGuard(m_pScreenshotSaveMutex);
+        nAvailableSaveSlots = MaxPendingScreenshotSaves - m_vScreenshotSaveQueue.size();
+    }
+
     {
         std::lock_guard<std::mutex> pGuard(m_pScreenshotQueueMutex);
 
@@ -739,11 +781,16 @@ void OverlayManager::ProcessScreenshots()
             while (iter != pScreenshot.vMessages.end())
             {
                 auto* pMessage = GetMessage(iter->first);
-                if (pMessage == nullptr)
+                if (pMessage == nullptr || !pScreenshot.pScreen)
                 {
-                    // popup no longer available, discard request
-                    iter = pScreenshot.vMessages.erase(iter);
+                    // popup or client area no longer available, discard request
                     RA_LOG_INFO("Popup no longer available for %s", iter->second);
+                    iter = pScreenshot.vMessages.erase(iter);
+                }
+                else if (nAvailableSaveSlots == 0)
+                {
+                    // too many screenshots waiting to be written. try again later
+                    ++iter;
                 }
                 else
                 {
@@ -759,6 +806,7 @@ void OverlayManager::ProcessScreenshots()
 
                         mReady.insert_or_assign(iter->second, RenderScreenshot(*pScreenshot.pScreen, *pMessage));
                         iter = pScreenshot.vMessages.erase(iter);
+                        --nAvailableSaveSlots;
                     }
                     else
                     {
@@ -787,19 +835,84 @@ void OverlayManager::ProcessScreenshots()
         }
     }
 
+    if (mReady.empty())
+        return;
+
+    // hand the composed images off to the writer. encoding the PNG is the most expensive part of
+    // the process, so don't hold up the compose step (or the popup queue) while it's happening.
+    {
+        std::lock_guard<std::mutex> pGuard(m_pScreenshotSaveMutex);
+        for (auto& pFile : mReady)
+            m_vScreenshotSaveQueue.push_back({ pFile.first, std::move(pFile.second) });
+
+        if (m_bSavingScreenshots)
+            return;
+
+        m_bSavingScreenshots = true;
+    }
+
+    ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().RunAsync([this]()
+    {
+        SaveScreenshots();
+    });
+}
+
+void OverlayManager::SaveScreenshots()
+{
     const auto& pSurfaceFactory = ra::services::ServiceLocator::Get<ra::ui::drawing::ISurfaceFactory>();
-    for (const auto& pFile : mReady)
+
+    for (;;)
     {
-        RA_LOG_INFO("Saving screenshot %s", pFile.first);
-        pSurfaceFactory.SaveImage(*pFile.second, pFile.first);
+        PendingScreenshotSave pSave;
+        {
+            std::lock_guard<std::mutex> pGuard(m_pScreenshotSaveMutex);
+            if (m_vScreenshotSaveQueue.empty())
+            {
+                m_bSavingScreenshots = false;
+                return;
+            }
+
+            pSave = std::move(m_vScreenshotSaveQueue.front());
+            m_vScreenshotSaveQueue.pop_front();
+        }
+
+        RA_LOG_INFO("Saving screenshot %s", pSave.sPath);
+        pSurfaceFactory.SaveImage(*pSave.pImage, pSave.sPath);
+
+        ReleaseScreenshotSurface(std::move(pSave.pImage));
     }
 }
 
-std::unique_ptr<ra::ui::drawing::ISurface> OverlayManager::RenderScreenshot(const ra::ui::drawing::ISurface& pClientSurface, const PopupMessageViewModel& vmPopup)
+std::unique_ptr<ra::ui::drawing::ISurface> OverlayManager::AcquireScreenshotSurface(unsigned int nWidth, unsigned int nHeight)
 {
+    {
+        std::lock_guard<std::mutex> pGuard(m_pScreenshotSaveMutex);
+        for (auto pIter = m_vScreenshotSurfacePool.begin(); pIter != m_vScreenshotSurfacePool.end(); ++pIter)
+        {
+            if ((*pIter)->GetWidth() == nWidth && (*pIter)->GetHeight() == nHeight)
+            {
+                auto pSurface = std::move(*pIter);
+                m_vScreenshotSurfacePool.erase(pIter);
+                return pSurface;
+            }
+        }
+    }
+
     const auto& pSurfaceFactory = ra::services::ServiceLocator::Get<ra::ui::drawing::ISurfaceFactory>();
-    auto pSurface = pSurfaceFactory.CreateSurface(pClientSurface.GetWidth(), pClientSurface.GetHeight());
+    return pSurfaceFactory.CreateSurface(nWidth, nHeight);
+}
+
+void OverlayManager::ReleaseScreenshotSurface(std::unique_ptr<ra::ui::drawing::ISurface> pSurface)
+{
+    std::lock_guard<std::mutex> pGuard(m_pScreenshotSaveMutex);
+    if (m_vScreenshotSurfacePool.size() < MaxPooledScreenshotSurfaces)
+        m_vScreenshotSurfacePool.push_back(std::move(pSurface));
+}
 
+std::unique_ptr<ra::ui::drawing::ISurface> OverlayManager::RenderScreenshot(const ra::ui::drawing::ISurface& pClientSurface, const PopupMessageViewModel& vmPopup)
+{
+    // the client area covers the entire surface, so a pooled surface doesn't have to be cleared first
+    auto pSurface = AcquireScreenshotSurface(pClientSurface.GetWidth(), pClientSurface.GetHeight());
     pSurface->DrawSurface(0, 0, pClientSurface);
 
     PopupLocations pPopupLocations;
@@ -809,6 +922,7 @@ std::unique_ptr<ra::ui::drawing::ISurface> OverlayManager::RenderScreenshot(cons
 
     if (ra::services::ServiceLocator::Get<ra::ui::OverlayTheme>().Transparent())
     {
+        const auto& pSurfaceFactory = ra::services::ServiceLocator::Get<ra::ui::drawing::ISurfaceFactory>();
         auto pTransparentPopup = pSurfaceFactory.CreateTransparentSurface(pPopupImage.GetWidth(), pPopupImage.GetHeight());
         pTransparentPopup->DrawSurface(0, 0, pPopupImage);
         pTransparentPopup->SetOpacity(0.90);
@@ -186,6 +186,18 @@ public:
     /// </summary>
     void CaptureScreenshot(int nMessageId, const std::wstring& sPath);
 
+    /// <summary>
+    /// Gets how long the most recent call to <see cref="CaptureScreenshot" /> blocked the calling thread.
+    /// </summary>
+    /// <remarks>
+    /// Composing the popup into the screenshot, and encoding and writing the image file, are done on
+    /// background threads, so this should only reflect the cost of copying the client area.
+    /// </remarks>
+    std::chrono::microseconds GetLastScreenshotCaptureTime() const noexcept
+    {
+        return std::chrono::microseconds(m_nLastScreenshotCaptureMicroseconds.load());
+    }
+
     /// <summary>
     /// Advances the frame counter to indicate the capture screen is no longer valid.
     /// </summary>
@@ -345,13 +357,22 @@ private:
     void UpdateScoreTrackers(ra::ui::drawing::ISurface& pSurface, PopupLocations& pPopupLocations, double fElapsed);
     void UpdateChallengeIndicators(ra::ui::drawing::ISurface& pSurface, PopupLocations& pPopupLocations, double fElapsed);
     void UpdatePopup(ra::ui::drawing::ISurface& pSurface, const PopupLocations& pPopupLocations, double fElapsed, ra::ui::viewmodels::PopupViewModelBase& vmPopup);
+    void AddDirtyRegion(const ra::ui::Rect& rcRegion);
+    void RenderPopups(ra::ui::drawing::ISurface& pSurface);
 
     void UpdateOverlay(ra::ui::drawing::ISurface& pSurface, double fElapsed);
 
     void ProcessScreenshots();
     std::unique_ptr<ra::ui::drawing::ISurface> RenderScreenshot(const ra::ui::drawing::ISurface& pClientSurface, const PopupMessageViewModel& vmPopup);
+    void SaveScreenshots();
+    std::unique_ptr<ra::ui::drawing::ISurface> AcquireScreenshotSurface(unsigned int nWidth, unsigned int nHeight);
+    void ReleaseScreenshotSurface(std::unique_ptr<ra::ui::drawing::ISurface> pSurface);
 
     bool m_bRedrawAll = false;
+
+    // areas of the surface that have to be cleared and redrawn. when a popup moves or changes, the
+    // area it previously occupied and the area it now occupies are added to the list.
+    std::vector<ra::ui::Rect> m_vDirtyRegions;
     std::chrono::steady_clock::time_point m_tLastRender{};
     std::chrono::steady_clock::time_point m_tLastRequestRender{};
     std::function<void()> m_fHandleRenderRequest;
@@ -372,6 +393,22 @@ private:
     std::mutex m_pScreenshotQueueMutex;
     std::mutex m_pPopupQueueMutex;
     bool m_bProcessingScreenshots = false;
+    std::atomic<int64_t> m_nLastScreenshotCaptureMicroseconds{ 0 }; // read from other threads
+
+    // composed screenshots waiting to be encoded and written to disk. the queue is bounded so a burst
+    // of unlocks can't hold an unbounded number of full-screen images in memory. composed images are
+    // returned to the pool after they're written so the next screenshot doesn't have to allocate one.
+    struct PendingScreenshotSave
+    {
+        std::wstring sPath;
+        std::unique_ptr<ra::ui::drawing::ISurface> pImage;
+    };
+    static constexpr size_t MaxPendingScreenshotSaves = 4;
+    static constexpr size_t MaxPooledScreenshotSurfaces = 2;
+    std::deque<PendingScreenshotSave> m_vScreenshotSaveQueue;
+    std::vector<std::unique_ptr<ra::ui::drawing::ISurface>> m_vScreenshotSurfacePool;
+    std::mutex m_pScreenshotSaveMutex;
+    bool m_bSavingScreenshots = false;
 };
 
 } // namespace viewmodels
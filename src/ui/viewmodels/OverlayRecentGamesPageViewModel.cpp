@@ -59,8 +59,11 @@ void OverlayRecentGamesPageViewModel::Refresh()
             ra::api::impl::OfflineServer cache;
             for (const auto nGameId : vPendingGames)
             {
+                // only the title and icon are needed. discard the assets as they're read instead of copying them
                 ra::api::FetchGameData::Request request;
                 request.GameId = nGameId;
+                request.AchievementHandler = [](const ra::api::FetchGameData::Response::Achievement&) noexcept {};
+                request.LeaderboardHandler = [](const ra::api::FetchGameData::Response::Leaderboard&) noexcept {};
                 const auto response = cache.FetchGameData(request);
                 if (response.Succeeded())
                 {
@@ -10,13 +10,55 @@ namespace viewmodels {
 const StringModelProperty ProgressViewModel::MessageProperty("ProgressViewModel", "Message", L"");
 const IntModelProperty ProgressViewModel::ProgressProperty("ProgressViewModel", "Progress", 0);
 
+// use up to four threads to process the queue
+static constexpr int MAX_THREADS = 4;
+
 void ProgressViewModel::QueueTask(std::function<void()>&& fTaskHandler)
 {
     auto pItem = std::make_unique<TaskItem>();
     pItem->fTaskHandler = std::move(fTaskHandler);
 
-    std::lock_guard<std::mutex> pGuard(m_pMutex);
-    m_vTasks.emplace_back(std::move(pItem));
+    AddTask(std::move(pItem));
+}
+
+void ProgressViewModel::QueuePriorityTask(std::function<void()>&& fTaskHandler)
+{
+    auto pItem = std::make_unique<TaskItem>();
+    pItem->fTaskHandler = std::move(fTaskHandler);
+    pItem->bPriority = true;
+
+    AddTask(std::move(pItem));
+}
+
+void ProgressViewModel::AddTask(std::unique_ptr<TaskItem> pItem)
+{
+    {
+        std::lock_guard<std::mutex> pGuard(m_pMutex);
+
+        if (pItem->bPriority)
+        {
+            // insert before the first non-priority task that hasn't been started
+            auto pIter = m_vTasks.begin();
+            while (pIter != m_vTasks.end() && ((*pIter)->bPriority || (*pIter)->nState != TaskState::None))
+                ++pIter;
+
+            m_vTasks.insert(pIter, std::move(pItem));
+        }
+        else
+        {
+            m_vTasks.emplace_back(std::move(pItem));
+        }
+
+        // if the queue isn't being processed, BeginTasks will start the workers. if it is, and there are fewer
+        // than the maximum number of workers, start another one so the new task doesn't have to wait for the
+        // existing workers.
+        if (m_nWorkers == 0 || m_nWorkers >= MAX_THREADS || m_bQueueComplete)
+            return;
+
+        ++m_nWorkers;
+    }
+
+    StartWorker();
 }
 
 void ProgressViewModel::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
@@ -35,29 +77,37 @@ void ProgressViewModel::BeginTasks()
 
     OnBegin();
 
-    // use up to four threads to process the queue
-    constexpr int MAX_THREADS = 4;
+    int nWorkers = 0;
+    {
+        std::lock_guard<std::mutex> pGuard(m_pMutex);
+        nWorkers = std::min(gsl::narrow_cast<int>(m_vTasks.size()), MAX_THREADS);
+        m_nWorkers = nWorkers;
+    }
+
+    for (int i = 0; i < nWorkers; ++i)
+        StartWorker();
+}
+
+void ProgressViewModel::StartWorker()
+{
     auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
-    for (int i = 0; i < std::min(gsl::narrow_cast<int>(m_vTasks.size()), MAX_THREADS); ++i)
+    pThreadPool.RunAsync([this, pAsyncHandle = CreateAsyncHandle()]()
     {
-        pThreadPool.RunAsync([this, pAsyncHandle = CreateAsyncHandle()]()
+        ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
+        if (!pAsyncHandle->IsDestroyed())
         {
-            ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
-            if (!pAsyncHandle->IsDestroyed())
-            {
-                ++m_vActiveThreads;
-                ProcessQueue();
-                if (--m_vActiveThreads == 0)
-                {
-                    if (m_bQueueComplete)
-                        OnComplete();
-                }
-            }
-        });
-    }
+            ++m_vActiveThreads;
+            const bool bQueueComplete = ProcessQueue();
+            --m_vActiveThreads;
+
+            // only the worker that finished the last task reports completion
+            if (bQueueComplete)
+                OnComplete();
+        }
+    });
 }
 
-void ProgressViewModel::ProcessQueue()
+bool ProgressViewModel::ProcessQueue()
 {
     do
     {
@@ -66,34 +116,58 @@ void ProgressViewModel::ProcessQueue()
         {
             std::lock_guard<std::mutex> pGuard(m_pMutex);
             if (m_bQueueComplete || GetDialogResult() != DialogResult::None)
-                return;
+            {
+                --m_nWorkers;
+                return false;
+            }
 
+            bool bTaskRunning = false;
             for (auto& pItem : m_vTasks)
             {
-                if (pItem->nState == TaskState::None && !pTask)
-                {
-                    pItem->nState = TaskState::Running;
-                    pTask = pItem.get();
-                }
-                else if (pItem->nState == TaskState::Done)
+                switch (pItem->nState)
                 {
-                    ++nComplete;
+                    case TaskState::None:
+                        if (!pTask)
+                        {
+                            pItem->nState = TaskState::Running;
+                            pTask = pItem.get();
+                        }
+                        break;
+
+                    case TaskState::Running:
+                        bTaskRunning = true;
+                        break;
+
+                    case TaskState::Done:
+                        ++nComplete;
+                        break;
                 }
             }
 
             if (pTask == nullptr)
+            {
+                // nothing left to start. if another worker is still running a task, it may queue more tasks, and
+                // it will process them itself. let it determine when the queue is complete.
+                --m_nWorkers;
+
+                if (bTaskRunning)
+                    return false;
+
                 m_bQueueComplete = true;
+            }
 
             nComplete = nComplete * 100 / gsl::narrow_cast<int>(m_vTasks.size());
         }
 
         SetValue(ProgressProperty, nComplete);
 
-        if (pTask != nullptr)
-        {
-            pTask->fTaskHandler();
-            pTask->nState = TaskState::Done;
-        }
+        if (pTask == nullptr)
+            return true;
+
+        pTask->fTaskHandler();
+
+        std::lock_guard<std::mutex> pGuard(m_pMutex);
+        pTask->nState = TaskState::Done;
     } while (true);
 }
 
@@ -57,8 +57,17 @@ public:
     /// </summary>
     void SetProgress(int nValue) { SetValue(ProgressProperty, nValue); }
 
+    /// <summary>
+    /// Adds a task to the end of the queue. If the queue is already being processed, an additional worker will
+    /// be started if fewer than the maximum number of workers are running.
+    /// </summary>
     void QueueTask(std::function<void()>&& fTaskHandler);
 
+    /// <summary>
+    /// Adds a task to the queue that will be started before any non-priority tasks that haven't started yet.
+    /// </summary>
+    void QueuePriorityTask(std::function<void()>&& fTaskHandler);
+
     const size_t TaskCount() const noexcept { return m_vTasks.size(); }
 
     bool IsProcessingTasks() const noexcept { return m_vActiveThreads != 0; }
@@ -71,7 +80,8 @@ protected:
 
 private:
     void BeginTasks();
-    void ProcessQueue();
+    void StartWorker();
+    bool ProcessQueue();
 
     enum class TaskState
     {
@@ -84,12 +94,16 @@ private:
     {
         std::function<void()> fTaskHandler;
         TaskState nState = TaskState::None;
+        bool bPriority = false;
     };
 
+    void AddTask(std::unique_ptr<TaskItem> pItem);
+
     std::vector<std::unique_ptr<TaskItem>> m_vTasks;
     std::mutex m_pMutex;
     bool m_bQueueComplete = false;
-    int m_vActiveThreads = 0;
+    int m_nWorkers = 0; // guarded by m_pMutex
+    std::atomic<int> m_vActiveThreads{ 0 };
 };
 
 } // namespace viewmodels
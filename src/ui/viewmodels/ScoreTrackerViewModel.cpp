@@ -38,16 +38,27 @@ bool ScoreTrackerViewModel::UpdateRenderImage(_UNUSED double fElapsed)
     const auto& pTheme = ra::services::ServiceLocator::Get<ra::ui::OverlayTheme>();
     const auto nShadowOffset = pTheme.ShadowOffset();
 
-    // create a temporary surface so we can determine the size required for the actual surface
+    // if there isn't an existing surface, create a temporary surface so we can determine the size
+    // required for the actual surface
     const auto& pSurfaceFactory = ra::services::ServiceLocator::Get<ra::ui::drawing::ISurfaceFactory>();
-    auto pTempSurface = pSurfaceFactory.CreateSurface(1, 1);
+    std::unique_ptr<ra::ui::drawing::ISurface> pTempSurface;
+    ra::ui::drawing::ISurface* pMeasureSurface = m_pSurface.get();
+    if (pMeasureSurface == nullptr)
+    {
+        pTempSurface = pSurfaceFactory.CreateSurface(1, 1);
+        pMeasureSurface = pTempSurface.get();
+    }
 
-    const auto nFontText = pTempSurface->LoadFont(pTheme.FontPopup(), pTheme.FontSizePopupLeaderboardTracker(), ra::ui::FontStyles::Normal);
+    const auto nFontText = pMeasureSurface->LoadFont(pTheme.FontPopup(), pTheme.FontSizePopupLeaderboardTracker(), ra::ui::FontStyles::Normal);
 
     const auto sScoreSoFar = GetDisplayText();
-    const auto szScoreSoFar = pTempSurface->MeasureText(nFontText, sScoreSoFar);
+    const auto szScoreSoFar = pMeasureSurface->MeasureText(nFontText, sScoreSoFar);
 
-    m_pSurface = pSurfaceFactory.CreateSurface(szScoreSoFar.Width + 8 + nShadowOffset, szScoreSoFar.Height + nShadowOffset);
+    // most value changes don't change the size of the tracker. only allocate a new surface if the size changed
+    const auto nWidth = szScoreSoFar.Width + 8 + nShadowOffset;
+    const auto nHeight = szScoreSoFar.Height + nShadowOffset;
+    if (!m_pSurface || ra::to_signed(m_pSurface->GetWidth()) != nWidth || ra::to_signed(m_pSurface->GetHeight()) != nHeight)
+        m_pSurface = pSurfaceFactory.CreateSurface(nWidth, nHeight);
 
     // background
     m_pSurface->FillRectangle(0, 0, m_pSurface->GetWidth(), m_pSurface->GetHeight(), Color::Transparent);
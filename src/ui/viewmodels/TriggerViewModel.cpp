@@ -705,6 +705,7 @@ void TriggerViewModel::ResumeConditionMonitor() const
 
 void TriggerViewModel::UpdateVersion()
 {
+    ResetFrameSnapshots();
     SetValue(VersionProperty, GetValue(VersionProperty) + 1);
 }
 
@@ -806,6 +807,8 @@ void TriggerViewModel::UpdateConditions()
 
 void TriggerViewModel::UpdateConditions(const GroupViewModel* pGroup)
 {
+    ResetFrameSnapshots();
+
     m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
     m_vConditions.BeginUpdate();
 
@@ -935,68 +938,101 @@ void TriggerViewModel::RemoveGroup()
 void TriggerViewModel::DoFrame()
 {
     auto* pGroup = m_vGroups.GetItemAt(GetSelectedGroupIndex());
-    if (pGroup != nullptr && pGroup->m_pConditionSet)
+    if (pGroup == nullptr || !pGroup->m_pConditionSet)
+        return;
+
+    // capture the hit counts into a flat array so they can be compared against the previous frame without
+    // going through the property system. in most frames, nothing will have changed.
+    m_vCurrentHits.clear();
+    const rc_condition_t* pCondition = pGroup->m_pConditionSet->conditions;
+    for (; pCondition != nullptr; pCondition = pCondition->next)
+        m_vCurrentHits.push_back(pCondition->current_hits);
+
+    const bool bFullUpdate = (pGroup->m_pConditionSet != m_pHitSnapshotConditionSet ||
+                              m_vCurrentHits.size() != m_vHitSnapshot.size());
+    if (!bFullUpdate && m_vCurrentHits == m_vHitSnapshot)
+        return;
+
+    m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
+    m_vConditions.BeginUpdate();
+
+    unsigned int nHits = 0;
+    bool bIsHitsChain = false;
+    bool bSynchronized = true;
+
+    for (gsl::index nConditionIndex = 0; nConditionIndex < gsl::narrow_cast<gsl::index>(m_vCurrentHits.size()); ++nConditionIndex)
     {
-        m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
-        m_vConditions.BeginUpdate();
+        auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex);
+        if (vmCondition == nullptr)
+        {
+            // assume the trigger is being updated on another thread and we'll
+            // resynchronize the hit counts on the next frame
+            bSynchronized = false;
+            break;
+        }
 
-        unsigned int nHits = 0;
-        bool bIsHitsChain = false;
+        const auto nCurrentHits = m_vCurrentHits.at(nConditionIndex);
+        if (bFullUpdate || nCurrentHits != m_vHitSnapshot.at(nConditionIndex))
+            vmCondition->SetCurrentHits(nCurrentHits);
 
-        gsl::index nConditionIndex = 0;
-        rc_condition_t* pCondition = pGroup->m_pConditionSet->conditions;
-        for (; pCondition != nullptr; pCondition = pCondition->next)
+        if (m_bHasHitChain)
         {
-            auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex++);
-            if (vmCondition == nullptr)
+            switch (vmCondition->GetType())
             {
-                // assume the trigger is being updated on another thread and we'll
-                // resynchronize the hit counts on the next frame
-                break;
-            }
+                case ra::ui::viewmodels::TriggerConditionType::AddHits:
+                    bIsHitsChain = true;
+                    nHits += nCurrentHits;
+                    break;
 
-            vmCondition->SetCurrentHits(pCondition->current_hits);
+                case ra::ui::viewmodels::TriggerConditionType::SubHits:
+                    bIsHitsChain = true;
+                    nHits -= nCurrentHits;
+                    break;
 
-            if (m_bHasHitChain)
-            {
-                switch (vmCondition->GetType())
-                {
-                    case ra::ui::viewmodels::TriggerConditionType::AddHits:
-                        bIsHitsChain = true;
-                        nHits += vmCondition->GetCurrentHits();
-                        break;
-
-                    case ra::ui::viewmodels::TriggerConditionType::SubHits:
-                        bIsHitsChain = true;
-                        nHits -= vmCondition->GetCurrentHits();
-                        break;
-
-                    case ra::ui::viewmodels::TriggerConditionType::AddAddress:
-                    case ra::ui::viewmodels::TriggerConditionType::AddSource:
-                    case ra::ui::viewmodels::TriggerConditionType::SubSource:
-                    case ra::ui::viewmodels::TriggerConditionType::AndNext:
-                    case ra::ui::viewmodels::TriggerConditionType::OrNext:
-                    case ra::ui::viewmodels::TriggerConditionType::ResetNextIf:
-                        break;
-
-                    default:
-                        if (bIsHitsChain)
-                        {
-                            nHits += vmCondition->GetCurrentHits();
-                            vmCondition->SetTotalHits(nHits);
-                            bIsHitsChain = false;
-                        }
-                        nHits = 0;
-                        break;
-                }
+                case ra::ui::viewmodels::TriggerConditionType::AddAddress:
+                case ra::ui::viewmodels::TriggerConditionType::AddSource:
+                case ra::ui::viewmodels::TriggerConditionType::SubSource:
+                case ra::ui::viewmodels::TriggerConditionType::AndNext:
+                case ra::ui::viewmodels::TriggerConditionType::OrNext:
+                case ra::ui::viewmodels::TriggerConditionType::ResetNextIf:
+                    break;
+
+                default:
+                    if (bIsHitsChain)
+                    {
+                        nHits += nCurrentHits;
+                        vmCondition->SetTotalHits(nHits);
+                        bIsHitsChain = false;
+                    }
+                    nHits = 0;
+                    break;
             }
         }
+    }
+
+    m_vConditions.EndUpdate();
+    m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
 
-        m_vConditions.EndUpdate();
-        m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
+    if (bSynchronized)
+    {
+        m_vHitSnapshot.swap(m_vCurrentHits);
+        m_pHitSnapshotConditionSet = pGroup->m_pConditionSet;
+    }
+    else
+    {
+        m_pHitSnapshotConditionSet = nullptr;
     }
 }
 
+void TriggerViewModel::ResetFrameSnapshots() noexcept
+{
+    m_pHitSnapshotConditionSet = nullptr;
+    m_vHitSnapshot.clear();
+
+    m_pRowColorSnapshotTrigger = nullptr;
+    m_vRowColorSnapshot.clear();
+}
+
 bool TriggerViewModel::BuildHitChainTooltip(std::wstring& sTooltip,
     const ViewModelCollection<TriggerConditionViewModel>& vmConditions, gsl::index nIndex)
 {
@@ -1171,60 +1207,74 @@ void TriggerViewModel::UpdateGroupColors(const rc_trigger_t* pTrigger)
 
 void TriggerViewModel::UpdateConditionColors(const rc_trigger_t* pTrigger)
 {
-    // update the condition rows for the currently selected group
-    gsl::index nConditionIndex = 0;
+    // determine which condition (if any) should be used to color each row of the currently selected group
+    const auto nRows = gsl::narrow_cast<gsl::index>(m_vConditions.Count());
+    m_vRowColorConditions.assign(m_vConditions.Count(), nullptr);
+
     if (pTrigger)
     {
         auto* pSelectedGroup = m_vGroups.GetItemAt(GetSelectedGroupIndex());
         if (pSelectedGroup && pSelectedGroup->m_pConditionSet)
         {
+            gsl::index nConditionIndex = 0;
+            const rc_condition_t* pCondition = pSelectedGroup->m_pConditionSet->conditions;
+
             if (pSelectedGroup->m_pConditionSet->is_paused)
             {
                 // when a condset is paused, processing stops when the first pause condition is true. only highlight it
                 bool bFirstPause = true;
-                rc_condition_t* pCondition = pSelectedGroup->m_pConditionSet->conditions;
-                for (; pCondition != nullptr; pCondition = pCondition->next, ++nConditionIndex)
+                for (; pCondition != nullptr && nConditionIndex < nRows; pCondition = pCondition->next, ++nConditionIndex)
                 {
-                    auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex);
-                    if (vmCondition != nullptr)
+                    if (pCondition->pause && bFirstPause)
                     {
-                        if (pCondition->pause && bFirstPause)
-                        {
-                            vmCondition->UpdateRowColor(pCondition);
-
-                            // processing stops when a PauseIf has met its hit target
-                            if (pCondition->type == RC_CONDITION_PAUSE_IF)
-                            {
-                                if (pCondition->required_hits == 0 || pCondition->current_hits == pCondition->required_hits)
-                                    bFirstPause = false;
-                            }
-                        }
-                        else
+                        m_vRowColorConditions.at(nConditionIndex) = pCondition;
+
+                        // processing stops when a PauseIf has met its hit target
+                        if (pCondition->type == RC_CONDITION_PAUSE_IF)
                         {
-                            vmCondition->UpdateRowColor(nullptr);
+                            if (pCondition->required_hits == 0 || pCondition->current_hits == pCondition->required_hits)
+                                bFirstPause = false;
                         }
                     }
                 }
             }
             else
             {
-                rc_condition_t* pCondition = pSelectedGroup->m_pConditionSet->conditions;
-                for (; pCondition != nullptr; pCondition = pCondition->next, ++nConditionIndex)
-                {
-                    auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex);
-                    if (vmCondition != nullptr)
-                        vmCondition->UpdateRowColor(pCondition);
-                }
+                for (; pCondition != nullptr && nConditionIndex < nRows; pCondition = pCondition->next, ++nConditionIndex)
+                    m_vRowColorConditions.at(nConditionIndex) = pCondition;
             }
         }
     }
 
-    for (; nConditionIndex < gsl::narrow_cast<gsl::index>(m_vConditions.Count()); ++nConditionIndex)
+    // the type and target of each condition can only change when the trigger is rebuilt (which resets the
+    // snapshot), so the row color only depends on the current hit count and truthiness of the condition.
+    constexpr uint64_t nNoHighlight = ~uint64_t{0};
+    m_vCurrentRowColors.clear();
+    for (const auto* pCondition : m_vRowColorConditions)
+    {
+        if (pCondition == nullptr)
+            m_vCurrentRowColors.push_back(nNoHighlight);
+        else
+            m_vCurrentRowColors.push_back((uint64_t{pCondition->current_hits} << 1) | (pCondition->is_true ? 1 : 0));
+    }
+
+    const bool bFullUpdate = (pTrigger != m_pRowColorSnapshotTrigger ||
+                              m_vCurrentRowColors.size() != m_vRowColorSnapshot.size());
+    if (!bFullUpdate && m_vCurrentRowColors == m_vRowColorSnapshot)
+        return;
+
+    for (gsl::index nIndex = 0; nIndex < nRows; ++nIndex)
     {
-        auto* pCondition = m_vConditions.GetItemAt(nConditionIndex);
-        if (pCondition != nullptr)
-            pCondition->UpdateRowColor(nullptr);
+        if (bFullUpdate || m_vCurrentRowColors.at(nIndex) != m_vRowColorSnapshot.at(nIndex))
+        {
+            auto* vmCondition = m_vConditions.GetItemAt(nIndex);
+            if (vmCondition != nullptr)
+                vmCondition->UpdateRowColor(m_vRowColorConditions.at(nIndex));
+        }
     }
+
+    m_vRowColorSnapshot.swap(m_vCurrentRowColors);
+    m_pRowColorSnapshotTrigger = pTrigger;
 }
 
 } // namespace viewmodels
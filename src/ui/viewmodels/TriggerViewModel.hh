@@ -170,11 +170,23 @@ private:
 
     void UpdateGroupColors(const rc_trigger_t* pTrigger);
     void UpdateConditionColors(const rc_trigger_t* pTrigger);
+    void ResetFrameSnapshots() noexcept;
 
     ViewModelCollection<GroupViewModel> m_vGroups;
     ViewModelCollection<TriggerConditionViewModel> m_vConditions;
     bool m_bHasHitChain = false;
 
+    // hit counts for the selected group as of the last DoFrame, used to only update rows that changed
+    std::vector<unsigned int> m_vHitSnapshot;
+    std::vector<unsigned int> m_vCurrentHits;
+    const rc_condset_t* m_pHitSnapshotConditionSet = nullptr;
+
+    // per-row state that determines the row color as of the last UpdateColors
+    std::vector<uint64_t> m_vRowColorSnapshot;
+    std::vector<uint64_t> m_vCurrentRowColors;
+    std::vector<const rc_condition_t*> m_vRowColorConditions;
+    const rc_trigger_t* m_pRowColorSnapshotTrigger = nullptr;
+
     class ConditionsMonitor : public ViewModelCollectionBase::NotifyTarget
     {
     public:
@@ -23,7 +23,10 @@ public:
     std::wstring GetText(const ra::ui::ViewModelCollectionBase& vmItems, gsl::index nIndex) const override
     {
         const auto nValue = vmItems.GetItemValue(nIndex, *m_pBoundProperty);
-        return ra::Widen(ra::ByteAddressToString(nValue));
+
+        ra::FixedString<wchar_t, 10> sAddress;
+        ra::AppendByteAddress(sAddress, nValue);
+        return std::wstring(sAddress.View());
     }
 
     bool DependsOn(const ra::ui::IntModelProperty& pProperty) const noexcept override
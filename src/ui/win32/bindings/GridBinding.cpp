@@ -216,6 +216,16 @@ void GridBinding::UpdateAllItems()
 
 void GridBinding::UpdateItems(gsl::index nColumn)
 {
+    if (m_bOwnerData)
+    {
+        // an owner data list doesn't store any text. make sure it has the correct number of items and redraw it
+        // so the text will be requested again.
+        m_mCachedText.clear();
+        UpdateItemCount();
+        InvalidateRect(m_hWnd, nullptr, FALSE);
+        return;
+    }
+
     const auto& pColumn = *m_vColumns.at(nColumn);
 
     const auto nItems = ListView_GetItemCount(m_hWnd);
@@ -348,7 +358,8 @@ void GridBinding::OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModel
     // when virtualizing, only the visible items have view models. adjust the index accordingly.
     nIndex = GetRealItemIndex(nIndex);
 
-    if (m_pIsSelectedProperty && *m_pIsSelectedProperty == args.Property)
+    // when the change came from the list control, it already has the new state
+    if (m_pIsSelectedProperty && *m_pIsSelectedProperty == args.Property && !m_bSyncingSelection)
         ListView_SetItemState(m_hWnd, nIndex, args.tNewValue ? LVIS_SELECTED : 0, LVIS_SELECTED);
 
     for (size_t nColumnIndex = 0; nColumnIndex < m_vColumns.size(); ++nColumnIndex)
@@ -396,6 +407,13 @@ void GridBinding::OnViewModelStringValueChanged(gsl::index nIndex, const StringM
 
 void GridBinding::UpdateCell(gsl::index nIndex, gsl::index nColumnIndex)
 {
+    // an owner data list will ask for the new text when the item is redrawn
+    if (m_bOwnerData)
+    {
+        ClearCachedText(nIndex);
+        return;
+    }
+
     std::wstring sText;
     LV_ITEMW item{};
     item.mask = LVIF_TEXT;
@@ -446,7 +464,7 @@ int GridBinding::UpdateSelected(const IntModelProperty& pProperty, int nNewValue
 void GridBinding::UpdateRow(gsl::index nIndex, bool bExisting)
 {
     // virtualized listview does not support LVM_INSERTITEM or LVM_SETITEM
-    if (m_pUpdateSelectedItems)
+    if (m_pUpdateSelectedItems || m_bOwnerData)
         return;
 
     std::wstring sText;
@@ -504,6 +522,21 @@ void GridBinding::OnViewModelAdded(gsl::index nIndex)
         // don't actually add/update items in virtual listview
         m_bForceRepaint = true;
     }
+    else if (m_bOwnerData)
+    {
+        // items are always added to the end of the collection, so the selection state of the existing items
+        // doesn't change. the list control just needs to know there are more items.
+        m_bItemCountChanged = true;
+        m_bForceRepaint = true;
+
+        if (m_pIsSelectedProperty && m_vmItems->GetItemValue(nIndex, *m_pIsSelectedProperty))
+            m_bUpdateSelectedItemStates = true;
+
+        if (!m_vmItems->IsUpdating())
+            OnEndViewModelCollectionUpdate();
+
+        return;
+    }
     else
     {
         SuspendRedraw();
@@ -523,6 +556,11 @@ void GridBinding::OnViewModelRemoved(gsl::index nIndex)
             // don't actually delete items from virtual listview
             m_bForceRepaint = true;
         }
+        else if (m_bOwnerData)
+        {
+            InvalidateOwnerDataItems();
+            return;
+        }
         else
         {
             SuspendRedraw();
@@ -538,11 +576,44 @@ void GridBinding::OnViewModelChanged(gsl::index nIndex)
 {
     if (m_hWnd)
     {
+        if (m_bOwnerData)
+        {
+            InvalidateOwnerDataItems();
+            return;
+        }
+
         SuspendRedraw();
         UpdateRow(nIndex, true);
     }
 }
 
+void GridBinding::InvalidateOwnerDataItems()
+{
+    // items were removed or moved. an owner data list only knows how many items there are and which indices
+    // are selected, so both have to be resynchronized with the collection.
+    m_mCachedText.clear();
+    m_bItemCountChanged = true;
+    m_bUpdateSelectedItemStates = true;
+    m_bForceRepaint = true;
+
+    if (!m_vmItems->IsUpdating())
+        OnEndViewModelCollectionUpdate();
+}
+
+void GridBinding::UpdateItemCount()
+{
+    m_bItemCountChanged = false;
+
+    const auto nItems = gsl::narrow_cast<int>(m_vmItems->Count());
+    if (ListView_GetItemCount(m_hWnd) != nItems)
+    {
+        if (nItems == 0)
+            ListView_SetItemCountEx(m_hWnd, 0, 0);
+        else
+            ListView_SetItemCountEx(m_hWnd, nItems, LVSICF_NOSCROLL);
+    }
+}
+
 void GridBinding::CheckForScrollBar()
 {
     int nItems = gsl::narrow_cast<int>(m_vmItems->Count());
@@ -580,6 +651,9 @@ void GridBinding::OnEndViewModelCollectionUpdate()
             m_bRedrawSuspended = false;
         }
 
+        if (m_bItemCountChanged)
+            UpdateItemCount();
+
         CheckForScrollBar();
 
         if (m_bUpdateSelectedItemStates)
@@ -618,7 +692,22 @@ void GridBinding::SuspendRedraw() noexcept
 
 void GridBinding::UpdateSelectedItemStates()
 {
-    if (m_pIsSelectedProperty && !m_pUpdateSelectedItems)
+    if (m_pIsSelectedProperty && m_bOwnerData)
+    {
+        // an owner data list can deselect everything with a single call. then only the selected items
+        // have to be updated.
+        m_bSyncingSelection = true;
+        ListView_SetItemState(m_hWnd, -1, 0, LVIS_SELECTED);
+
+        for (gsl::index nIndex = 0; nIndex < ra::to_signed(m_vmItems->Count()); ++nIndex)
+        {
+            if (m_vmItems->GetItemValue(nIndex, *m_pIsSelectedProperty))
+                ListView_SetItemState(m_hWnd, nIndex, LVIS_SELECTED, LVIS_SELECTED);
+        }
+
+        m_bSyncingSelection = false;
+    }
+    else if (m_pIsSelectedProperty && !m_pUpdateSelectedItems)
     {
         for (gsl::index nIndex = 0; nIndex < ra::to_signed(m_vmItems->Count()); ++nIndex)
         {
@@ -672,6 +761,7 @@ void GridBinding::Virtualize(const IntModelProperty& pScrollOffsetProperty, cons
     m_pScrollOffsetProperty = &pScrollOffsetProperty;
     m_pScrollMaximumProperty = &pScrollMaximumProperty;
     m_pUpdateSelectedItems = pUpdateSelectedItems;
+    m_bOwnerData = false;
 
     m_nScrollOffset = GetValue(pScrollOffsetProperty);
 }
@@ -684,6 +774,10 @@ void GridBinding::SetHWND(DialogBase& pDialog, HWND hControl)
     {
         Expects((GetWindowStyle(m_hWnd) & LVS_OWNERDATA) != 0);
     }
+    else
+    {
+        m_bOwnerData = ((GetWindowStyle(m_hWnd) & LVS_OWNERDATA) != 0);
+    }
 
     if (!m_vColumns.empty())
     {
@@ -814,6 +908,10 @@ LRESULT GridBinding::OnLvnItemChanging(const LPNMLISTVIEW pnmListView)
 
 void GridBinding::OnLvnItemChanged(const LPNMLISTVIEW pnmListView)
 {
+    // ignore the notifications caused by copying the selection state from the view model to the list control
+    if (m_bSyncingSelection)
+        return;
+
     if (pnmListView->iItem == -1)
     {
         if (m_pUpdateSelectedItems)
@@ -825,6 +923,14 @@ void GridBinding::OnLvnItemChanged(const LPNMLISTVIEW pnmListView)
             pnmStateChange.uOldState = pnmListView->uOldState;
             OnLvnOwnerDrawStateChanged(&pnmStateChange);
         }
+        else if (m_bOwnerData && m_pIsSelectedProperty)
+        {
+            // an owner data list uses -1 to indicate the state of every item changed
+            if (pnmListView->uNewState & LVIS_SELECTED)
+                SetItemsSelected(0, ra::to_signed(m_vmItems->Count()) - 1, true);
+            else if (pnmListView->uOldState & LVIS_SELECTED)
+                SetItemsSelected(0, ra::to_signed(m_vmItems->Count()) - 1, false);
+        }
 
         return;
     }
@@ -913,6 +1019,31 @@ void GridBinding::OnLvnOwnerDrawStateChanged(const LPNMLVODSTATECHANGE pnmStateC
             m_vmItems->AddNotifyTarget(*this);
         }
     }
+    else if (m_bOwnerData && m_pIsSelectedProperty &&
+             (pnmStateChanged->uNewState ^ pnmStateChanged->uOldState) & LVIS_SELECTED)
+    {
+        SetItemsSelected(pnmStateChanged->iFrom, pnmStateChanged->iTo, pnmStateChanged->uNewState & LVIS_SELECTED);
+    }
+}
+
+void GridBinding::SetItemsSelected(gsl::index nFrom, gsl::index nTo, bool bSelected)
+{
+    if (nFrom < 0)
+        nFrom = 0;
+
+    const auto nLast = ra::to_signed(m_vmItems->Count()) - 1;
+    if (nTo > nLast)
+        nTo = nLast;
+
+    // the list control already has the new state. don't send it back to the control.
+    m_bSyncingSelection = true;
+
+    m_vmItems->BeginUpdate();
+    for (gsl::index nIndex = nFrom; nIndex <= nTo; ++nIndex)
+        m_vmItems->SetItemValue(nIndex, *m_pIsSelectedProperty, bSelected);
+    m_vmItems->EndUpdate();
+
+    m_bSyncingSelection = false;
 }
 
 void GridBinding::OnLvnColumnClick(const LPNMLISTVIEW pnmListView)
@@ -1108,8 +1239,51 @@ static void CacheText(ra::tstring& sCacheString, const std::wstring& sText)
 #endif
 }
 
+const ra::tstring& GridBinding::GetCachedText(gsl::index nIndex, gsl::index nColumn)
+{
+    const auto nKey = (gsl::narrow_cast<uint64_t>(nIndex) << 8) | gsl::narrow_cast<uint64_t>(nColumn);
+
+    auto pIter = m_mCachedText.find(nKey);
+    if (pIter == m_mCachedText.end())
+    {
+        pIter = m_mCachedText.emplace(nKey, ra::tstring()).first;
+        CacheText(pIter->second, m_vColumns.at(nColumn)->GetText(*m_vmItems, nIndex));
+    }
+
+    return pIter->second;
+}
+
+void GridBinding::ClearCachedText(gsl::index nIndex)
+{
+    if (m_mCachedText.empty())
+        return;
+
+    const auto nKey = (gsl::narrow_cast<uint64_t>(nIndex) << 8);
+    for (size_t nColumn = 0; nColumn < m_vColumns.size(); ++nColumn)
+        m_mCachedText.erase(nKey | nColumn);
+}
+
 void GridBinding::OnLvnGetDispInfo(NMLVDISPINFO& pnmDispInfo)
 {
+    if (m_bOwnerData)
+    {
+        if ((pnmDispInfo.item.mask & LVIF_TEXT) == 0)
+            return;
+
+        // the list control may paint before it's been told the collection shrank
+        const auto nIndex = gsl::narrow_cast<gsl::index>(pnmDispInfo.item.iItem);
+        const auto nColumn = gsl::narrow_cast<gsl::index>(pnmDispInfo.item.iSubItem);
+        if (nIndex < 0 || nIndex >= ra::to_signed(m_vmItems->Count()) ||
+            nColumn < 0 || nColumn >= ra::to_signed(m_vColumns.size()))
+        {
+            GSL_SUPPRESS_TYPE3 pnmDispInfo.item.pszText = const_cast<LPTSTR>(TEXT(""));
+            return;
+        }
+
+        GSL_SUPPRESS_TYPE3 pnmDispInfo.item.pszText = const_cast<LPTSTR>(GetCachedText(nIndex, nColumn).c_str());
+        return;
+    }
+
     // when virtualizing, only the visible items have view models. adjust the index accordingly.
     const auto nIndex = GetVisibleItemIndex(pnmDispInfo.item.iItem);
 
@@ -1160,6 +1334,10 @@ LRESULT GridBinding::OnCustomDraw(NMLVCUSTOMDRAW* pCustomDraw)
 {
     LRESULT nResult = CDRF_DODEFAULT;
 
+    // only keep the text for the cells being drawn in the current frame
+    if (pCustomDraw->nmcd.dwDrawStage == CDDS_PREPAINT)
+        m_mCachedText.clear();
+
     if (m_pRowColorProperty)
     {
         switch (pCustomDraw->nmcd.dwDrawStage)
@@ -73,6 +73,19 @@ public:
 
     virtual void EnsureVisible(gsl::index nIndex) noexcept(false);
 
+    /// <summary>
+    /// Determines whether the list control is an owner data (<c>LVS_OWNERDATA</c>) control that requests the text
+    /// for each cell of the bound collection as it's drawn instead of storing a copy of every row.
+    /// </summary>
+    /// <remarks>
+    /// Owner data controls that have been paged with <see cref="Virtualize" /> are not considered owner data lists as
+    /// only the visible page of items exists in the collection. Check box columns are not supported.
+    /// Only the copy of each row held by the list control is avoided. The bound collection must still provide a view
+    /// model for every row, so an owner data list is suited to collections that already hold one per item (like the
+    /// asset list). Collections too large to materialize should continue to be paged with <see cref="Virtualize" />.
+    /// </remarks>
+    bool IsOwnerData() const noexcept { return m_bOwnerData; }
+
 protected:
     void SuspendRedraw() noexcept;
     void UpdateLayout();
@@ -111,6 +124,11 @@ protected:
 private:
     void UpdateRow(gsl::index nIndex, bool bExisting);
     void UpdateSelectedItemStates();
+    void UpdateItemCount();
+    void InvalidateOwnerDataItems();
+    void SetItemsSelected(gsl::index nFrom, gsl::index nTo, bool bSelected);
+    const ra::tstring& GetCachedText(gsl::index nIndex, gsl::index nColumn);
+    void ClearCachedText(gsl::index nIndex);
 
     bool m_bShowGridLines = false;
     bool m_bHasScrollbar = false;
@@ -120,6 +138,13 @@ private:
     bool m_bUpdateSelectedItemStates = false;
     int m_nAdjustingScrollOffset = 0;
 
+    bool m_bOwnerData = false;
+    bool m_bItemCountChanged = false;
+    bool m_bSyncingSelection = false;
+
+    // text for the cells drawn by an owner data list, keyed by (item * 256 + column). discarded before each paint.
+    std::unordered_map<uint64_t, ra::tstring> m_mCachedText;
+
     size_t m_nColumnsCreated = 0;
     bool m_bHasColoredColumns = false;
 
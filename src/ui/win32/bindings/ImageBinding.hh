@@ -42,12 +42,11 @@ protected:
     {
         if (nType == m_pImageReference.Type() && sName == m_pImageReference.Name())
         {
-            auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
-            pImageRepository.RemoveNotifyTarget(*this);
-
-            // if the download failed, this will set the image to either a default image or blank
-            // depending on what the ImageRepository returns when an image is not available
-            UpdateImage();
+            // a completed download is followed by a decode, which will raise another notification.
+            // TryUpdateImage only stops listening once the image is actually available. if the
+            // download failed, this will set the image to either a default image or blank depending
+            // on what the ImageRepository returns when an image is not available.
+            TryUpdateImage();
         }
     }
 
@@ -69,11 +68,22 @@ private:
             // load the image or placeholder
             UpdateImage();
 
-            // if it's the placeholder, request the actual image
+            // images are decoded asynchronously. listen for the notification before checking to see
+            // if the image is available so the notification isn't missed if decoding finishes.
             auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
-            if (!pImageRepository.IsImageAvailable(m_pImageReference.Type(), m_pImageReference.Name()))
+            pImageRepository.AddNotifyTarget(*this);
+
+            if (pImageRepository.IsImageAvailable(m_pImageReference.Type(), m_pImageReference.Name()))
+            {
+                pImageRepository.RemoveNotifyTarget(*this);
+
+                // the image may have become available after the placeholder was loaded
+                if (pImageRepository.HasReferencedImageChanged(m_pImageReference))
+                    UpdateImage();
+            }
+            else
             {
-                pImageRepository.AddNotifyTarget(*this);
+                // if it's the placeholder, request the actual image
                 pImageRepository.FetchImage(m_pImageReference.Type(), m_pImageReference.Name());
             }
         }
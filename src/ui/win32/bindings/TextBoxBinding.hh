@@ -125,15 +125,23 @@ protected:
 
     void UpdateSourceDelayed()
     {
-        static int nVersion = 0;
-        const int nCapturedVersion = ++nVersion;
+        auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
 
-        ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().ScheduleAsync(
-            std::chrono::milliseconds(300), [this, nCapturedVersion]()
+        // only update the source once the user stops typing
+        if (m_nUpdateSourceTaskId != 0)
+            pThreadPool.CancelScheduledTask(m_nUpdateSourceTaskId);
+
+        // the task only knows its id once ScheduleAsync returns. if another task was scheduled while
+        // this one was waiting to run, leave the newer id alone so it can still be cancelled.
+        auto pTaskId = std::make_shared<std::atomic<ra::services::IThreadPool::ScheduledTaskId>>(0U);
+        const auto nTaskId = pThreadPool.ScheduleAsync(std::chrono::milliseconds(300), [this, pTaskId]()
             {
-                if (nCapturedVersion == nVersion)
-                    UpdateSource();
+                auto nExpected = pTaskId->load();
+                m_nUpdateSourceTaskId.compare_exchange_strong(nExpected, 0U);
+                UpdateSource();
             });
+        pTaskId->store(nTaskId);
+        m_nUpdateSourceTaskId = nTaskId;
     }
 
     UpdateMode m_pTextUpdateMode = UpdateMode::None;
@@ -141,6 +149,7 @@ protected:
 private:
     const StringModelProperty* m_pTextBoundProperty = nullptr;
     std::map<unsigned int, std::function<bool()>> m_mKeyHandlers;
+    std::atomic<ra::services::IThreadPool::ScheduledTaskId> m_nUpdateSourceTaskId{0U};
 };
 
 } // namespace bindings
@@ -17,6 +17,7 @@
 #include "tests\mocks\MockOverlayTheme.hh"
 #include "tests\mocks\MockServer.hh"
 #include "tests\mocks\MockSessionTracker.hh"
+#include "tests\mocks\MockSubmissionOutbox.hh"
 #include "tests\mocks\MockSurface.hh"
 #include "tests\mocks\MockThreadPool.hh"
 #include "tests\mocks\MockUserContext.hh"
@@ -506,6 +507,7 @@ private:
         MockThreadPool mockThreadPool;
         MockServer mockServer;
         MockUserContext mockUserContext;
+        ra::services::mocks::MockSubmissionOutbox mockSubmissionOutbox;
 
         std::set<unsigned int> m_vUnlockedAchievements;
         std::map<ra::LeaderboardID, unsigned int> m_vSubmittedLeaderboardEntries;
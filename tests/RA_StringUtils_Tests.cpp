@@ -59,6 +59,55 @@ public:
         Assert::AreEqual(std::wstring(L"T\xFFFDst"), Widen("T\xA9st")); // should be \xC3\xA9
     }
 
+    TEST_METHOD(TestNarrowBuffer)
+    {
+        std::string sBuffer;
+
+        // ASCII
+        Assert::AreEqual(std::string("Test"), std::string(Narrow(std::wstring_view(L"Test"), sBuffer)));
+        Assert::AreEqual(std::string("Test"), sBuffer);
+
+        // U+00E9 - LATIN SMALL LETTER E WITH ACUTE, U+20AC - EURO SIGN
+        Assert::AreEqual(std::string("T\xC3\xA9st \xE2\x82\xAC"), std::string(Narrow(L"T\xE9st \x20AC", sBuffer)));
+
+        // U+1F30F - EARTH GLOBE ASIA-AUSTRALIA
+        Assert::AreEqual(std::string("\xF0\x9F\x8C\x8F"), std::string(Narrow(L"\xD83C\xDF0F", sBuffer)));
+
+        // unpaired surrogates replaced with placeholder U+FFFD
+        Assert::AreEqual(std::string("\xEF\xBF\xBD" "A"), std::string(Narrow(L"\xD83C" L"A", sBuffer)));
+        Assert::AreEqual(std::string("A\xEF\xBF\xBD"), std::string(Narrow(L"A\xDF0F", sBuffer)));
+
+        // buffer is replaced, not appended to
+        Assert::AreEqual(std::string(""), std::string(Narrow(L"", sBuffer)));
+        Assert::AreEqual(std::string(""), sBuffer);
+    }
+
+    TEST_METHOD(TestWidenBuffer)
+    {
+        std::wstring sBuffer;
+
+        // ASCII
+        Assert::AreEqual(std::wstring(L"Test"), std::wstring(Widen(std::string_view("Test"), sBuffer)));
+        Assert::AreEqual(std::wstring(L"Test"), sBuffer);
+
+        // U+00E9 - LATIN SMALL LETTER E WITH ACUTE, U+20AC - EURO SIGN
+        Assert::AreEqual(std::wstring(L"T\xE9st \x20AC"), std::wstring(Widen("T\xC3\xA9st \xE2\x82\xAC", sBuffer)));
+
+        // U+1F30F - EARTH GLOBE ASIA-AUSTRALIA
+        Assert::AreEqual(std::wstring(L"\xD83C\xDF0F"), std::wstring(Widen("\xF0\x9F\x8C\x8F", sBuffer)));
+
+        // invalid UTF-8 replaced with placeholder U+FFFD
+        Assert::AreEqual(std::wstring(L"T\xFFFDst"), std::wstring(Widen("T\xA9st", sBuffer)));
+        Assert::AreEqual(std::wstring(L"T\xFFFDst"), std::wstring(Widen("T\xC3st", sBuffer))); // truncated sequence
+        Assert::AreEqual(std::wstring(L"\xFFFD"), std::wstring(Widen("\xF0\x9F\x8C", sBuffer))); // truncated at end
+        Assert::AreEqual(std::wstring(L"\xFFFD"), std::wstring(Widen("\xC0\xAF", sBuffer))); // overlong encoding
+        Assert::AreEqual(std::wstring(L"\xFFFD"), std::wstring(Widen("\xED\xA0\xBC", sBuffer))); // encoded surrogate
+
+        // buffer is replaced, not appended to
+        Assert::AreEqual(std::wstring(L""), std::wstring(Widen("", sBuffer)));
+        Assert::AreEqual(std::wstring(L""), sBuffer);
+    }
+
     TEST_METHOD(TestTrimLineEnding)
     {
         Assert::AreEqual(std::string("test"), TrimLineEnding(std::string("test")));
@@ -461,6 +510,94 @@ public:
 
         AssertParseHexError(L"0x12345", 0x12344, L"Value cannot exceed 0x12344");
     }
+
+    TEST_METHOD(TestFixedString)
+    {
+        FixedString<char, 16> sString;
+        Assert::IsTrue(sString.IsEmpty());
+        Assert::AreEqual("", sString.GetString());
+
+        sString.Append("0x").AppendHex(0x12ABU, 6).Append(' ').AppendDecimal(-42);
+        Assert::AreEqual(std::string("0x0012ab -42"), std::string(sString.View()));
+        Assert::AreEqual({ 12U }, sString.Length());
+        Assert::IsFalse(sString.IsTruncated());
+
+        sString.Clear();
+        sString.AppendHex(0xDEADBEEFU, 0, true);
+        Assert::AreEqual("DEADBEEF", sString.GetString());
+
+        sString.Clear();
+        sString.AppendDecimal(std::numeric_limits<uint64_t>::max());
+        Assert::AreEqual("1844674407370955", sString.GetString());
+        Assert::IsTrue(sString.IsTruncated());
+
+        FixedString<wchar_t, 16> sWString;
+        sWString.Append(L"Value: ").AppendDecimal(1234U).Append(L'/').AppendHex(uint8_t{ 0xF }, 2);
+        Assert::AreEqual(std::wstring(L"Value: 1234/0f"), std::wstring(sWString.View()));
+        Assert::AreEqual(L"Value: 1234/0f", sWString.GetString());
+
+        sWString.Append(L"overflow");
+        Assert::AreEqual(L"Value: 1234/0fov", sWString.GetString());
+        Assert::AreEqual({ 16U }, sWString.Length());
+        Assert::IsTrue(sWString.IsTruncated());
+    }
+
+    TEST_METHOD(TestAppendByteAddress)
+    {
+        FixedString<wchar_t, 10> sAddress;
+        AppendByteAddress(sAddress, 0x12U);
+        Assert::AreEqual(L"0x0012", sAddress.GetString());
+
+        sAddress.Clear();
+        AppendByteAddress(sAddress, 0xABCDEFU);
+        Assert::AreEqual(L"0xabcdef", sAddress.GetString());
+
+        Assert::AreEqual(std::string("0x0012"), ByteAddressToString(0x12U));
+        Assert::AreEqual(std::string("0xffffffff"), ByteAddressToString(0xFFFFFFFFU));
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(BenchmarkFormatting)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(BenchmarkFormatting)
+    {
+        // not a correctness test - run manually to compare the allocating and allocation-free implementations
+        constexpr int nIterations = 100000;
+        size_t nTotal = 0;
+
+        auto tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nIterations; ++i)
+            nTotal += ra::StringPrintf(L"0x%06x: %u", i, i * 3).length();
+        const auto nPrintfNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nIterations; ++i)
+        {
+            FixedString<wchar_t, 32> sString;
+            sString.Append(L"0x").AppendHex(ra::to_unsigned(i), 6).Append(L": ").AppendDecimal(ra::to_unsigned(i * 3));
+            nTotal += sString.Length();
+        }
+        const auto nFixedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        const std::string sText("Lorem ipsum dolor sit amet, consectetur adipiscing elit \xE2\x82\xAC");
+        tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nIterations; ++i)
+            nTotal += ra::Widen(sText).length();
+        const auto nWidenNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        std::wstring sBuffer;
+        tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nIterations; ++i)
+            nTotal += ra::Widen(sText, sBuffer).length();
+        const auto nWidenBufferNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        std::string sMessage = "StringPrintf: " + std::to_string(nPrintfNanoseconds / (nIterations / 1000)) + "ns per 1000 calls\n";
+        sMessage += "FixedString: " + std::to_string(nFixedNanoseconds / (nIterations / 1000)) + "ns per 1000 calls\n";
+        sMessage += "Widen: " + std::to_string(nWidenNanoseconds / (nIterations / 1000)) + "ns per 1000 calls\n";
+        sMessage += "Widen (buffer): " + std::to_string(nWidenBufferNanoseconds / (nIterations / 1000)) +
+                    "ns per 1000 calls (" + std::to_string(nTotal) + ")\n";
+        Logger::WriteMessage(sMessage.c_str());
+    }
 };
 
 
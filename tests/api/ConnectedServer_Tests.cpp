@@ -564,6 +564,73 @@ public:
         std::string sPatchData = "{\"ID\":99, \"Title\":\"Game Name\", \"ConsoleID\":5, \"ImageIcon\":\"/Images/BADGE.png\", \"Achievements\":[], \"Leaderboards\":[]}";
         Assert::AreEqual(sPatchData, mockLocalStorage.GetStoredData(ra::services::StorageItemType::GameData, L"99"));
     }
+
+    TEST_METHOD(TestFetchGameDataError)
+    {
+        MockUserContext mockUserContext;
+        mockUserContext.Initialize("Username", "ApiToken");
+
+        MockHttpRequester mockHttp([](const Http::Request&)
+        {
+            return Http::Response(Http::StatusCode::OK, "{\"Success\":false,\"Error\":\"Unknown game\"}");
+        });
+
+        MockLocalStorage mockLocalStorage;
+
+        ra::services::ServiceLocator::ServiceOverride<ra::api::IServer> serviceOverride(new ConnectedServer("host.com"), true);
+        auto& server = ra::services::ServiceLocator::GetMutable<ra::api::IServer>();
+
+        FetchGameData::Request request;
+        request.GameId = 99;
+        auto response = server.FetchGameData(request);
+
+        Assert::AreEqual(ApiResult::Error, response.Result);
+        Assert::AreEqual(std::string("Unknown game"), response.ErrorMessage);
+        Assert::IsFalse(mockLocalStorage.HasStoredData(ra::services::StorageItemType::GameData, L"99"));
+    }
+
+    TEST_METHOD(TestFetchGameDataHandlers)
+    {
+        MockUserContext mockUserContext;
+        mockUserContext.Initialize("Username", "ApiToken");
+
+        MockHttpRequester mockHttp([](const Http::Request&)
+        {
+            return Http::Response(Http::StatusCode::OK,
+                "{\"Success\":true,\"PatchData\":"
+                    "{\"ID\":99, \"Title\":\"Game Name\", \"ConsoleID\":5, \"ImageIcon\":\"/Images/BADGE.png\", "
+                    "\"Achievements\":[{\"ID\":1,\"Title\":\"Ach1\",\"MemAddr\":\"0xH1234=1\",\"Flags\":3}], "
+                    "\"Leaderboards\":[{\"ID\":2,\"Title\":\"Lboard2\",\"Mem\":\"STA:1=1::CAN:0=1::SUB:1=1::VAL:1\"}]}"
+                "}");
+        });
+
+        MockLocalStorage mockLocalStorage;
+
+        ra::services::ServiceLocator::ServiceOverride<ra::api::IServer> serviceOverride(new ConnectedServer("host.com"), true);
+        auto& server = ra::services::ServiceLocator::GetMutable<ra::api::IServer>();
+
+        std::vector<std::string> vTitles;
+        FetchGameData::Request request;
+        request.GameId = 99;
+        request.AchievementHandler = [&vTitles](const FetchGameData::Response::Achievement& pAchievement)
+        {
+            vTitles.push_back(pAchievement.Title);
+        };
+        request.LeaderboardHandler = [&vTitles](const FetchGameData::Response::Leaderboard& pLeaderboard)
+        {
+            vTitles.push_back(pLeaderboard.Title);
+        };
+        auto response = server.FetchGameData(request);
+
+        Assert::AreEqual(ApiResult::Success, response.Result);
+        Assert::AreEqual(std::wstring(L"Game Name"), response.Title);
+        Assert::AreEqual(std::string("BADGE"), response.ImageIcon);
+        Assert::AreEqual({ 0U }, response.Achievements.size());
+        Assert::AreEqual({ 0U }, response.Leaderboards.size());
+        Assert::AreEqual({ 2U }, vTitles.size());
+        Assert::AreEqual(std::string("Ach1"), vTitles.at(0));
+        Assert::AreEqual(std::string("Lboard2"), vTitles.at(1));
+    }
 };
 
 } // namespace tests
@@ -0,0 +1,272 @@
+#include "CppUnitTest.h"
+
+#include "api\impl\PatchDataParser.hh"
+
+#include "services\impl\StringTextReader.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Microsoft {
+namespace VisualStudio {
+namespace CppUnitTestFramework {
+
+template<>
+std::wstring ToString<ra::api::impl::PatchDataParser::Result>(const ra::api::impl::PatchDataParser::Result& nResult)
+{
+    switch (nResult)
+    {
+        case ra::api::impl::PatchDataParser::Result::Success:
+            return L"Success";
+        case ra::api::impl::PatchDataParser::Result::InvalidJson:
+            return L"InvalidJson";
+        case ra::api::impl::PatchDataParser::Result::MissingValue:
+            return L"MissingValue";
+        default:
+            return std::to_wstring(static_cast<int>(nResult));
+    }
+}
+
+} // namespace CppUnitTestFramework
+} // namespace VisualStudio
+} // namespace Microsoft
+
+namespace ra {
+namespace api {
+namespace impl {
+namespace tests {
+
+TEST_CLASS(PatchDataParser_Tests)
+{
+private:
+    static const std::string PatchData;
+
+    static std::string BuildPatchData(unsigned int nAchievements)
+    {
+        std::string sPatchData = "{\"ID\":1234,\"Title\":\"Big Set\",\"ConsoleID\":7,\"Achievements\":[";
+        for (unsigned int i = 1; i <= nAchievements; ++i)
+        {
+            if (i > 1)
+                sPatchData.push_back(',');
+
+            sPatchData.append(ra::StringPrintf("{\"ID\":%u,\"MemAddr\":\"0xH%04x=%u\",\"Title\":\"Achievement %u\","
+                "\"Description\":\"Do thing number %u\",\"Points\":%u,\"Author\":\"User%u\",\"Modified\":%u,"
+                "\"Created\":%u,\"BadgeName\":\"%05u\",\"Flags\":3}",
+                i, i, i % 256, i, i, i % 50, i % 7, 1600000000U + i, 1500000000U + i, i));
+        }
+        sPatchData.append("],\"Leaderboards\":[]}");
+        return sPatchData;
+    }
+
+public:
+    TEST_METHOD(TestParseServerResponse)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        const std::string sJson = "{\"Success\":true,\"PatchData\":" + PatchData + "}";
+        Assert::AreEqual(PatchDataParser::Result::Success, parser.ParseServerResponse(sJson));
+        Assert::IsTrue(parser.Succeeded());
+        Assert::AreEqual(PatchData, std::string(parser.GetPatchData()));
+
+        Assert::AreEqual(std::wstring(L"Game Name \u00e9"), response.Title);
+        Assert::AreEqual(5U, response.ConsoleId);
+        Assert::AreEqual(std::string("012345"), response.ImageIcon);
+        Assert::AreEqual(std::string("Display:\nHello"), response.RichPresence);
+
+        Assert::AreEqual({ 2U }, parser.GetAchievementCount());
+        Assert::AreEqual({ 2U }, response.Achievements.size());
+        const auto& pAchievement1 = response.Achievements.at(0);
+        Assert::AreEqual(5501U, pAchievement1.Id);
+        Assert::AreEqual(std::string("Ach1"), pAchievement1.Title);
+        Assert::AreEqual(std::string("Desc1"), pAchievement1.Description);
+        Assert::AreEqual(3U, pAchievement1.CategoryId);
+        Assert::AreEqual(5U, pAchievement1.Points);
+        Assert::AreEqual(std::string("0xH1234=1"), pAchievement1.Definition);
+        Assert::AreEqual(std::string("User1"), pAchievement1.Author);
+        Assert::AreEqual(std::string("00234"), pAchievement1.BadgeName);
+        Assert::AreEqual(1367266583, gsl::narrow_cast<int>(pAchievement1.Created));
+        Assert::AreEqual(1376929305, gsl::narrow_cast<int>(pAchievement1.Updated));
+
+        // fields that aren't provided aren't carried over from the previous achievement
+        const auto& pAchievement2 = response.Achievements.at(1);
+        Assert::AreEqual(5502U, pAchievement2.Id);
+        Assert::AreEqual(std::string("Ach2"), pAchievement2.Title);
+        Assert::AreEqual(std::string(), pAchievement2.Description);
+        Assert::AreEqual(5U, pAchievement2.CategoryId);
+        Assert::AreEqual(0U, pAchievement2.Points);
+        Assert::AreEqual(std::string("0xH1234=2"), pAchievement2.Definition);
+        Assert::AreEqual(std::string(), pAchievement2.Author);
+
+        Assert::AreEqual({ 1U }, parser.GetLeaderboardCount());
+        Assert::AreEqual({ 1U }, response.Leaderboards.size());
+        const auto& pLeaderboard = response.Leaderboards.at(0);
+        Assert::AreEqual(4401U, pLeaderboard.Id);
+        Assert::AreEqual(std::string("Leaderboard1"), pLeaderboard.Title);
+        Assert::AreEqual(std::string("Desc"), pLeaderboard.Description);
+        Assert::AreEqual(std::string("STA:0xH0000=1::CAN:0xH0000=2::SUB:0xH0000=3::VAL:0xH0001"), pLeaderboard.Definition);
+        Assert::AreEqual(gsl::narrow_cast<int>(RC_FORMAT_SCORE), pLeaderboard.Format);
+        Assert::IsTrue(pLeaderboard.LowerIsBetter);
+        Assert::IsFalse(pLeaderboard.Hidden);
+    }
+
+    TEST_METHOD(TestParseServerResponseHandlers)
+    {
+        FetchGameData::Request request;
+        std::vector<unsigned int> vAchievementIds;
+        std::vector<std::string> vLeaderboardTitles;
+        request.AchievementHandler = [&vAchievementIds](const FetchGameData::Response::Achievement& pAchievement)
+        {
+            vAchievementIds.push_back(pAchievement.Id);
+        };
+        request.LeaderboardHandler = [&vLeaderboardTitles](const FetchGameData::Response::Leaderboard& pLeaderboard)
+        {
+            vLeaderboardTitles.push_back(pLeaderboard.Title);
+        };
+
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+        Assert::AreEqual(PatchDataParser::Result::Success, parser.ParseServerResponse("{\"Success\":true,\"PatchData\":" + PatchData + "}"));
+
+        // items are passed to the handlers instead of being added to the response
+        Assert::AreEqual({ 0U }, response.Achievements.size());
+        Assert::AreEqual({ 0U }, response.Leaderboards.size());
+        Assert::AreEqual({ 2U }, vAchievementIds.size());
+        Assert::AreEqual(5501U, vAchievementIds.at(0));
+        Assert::AreEqual(5502U, vAchievementIds.at(1));
+        Assert::AreEqual({ 1U }, vLeaderboardTitles.size());
+        Assert::AreEqual(std::string("Leaderboard1"), vLeaderboardTitles.at(0));
+        Assert::AreEqual(std::wstring(L"Game Name \u00e9"), response.Title);
+    }
+
+    TEST_METHOD(TestParseServerResponsePatchDataLast)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        const std::string sJson = "{\"PatchData\":" + PatchData + ",\"Success\":true}";
+        Assert::AreEqual(PatchDataParser::Result::Success, parser.ParseServerResponse(sJson));
+        Assert::AreEqual(PatchData, std::string(parser.GetPatchData()));
+        Assert::AreEqual({ 2U }, response.Achievements.size());
+    }
+
+    TEST_METHOD(TestParseServerResponseError)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        Assert::AreEqual(PatchDataParser::Result::Success,
+            parser.ParseServerResponse("{\"Success\":false,\"Error\":\"Unknown game\",\"Code\":\"not_found\"}"));
+        Assert::IsFalse(parser.Succeeded());
+        Assert::AreEqual(std::string("Unknown game"), parser.GetErrorMessage());
+        Assert::AreEqual(std::string(), std::string(parser.GetPatchData()));
+    }
+
+    TEST_METHOD(TestParseServerResponseInvalidJson)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        Assert::AreEqual(PatchDataParser::Result::InvalidJson,
+            parser.ParseServerResponse("{\"Success\":true,\"PatchData\":{\"ID\":1,\"Title\":\"T\",\"ConsoleID\":1"));
+        Assert::AreEqual(PatchDataParser::Result::InvalidJson, parser.ParseServerResponse("<html>Error</html>"));
+    }
+
+    TEST_METHOD(TestParseServerResponseMissingPatchData)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        Assert::AreEqual(PatchDataParser::Result::MissingValue, parser.ParseServerResponse("{\"Success\":true}"));
+    }
+
+    TEST_METHOD(TestParseServerResponseMissingValue)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        // achievement without a definition
+        Assert::AreEqual(PatchDataParser::Result::MissingValue, parser.ParseServerResponse(
+            "{\"Success\":true,\"PatchData\":{\"ID\":1,\"Title\":\"T\",\"ConsoleID\":1,\"Achievements\":[{\"ID\":5}]}}"));
+
+        // patch data without a console
+        FetchGameData::Response response2;
+        PatchDataParser parser2(request, response2);
+        Assert::AreEqual(PatchDataParser::Result::MissingValue, parser2.ParseServerResponse(
+            "{\"Success\":true,\"PatchData\":{\"ID\":1,\"Title\":\"T\",\"ConsoleID\":null}}"));
+    }
+
+    TEST_METHOD(TestParsePatchData)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        ra::services::impl::StringTextReader pReader(PatchData);
+        Assert::AreEqual(PatchDataParser::Result::Success, parser.ParsePatchData(pReader));
+        Assert::AreEqual(std::wstring(L"Game Name \u00e9"), response.Title);
+        Assert::AreEqual({ 2U }, response.Achievements.size());
+        Assert::AreEqual({ 1U }, response.Leaderboards.size());
+    }
+
+    TEST_METHOD(TestParsePatchDataNotObject)
+    {
+        FetchGameData::Request request;
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        ra::services::impl::StringTextReader pReader("[1,2,3]");
+        Assert::AreEqual(PatchDataParser::Result::MissingValue, parser.ParsePatchData(pReader));
+    }
+
+    TEST_METHOD(TestParseLargeSet)
+    {
+        FetchGameData::Request request;
+        size_t nCount = 0;
+        std::string sLastTitle;
+        request.AchievementHandler = [&nCount, &sLastTitle](const FetchGameData::Response::Achievement& pAchievement)
+        {
+            Assert::AreEqual(++nCount, gsl::narrow_cast<size_t>(pAchievement.Id));
+            Assert::AreEqual(ra::StringPrintf("0xH%04x=%u", pAchievement.Id, pAchievement.Id % 256), pAchievement.Definition);
+            Assert::AreEqual(ra::StringPrintf("%05u", pAchievement.Id), pAchievement.BadgeName);
+            sLastTitle = pAchievement.Title;
+        };
+
+        FetchGameData::Response response;
+        PatchDataParser parser(request, response);
+
+        ra::services::impl::StringTextReader pReader(BuildPatchData(600));
+        Assert::AreEqual(PatchDataParser::Result::Success, parser.ParsePatchData(pReader));
+        Assert::AreEqual({ 600U }, nCount);
+        Assert::AreEqual({ 600U }, parser.GetAchievementCount());
+        Assert::AreEqual(std::string("Achievement 600"), sLastTitle);
+        Assert::AreEqual({ 0U }, response.Achievements.size());
+    }
+};
+
+const std::string PatchDataParser_Tests::PatchData =
+    "{\"ID\":1234,\"Title\":\"Game Name \\u00e9\",\"ConsoleID\":5,\"ImageIcon\":\"/Images/012345.png\","
+    "\"ImageIconURL\":\"https://host/Images/012345.png\",\"Flags\":null,\"RichPresencePatch\":\"Display:\\nHello\","
+    "\"Sets\":[{\"ID\":1,\"Achievements\":[{\"ID\":9999}]}],"
+    "\"Achievements\":["
+        "{\"ID\":5501,\"MemAddr\":\"0xH1234=1\",\"Title\":\"Ach1\",\"Description\":\"Desc1\",\"Points\":5,"
+        "\"Author\":\"User1\",\"Modified\":1376929305,\"Created\":1367266583,\"BadgeName\":\"00234\",\"Flags\":3,"
+        "\"Type\":null,\"Rarity\":12.5,\"Tags\":[\"a\",{\"b\":[]}]},"
+        "{\"ID\":5502,\"MemAddr\":\"0xH1234=2\",\"Title\":\"Ach2\",\"Flags\":5}"
+    "],"
+    "\"Leaderboards\":["
+        "{\"ID\":4401,\"Mem\":\"STA:0xH0000=1::CAN:0xH0000=2::SUB:0xH0000=3::VAL:0xH0001\",\"Format\":\"SCORE\","
+        "\"LowerIsBetter\":1,\"Title\":\"Leaderboard1\",\"Description\":\"Desc\",\"Hidden\":false}"
+    "]}";
+
+} // namespace tests
+} // namespace impl
+} // namespace api
+} // namespace ra
@@ -24,6 +24,20 @@ TEST_CLASS(ModelPropertyContainer_Tests)
         BoolModelProperty BoolProperty{ "ViewModelHarness", "Bool", false };
         bool GetBool() const { return GetValue(BoolProperty); }
         void SetBool(bool bValue) { SetValue(BoolProperty, bValue); }
+
+        IntModelProperty Int2Property{ "ViewModelHarness", "Int2", 6 };
+        int GetInt2() const { return GetValue(Int2Property); }
+        void SetInt2(int nValue) { SetValue(Int2Property, nValue); }
+
+        StringModelProperty String2Property{ "ViewModelHarness", "String2", L"" };
+        const std::wstring& GetString2() const { return GetValue(String2Property); }
+        void SetString2(const std::wstring& sValue) { SetValue(String2Property, sValue); }
+
+        int nChanges = 0;
+        std::wstring sLastNewValue;
+        void OnValueChanged(const IntModelProperty::ChangeArgs&) override { ++nChanges; }
+        void OnValueChanged(const BoolModelProperty::ChangeArgs&) override { ++nChanges; }
+        void OnValueChanged(const StringModelProperty::ChangeArgs& args) override { ++nChanges; sLastNewValue = args.tNewValue; }
     };
 
 public:
@@ -53,6 +67,109 @@ public:
         vmViewModel.SetBool(true);
         Assert::AreEqual(true, vmViewModel.GetBool());
     }
+
+    TEST_METHOD(TestMultipleIntProperties)
+    {
+        ModelPropertyContainerHarness vmViewModel;
+
+        // set in reverse key order - bools share storage with ints
+        vmViewModel.SetInt2(12);
+        vmViewModel.SetBool(true);
+        vmViewModel.SetInt(32);
+        Assert::AreEqual(3, vmViewModel.nChanges);
+        Assert::AreEqual(32, vmViewModel.GetInt());
+        Assert::AreEqual(true, vmViewModel.GetBool());
+        Assert::AreEqual(12, vmViewModel.GetInt2());
+
+        // setting the same value does not raise a change
+        vmViewModel.SetInt2(12);
+        Assert::AreEqual(3, vmViewModel.nChanges);
+
+        // resetting to default removes the value without affecting the others
+        vmViewModel.SetBool(false);
+        Assert::AreEqual(4, vmViewModel.nChanges);
+        Assert::AreEqual(32, vmViewModel.GetInt());
+        Assert::AreEqual(false, vmViewModel.GetBool());
+        Assert::AreEqual(12, vmViewModel.GetInt2());
+
+        vmViewModel.SetInt2(6);
+        Assert::AreEqual(5, vmViewModel.nChanges);
+        Assert::AreEqual(32, vmViewModel.GetInt());
+        Assert::AreEqual(6, vmViewModel.GetInt2());
+
+        vmViewModel.SetInt2(7);
+        Assert::AreEqual(6, vmViewModel.nChanges);
+        Assert::AreEqual(32, vmViewModel.GetInt());
+        Assert::AreEqual(7, vmViewModel.GetInt2());
+    }
+
+    TEST_METHOD(TestSetStringPropertyFromOtherProperty)
+    {
+        ModelPropertyContainerHarness vmViewModel;
+
+        // the value being set is stored in the same array that has to grow to hold it
+        vmViewModel.SetString2(L"This string is too long for the small string buffer");
+        vmViewModel.SetString(vmViewModel.GetString2());
+        Assert::AreEqual(std::wstring(L"This string is too long for the small string buffer"), vmViewModel.GetString());
+        Assert::AreEqual(std::wstring(L"This string is too long for the small string buffer"), vmViewModel.GetString2());
+        Assert::AreEqual(std::wstring(L"This string is too long for the small string buffer"), vmViewModel.sLastNewValue);
+
+        // updating an existing value doesn't move the other values
+        vmViewModel.SetString2(L"Test2");
+        vmViewModel.SetString(vmViewModel.GetString2());
+        Assert::AreEqual(std::wstring(L"Test2"), vmViewModel.GetString());
+        Assert::AreEqual(std::wstring(L"Test2"), vmViewModel.sLastNewValue);
+    }
+
+    TEST_METHOD(TestStringPropertyReferenceStable)
+    {
+        ModelPropertyContainerHarness vmViewModel;
+        vmViewModel.SetString2(L"This string is too long for the small string buffer");
+        const auto& sValue = vmViewModel.GetString2();
+
+        // adding and removing another value doesn't move the referenced value
+        vmViewModel.SetString(L"Test");
+        vmViewModel.SetString(L"");
+        Assert::AreEqual(std::wstring(L"This string is too long for the small string buffer"), sValue);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(BenchmarkGetSetValue)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(BenchmarkGetSetValue)
+    {
+        // not a correctness test - run manually to measure property access throughput
+        constexpr int nIterations = 1000000;
+        ModelPropertyContainerHarness vmViewModel;
+        vmViewModel.SetInt(1);
+        vmViewModel.SetInt2(2);
+        vmViewModel.SetBool(true);
+        vmViewModel.SetString(L"Test");
+
+        const auto tStart = std::chrono::steady_clock::now();
+        int nTotal = 0;
+        for (int i = 0; i < nIterations; ++i)
+        {
+            nTotal += vmViewModel.GetInt() + vmViewModel.GetInt2();
+            nTotal += gsl::narrow_cast<int>(vmViewModel.GetString().length());
+        }
+        const auto tGet = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < nIterations; ++i)
+        {
+            vmViewModel.SetInt(i);
+            vmViewModel.SetBool((i & 1) != 0);
+        }
+        const auto tSet = std::chrono::steady_clock::now();
+
+        const auto nGetNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(tGet - tStart).count();
+        const auto nSetNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(tSet - tGet).count();
+        std::string sMessage = "GetValue: " + std::to_string(nGetNanoseconds / (nIterations * 3 / 1000)) +
+                               "ns per 1000 calls (" + std::to_string(nTotal) + ")\n";
+        sMessage += "SetValue: " + std::to_string(nSetNanoseconds / (nIterations * 2 / 1000)) + "ns per 1000 calls\n";
+        sMessage += "sizeof(ModelPropertyContainer): " + std::to_string(sizeof(ModelPropertyContainer)) + " bytes\n";
+        Logger::WriteMessage(sMessage.c_str());
+    }
 };
 
 } // namespace tests
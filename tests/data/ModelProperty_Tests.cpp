@@ -80,6 +80,42 @@ public:
 
         AssertProperty(nKey, nullptr);
     }
+
+    TEST_METHOD(TestValueMap)
+    {
+        IntModelProperty::ValueMap mValues;
+        Assert::IsTrue(mValues.empty());
+        Assert::IsTrue(mValues.find(1) == mValues.end());
+
+        mValues.insert_or_assign(7, 70);
+        mValues.insert_or_assign(3, 30);
+        mValues.insert_or_assign(5, 50);
+        Assert::AreEqual({ 3U }, mValues.size());
+
+        // entries are kept sorted by key
+        auto iter = mValues.begin();
+        Assert::AreEqual(3, iter->first);
+        Assert::AreEqual(5, (++iter)->first);
+        Assert::AreEqual(7, (++iter)->first);
+
+        iter = mValues.find(5);
+        Assert::IsFalse(iter == mValues.end());
+        Assert::AreEqual(50, iter->second);
+
+        mValues.insert_or_assign(5, 55);
+        Assert::AreEqual({ 3U }, mValues.size());
+        Assert::AreEqual(55, mValues.find(5)->second);
+
+        mValues.erase(mValues.find(3));
+        Assert::AreEqual({ 2U }, mValues.size());
+        Assert::IsTrue(mValues.find(3) == mValues.end());
+        Assert::AreEqual(70, mValues.find(7)->second);
+
+        IntModelProperty::ValueMap mOther;
+        mOther.swap(mValues);
+        Assert::IsTrue(mValues.empty());
+        Assert::AreEqual({ 2U }, mOther.size());
+    }
 };
 
 } // namespace tests
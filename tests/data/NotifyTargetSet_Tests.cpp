@@ -0,0 +1,126 @@
+#include "data\NotifyTargetSet.hh"
+
+#include "ra_fwd.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace data {
+namespace tests {
+
+TEST_CLASS(NotifyTargetSet_Tests)
+{
+    class TargetHarness
+    {
+    public:
+        int nCalls = 0;
+    };
+
+public:
+    TEST_METHOD(TestAddRemove)
+    {
+        NotifyTargetSet<TargetHarness> vTargets;
+        Assert::IsTrue(vTargets.IsEmpty());
+
+        TargetHarness pTarget1, pTarget2;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget1);
+        Assert::IsFalse(vTargets.IsEmpty());
+        Assert::AreEqual({ 2U }, vTargets.Count());
+
+        vTargets.Dispatch([](TargetHarness& pTarget) noexcept { ++pTarget.nCalls; });
+        Assert::AreEqual(1, pTarget1.nCalls);
+        Assert::AreEqual(1, pTarget2.nCalls);
+
+        vTargets.Remove(pTarget1);
+        Assert::AreEqual({ 1U }, vTargets.Count());
+
+        vTargets.Dispatch([](TargetHarness& pTarget) noexcept { ++pTarget.nCalls; });
+        Assert::AreEqual(1, pTarget1.nCalls);
+        Assert::AreEqual(2, pTarget2.nCalls);
+
+        vTargets.Clear();
+        Assert::IsTrue(vTargets.IsEmpty());
+    }
+
+    TEST_METHOD(TestRemoveDuringDispatch)
+    {
+        NotifyTargetSet<TargetHarness> vTargets;
+        TargetHarness pTarget1, pTarget2, pTarget3;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        // removing a target that hasn't been called yet prevents it from being called
+        vTargets.Dispatch([&](TargetHarness& pTarget) {
+            ++pTarget.nCalls;
+            vTargets.Remove(pTarget2);
+        });
+        Assert::AreEqual(1, pTarget1.nCalls);
+        Assert::AreEqual(0, pTarget2.nCalls);
+        Assert::AreEqual(1, pTarget3.nCalls);
+        Assert::AreEqual({ 2U }, vTargets.Count());
+
+        // removed entry is compacted after the dispatch completes
+        vTargets.Dispatch([](TargetHarness& pTarget) noexcept { ++pTarget.nCalls; });
+        Assert::AreEqual(2, pTarget1.nCalls);
+        Assert::AreEqual(0, pTarget2.nCalls);
+        Assert::AreEqual(2, pTarget3.nCalls);
+    }
+
+    TEST_METHOD(TestAddDuringDispatch)
+    {
+        NotifyTargetSet<TargetHarness> vTargets;
+        TargetHarness pTarget1, pTarget2;
+        vTargets.Add(pTarget1);
+
+        // targets added during a dispatch are not notified until the next dispatch
+        vTargets.Dispatch([&](TargetHarness& pTarget) {
+            ++pTarget.nCalls;
+            vTargets.Add(pTarget2);
+        });
+        Assert::AreEqual(1, pTarget1.nCalls);
+        Assert::AreEqual(0, pTarget2.nCalls);
+        Assert::AreEqual({ 2U }, vTargets.Count());
+
+        vTargets.Dispatch([](TargetHarness& pTarget) noexcept { ++pTarget.nCalls; });
+        Assert::AreEqual(2, pTarget1.nCalls);
+        Assert::AreEqual(1, pTarget2.nCalls);
+    }
+
+    TEST_METHOD(TestClearDuringNestedDispatch)
+    {
+        NotifyTargetSet<TargetHarness> vTargets;
+        TargetHarness pTarget1, pTarget2;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+
+        bool bNested = false;
+        vTargets.Dispatch([&](TargetHarness& pTarget) {
+            ++pTarget.nCalls;
+            if (!bNested)
+            {
+                bNested = true;
+                vTargets.Dispatch([&](TargetHarness& pInnerTarget) {
+                    pInnerTarget.nCalls += 10;
+                    vTargets.Clear();
+                });
+            }
+        });
+
+        // outer dispatch called target1, inner dispatch called target1 and cleared the set
+        Assert::AreEqual(11, pTarget1.nCalls);
+        Assert::AreEqual(0, pTarget2.nCalls);
+        Assert::IsTrue(vTargets.IsEmpty());
+
+        vTargets.Add(pTarget2);
+        vTargets.Dispatch([](TargetHarness& pTarget) noexcept { ++pTarget.nCalls; });
+        Assert::AreEqual(11, pTarget1.nCalls);
+        Assert::AreEqual(1, pTarget2.nCalls);
+    }
+};
+
+} // namespace tests
+} // namespace data
+} // namespace ra
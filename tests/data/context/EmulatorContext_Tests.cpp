@@ -1253,6 +1253,26 @@ public:
         Assert::AreEqual(0x57, static_cast<int>(emulator.ReadMemory(4U, MemSize::EightBit)));
     }
 
+    TEST_METHOD(TestDecodeMemoryValue)
+    {
+        const std::array<uint8_t, 4> pBuffer = { 0xA8, 0x00, 0x37, 0x2E };
+
+        Assert::AreEqual(0U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Bit_0));
+        Assert::AreEqual(1U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Bit_3));
+        Assert::AreEqual(1U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Bit_7));
+        Assert::AreEqual(3U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::BitCount));
+        Assert::AreEqual(8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Nibble_Lower));
+        Assert::AreEqual(10U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Nibble_Upper));
+        Assert::AreEqual(0xA8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::EightBit));
+        Assert::AreEqual(0xA8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::SixteenBit));
+        Assert::AreEqual(0x3700A8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::TwentyFourBit));
+        Assert::AreEqual(0x2E3700A8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::ThirtyTwoBit));
+        Assert::AreEqual(0xA800U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::SixteenBitBigEndian));
+        Assert::AreEqual(0xA80037U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::TwentyFourBitBigEndian));
+        Assert::AreEqual(0xA800372EU, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::ThirtyTwoBitBigEndian));
+        Assert::AreEqual(0x2E3700A8U, EmulatorContext::DecodeMemoryValue(pBuffer.data(), MemSize::Float));
+    }
+
     TEST_METHOD(TestReadMemoryBlock)
     {
         for (size_t i = 0; i < memory.size(); i++)
@@ -1333,6 +1353,23 @@ public:
         Assert::IsFalse(emulator.mockAchievementRuntime.IsAchievementSupported(1));
     }
 
+    TEST_METHOD(TestGetReadableBytes)
+    {
+        EmulatorContextHarness emulator;
+        Assert::AreEqual({ 0U }, emulator.GetReadableBytes(4U));
+
+        emulator.AddMemoryBlock(0, 20, &ReadMemory0, &WriteMemory0);
+        emulator.AddMemoryBlock(1, 10, nullptr, nullptr);
+        emulator.AddMemoryBlock(2, 30, &ReadMemory2, &WriteMemory2);
+        Assert::AreEqual({ 20U }, emulator.GetReadableBytes(0U));
+        Assert::AreEqual({ 1U }, emulator.GetReadableBytes(19U));
+        Assert::AreEqual({ 0U }, emulator.GetReadableBytes(20U));
+        Assert::AreEqual({ 0U }, emulator.GetReadableBytes(29U));
+        Assert::AreEqual({ 30U }, emulator.GetReadableBytes(30U));
+        Assert::AreEqual({ 5U }, emulator.GetReadableBytes(55U));
+        Assert::AreEqual({ 0U }, emulator.GetReadableBytes(60U));
+    }
+
     TEST_METHOD(TestReadMemoryBuffer)
     {
         InitializeMemory();
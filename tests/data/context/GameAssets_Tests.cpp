@@ -691,6 +691,147 @@ public:
             GameAssets::FirstLocalId);
         Assert::AreEqual(sExpected, gameAssets.GetUserFile());
     }
+    TEST_METHOD(TestReloadUsesIndexFromSave)
+    {
+        GameAssetsHarness gameAssets;
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        auto& pAchievement2 = gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach2", L"Desc2", L"22222", "2=2");
+        gameAssets.SaveAllAssets();
+
+        // change the ID of the first record without changing the size of the file. a full scan would merge the
+        // first record into the second achievement. the index knows where the second achievement's record is.
+        std::string sFile = gameAssets.GetUserFile();
+        const auto sFirstId = std::to_string(GameAssets::FirstLocalId) + ":";
+        const auto nOffset = sFile.find(sFirstId);
+        Assert::AreNotEqual(std::string::npos, nOffset);
+        sFile.replace(nOffset, sFirstId.length(), std::to_string(GameAssets::FirstLocalId + 1) + ":");
+        gameAssets.MockUserFile(sFile);
+
+        pAchievement2.SetName(L"Modified");
+        Assert::AreEqual(AssetChanges::Modified, pAchievement2.GetChanges());
+
+        gameAssets.ReloadAsset(AssetType::Achievement, GameAssets::FirstLocalId + 1);
+
+        Assert::AreEqual(std::wstring(L"Ach2"), pAchievement2.GetName());
+        Assert::AreEqual(std::string("2=2"), pAchievement2.GetTrigger());
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement2.GetChanges());
+    }
+
+    TEST_METHOD(TestReloadFileChangedSinceIndexed)
+    {
+        GameAssetsHarness gameAssets;
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        auto& pAchievement2 = gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach2", L"Desc2", L"22222", "2=2");
+        gameAssets.SaveAllAssets();
+
+        // file was modified outside of the toolkit. records have moved, so the index can't be used.
+        gameAssets.MockUserFileContents(ra::StringPrintf(
+            "%u:\"1=1\":Ach1:\"Longer Desc1\"::::Auth1:5:::::11111\n"
+            "%u:\"2=3\":Ach2b:Desc2::::Auth2:5:::::22222\n",
+            GameAssets::FirstLocalId, GameAssets::FirstLocalId + 1));
+
+        gameAssets.ReloadAsset(AssetType::Achievement, GameAssets::FirstLocalId + 1);
+
+        Assert::AreEqual(std::wstring(L"Ach2b"), pAchievement2.GetName());
+        Assert::AreEqual(std::string("2=3"), pAchievement2.GetTrigger());
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement2.GetChanges());
+    }
+
+    TEST_METHOD(TestReloadIndexIgnoredWhenTimestampChanges)
+    {
+        GameAssetsHarness gameAssets;
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        auto& pAchievement2 = gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach2", L"Desc2", L"22222", "2=2");
+        gameAssets.SaveAllAssets();
+
+        // change the ID of the first record without changing the size of the file, but update the timestamp
+        std::string sFile = gameAssets.GetUserFile();
+        const auto sFirstId = std::to_string(GameAssets::FirstLocalId) + ":";
+        sFile.replace(sFile.find(sFirstId), sFirstId.length(), std::to_string(GameAssets::FirstLocalId + 1) + ":");
+        gameAssets.MockUserFile(sFile);
+        gameAssets.mockLocalStorage.MockLastModified(ra::services::StorageItemType::UserAchievements,
+            std::to_wstring(gameAssets.mockGameContext.GameId()), std::chrono::system_clock::now());
+
+        gameAssets.ReloadAsset(AssetType::Achievement, GameAssets::FirstLocalId + 1);
+
+        // full scan merges the first record with the matching ID
+        Assert::AreEqual(std::wstring(L"Ach1"), pAchievement2.GetName());
+        Assert::AreEqual(std::string("1=1"), pAchievement2.GetTrigger());
+    }
+
+    TEST_METHOD(TestReloadIndexedDiscardsMissingLocalAchievement)
+    {
+        GameAssetsHarness gameAssets;
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        gameAssets.SaveAllAssets();
+
+        // not in the file, and the file hasn't changed since it was written
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach2", L"Desc2", L"22222", "2=2");
+        Assert::IsNotNull(gameAssets.FindAchievement(GameAssets::FirstLocalId + 1));
+
+        gameAssets.ReloadAsset(AssetType::Achievement, GameAssets::FirstLocalId + 1);
+
+        Assert::IsNull(gameAssets.FindAchievement(GameAssets::FirstLocalId + 1));
+        Assert::IsNotNull(gameAssets.FindAchievement(GameAssets::FirstLocalId));
+    }
+
+    TEST_METHOD(TestReloadIndexedLeaderboard)
+    {
+        GameAssetsHarness gameAssets;
+        auto& pLeaderboard = gameAssets.AddLeaderboard(AssetCategory::Local, L"LB1", L"Desc1",
+            "0xH1234=1", "0xH1234=2", "0xH1234=3", "0xH2345", ValueFormat::Score);
+        gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        gameAssets.SaveAllAssets();
+
+        pLeaderboard.SetName(L"Modified");
+        pLeaderboard.SetStartTrigger("0xH1234=9");
+
+        gameAssets.ReloadAsset(AssetType::Leaderboard, GameAssets::FirstLocalId);
+
+        Assert::AreEqual(std::wstring(L"LB1"), pLeaderboard.GetName());
+        Assert::AreEqual(std::string("0xH1234=1"), pLeaderboard.GetStartTrigger());
+        Assert::AreEqual(AssetChanges::Unpublished, pLeaderboard.GetChanges());
+    }
+
+    TEST_METHOD(TestSaveAfterUnsavedChangesToSavedAsset)
+    {
+        GameAssetsHarness gameAssets;
+        auto& pAchievement1 = gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach1", L"Desc1", L"11111", "1=1");
+        auto& pAchievement2 = gameAssets.AddAchievement(AssetCategory::Local, 5, L"Ach2", L"Desc2", L"22222", "2=2");
+        gameAssets.SaveAllAssets();
+
+        const auto& sExpected = ra::StringPrintf("0.0.0.0\nGameName\n"
+            "%u:\"1=1\":Ach1:Desc1::::Auth1:5:::::11111\n"
+            "%u:\"2=2\":Ach2:Desc2::::Auth2:5:::::22222\n",
+            GameAssets::FirstLocalId, GameAssets::FirstLocalId + 1);
+        Assert::AreEqual(sExpected, gameAssets.GetUserFile());
+
+        // author is not transactional, so the achievement isn't Modified, but the saved text must still change.
+        pAchievement1.SetAuthor(L"Someone");
+        // name is transactional, but the achievement is not selected, so the change is not written.
+        pAchievement2.SetName(L"Modified");
+
+        std::vector<ra::data::models::AssetModelBase*> vAssetsToSave;
+        vAssetsToSave.push_back(&pAchievement1);
+        gameAssets.SaveAssets(vAssetsToSave);
+
+        const auto& sExpected2 = ra::StringPrintf("0.0.0.0\nGameName\n"
+            "%u:\"1=1\":Ach1:Desc1::::Someone:5:::::11111\n"
+            "%u:\"2=2\":Ach2:Desc2::::Auth2:5:::::22222\n",
+            GameAssets::FirstLocalId, GameAssets::FirstLocalId + 1);
+        Assert::AreEqual(sExpected2, gameAssets.GetUserFile());
+
+        // now save the second achievement
+        vAssetsToSave.clear();
+        vAssetsToSave.push_back(&pAchievement2);
+        gameAssets.SaveAssets(vAssetsToSave);
+
+        const auto& sExpected3 = ra::StringPrintf("0.0.0.0\nGameName\n"
+            "%u:\"1=1\":Ach1:Desc1::::Someone:5:::::11111\n"
+            "%u:\"2=2\":Modified:Desc2::::Auth2:5:::::22222\n",
+            GameAssets::FirstLocalId, GameAssets::FirstLocalId + 1);
+        Assert::AreEqual(sExpected3, gameAssets.GetUserFile());
+    }
 };
 
 } // namespace tests
@@ -25,6 +25,20 @@ namespace tests {
 
 TEST_CLASS(SessionTracker_Tests)
 {
+private:
+    static constexpr size_t LOG_HEADER_SIZE = 8;
+    static constexpr size_t LOG_RECORD_SIZE = 20;
+
+    template<typename T>
+    static T ReadValue(const std::string& sBuffer, size_t nOffset)
+    {
+        std::make_unsigned_t<T> nBits = 0;
+        for (size_t i = sizeof(T); i > 0; --i)
+            nBits = gsl::narrow_cast<std::make_unsigned_t<T>>((nBits << 8) | static_cast<uint8_t>(sBuffer.at(nOffset + i - 1)));
+
+        return static_cast<T>(nBits);
+    }
+
 public:
     class SessionTrackerHarness : public SessionTracker
     {
@@ -59,6 +73,59 @@ public:
             mockStorage.MockStoredData(StorageItemType::SessionStats, m_sUsernameWide, sContents);
         }
 
+        bool HasSessionLog() const
+        {
+            return mockStorage.HasStoredData(StorageItemType::SessionLog, m_sUsernameWide);
+        }
+
+        bool HasSessionIndex() const
+        {
+            return mockStorage.HasStoredData(StorageItemType::SessionIndex, m_sUsernameWide);
+        }
+
+        // decodes the binary session log into "<gameid>:<sessionstart>:<sessionlength>" lines
+        std::string GetSessionLog() const
+        {
+            const auto& sLog = mockStorage.GetStoredData(StorageItemType::SessionLog, m_sUsernameWide);
+            std::string sDecoded;
+            if (sLog.empty())
+                return sDecoded;
+
+            Assert::AreEqual(std::string("RASL"), sLog.substr(0, 4));
+            for (size_t nOffset = LOG_HEADER_SIZE; nOffset + LOG_RECORD_SIZE <= sLog.size(); nOffset += LOG_RECORD_SIZE)
+            {
+                sDecoded.append(std::to_string(ReadValue<uint32_t>(sLog, nOffset)));
+                sDecoded.push_back(':');
+                sDecoded.append(std::to_string(ReadValue<int64_t>(sLog, nOffset + 4)));
+                sDecoded.push_back(':');
+                sDecoded.append(std::to_string(ReadValue<uint32_t>(sLog, nOffset + 12)));
+                sDecoded.push_back('\n');
+            }
+
+            return sDecoded;
+        }
+
+        void CorruptSessionLogRecord(size_t nRecord)
+        {
+            auto sLog = mockStorage.GetStoredData(StorageItemType::SessionLog, m_sUsernameWide);
+            sLog.at(LOG_HEADER_SIZE + nRecord * LOG_RECORD_SIZE + 12) ^= 0x40; // modify session length
+            mockStorage.MockStoredData(StorageItemType::SessionLog, m_sUsernameWide, sLog);
+        }
+
+        void DeleteSessionIndex()
+        {
+            mockStorage.DeleteStoredData(StorageItemType::SessionIndex, m_sUsernameWide);
+        }
+
+        void CopySessionData(const SessionTrackerHarness& pOther)
+        {
+            for (const auto nType : { StorageItemType::SessionStats, StorageItemType::SessionLog, StorageItemType::SessionIndex })
+            {
+                if (pOther.mockStorage.HasStoredData(nType, m_sUsernameWide))
+                    mockStorage.MockStoredData(nType, m_sUsernameWide, pOther.mockStorage.GetStoredData(nType, m_sUsernameWide));
+            }
+        }
+
         void MockInspectingMemory(bool bInspectingMemory)
         {
             mockWindowManager.MemoryBookmarks.SetIsVisible(bInspectingMemory);
@@ -79,7 +146,7 @@ public:
         SessionTrackerHarness tracker;
 
         tracker.Initialize("User");
-        Assert::IsFalse(tracker.HasStoredData());
+        Assert::IsFalse(tracker.HasSessionLog());
 
         bool bSessionStarted = false;
         tracker.mockServer.HandleRequest<ra::api::StartSession>([&bSessionStarted](const ra::api::StartSession::Request& request, _UNUSED ra::api::StartSession::Response& /*response*/)
@@ -94,7 +161,7 @@ public:
         tracker.BeginSession(1234U);
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
-        Assert::IsFalse(tracker.HasStoredData());
+        Assert::IsFalse(tracker.HasSessionLog());
         Assert::IsTrue(bSessionStarted);
 
         // after 30 seconds, the callback will be called, but the file shouldn't be written until at least 60 seconds have elapsed
@@ -102,23 +169,23 @@ public:
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(30));
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
-        Assert::IsFalse(tracker.HasStoredData());
+        Assert::IsFalse(tracker.HasSessionLog());
 
         // after two minutes, the callback will be called again, and the file finally written
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
-        Assert::IsTrue(tracker.HasStoredData());
-        Assert::AreEqual(std::string("1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::IsTrue(tracker.HasSessionLog());
+        Assert::AreEqual(std::string("1234:1534889323:150\n"), tracker.GetSessionLog());
 
         // after two more minutes, the callback will be called again, and the file updated
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
-        Assert::IsTrue(tracker.HasStoredData());
-        Assert::AreEqual(std::string("1234:1534889323:270:f9\n"), tracker.GetStoredData());
+        Assert::IsTrue(tracker.HasSessionLog());
+        Assert::AreEqual(std::string("1234:1534889323:270\n"), tracker.GetSessionLog());
     }
 
     TEST_METHOD(TestNonEmptyFile)
@@ -128,7 +195,7 @@ public:
         tracker.MockStoredData(sInitialValue);
 
         tracker.Initialize("User");
-        Assert::IsTrue(tracker.HasStoredData());
+        Assert::IsTrue(tracker.HasSessionLog());
 
         bool bSessionStarted = false;
         tracker.mockServer.HandleRequest<ra::api::StartSession>([&bSessionStarted](const ra::api::StartSession::Request& request, _UNUSED ra::api::StartSession::Response& /*response*/)
@@ -142,24 +209,24 @@ public:
         tracker.mockGameContext.SetGameId(1234U);
         tracker.BeginSession(1234U);
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
-        Assert::AreEqual(sInitialValue, tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n"), tracker.GetSessionLog());
         Assert::IsTrue(bSessionStarted);
 
         // after 30 seconds, the callback will be called, but the file shouldn't be written until at least 60 seconds have elapsed
         tracker.mockClock.AdvanceTime(std::chrono::seconds(30));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(30));
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
-        Assert::AreEqual(sInitialValue, tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n"), tracker.GetSessionLog());
 
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:150\n"), tracker.GetSessionLog());
 
         // after two more minutes, the callback will be called again, and the new entry updated
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:270:f9\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:270\n"), tracker.GetSessionLog());
 
         // total playtime should include current session and previous session
         Assert::AreEqual(1732U + 270U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
@@ -167,7 +234,7 @@ public:
         // ending session should count any time in the since the last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(23));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:293:c9\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:293\n"), tracker.GetSessionLog());
         Assert::AreEqual(1732U + 293U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
     }
 
@@ -207,11 +274,11 @@ public:
         tracker.MockStoredData(sInitialValue);
 
         tracker.Initialize("User");
-        Assert::IsTrue(tracker.HasStoredData());
+        Assert::IsTrue(tracker.HasSessionLog());
 
         tracker.mockGameContext.SetGameId(1234U);
         tracker.BeginSession(1234U);
-        Assert::AreEqual(sInitialValue, tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n"), tracker.GetSessionLog());
 
         // after 30 seconds, the callback will be called, but the file shouldn't be written until at least 60 seconds have elapsed
         tracker.mockClock.AdvanceTime(std::chrono::seconds(30));
@@ -220,12 +287,12 @@ public:
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:150\n"), tracker.GetSessionLog());
 
         // end session should include time since last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(23));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:173\n"), tracker.GetSessionLog());
 
         // start new session
         tracker.BeginSession(9999U);
@@ -237,12 +304,94 @@ public:
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n9999:1534889496:150:d0\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:173\n9999:1534889496:150\n"), tracker.GetSessionLog());
 
         // end session should include time since last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(19));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n9999:1534889496:169:14\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:173\n9999:1534889496:169\n"), tracker.GetSessionLog());
+    }
+
+    TEST_METHOD(TestMigrateTextFile)
+    {
+        std::string sInitialValue("1234:1534000000:1732:f5\n"
+            "9999:1534100000:963:00\n"
+            "1234:1534200000:591:0b\n");
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData(sInitialValue);
+
+        // valid entries should be copied to the binary log and the text file left alone
+        tracker.Initialize("User");
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534200000:591\n"), tracker.GetSessionLog());
+        Assert::IsTrue(tracker.HasSessionIndex());
+        Assert::AreEqual(sInitialValue, tracker.GetStoredData());
+        Assert::AreEqual(1732U + 591U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(0U, static_cast<unsigned int>(tracker.GetTotalPlaytime(9999U).count()));
+
+        // once migrated, changes to the text file should be ignored
+        tracker.MockStoredData("9999:1534100000:963:4e\n");
+        tracker.Initialize("User");
+        Assert::AreEqual(1732U + 591U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(0U, static_cast<unsigned int>(tracker.GetTotalPlaytime(9999U).count()));
+    }
+
+    TEST_METHOD(TestLoadFromIndex)
+    {
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData("1234:1534000000:1732:f5\n");
+        tracker.Initialize("User");
+
+        tracker.mockGameContext.SetGameId(1234U);
+        tracker.BeginSession(1234U);
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(173));
+        tracker.EndSession();
+        Assert::AreEqual(std::string("1234:1534000000:1732\n1234:1534889323:173\n"), tracker.GetSessionLog());
+
+        // the index is up to date, so the log should not be read
+        tracker.CorruptSessionLogRecord(0);
+        tracker.Initialize("User");
+        Assert::AreEqual(1732U + 173U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+
+        // without the index, the totals are rebuilt from the log, ignoring any damaged records
+        tracker.DeleteSessionIndex();
+        tracker.Initialize("User");
+        Assert::IsTrue(tracker.HasSessionIndex());
+        Assert::AreEqual(173U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+    }
+
+    TEST_METHOD(TestReplayUnfinishedSession)
+    {
+        SessionTrackerHarness tracker;
+        tracker.Initialize("User");
+
+        tracker.mockGameContext.SetGameId(1234U);
+        tracker.BeginSession(1234U);
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(173));
+        tracker.EndSession();
+
+        // second session is written by the periodic update, but never ended
+        tracker.BeginSession(9999U);
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(30));
+        tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(30));
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
+        tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
+        Assert::AreEqual(std::string("1234:1534889323:173\n9999:1534889496:150\n"), tracker.GetSessionLog());
+
+        // sessions after the indexed portion of the log should be replayed at the next login
+        SessionTrackerHarness tracker2;
+        tracker2.CopySessionData(tracker);
+        tracker2.Initialize("User");
+        Assert::AreEqual(173U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(150U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(9999U).count()));
+        Assert::AreEqual(9999U, tracker2.SessionData().front().GameId);
+
+        // new sessions should be appended after the replayed session
+        tracker2.mockGameContext.SetGameId(1234U);
+        tracker2.BeginSession(1234U);
+        tracker2.mockClock.AdvanceTime(std::chrono::seconds(45));
+        tracker2.EndSession();
+        Assert::AreEqual(std::string("1234:1534889323:173\n9999:1534889496:150\n1234:1534889323:45\n"), tracker2.GetSessionLog());
+        Assert::AreEqual(173U + 45U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
     }
 
     TEST_METHOD(TestPing)
@@ -332,7 +481,7 @@ public:
 
         // total playtime should still be tallied, but not written to the file
         Assert::AreEqual(150, gsl::narrow<int>(tracker.GetTotalPlaytime(0U).count()));
-        Assert::AreEqual(std::string(""), tracker.GetStoredData());
+        Assert::AreEqual(std::string(""), tracker.GetSessionLog());
     }
 
     TEST_METHOD(TestCurrentActivityNoRichPresence)
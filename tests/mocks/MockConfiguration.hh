@@ -47,6 +47,10 @@ public:
     }
 
     unsigned int GetNumBackgroundThreads() const noexcept override { return m_nBackgroundThreads; }
+    void SetNumBackgroundThreads(unsigned int nValue) noexcept { m_nBackgroundThreads = nValue; }
+
+    LogLevel GetLogLevel() const noexcept override { return m_nLogLevel; }
+    void SetLogLevel(LogLevel nValue) noexcept { m_nLogLevel = nValue; }
 
     const std::wstring& GetRomDirectory() const noexcept override { return m_sRomDirectory; }
     void SetRomDirectory(const std::wstring& sValue) override { m_sRomDirectory = sValue; }
@@ -109,6 +113,7 @@ private:
     std::string m_sImageHostUrl;
 
     unsigned int m_nBackgroundThreads = 0;
+    LogLevel m_nLogLevel = LogLevel::Info;
 
     std::set<Feature> m_vEnabledFeatures;
     std::array<ra::ui::viewmodels::PopupLocation, ra::etoi(ra::ui::viewmodels::Popup::NumPopups)> m_vPopupLocations = {};
@@ -6,6 +6,8 @@
 
 #include "ui\IDesktop.hh"
 
+#include "tests\mocks\MockSurface.hh"
+
 namespace ra {
 namespace ui {
 namespace mocks {
@@ -60,11 +62,19 @@ public:
         m_sLastOpenedUrl = sUrl;
     }
 
-    std::unique_ptr<ra::ui::drawing::ISurface> CaptureClientArea(const WindowViewModelBase&) const noexcept override
+    std::unique_ptr<ra::ui::drawing::ISurface> CaptureClientArea(const WindowViewModelBase&) const override
     {
-        return {};
+        if (m_szClientArea.Width == 0 || m_szClientArea.Height == 0)
+            return {};
+
+        return std::make_unique<ra::ui::drawing::mocks::MockSurface>(m_szClientArea.Width, m_szClientArea.Height);
     }
 
+    /// <summary>
+    /// Sets the size of the surface returned by <see cref="CaptureClientArea" />. If not set, no surface is returned.
+    /// </summary>
+    void SetClientAreaSize(int nWidth, int nHeight) noexcept { m_szClientArea = { nWidth, nHeight }; }
+
     const std::string& LastOpenedUrl() const noexcept { return m_sLastOpenedUrl; }
 
     void Shutdown() noexcept override {}
@@ -114,6 +124,7 @@ private:
     mutable std::string m_sLastOpenedUrl;
     std::wstring m_sExecutable;
     bool m_bDebuggerPresent = false;
+    ra::ui::Size m_szClientArea;
 };
 
 } // namespace mocks
@@ -0,0 +1,40 @@
+#ifndef RA_SERVICES_MOCK_FILELOCK_HH
+#define RA_SERVICES_MOCK_FILELOCK_HH
+#pragma once
+
+#include "services\FileLock.hh"
+
+namespace ra {
+namespace services {
+namespace mocks {
+
+class MockFileLock : public FileLock
+{
+public:
+    MockFileLock(std::set<std::wstring>& vLockedFiles, const std::wstring& sKey)
+        : m_vLockedFiles(vLockedFiles), m_sKey(sKey)
+    {
+        // a process waiting on a lock it already holds would never be granted the lock
+        Expects(m_vLockedFiles.insert(m_sKey).second);
+    }
+
+    GSL_SUPPRESS_F6 ~MockFileLock() noexcept
+    {
+        m_vLockedFiles.erase(m_sKey);
+    }
+
+    MockFileLock(const MockFileLock&) noexcept = delete;
+    MockFileLock& operator=(const MockFileLock&) noexcept = delete;
+    MockFileLock(MockFileLock&&) noexcept = delete;
+    MockFileLock& operator=(MockFileLock&&) noexcept = delete;
+
+private:
+    std::set<std::wstring>& m_vLockedFiles;
+    std::wstring m_sKey;
+};
+
+} // namespace mocks
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_MOCK_FILELOCK_HH
@@ -4,9 +4,12 @@
 
 #include "services\IFileSystem.hh"
 #include "services\ServiceLocator.hh"
+#include "services\impl\StringMappedFile.hh"
 #include "services\impl\StringTextReader.hh"
 #include "services\impl\StringTextWriter.hh"
 
+#include "tests\mocks\MockFileLock.hh"
+
 namespace ra {
 namespace services {
 namespace mocks {
@@ -53,6 +56,23 @@ public:
         return vResults.size() - nInitialSize;
     }
 
+    size_t GetNonEmptyFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const override
+    {
+        const size_t nInitialSize = vResults.size();
+
+        std::vector<std::wstring> vFiles;
+        GetFilesInDirectory(sDirectory, vFiles);
+        for (auto& sFile : vFiles)
+        {
+            const auto pIter = m_mFileSizes.find(sDirectory + sFile);
+            const bool bEmpty = (pIter != m_mFileSizes.end()) ? (pIter->second <= 0) : m_mFileContents.at(sDirectory + sFile).empty();
+            if (!bEmpty)
+                vResults.push_back(std::move(sFile));
+        }
+
+        return vResults.size() - nInitialSize;
+    }
+
     /// <summary>
     /// Mocks the contents of a file.
     /// </summary>
@@ -187,6 +207,35 @@ public:
         return std::unique_ptr<TextWriter>(pWriter.release());
     }
 
+    std::unique_ptr<MappedFile> MapFile(const std::wstring& sPath) const override
+    {
+        if (!m_bMapFileSupported)
+            return std::unique_ptr<MappedFile>();
+
+        const auto pIter = m_mFileContents.find(sPath);
+        if (pIter == m_mFileContents.end() || pIter->second.empty())
+            return std::unique_ptr<MappedFile>();
+
+        auto pMappedFile = std::make_unique<ra::services::impl::StringMappedFile>(pIter->second);
+        return std::unique_ptr<MappedFile>(pMappedFile.release());
+    }
+
+    /// <summary>
+    /// Determines whether <see cref="MapFile" /> can succeed, so callers' streaming fallbacks can be tested.
+    /// </summary>
+    void SetMapFileSupported(bool bValue) noexcept { m_bMapFileSupported = bValue; }
+
+    std::unique_ptr<FileLock> LockFile(const std::wstring& sPath) const override
+    {
+        auto pFileLock = std::make_unique<MockFileLock>(m_vLockedFiles, sPath);
+        return std::unique_ptr<FileLock>(pFileLock.release());
+    }
+
+    /// <summary>
+    /// Determines whether a <see cref="FileLock" /> is currently held for the specified file.
+    /// </summary>
+    bool IsFileLocked(const std::wstring& sPath) const { return m_vLockedFiles.find(sPath) != m_vLockedFiles.end(); }
+
     std::wstring GetFileName(const std::wstring& sPath) const override
     {
         const auto nIndex = sPath.find_last_of(L"/\\");
@@ -221,6 +270,8 @@ private:
     mutable std::unordered_map<std::wstring, std::string> m_mFileContents;
     mutable std::unordered_map<std::wstring, int64_t> m_mFileSizes;
     mutable std::unordered_map<std::wstring, std::chrono::system_clock::time_point> m_mFileModifiedTimes;
+    bool m_bMapFileSupported = true;
+    mutable std::set<std::wstring> m_vLockedFiles;
 };
 
 } // namespace mocks
@@ -44,6 +44,11 @@ public:
 
     }
 
+    void FetchImages(_UNUSED ImageType nType, _UNUSED const std::vector<std::string>& vNames, _UNUSED bool bPriority) noexcept override
+    {
+
+    }
+
     std::string StoreImage(_UNUSED ImageType nType, _UNUSED const std::wstring& sPath) override
     {
         return "REPO:" + ra::Narrow(sPath);
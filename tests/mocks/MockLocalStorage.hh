@@ -4,9 +4,12 @@
 
 #include "services\ILocalStorage.hh"
 #include "services\ServiceLocator.hh"
+#include "services\impl\StringMappedFile.hh"
 #include "services\impl\StringTextReader.hh"
 #include "services\impl\StringTextWriter.hh"
 
+#include "tests\mocks\MockFileLock.hh"
+
 namespace ra {
 namespace services {
 namespace mocks {
@@ -90,7 +93,36 @@ public:
         return std::unique_ptr<TextWriter>(pWriter.release());
     }
 
+    std::unique_ptr<MappedFile> MapData(StorageItemType nType, const std::wstring& sKey) override
+    {
+        const auto pText = GetText(nType, sKey, false);
+        if (pText == nullptr || pText->empty())
+            return std::unique_ptr<MappedFile>();
+
+        auto pMappedFile = std::make_unique<ra::services::impl::StringMappedFile>(*pText);
+        return std::unique_ptr<MappedFile>(pMappedFile.release());
+    }
+
+    std::unique_ptr<FileLock> LockData(StorageItemType nType, const std::wstring& sKey) override
+    {
+        auto pFileLock = std::make_unique<MockFileLock>(m_vLockedData, GetLockKey(nType, sKey));
+        return std::unique_ptr<FileLock>(pFileLock.release());
+    }
+
+    /// <summary>
+    /// Determines whether a <see cref="FileLock" /> is currently held for the specified data.
+    /// </summary>
+    bool IsDataLocked(StorageItemType nType, const std::wstring& sKey) const
+    {
+        return m_vLockedData.find(GetLockKey(nType, sKey)) != m_vLockedData.end();
+    }
+
 private:
+    static std::wstring GetLockKey(StorageItemType nType, const std::wstring& sKey)
+    {
+        return std::to_wstring(ra::etoi(nType)) + L":" + sKey;
+    }
+
     std::string* GetText(StorageItemType nType, const std::wstring& sKey, bool bCreateIfMissing) const
     {
         auto pMap = m_mStoredData.find(nType);
@@ -119,6 +151,7 @@ private:
     ra::services::ServiceLocator::ServiceOverride<ra::services::ILocalStorage> m_Override;
     mutable std::unordered_map<StorageItemType, std::unordered_map<std::wstring, std::string>> m_mStoredData;
     mutable std::unordered_map<StorageItemType, std::unordered_map<std::wstring, std::chrono::system_clock::time_point>> m_mLastModified;
+    std::set<std::wstring> m_vLockedData;
 };
 
 } // namespace mocks
@@ -0,0 +1,31 @@
+#ifndef RA_SERVICES_MOCK_SUBMISSION_OUTBOX_HH
+#define RA_SERVICES_MOCK_SUBMISSION_OUTBOX_HH
+#pragma once
+
+#include "services\SubmissionOutbox.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+namespace mocks {
+
+/// <summary>
+/// Registers a <see cref="SubmissionOutbox" /> for the test. Submissions are sent through the IThreadPool and
+/// IServer services. They're only journaled if <see cref="Initialize" /> is called.
+/// </summary>
+class MockSubmissionOutbox : public SubmissionOutbox
+{
+public:
+    MockSubmissionOutbox() noexcept : m_Override(this)
+    {
+    }
+
+private:
+    ra::services::ServiceLocator::ServiceOverride<ra::services::SubmissionOutbox> m_Override;
+};
+
+} // namespace mocks
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_MOCK_SUBMISSION_OUTBOX_HH
@@ -33,11 +33,18 @@ public:
     void WriteText(int, int, int, Color, const std::wstring&) noexcept override {}
     void DrawImage(int, int, int, int, const ImageReference&) noexcept override {}
     void DrawImageStretched(int, int, int, int, const ImageReference&) noexcept override {}
-    void DrawSurface(int, int, const ISurface&) noexcept override {}
-    void DrawSurface(int, int, const ISurface&, int, int, int, int) noexcept override {}
+    void DrawSurface(int, int, const ISurface&) noexcept override { ++m_nDrawSurfaceCount; }
+    void DrawSurface(int, int, const ISurface&, int, int, int, int) noexcept override { ++m_nDrawSurfaceCount; }
     void SetOpacity(double) noexcept override {}
 
+    /// <summary>
+    /// Gets the number of times any <see cref="DrawSurface" /> overload has been called.
+    /// </summary>
+    int GetDrawSurfaceCount() const noexcept { return m_nDrawSurfaceCount; }
+    void ResetDrawSurfaceCount() noexcept { m_nDrawSurfaceCount = 0; }
+
 private:
+    int m_nDrawSurfaceCount = 0;
     unsigned int m_nWidth;
     unsigned int m_nHeight;
 };
@@ -49,21 +56,36 @@ public:
 
     std::unique_ptr<ISurface> CreateSurface(int nWidth, int nHeight) const override
     {
+        ++m_nSurfacesCreated;
         return std::make_unique<MockSurface>(nWidth, nHeight);
     }
 
     std::unique_ptr<ISurface> CreateTransparentSurface(int nWidth, int nHeight) const override
     {
+        ++m_nSurfacesCreated;
         return std::make_unique<MockSurface>(nWidth, nHeight);
     }
 
-    bool SaveImage(const ISurface&, const std::wstring&) const noexcept override
+    bool SaveImage(const ISurface&, const std::wstring& sPath) const override
     {
+        m_vSavedImages.push_back(sPath);
         return false;
     }
 
+    /// <summary>
+    /// Gets the paths passed to <see cref="SaveImage" />, in the order they were saved.
+    /// </summary>
+    const std::vector<std::wstring>& GetSavedImages() const noexcept { return m_vSavedImages; }
+
+    /// <summary>
+    /// Gets the number of surfaces that have been created by the factory.
+    /// </summary>
+    int GetSurfacesCreated() const noexcept { return m_nSurfacesCreated; }
+
 private:
     ra::services::ServiceLocator::ServiceOverride<ISurfaceFactory> m_Override;
+    mutable std::vector<std::wstring> m_vSavedImages;
+    mutable int m_nSurfacesCreated = 0;
 };
 
 } // namespace mocks
@@ -19,8 +19,13 @@ public:
     {
     }
 
-    void RunAsync(std::function<void()>&& f) override
+    using IThreadPool::RunAsync;
+
+    void RunAsync([[maybe_unused]] TaskPriority /*nPriority*/, std::function<void()>&& f) override
     {
+        if (m_bShutdownRequested)
+            return;
+
         if (m_bSynchronous)
         {
             f();
@@ -31,9 +36,24 @@ public:
         }
     }
 
-    void ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) override
+    ScheduledTaskId ScheduleAsync(std::chrono::milliseconds nDelay, std::function<void()>&& f) override
     {
-        m_vDelayedTasks.emplace_back(nDelay, f);
+        m_vDelayedTasks.emplace_back(++m_nLastScheduledTaskId, nDelay, f);
+        return m_nLastScheduledTaskId;
+    }
+
+    bool CancelScheduledTask(ScheduledTaskId nId) override
+    {
+        for (auto pIter = m_vDelayedTasks.begin(); pIter != m_vDelayedTasks.end(); ++pIter)
+        {
+            if (pIter->nId == nId)
+            {
+                m_vDelayedTasks.erase(pIter);
+                return true;
+            }
+        }
+
+        return false;
     }
 
     void AdvanceTime(std::chrono::milliseconds nDuration)
@@ -91,9 +111,14 @@ public:
         fTask();
     }
 
-    void Shutdown([[maybe_unused]] bool /*bWait*/) noexcept override {}
+    void Shutdown([[maybe_unused]] bool /*bWait*/) noexcept override
+    {
+        // like the real thread pool, tasks that haven't been started are discarded
+        m_bShutdownRequested = true;
+        m_vTasks = {};
+    }
 
-    bool IsShutdownRequested() const noexcept override { return false; }
+    bool IsShutdownRequested() const noexcept override { return m_bShutdownRequested; }
 
     /// <summary>
     /// Specifies whether non-scheduled tasks should be immediately executed when queued.
@@ -108,15 +133,19 @@ private:
 
     std::queue<std::function<void()>> m_vTasks;
     bool m_bSynchronous = false;
+    bool m_bShutdownRequested = false;
 
     struct DelayedTask
     {
-        DelayedTask(std::chrono::milliseconds nDelay, std::function<void()> fTask) : nDelay(nDelay), fTask(fTask) {};
+        DelayedTask(ScheduledTaskId nId, std::chrono::milliseconds nDelay, std::function<void()> fTask) :
+            nId(nId), nDelay(nDelay), fTask(fTask) {};
 
+        ScheduledTaskId nId;
         std::chrono::milliseconds nDelay;
         std::function<void()> fTask;
     };
     std::vector<DelayedTask> m_vDelayedTasks;
+    ScheduledTaskId m_nLastScheduledTaskId = 0;
 };
 
 } // namespace mocks
@@ -1280,6 +1280,102 @@ public:
         AssertChange(vChanges, AchievementRuntime::ChangeType::LeaderboardCancelTriggered, 6U);
     }
 
+    TEST_METHOD(TestGetStateChangesAchievements)
+    {
+        std::array<unsigned char, 1> memory{ 0x00 };
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+
+        std::vector<ra::AchievementID> vAchievementIds;
+        std::vector<ra::LeaderboardID> vLeaderboardIds;
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vAchievementIds.size());
+        Assert::AreEqual({ 0U }, vLeaderboardIds.size());
+
+        // newly activated achievements are reported
+        runtime.ActivateAchievement(6U, "0xH0000=1");
+        runtime.ActivateAchievement(7U, "0xH0000=2");
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 2U }, vAchievementIds.size());
+        Assert::AreEqual(6U, vAchievementIds.at(0));
+        Assert::AreEqual(7U, vAchievementIds.at(1));
+        Assert::AreEqual({ 0U }, vLeaderboardIds.size());
+
+        // nothing changed
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vAchievementIds.size());
+
+        // first Process call will switch the state from Waiting to Active
+        std::vector<AchievementRuntime::Change> vChanges;
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 2U }, vAchievementIds.size());
+        Assert::AreEqual(6U, vAchievementIds.at(0));
+        Assert::AreEqual(7U, vAchievementIds.at(1));
+
+        // still active
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vAchievementIds.size());
+
+        // only the triggered achievement is reported
+        memory.at(0) = 1;
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 1U }, vAchievementIds.size());
+        Assert::AreEqual(6U, vAchievementIds.at(0));
+
+        // deactivated achievements are reported
+        runtime.DeactivateAchievement(7U);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 1U }, vAchievementIds.size());
+        Assert::AreEqual(7U, vAchievementIds.at(0));
+
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vAchievementIds.size());
+    }
+
+    TEST_METHOD(TestGetStateChangesLeaderboards)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+
+        std::vector<ra::AchievementID> vAchievementIds;
+        std::vector<ra::LeaderboardID> vLeaderboardIds;
+        runtime.ActivateLeaderboard(6U, "STA:0xH00=1::CAN:0xH00=2::SUB:0xH00=3::VAL:0xH02");
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vAchievementIds.size());
+        Assert::AreEqual({ 1U }, vLeaderboardIds.size());
+        Assert::AreEqual(6U, vLeaderboardIds.at(0));
+
+        // first Process call will switch the state from Waiting to Active
+        std::vector<AchievementRuntime::Change> vChanges;
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 1U }, vLeaderboardIds.size());
+
+        // value changes don't change the state
+        memory.at(2) = 33;
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 0U }, vLeaderboardIds.size());
+
+        // started
+        memory.at(0) = 1;
+        runtime.Process(vChanges);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 1U }, vLeaderboardIds.size());
+        Assert::AreEqual(6U, vLeaderboardIds.at(0));
+
+        runtime.DeactivateLeaderboard(6U);
+        runtime.GetStateChanges(vAchievementIds, vLeaderboardIds);
+        Assert::AreEqual({ 1U }, vLeaderboardIds.size());
+        Assert::AreEqual(6U, vLeaderboardIds.at(0));
+    }
+
     TEST_METHOD(TestDetectUnsupportedAchievements)
     {
         ra::data::context::mocks::MockConsoleContext mockConsoleContext(Atari2600, L"Atari 2600");
@@ -0,0 +1,166 @@
+#include "CppUnitTest.h"
+
+#include "services\FileHasher.hh"
+
+#include "RA_md5factory.h"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+#include "tests\mocks\MockFileSystem.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ra::bitwise_ops;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(FileHasher_Tests)
+{
+private:
+    static void Append(FileHasher& pHasher, const std::string& sData)
+    {
+        const uint8_t* pData;
+        GSL_SUPPRESS_TYPE1 pData = reinterpret_cast<const uint8_t*>(sData.data());
+        pHasher.Append(pData, sData.length());
+    }
+
+    static std::string MakeData(size_t nSize)
+    {
+        std::string sData;
+        sData.reserve(nSize);
+        for (size_t i = 0; i < nSize; ++i)
+            sData.push_back(gsl::narrow_cast<char>(i * 7 + (i >> 8)));
+        return sData;
+    }
+
+public:
+    TEST_METHOD(TestEmpty)
+    {
+        FileHasher pHasher(HashAlgorithm::MD5 | HashAlgorithm::XXH64);
+        Assert::AreEqual(std::string("d41d8cd98f00b204e9800998ecf8427e"), pHasher.GetMD5());
+        Assert::AreEqual({ 0xEF46DB3751D8E999ULL }, pHasher.GetXXH64());
+        Assert::AreEqual({ 0U }, pHasher.GetBytesHashed());
+    }
+
+    TEST_METHOD(TestShortInput)
+    {
+        FileHasher pHasher(HashAlgorithm::MD5 | HashAlgorithm::XXH64);
+        Append(pHasher, "abc");
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), pHasher.GetMD5());
+        Assert::AreEqual({ 0x44BC2CF5AD770999ULL }, pHasher.GetXXH64());
+        Assert::AreEqual({ 3U }, pHasher.GetBytesHashed());
+    }
+
+    TEST_METHOD(TestLongInputInPieces)
+    {
+        // XXH64 processes data in 32-byte stripes - make sure partial stripes are carried between calls
+        FileHasher pHasher(HashAlgorithm::MD5 | HashAlgorithm::XXH64);
+        Append(pHasher, "Nobody ");
+        Append(pHasher, "inspects the spammish");
+        Append(pHasher, " repetition");
+        Assert::AreEqual(RAGenerateMD5(std::string("Nobody inspects the spammish repetition")), pHasher.GetMD5());
+        Assert::AreEqual({ 0xFBCEA83C8A378BF1ULL }, pHasher.GetXXH64());
+
+        const auto sData = MakeData(1000);
+        FileHasher pWhole(HashAlgorithm::XXH64);
+        Append(pWhole, sData);
+
+        FileHasher pSplit(HashAlgorithm::XXH64);
+        Append(pSplit, sData.substr(0, 5));
+        Append(pSplit, sData.substr(5, 64));
+        Append(pSplit, sData.substr(69));
+        Assert::AreEqual(pWhole.GetXXH64(), pSplit.GetXXH64());
+    }
+
+    TEST_METHOD(TestOnlyRequestedAlgorithms)
+    {
+        FileHasher pMD5(HashAlgorithm::MD5);
+        Append(pMD5, "abc");
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), pMD5.GetMD5());
+        Assert::AreEqual({ 0ULL }, pMD5.GetXXH64());
+
+        FileHasher pXXH64(HashAlgorithm::XXH64);
+        Append(pXXH64, "abc");
+        Assert::AreEqual(std::string(), pXXH64.GetMD5());
+        Assert::AreEqual({ 0x44BC2CF5AD770999ULL }, pXXH64.GetXXH64());
+    }
+
+    TEST_METHOD(TestAppendFileMapped)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        const auto sData = MakeData(FileHasher::StreamBufferSize * 2 + 100);
+        mockFileSystem.MockFile(L"game.iso", sData);
+
+        FileHasher pHasher(HashAlgorithm::MD5 | HashAlgorithm::XXH64);
+        std::vector<uint8_t> vBuffer;
+        Assert::IsTrue(pHasher.AppendFile(L"game.iso", vBuffer));
+
+        // mapped file should be hashed in place
+        Assert::AreEqual({ 0U }, vBuffer.size());
+
+        FileHasher pExpected(HashAlgorithm::XXH64);
+        Append(pExpected, sData);
+        Assert::AreEqual(RAGenerateMD5(sData), pHasher.GetMD5());
+        Assert::AreEqual(pExpected.GetXXH64(), pHasher.GetXXH64());
+        Assert::AreEqual(static_cast<uint64_t>(sData.length()), pHasher.GetBytesHashed());
+    }
+
+    TEST_METHOD(TestAppendFileStreamed)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        mockFileSystem.SetMapFileSupported(false);
+        const auto sData = MakeData(FileHasher::StreamBufferSize * 2 + 100);
+        mockFileSystem.MockFile(L"game.iso", sData);
+
+        FileHasher pHasher(HashAlgorithm::MD5);
+        std::vector<uint8_t> vBuffer;
+        Assert::IsTrue(pHasher.AppendFile(L"game.iso", vBuffer));
+        Assert::AreEqual(FileHasher::StreamBufferSize, vBuffer.size());
+
+        Assert::AreEqual(RAGenerateMD5(sData), pHasher.GetMD5());
+        Assert::AreEqual(static_cast<uint64_t>(sData.length()), pHasher.GetBytesHashed());
+    }
+
+    TEST_METHOD(TestAppendFileEmpty)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(L"empty.bin", "");
+
+        FileHasher pHasher(HashAlgorithm::MD5);
+        Assert::IsTrue(pHasher.AppendFile(L"empty.bin"));
+        Assert::AreEqual(std::string("d41d8cd98f00b204e9800998ecf8427e"), pHasher.GetMD5());
+    }
+
+    TEST_METHOD(TestAppendFileMissing)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+
+        FileHasher pHasher(HashAlgorithm::MD5);
+        Assert::IsFalse(pHasher.AppendFile(L"missing.bin"));
+        Assert::AreEqual(std::string(""), RAGenerateFileMD5(L"missing.bin"));
+    }
+
+    TEST_METHOD(TestAppendFileCancelled)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(L"game.iso", MakeData(1000));
+
+        std::atomic<bool> bCancel{ true };
+        FileHasher pHasher(HashAlgorithm::MD5);
+        pHasher.SetCancelFlag(&bCancel);
+        Assert::IsFalse(pHasher.AppendFile(L"game.iso"));
+        Assert::AreEqual({ 0U }, pHasher.GetBytesHashed());
+    }
+
+    TEST_METHOD(TestGenerateFileMD5)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(L"badge.png", "abc");
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), RAGenerateFileMD5(L"badge.png"));
+    }
+};
+
+} // namespace tests
+} // namespace services
+} // namespace ra
@@ -118,6 +118,11 @@ public:
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::UserPic, L"12345"), std::wstring(L".\\RACache\\UserPic\\12345.png"));
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::Bookmarks, L"12345"), std::wstring(L".\\RACache\\Bookmarks\\12345-Bookmarks.json"));
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::HashMapping, L"0123456789abcdef0123456789abcdef"), std::wstring(L".\\RACache\\Data\\0123456789abcdef0123456789abcdef.txt"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::KnownHashIndex, L"Hashes"), std::wstring(L".\\RACache\\Data\\Hashes.idx"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::KnownHashJournal, L"Hashes"), std::wstring(L".\\RACache\\Data\\Hashes.jnl"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::SessionLog, L"User"), std::wstring(L".\\RACache\\User-history.bin"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::SessionIndex, L"User"), std::wstring(L".\\RACache\\User-history.idx"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::SubmissionJournal, L"User"), std::wstring(L".\\RACache\\User-outbox.txt"));
     }
 
     TEST_METHOD(TestReadTextNonExistant)
@@ -157,6 +162,23 @@ public:
         pData->Write("{\"Key\": 1}");
         Assert::AreEqual(std::string("{\"Key\": 1}"), mockFileSystem.GetFileContents(L".\\RACache\\Data\\12345.json"));
     }
+
+    TEST_METHOD(TestLockData)
+    {
+        MockFileSystem mockFileSystem;
+        FileLocalStorage storage(mockFileSystem);
+
+        {
+            auto pLock = storage.LockData(ra::services::StorageItemType::KnownHashJournal, L"Hashes");
+            Assert::IsFalse(pLock == nullptr);
+
+            // the lock is held on a separate file so the data file can still be opened
+            Assert::IsTrue(mockFileSystem.IsFileLocked(L".\\RACache\\Data\\Hashes.jnl.lock"));
+            Assert::IsFalse(mockFileSystem.IsFileLocked(L".\\RACache\\Data\\Hashes.jnl"));
+        }
+
+        Assert::IsFalse(mockFileSystem.IsFileLocked(L".\\RACache\\Data\\Hashes.jnl.lock"));
+    }
 };
 
 } // namespace tests
@@ -2,12 +2,14 @@
 
 #include "tests\mocks\MockClock.hh"
 #include "tests\mocks\MockFileSystem.hh"
+#include "tests\mocks\MockThreadPool.hh"
 #include "tests\RA_UnitTestHelpers.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 using ra::services::mocks::MockClock;
 using ra::services::mocks::MockFileSystem;
+using ra::services::mocks::MockThreadPool;
 
 namespace ra {
 namespace services {
@@ -20,6 +22,28 @@ private:
     const std::wstring mockLogFileName = L".\\RACache\\RALog.txt";
     const std::wstring mockOldLogFileName = L".\\RACache\\RALog-old.txt";
 
+    // returns the number of messages that were either written or counted as dropped
+    static size_t CountLoggedMessages(const std::string& sContents)
+    {
+        size_t nWritten = 0;
+        size_t nIndex = 0;
+        while ((nIndex = sContents.find("| Message\n", nIndex)) != std::string::npos)
+        {
+            ++nWritten;
+            ++nIndex;
+        }
+
+        size_t nDropped = 0;
+        nIndex = 0;
+        while ((nIndex = sContents.find("|WARN| ", nIndex)) != std::string::npos)
+        {
+            nIndex += 7;
+            nDropped += std::stoul(sContents.substr(nIndex));
+        }
+
+        return nWritten + nDropped;
+    }
+
 public:
     TEST_METHOD(TestInitialization)
     {
@@ -77,6 +101,124 @@ public:
         Assert::AreEqual(static_cast<int>(mockFileSystem.GetFileSize(mockLogFileName)), 37);
         Assert::AreEqual(static_cast<int>(mockFileSystem.GetFileSize(mockOldLogFileName)), 1100000);
     }
+
+    TEST_METHOD(TestRotateWhileLogging)
+    {
+        MockClock mockClock;
+        MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(mockLogFileName, std::string(FileLogger::MaxLogSize - 20, 'A'));
+
+        FileLogger logger(mockFileSystem);
+        logger.LogMessage(LogLevel::Info, "This is a message.");
+        Assert::AreEqual(static_cast<int>(mockFileSystem.GetFileSize(mockLogFileName)), 0);
+        Assert::AreEqual(static_cast<int>(mockFileSystem.GetFileSize(mockOldLogFileName)), static_cast<int>(FileLogger::MaxLogSize) + 17);
+
+        logger.LogMessage(LogLevel::Info, "This is another message.");
+        Assert::AreEqual(std::string("220843.000|INFO| This is another message.\n"), mockFileSystem.GetFileContents(mockLogFileName));
+    }
+
+    TEST_METHOD(TestIsEnabled)
+    {
+        MockFileSystem mockFileSystem;
+        FileLogger logger(mockFileSystem);
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Info));
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Warn));
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Error));
+
+        logger.SetMinimumLevel(LogLevel::Warn);
+        Assert::IsFalse(logger.IsEnabled(LogLevel::Info));
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Warn));
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Error));
+
+        logger.SetMinimumLevel(LogLevel::Error);
+        Assert::IsFalse(logger.IsEnabled(LogLevel::Info));
+        Assert::IsFalse(logger.IsEnabled(LogLevel::Warn));
+        Assert::IsTrue(logger.IsEnabled(LogLevel::Error));
+    }
+
+    TEST_METHOD(TestLogLongMessage)
+    {
+        MockClock mockClock;
+        MockFileSystem mockFileSystem;
+        FileLogger logger(mockFileSystem);
+
+        logger.LogMessage(LogLevel::Info, std::string(FileLogger::MaxMessageLength + 100, 'A'));
+
+        Assert::AreEqual(std::string("\n220843.000|INFO| ") + std::string(FileLogger::MaxMessageLength, 'A') +
+            "... (4196 bytes)\n", mockFileSystem.GetFileContents(mockLogFileName));
+    }
+
+    TEST_METHOD(TestBackgroundWriter)
+    {
+        MockClock mockClock;
+        MockFileSystem mockFileSystem;
+        FileLogger logger(mockFileSystem);
+
+        logger.StartBackgroundWriter();
+        logger.LogMessage(LogLevel::Info, "This is a message.");
+        logger.LogMessage(LogLevel::Warn, "This is another message.");
+        mockClock.AdvanceTime(std::chrono::milliseconds(375));
+        logger.LogMessage(LogLevel::Error, "This is the third message.");
+        logger.StopBackgroundWriter();
+
+        Assert::AreEqual(std::string("\n"
+            "220843.000|INFO| This is a message.\n"
+            "220843.000|WARN| This is another message.\n"
+            "220843.375|ERR | This is the third message.\n"), mockFileSystem.GetFileContents(mockLogFileName));
+
+        // after stopping the background writer, messages should be written immediately
+        logger.LogMessage(LogLevel::Info, "This is the fourth message.");
+        Assert::AreEqual(std::string("\n"
+            "220843.000|INFO| This is a message.\n"
+            "220843.000|WARN| This is another message.\n"
+            "220843.375|ERR | This is the third message.\n"
+            "220843.375|INFO| This is the fourth message.\n"), mockFileSystem.GetFileContents(mockLogFileName));
+    }
+
+    TEST_METHOD(TestBackgroundWriterQueueFull)
+    {
+        MockClock mockClock;
+        MockFileSystem mockFileSystem;
+        FileLogger logger(mockFileSystem);
+
+        // log messages faster than the writer can drain them. every message should either be written or
+        // counted as dropped.
+        logger.StartBackgroundWriter();
+        for (size_t i = 0; i < FileLogger::QueueCapacity * 4; ++i)
+            logger.LogMessage(LogLevel::Info, "Message");
+        logger.StopBackgroundWriter();
+
+        Assert::AreEqual(FileLogger::QueueCapacity * 4, CountLoggedMessages(mockFileSystem.GetFileContents(mockLogFileName)));
+    }
+
+    TEST_METHOD(TestStopBackgroundWriterWhileLogging)
+    {
+        MockClock mockClock;
+        MockFileSystem mockFileSystem;
+        MockThreadPool mockThreadPool; // synchronous writes are only serialized when a thread pool exists
+        FileLogger logger(mockFileSystem);
+
+        // messages logged while the background writer is stopping should be written either by the final
+        // flush or immediately. none of them should be left in the queue.
+        logger.StartBackgroundWriter();
+        std::atomic<bool> bStarted{ false };
+        std::thread pThread([&logger, &bStarted]()
+        {
+            for (size_t i = 0; i < FileLogger::QueueCapacity * 4; ++i)
+            {
+                logger.LogMessage(LogLevel::Info, "Message");
+                bStarted = true;
+            }
+        });
+
+        while (!bStarted)
+            std::this_thread::yield();
+
+        logger.StopBackgroundWriter();
+        pThread.join();
+
+        Assert::AreEqual(FileLogger::QueueCapacity * 4, CountLoggedMessages(mockFileSystem.GetFileContents(mockLogFileName)));
+    }
 };
 
 } // namespace tests
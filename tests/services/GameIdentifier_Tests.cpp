@@ -650,7 +650,8 @@ public:
         GameIdentifierHarness identifier;
         identifier.SaveKnownHashes();
 
-        Assert::IsFalse(identifier.mockLocalStorage.HasStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
+        Assert::IsFalse(identifier.mockLocalStorage.HasStoredData(ra::services::StorageItemType::KnownHashIndex, KNOWN_HASHES_KEY));
+        Assert::IsFalse(identifier.mockLocalStorage.HasStoredData(ra::services::StorageItemType::KnownHashJournal, KNOWN_HASHES_KEY));
     }
 
     TEST_METHOD(TestSaveKnownHashesNew)
@@ -667,11 +668,20 @@ public:
         });
         Assert::AreEqual(32U, identifier.IdentifyHash(ROM_HASH));
 
+        // new hash is journaled immediately
+        Assert::AreEqual({ 20U }, identifier.mockLocalStorage.GetStoredData(
+            ra::services::StorageItemType::KnownHashJournal, KNOWN_HASHES_KEY).length());
+
         identifier.SaveKnownHashes();
 
-        Assert::IsTrue(identifier.mockLocalStorage.HasStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
-        Assert::AreEqual(ra::StringPrintf("%s=%u\n", ROM_HASH, 32U),
-            identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
+        // and merged into the index when saved
+        Assert::IsTrue(identifier.mockLocalStorage.HasStoredData(ra::services::StorageItemType::KnownHashIndex, KNOWN_HASHES_KEY));
+        Assert::AreEqual(std::string(), identifier.mockLocalStorage.GetStoredData(
+            ra::services::StorageItemType::KnownHashJournal, KNOWN_HASHES_KEY));
+
+        KnownHashStore pStore(KNOWN_HASHES_KEY);
+        Assert::AreEqual(32U, pStore.Find(ROM_HASH));
+        Assert::AreEqual({ 1U }, pStore.GetIndexSize());
     }
 
     TEST_METHOD(TestSaveKnownHashesUnchanged)
@@ -680,7 +690,7 @@ public:
         identifier.mockUserContext.Initialize("User", "ApiToken");
         const auto sFileContents = ra::StringPrintf("%s=%u\ninvalid=0\n", ROM_HASH, 32U);
         identifier.mockLocalStorage.MockStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY, sFileContents);
-                            
+
         identifier.mockServer.HandleRequest<ra::api::ResolveHash>(
             [](const ra::api::ResolveHash::Request&, ra::api::ResolveHash::Response& response)
         {
@@ -690,11 +700,19 @@ public:
         });
         Assert::AreEqual(32U, identifier.IdentifyHash(ROM_HASH));
 
-        identifier.SaveKnownHashes();
-
-        // invalid entry would be removed if the file were updated
+        // old text file is migrated to the index (without the invalid entry) and left alone
+        const auto sIndex = identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::KnownHashIndex, KNOWN_HASHES_KEY);
+        Assert::AreEqual({ 12U + 20U }, sIndex.length());
         Assert::AreEqual(sFileContents,
             identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
+
+        identifier.SaveKnownHashes();
+
+        // nothing changed, so the journal should be empty and the index should not be rewritten
+        Assert::AreEqual(std::string(), identifier.mockLocalStorage.GetStoredData(
+            ra::services::StorageItemType::KnownHashJournal, KNOWN_HASHES_KEY));
+        Assert::AreEqual(sIndex,
+            identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::KnownHashIndex, KNOWN_HASHES_KEY));
     }
 
     TEST_METHOD(TestSaveKnownHashesIDChanged)
@@ -716,10 +734,10 @@ public:
 
         identifier.SaveKnownHashes();
 
-        // invalid entry will be discarded
-        Assert::AreEqual(
-            ra::StringPrintf("%s=%u\n", ROM_HASH, 35U),
-            identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
+        KnownHashStore pStore(KNOWN_HASHES_KEY);
+        Assert::AreEqual(35U, pStore.Find(ROM_HASH));
+        Assert::AreEqual({ 1U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, pStore.GetJournalSize());
     }
 
     TEST_METHOD(TestSaveKnownHashesAdded)
@@ -742,10 +760,11 @@ public:
 
         identifier.SaveKnownHashes();
 
-        // invalid entry will be discarded
-        Assert::AreEqual(
-            ra::StringPrintf("%s=%u\n%s=%u\n", ROM_HASH, 35U, sAlternateHash, 32U),
-            identifier.mockLocalStorage.GetStoredData(ra::services::StorageItemType::HashMapping, KNOWN_HASHES_KEY));
+        KnownHashStore pStore(KNOWN_HASHES_KEY);
+        Assert::AreEqual(35U, pStore.Find(ROM_HASH));
+        Assert::AreEqual(32U, pStore.Find(sAlternateHash));
+        Assert::AreEqual({ 2U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, pStore.GetJournalSize());
     }
 
     TEST_METHOD(TestIdentifyGameOfflineUnknown)
@@ -176,6 +176,38 @@ public:
         TestFeature(ra::services::Feature::PreferDecimal, "Prefer Decimal", false);
     }
 
+    TEST_METHOD(TestLogLevel)
+    {
+        MockFileSystem fileSystem;
+
+        // default
+        JsonFileConfiguration config;
+        Assert::IsTrue(config.GetLogLevel() == LogLevel::Info);
+
+        // no value provided
+        fileSystem.MockFile(sFilename, "{}");
+        Assert::IsTrue(config.Load(sFilename));
+        Assert::IsTrue(config.GetLogLevel() == LogLevel::Info);
+
+        // value provided
+        fileSystem.MockFile(sFilename, "{\"Log Level\":\"Warn\"}");
+        Assert::IsTrue(config.Load(sFilename));
+        Assert::IsTrue(config.GetLogLevel() == LogLevel::Warn);
+
+        fileSystem.MockFile(sFilename, "{\"Log Level\":\"Error\"}");
+        Assert::IsTrue(config.Load(sFilename));
+        Assert::IsTrue(config.GetLogLevel() == LogLevel::Error);
+
+        // persist value
+        config.Save();
+        AssertContains(fileSystem.GetFileContents(sFilename), "\"Log Level\":\"Error\"");
+
+        // unknown value
+        fileSystem.MockFile(sFilename, "{\"Log Level\":\"Verbose\"}");
+        Assert::IsTrue(config.Load(sFilename));
+        Assert::IsTrue(config.GetLogLevel() == LogLevel::Info);
+    }
+
     void TestPopupLocation(ra::ui::viewmodels::Popup nPopup, const std::string& sJsonKey, ra::ui::viewmodels::PopupLocation nDefault)
     {
         MockFileSystem fileSystem;
@@ -0,0 +1,260 @@
+#include "CppUnitTest.h"
+
+#include "services\KnownHashStore.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+#include "tests\mocks\MockLocalStorage.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(KnownHashStore_Tests)
+{
+private:
+    static constexpr const wchar_t* KEY = L"Hashes";
+
+    static std::string MakeHash(unsigned int nIndex)
+    {
+        // spread the hashes out so they don't sort in the order they're generated
+        return ra::StringPrintf("%08x%08x0123456789abcdef", (nIndex * 2654435761U), nIndex);
+    }
+
+    static size_t GetStoredSize(const ra::services::mocks::MockLocalStorage& mockLocalStorage, StorageItemType nType)
+    {
+        return mockLocalStorage.GetStoredData(nType, KEY).length();
+    }
+
+public:
+    TEST_METHOD(TestEmpty)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        KnownHashStore pStore(KEY);
+
+        Assert::AreEqual(0U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual({ 0U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, pStore.GetJournalSize());
+        Assert::IsFalse(mockLocalStorage.HasStoredData(StorageItemType::KnownHashIndex, KEY));
+    }
+
+    TEST_METHOD(TestInvalidHash)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        KnownHashStore pStore(KEY);
+
+        Assert::IsFalse(pStore.Add("invalid", 1U));
+        Assert::IsFalse(pStore.Add("0123456789abcdef0123456789abcdeg", 1U));
+        Assert::AreEqual(0U, pStore.Find("invalid"));
+        Assert::IsFalse(mockLocalStorage.HasStoredData(StorageItemType::KnownHashJournal, KEY));
+    }
+
+    TEST_METHOD(TestAddJournalsImmediately)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        {
+            KnownHashStore pStore(KEY);
+            Assert::IsTrue(pStore.Add(MakeHash(1), 11U));
+            Assert::IsTrue(pStore.Add(MakeHash(2), 22U));
+            Assert::IsFalse(pStore.Add(MakeHash(1), 11U));
+            Assert::IsTrue(pStore.Add(MakeHash(1), 111U));
+            Assert::AreEqual(111U, pStore.Find(MakeHash(1)));
+        }
+
+        // every change is appended, no index is written until compacted
+        Assert::AreEqual({ 60U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashJournal));
+        Assert::IsFalse(mockLocalStorage.HasStoredData(StorageItemType::KnownHashIndex, KEY));
+
+        // replaying the journal should keep the last value for each hash
+        KnownHashStore pStore(KEY);
+        Assert::AreEqual(111U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual(22U, pStore.Find(MakeHash(2)));
+        Assert::AreEqual({ 2U }, pStore.GetJournalSize());
+    }
+
+    TEST_METHOD(TestJournalIncompleteEntry)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        {
+            KnownHashStore pStore(KEY);
+            pStore.Add(MakeHash(1), 11U);
+            pStore.Add(MakeHash(2), 22U);
+        }
+
+        // simulate an interrupted write
+        auto sJournal = mockLocalStorage.GetStoredData(StorageItemType::KnownHashJournal, KEY);
+        sJournal.resize(sJournal.length() - 3);
+        mockLocalStorage.MockStoredData(StorageItemType::KnownHashJournal, KEY, sJournal);
+
+        KnownHashStore pStore(KEY);
+        Assert::AreEqual(11U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual(0U, pStore.Find(MakeHash(2)));
+    }
+
+    TEST_METHOD(TestCompact)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        {
+            KnownHashStore pStore(KEY);
+            for (unsigned int i = 1; i <= 50; ++i)
+                pStore.Add(MakeHash(i), i);
+
+            pStore.Compact();
+            Assert::AreEqual({ 50U }, pStore.GetIndexSize());
+            Assert::AreEqual({ 0U }, pStore.GetJournalSize());
+
+            // updates after compacting are journaled on top of the index
+            pStore.Add(MakeHash(7), 700U);
+            pStore.Add(MakeHash(51), 51U);
+            Assert::AreEqual(700U, pStore.Find(MakeHash(7)));
+            Assert::AreEqual(51U, pStore.Find(MakeHash(51)));
+            Assert::AreEqual({ 40U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashJournal));
+        }
+
+        Assert::AreEqual({ 12U + 50U * 20U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashIndex));
+
+        KnownHashStore pStore(KEY);
+        for (unsigned int i = 1; i <= 51; ++i)
+            Assert::AreEqual((i == 7) ? 700U : i, pStore.Find(MakeHash(i)));
+        Assert::AreEqual(0U, pStore.Find(MakeHash(52)));
+
+        // existing entries are replaced, new entries are merged in order
+        pStore.Compact();
+        Assert::AreEqual({ 51U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashJournal));
+
+        KnownHashStore pStore2(KEY);
+        for (unsigned int i = 1; i <= 51; ++i)
+            Assert::AreEqual((i == 7) ? 700U : i, pStore2.Find(MakeHash(i)));
+    }
+
+    TEST_METHOD(TestCompactWhenJournalFull)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        KnownHashStore pStore(KEY);
+
+        const auto nMaxJournalEntries = gsl::narrow_cast<unsigned int>(KnownHashStore::MaxJournalEntries);
+        for (unsigned int i = 1; i < nMaxJournalEntries; ++i)
+            pStore.Add(MakeHash(i), i);
+
+        Assert::IsFalse(mockLocalStorage.HasStoredData(StorageItemType::KnownHashIndex, KEY));
+        Assert::AreEqual(KnownHashStore::MaxJournalEntries - 1, pStore.GetJournalSize());
+
+        pStore.Add(MakeHash(nMaxJournalEntries), 1U);
+        Assert::AreEqual(KnownHashStore::MaxJournalEntries, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, pStore.GetJournalSize());
+        Assert::AreEqual({ 0U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashJournal));
+        Assert::AreEqual(1U, pStore.Find(MakeHash(nMaxJournalEntries)));
+    }
+
+    TEST_METHOD(TestCompactMergesEntriesJournaledByOtherProcess)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        KnownHashStore pStore(KEY);
+        KnownHashStore pOtherStore(KEY);
+        Assert::AreEqual(0U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual(0U, pOtherStore.Find(MakeHash(1)));
+
+        pStore.Add(MakeHash(1), 11U);
+        pOtherStore.Add(MakeHash(2), 22U);
+        Assert::IsFalse(mockLocalStorage.IsDataLocked(StorageItemType::KnownHashJournal, KEY));
+        Assert::AreEqual({ 1U }, pStore.GetJournalSize());
+
+        // the entry the other store appended must not be lost when the journal is truncated
+        pStore.Compact();
+        Assert::IsFalse(mockLocalStorage.IsDataLocked(StorageItemType::KnownHashJournal, KEY));
+        Assert::AreEqual({ 2U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 0U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashJournal));
+
+        KnownHashStore pNewStore(KEY);
+        Assert::AreEqual(11U, pNewStore.Find(MakeHash(1)));
+        Assert::AreEqual(22U, pNewStore.Find(MakeHash(2)));
+    }
+
+    TEST_METHOD(TestCompactMergesIndexCompactedByOtherProcess)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        KnownHashStore pStore(KEY);
+        KnownHashStore pOtherStore(KEY);
+        Assert::AreEqual(0U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual(0U, pOtherStore.Find(MakeHash(1)));
+
+        pOtherStore.Add(MakeHash(2), 22U);
+        pOtherStore.Add(MakeHash(3), 33U);
+        pOtherStore.Compact();
+        Assert::AreEqual({ 2U }, pOtherStore.GetIndexSize());
+
+        // the other store's entries are only in the index now, which this store loaded before they were added
+        pStore.Add(MakeHash(1), 11U);
+        pStore.Add(MakeHash(3), 333U);
+        pStore.Compact();
+        Assert::AreEqual({ 3U }, pStore.GetIndexSize());
+
+        KnownHashStore pNewStore(KEY);
+        Assert::AreEqual(11U, pNewStore.Find(MakeHash(1)));
+        Assert::AreEqual(22U, pNewStore.Find(MakeHash(2)));
+        Assert::AreEqual(333U, pNewStore.Find(MakeHash(3)));
+        Assert::AreEqual({ 0U }, pNewStore.GetJournalSize());
+    }
+
+    TEST_METHOD(TestMigrateTextFile)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        mockLocalStorage.MockStoredData(StorageItemType::HashMapping, KEY,
+            MakeHash(1) + "=11\ninvalid=0\n3C6EF362000000020123456789ABCDEF=22\n");
+
+        KnownHashStore pStore(KEY);
+        Assert::AreEqual(11U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual(22U, pStore.Find(MakeHash(2)));
+        Assert::AreEqual({ 2U }, pStore.GetIndexSize());
+        Assert::AreEqual({ 12U + 2U * 20U }, GetStoredSize(mockLocalStorage, StorageItemType::KnownHashIndex));
+
+        // once the index exists, the text file is ignored
+        mockLocalStorage.MockStoredData(StorageItemType::HashMapping, KEY, MakeHash(3) + "=33\n");
+        KnownHashStore pStore2(KEY);
+        Assert::AreEqual(0U, pStore2.Find(MakeHash(3)));
+        Assert::AreEqual(11U, pStore2.Find(MakeHash(1)));
+    }
+
+    TEST_METHOD(TestInvalidIndex)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        mockLocalStorage.MockStoredData(StorageItemType::KnownHashIndex, KEY, std::string("RAKH\x02\0\0\0\0\0\0\0", 12));
+
+        KnownHashStore pStore(KEY);
+        Assert::AreEqual(0U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual({ 0U }, pStore.GetIndexSize());
+
+        // invalid index is replaced when compacted
+        pStore.Add(MakeHash(1), 11U);
+        pStore.Compact();
+
+        KnownHashStore pStore2(KEY);
+        Assert::AreEqual(11U, pStore2.Find(MakeHash(1)));
+    }
+
+    TEST_METHOD(TestTruncatedIndex)
+    {
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
+        {
+            KnownHashStore pStore(KEY);
+            pStore.Add(MakeHash(1), 11U);
+            pStore.Add(MakeHash(2), 22U);
+            pStore.Compact();
+        }
+
+        auto sIndex = mockLocalStorage.GetStoredData(StorageItemType::KnownHashIndex, KEY);
+        sIndex.resize(sIndex.length() - 1);
+        mockLocalStorage.MockStoredData(StorageItemType::KnownHashIndex, KEY, sIndex);
+
+        KnownHashStore pStore(KEY);
+        Assert::AreEqual(0U, pStore.Find(MakeHash(1)));
+        Assert::AreEqual({ 0U }, pStore.GetIndexSize());
+    }
+};
+
+} // namespace tests
+} // namespace services
+} // namespace ra
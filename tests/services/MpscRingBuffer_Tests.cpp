@@ -0,0 +1,124 @@
+#include "CppUnitTest.h"
+
+#include "services\impl\MpscRingBuffer.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace services {
+namespace impl {
+namespace tests {
+
+TEST_CLASS(MpscRingBuffer_Tests)
+{
+public:
+    TEST_METHOD(TestEmpty)
+    {
+        MpscRingBuffer<std::string> pBuffer(4);
+        Assert::AreEqual({ 4U }, pBuffer.Capacity());
+
+        std::string sItem;
+        Assert::IsFalse(pBuffer.TryPop(sItem));
+    }
+
+    TEST_METHOD(TestPushPop)
+    {
+        MpscRingBuffer<std::string> pBuffer(4);
+        Assert::IsTrue(pBuffer.TryPush("One"));
+        Assert::IsTrue(pBuffer.TryPush("Two"));
+
+        std::string sItem;
+        Assert::IsTrue(pBuffer.TryPop(sItem));
+        Assert::AreEqual(std::string("One"), sItem);
+        Assert::IsTrue(pBuffer.TryPop(sItem));
+        Assert::AreEqual(std::string("Two"), sItem);
+        Assert::IsFalse(pBuffer.TryPop(sItem));
+    }
+
+    TEST_METHOD(TestFull)
+    {
+        MpscRingBuffer<std::string> pBuffer(4);
+        Assert::IsTrue(pBuffer.TryPush("One"));
+        Assert::IsTrue(pBuffer.TryPush("Two"));
+        Assert::IsTrue(pBuffer.TryPush("Three"));
+        Assert::IsTrue(pBuffer.TryPush("Four"));
+        Assert::IsFalse(pBuffer.TryPush("Five"));
+
+        // popping an item should make room for another
+        std::string sItem;
+        Assert::IsTrue(pBuffer.TryPop(sItem));
+        Assert::AreEqual(std::string("One"), sItem);
+        Assert::IsTrue(pBuffer.TryPush("Five"));
+        Assert::IsFalse(pBuffer.TryPush("Six"));
+    }
+
+    TEST_METHOD(TestWrapAround)
+    {
+        MpscRingBuffer<std::string> pBuffer(4);
+        std::string sItem;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            Assert::IsTrue(pBuffer.TryPush(std::to_string(i * 2)));
+            Assert::IsTrue(pBuffer.TryPush(std::to_string(i * 2 + 1)));
+            Assert::IsTrue(pBuffer.TryPop(sItem));
+            Assert::AreEqual(std::to_string(i * 2), sItem);
+            Assert::IsTrue(pBuffer.TryPop(sItem));
+            Assert::AreEqual(std::to_string(i * 2 + 1), sItem);
+        }
+
+        Assert::IsFalse(pBuffer.TryPop(sItem));
+    }
+
+    TEST_METHOD(TestMultipleProducers)
+    {
+        constexpr int nProducers = 4;
+        constexpr int nItemsPerProducer = 2000;
+        MpscRingBuffer<std::string> pBuffer(64);
+
+        std::vector<std::thread> vThreads;
+        for (int nProducer = 0; nProducer < nProducers; ++nProducer)
+        {
+            vThreads.emplace_back([&pBuffer, nProducer]()
+            {
+                for (int i = 0; i < nItemsPerProducer; ++i)
+                {
+                    std::string sItem = ra::StringPrintf("%d:%d", nProducer, i);
+                    while (!pBuffer.TryPush(std::move(sItem)))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        // each producer's items should be received in the order they were pushed
+        std::array<int, nProducers> vNextItem{};
+        int nReceived = 0;
+        std::string sItem;
+        while (nReceived < nProducers * nItemsPerProducer)
+        {
+            if (!pBuffer.TryPop(sItem))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto nIndex = sItem.find(':');
+            const auto nProducer = std::stoi(sItem.substr(0, nIndex));
+            Assert::AreEqual(vNextItem.at(nProducer), std::stoi(sItem.substr(nIndex + 1)));
+            ++vNextItem.at(nProducer);
+            ++nReceived;
+        }
+
+        for (auto& pThread : vThreads)
+            pThread.join();
+
+        Assert::IsFalse(pBuffer.TryPop(sItem));
+    }
+};
+
+} // namespace tests
+} // namespace impl
+} // namespace services
+} // namespace ra
@@ -0,0 +1,285 @@
+#include "CppUnitTest.h"
+
+#include "services\RomLibraryScanner.hh"
+
+#include "RA_md5factory.h"
+
+#include "services\FileHasher.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+#include "tests\mocks\MockClock.hh"
+#include "tests\mocks\MockConfiguration.hh"
+#include "tests\mocks\MockFileSystem.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(RomLibraryScanner_Tests)
+{
+private:
+    class RomLibraryScannerHarness : public RomLibraryScanner
+    {
+    public:
+        ra::services::mocks::MockClock mockClock;
+        ra::services::mocks::MockConfiguration mockConfiguration;
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        ra::services::mocks::MockThreadPool mockThreadPool;
+
+        void MockRom(const std::wstring& sPath, const std::string& sContents, int nTimestamp)
+        {
+            mockFileSystem.MockFile(sPath, sContents);
+            mockFileSystem.MockLastModified(sPath, std::chrono::system_clock::time_point() + std::chrono::seconds(nTimestamp));
+        }
+
+        void RunScan(std::vector<std::wstring>&& vFiles)
+        {
+            Scan(std::move(vFiles));
+            while (mockThreadPool.PendingTasks() > 0)
+                mockThreadPool.ExecuteNextTask();
+        }
+    };
+
+    static const std::wstring IndexPath;
+
+public:
+    TEST_METHOD(TestScanHashesFiles)
+    {
+        RomLibraryScannerHarness scanner;
+        const std::string sRom1(1000, 'a');
+        const std::string sRom2(FileHasher::StreamBufferSize * 2 + 17, 'b'); // larger than the read buffer
+        scanner.MockRom(L"C:\\Roms\\a.bin", sRom1, 1000);
+        scanner.MockRom(L"C:\\Roms\\b.bin", sRom2, 2000);
+
+        scanner.RunScan({ L"C:\\Roms\\a.bin", L"C:\\Roms\\b.bin", L"C:\\Roms\\missing.bin" });
+
+        const auto mHashes = scanner.GetHashes();
+        Assert::AreEqual({ 2U }, mHashes.size());
+        Assert::AreEqual(RAGenerateMD5(sRom1), mHashes.at(L"C:\\Roms\\a.bin"));
+        Assert::AreEqual(RAGenerateMD5(sRom2), mHashes.at(L"C:\\Roms\\b.bin"));
+
+        const auto pProgress = scanner.GetProgress();
+        Assert::IsTrue(pProgress.bComplete);
+        Assert::AreEqual({ 3U }, pProgress.nFilesTotal);
+        Assert::AreEqual({ 3U }, pProgress.nFilesProcessed);
+        Assert::AreEqual({ 0U }, pProgress.nFilesSkipped);
+        Assert::AreEqual(static_cast<uint64_t>(sRom1.length() + sRom2.length()), pProgress.nBytesHashed);
+    }
+
+    TEST_METHOD(TestScanMultipleWorkers)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.mockConfiguration.SetNumBackgroundThreads(4);
+        std::vector<std::wstring> vFiles;
+        for (int i = 0; i < 10; ++i)
+        {
+            vFiles.push_back(ra::StringPrintf(L"C:\\Roms\\%d.bin", i));
+            scanner.MockRom(vFiles.back(), std::string(100, gsl::narrow_cast<char>('0' + i)), i);
+        }
+
+        // one background thread is left available for other work
+        scanner.Scan(std::move(vFiles));
+        Assert::AreEqual({ 3U }, scanner.mockThreadPool.PendingTasks());
+        Assert::IsTrue(scanner.IsScanning());
+
+        // first worker processes all of the files, the others have nothing to do
+        scanner.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 10U }, scanner.GetProgress().nFilesProcessed);
+        Assert::IsFalse(scanner.GetProgress().bComplete);
+
+        scanner.mockThreadPool.ExecuteNextTask();
+        scanner.mockThreadPool.ExecuteNextTask();
+        Assert::IsTrue(scanner.GetProgress().bComplete);
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 10U }, scanner.GetHashes().size());
+    }
+
+    TEST_METHOD(TestScanSkipsUnchangedFiles)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+        scanner.MockRom(L"C:\\Roms\\b.bin", "ghijkl", 2000);
+        scanner.RunScan({ L"C:\\Roms\\a.bin", L"C:\\Roms\\b.bin" });
+        Assert::IsTrue(scanner.SaveIndex(IndexPath));
+
+        const auto sIndex = scanner.mockFileSystem.GetFileContents(IndexPath);
+
+        RomLibraryScannerHarness scanner2;
+        scanner2.mockFileSystem.MockFile(IndexPath, sIndex);
+        scanner2.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+        scanner2.MockRom(L"C:\\Roms\\b.bin", "mnopqr", 2001); // modified
+        Assert::IsTrue(scanner2.LoadIndex(IndexPath));
+        Assert::AreEqual(RAGenerateMD5(std::string("ghijkl")), scanner2.GetHashes().at(L"C:\\Roms\\b.bin"));
+
+        scanner2.RunScan({ L"C:\\Roms\\a.bin", L"C:\\Roms\\b.bin" });
+
+        // b.bin is the same size, so it's checked with XXH64 before being rehashed
+        const auto pProgress = scanner2.GetProgress();
+        Assert::AreEqual({ 2U }, pProgress.nFilesProcessed);
+        Assert::AreEqual({ 1U }, pProgress.nFilesSkipped);
+        Assert::AreEqual({ 12U }, pProgress.nBytesHashed);
+
+        const auto mHashes = scanner2.GetHashes();
+        Assert::AreEqual(RAGenerateMD5(std::string("abcdef")), mHashes.at(L"C:\\Roms\\a.bin"));
+        Assert::AreEqual(RAGenerateMD5(std::string("mnopqr")), mHashes.at(L"C:\\Roms\\b.bin"));
+    }
+
+    TEST_METHOD(TestScanTouchedFileNotRehashed)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+        scanner.RunScan({ L"C:\\Roms\\a.bin" });
+        Assert::IsTrue(scanner.SaveIndex(IndexPath));
+
+        const auto sIndex = scanner.mockFileSystem.GetFileContents(IndexPath);
+
+        RomLibraryScannerHarness scanner2;
+        scanner2.mockFileSystem.MockFile(IndexPath, sIndex);
+        scanner2.MockRom(L"C:\\Roms\\a.bin", "abcdef", 3000); // touched, but not modified
+        Assert::IsTrue(scanner2.LoadIndex(IndexPath));
+
+        scanner2.RunScan({ L"C:\\Roms\\a.bin" });
+
+        auto pProgress = scanner2.GetProgress();
+        Assert::AreEqual({ 1U }, pProgress.nFilesProcessed);
+        Assert::AreEqual({ 1U }, pProgress.nFilesSkipped);
+        Assert::AreEqual({ 6U }, pProgress.nBytesHashed);
+        Assert::AreEqual(RAGenerateMD5(std::string("abcdef")), scanner2.GetHashes().at(L"C:\\Roms\\a.bin"));
+
+        // the new timestamp is remembered, so the file doesn't have to be checked again
+        scanner2.RunScan({ L"C:\\Roms\\a.bin" });
+
+        pProgress = scanner2.GetProgress();
+        Assert::AreEqual({ 1U }, pProgress.nFilesSkipped);
+        Assert::AreEqual({ 0U }, pProgress.nBytesHashed);
+    }
+
+    TEST_METHOD(TestLoadIndexInvalid)
+    {
+        RomLibraryScannerHarness scanner;
+        Assert::IsFalse(scanner.LoadIndex(IndexPath));
+
+        scanner.mockFileSystem.MockFile(IndexPath, "C:\\Roms\\a.bin\n0123456789abcdef0123456789abcdef\n");
+        Assert::IsFalse(scanner.LoadIndex(IndexPath));
+        Assert::AreEqual({ 0U }, scanner.GetHashes().size());
+    }
+
+    TEST_METHOD(TestAddHashIsRehashed)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.AddHash(L"C:\\Roms\\a.bin", "0123456789abcdef0123456789abcdef");
+        scanner.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+
+        scanner.RunScan({ L"C:\\Roms\\a.bin" });
+
+        Assert::AreEqual({ 0U }, scanner.GetProgress().nFilesSkipped);
+        Assert::AreEqual(RAGenerateMD5(std::string("abcdef")), scanner.GetHashes().at(L"C:\\Roms\\a.bin"));
+    }
+
+    TEST_METHOD(TestProgressThroughput)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.MockRom(L"C:\\Roms\\a.bin", std::string(1024 * 1024, 'a'), 1000);
+        scanner.MockRom(L"C:\\Roms\\b.bin", std::string(1024 * 1024, 'b'), 1000);
+
+        int nProgressCalls = 0;
+        scanner.SetProgressHandler([&nProgressCalls]() { ++nProgressCalls; });
+
+        scanner.Scan({ L"C:\\Roms\\a.bin", L"C:\\Roms\\b.bin" });
+        scanner.mockClock.AdvanceTime(std::chrono::milliseconds(500));
+        scanner.mockThreadPool.ExecuteNextTask();
+
+        // once per file, and once when complete
+        Assert::AreEqual(3, nProgressCalls);
+
+        const auto pProgress = scanner.GetProgress();
+        Assert::IsTrue(pProgress.bComplete);
+        Assert::AreEqual(4.0, pProgress.fFilesPerSecond, 0.001);
+        Assert::AreEqual(4.0, pProgress.fMegabytesPerSecond, 0.001);
+
+        // completed scan should not continue to accumulate time
+        scanner.mockClock.AdvanceTime(std::chrono::milliseconds(500));
+        Assert::AreEqual(4.0, scanner.GetProgress().fFilesPerSecond, 0.001);
+    }
+
+    TEST_METHOD(TestCancelAndWaitAfterShutdownDiscardsQueuedWorkers)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.mockConfiguration.SetNumBackgroundThreads(4);
+        scanner.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+        scanner.MockRom(L"C:\\Roms\\b.bin", "ghijkl", 2000);
+
+        scanner.Scan({ L"C:\\Roms\\a.bin", L"C:\\Roms\\b.bin" });
+        Assert::AreEqual({ 2U }, scanner.mockThreadPool.PendingTasks());
+        scanner.mockThreadPool.ExecuteNextTask();
+
+        // the second worker is discarded by the thread pool without ever starting
+        scanner.mockThreadPool.Shutdown(false);
+        Assert::IsTrue(scanner.IsScanning());
+
+        // should not wait for the discarded worker
+        scanner.CancelAndWait();
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 2U }, scanner.GetHashes().size());
+    }
+
+    TEST_METHOD(TestScanAfterShutdown)
+    {
+        RomLibraryScannerHarness scanner;
+        scanner.MockRom(L"C:\\Roms\\a.bin", "abcdef", 1000);
+        scanner.mockThreadPool.Shutdown(false);
+
+        // the thread pool won't accept the workers
+        scanner.Scan({ L"C:\\Roms\\a.bin" });
+        Assert::AreEqual({ 0U }, scanner.mockThreadPool.PendingTasks());
+
+        scanner.CancelAndWait();
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 0U }, scanner.GetHashes().size());
+    }
+
+    TEST_METHOD(TestDestroyWhileCompleting)
+    {
+        ra::services::mocks::MockClock mockClock;
+        ra::services::mocks::MockConfiguration mockConfiguration;
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        ra::services::mocks::MockThreadPool mockThreadPool;
+        mockFileSystem.MockFile(L"C:\\Roms\\a.bin", "abcdef");
+
+        auto pScanner = std::make_unique<RomLibraryScanner>();
+        std::atomic<int> nProgressCalls{ 0 };
+        std::atomic<bool> bCompleting{ false };
+        std::atomic<bool> bCompleted{ false };
+        pScanner->SetProgressHandler([&nProgressCalls, &bCompleting, &bCompleted]()
+        {
+            // once for the file, then once when complete
+            if (++nProgressCalls == 2)
+            {
+                bCompleting = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                bCompleted = true;
+            }
+        });
+
+        pScanner->Scan({ L"C:\\Roms\\a.bin" });
+        std::thread pWorker([&mockThreadPool]() { mockThreadPool.ExecuteNextTask(); });
+        while (!bCompleting)
+            std::this_thread::yield();
+
+        // the last worker is in the completion handler. the scanner must not be destroyed until it's done.
+        pScanner.reset();
+        Assert::IsTrue(bCompleted);
+
+        pWorker.join();
+    }
+};
+
+const std::wstring RomLibraryScanner_Tests::IndexPath = L"C:\\RA\\Data\\mygamelibrary.idx";
+
+} // namespace tests
+} // namespace services
+} // namespace ra
@@ -1,5 +1,7 @@
 #include "services\SearchResults.h"
 
+#include "services\impl\ThreadPool.hh"
+
 #include "tests\RA_UnitTestHelpers.h"
 #include "tests\mocks\MockEmulatorContext.hh"
 
@@ -1048,6 +1050,56 @@ public:
         Assert::IsTrue(results2.MatchesFilter(results1, result));
     }
 
+    TEST_METHOD(TestInitializeFromResultsEightBitNotEqualPreviousParallel)
+    {
+        auto memory = std::make_unique<unsigned char[]>(BIG_BLOCK_SIZE);
+        for (unsigned int i = 0; i < BIG_BLOCK_SIZE; ++i)
+            GSL_SUPPRESS_BOUNDS4 memory[i] = (i % 256);
+        ra::data::context::mocks::MockEmulatorContext mockEmulatorContext;
+        mockEmulatorContext.MockMemory(memory.get(), BIG_BLOCK_SIZE);
+
+        ra::services::impl::ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+        ra::services::ServiceLocator::ServiceOverride<ra::services::IThreadPool> pThreadPoolOverride(&pThreadPool);
+
+        SearchResults results;
+        results.Initialize(0U, BIG_BLOCK_SIZE, ra::services::SearchType::EightBit);
+        Assert::AreEqual({ BIG_BLOCK_SIZE }, results.MatchingAddressCount());
+
+        // blocks are filtered on separate threads, but the results should still be in address order
+        GSL_SUPPRESS_BOUNDS4 memory[BIG_BLOCK_SIZE - 2] = 0x55;
+        GSL_SUPPRESS_BOUNDS4 memory[MAX_BLOCK_SIZE + 7] = 0x66;
+        GSL_SUPPRESS_BOUNDS4 memory[3] = 0x77;
+        SearchResults results1;
+        results1.Initialize(results, ComparisonType::NotEqualTo, ra::services::SearchFilterType::LastKnownValue, L"");
+
+        Assert::AreEqual({ 3U }, results1.MatchingAddressCount());
+
+        SearchResults::Result result;
+        Assert::IsTrue(results1.GetMatchingAddress(0U, result));
+        Assert::AreEqual(3U, result.nAddress);
+        Assert::AreEqual(0x77U, result.nValue);
+
+        Assert::IsTrue(results1.GetMatchingAddress(1U, result));
+        Assert::AreEqual(MAX_BLOCK_SIZE + 7, result.nAddress);
+        Assert::AreEqual(0x66U, result.nValue);
+
+        Assert::IsTrue(results1.GetMatchingAddress(2U, result));
+        Assert::AreEqual(BIG_BLOCK_SIZE - 2, result.nAddress);
+        Assert::AreEqual(0x55U, result.nValue);
+
+        // everything that wasn't modified still matches
+        SearchResults results2;
+        results2.Initialize(results, ComparisonType::Equals, ra::services::SearchFilterType::InitialValue, L"");
+        Assert::AreEqual({ BIG_BLOCK_SIZE - 3 }, results2.MatchingAddressCount());
+        Assert::IsFalse(results2.ContainsAddress(3U));
+        Assert::IsTrue(results2.ContainsAddress(4U));
+        Assert::IsFalse(results2.ContainsAddress(BIG_BLOCK_SIZE - 2));
+        Assert::IsTrue(results2.ContainsAddress(BIG_BLOCK_SIZE - 1));
+
+        pThreadPool.Shutdown(true);
+    }
+
     TEST_METHOD(TestInitializeFromResultsThirtyTwoBitAlignedOffset)
     {
         std::array<unsigned char, 12> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56, 0xCD, 0x44, 0x20, 0x11, 0x22, 0x33, 0x44 };
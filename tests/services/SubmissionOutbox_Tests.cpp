@@ -0,0 +1,341 @@
+#include "CppUnitTest.h"
+
+#include "services\SubmissionOutbox.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockClock.hh"
+#include "tests\mocks\MockLocalStorage.hh"
+#include "tests\mocks\MockServer.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::api::mocks::MockServer;
+using ra::services::mocks::MockClock;
+using ra::services::mocks::MockLocalStorage;
+using ra::services::mocks::MockThreadPool;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(SubmissionOutbox_Tests)
+{
+private:
+    class SubmissionOutboxHarness : public SubmissionOutbox
+    {
+    public:
+        MockClock mockClock;
+        MockLocalStorage mockLocalStorage;
+        MockServer mockServer;
+        MockThreadPool mockThreadPool;
+
+        std::vector<unsigned int> vUnlocked;
+        std::vector<unsigned int> vSubmitted;
+        bool bServerAvailable = true;
+
+        SubmissionOutboxHarness()
+        {
+            mockServer.HandleRequest<ra::api::AwardAchievement>([this](const ra::api::AwardAchievement::Request& request, ra::api::AwardAchievement::Response& response)
+            {
+                if (!bServerAvailable)
+                {
+                    response.Result = ra::api::ApiResult::Incomplete;
+                    return true;
+                }
+
+                vUnlocked.push_back(request.AchievementId);
+                response.Result = ra::api::ApiResult::Success;
+                return true;
+            });
+
+            mockServer.HandleRequest<ra::api::SubmitLeaderboardEntry>([this](const ra::api::SubmitLeaderboardEntry::Request& request, ra::api::SubmitLeaderboardEntry::Response& response)
+            {
+                if (!bServerAvailable)
+                {
+                    response.Result = ra::api::ApiResult::Incomplete;
+                    return true;
+                }
+
+                vSubmitted.push_back(request.LeaderboardId);
+                response.Result = ra::api::ApiResult::Success;
+                return true;
+            });
+        }
+
+        void QueueUnlock(unsigned int nAchievementId, ra::api::AwardAchievement::Request::Callback&& fCallback = nullptr)
+        {
+            ra::api::AwardAchievement::Request request;
+            request.AchievementId = nAchievementId;
+            request.Hardcore = true;
+            request.GameHash = "hash";
+            SubmissionOutbox::QueueUnlock(request, std::move(fCallback));
+        }
+
+        void QueueLeaderboardEntry(unsigned int nLeaderboardId, int nScore)
+        {
+            ra::api::SubmitLeaderboardEntry::Request request;
+            request.LeaderboardId = nLeaderboardId;
+            request.Score = nScore;
+            request.GameHash = "hash";
+            SubmissionOutbox::QueueLeaderboardEntry(request, nullptr);
+        }
+
+        void ExecuteAllTasks()
+        {
+            while (mockThreadPool.PendingTasks() > 0)
+                mockThreadPool.ExecuteNextTask();
+        }
+
+        const std::string& GetJournal(const std::wstring& sUsername = L"User") const
+        {
+            return mockLocalStorage.GetStoredData(ra::services::StorageItemType::SubmissionJournal, sUsername);
+        }
+
+        void MockJournal(const std::string& sContents)
+        {
+            mockLocalStorage.MockStoredData(ra::services::StorageItemType::SubmissionJournal, L"User", sContents);
+        }
+    };
+
+public:
+    TEST_METHOD(TestQueueUnlock)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+
+        bool bCallbackCalled = false;
+        outbox.QueueUnlock(12U, [&bCallbackCalled](const ra::api::AwardAchievement::Response& response)
+        {
+            Assert::IsTrue(response.Succeeded());
+            bCallbackCalled = true;
+        });
+
+        // journaled before being sent
+        Assert::AreEqual(std::string("U:1:12:1:hash:\n"), outbox.GetJournal());
+        Assert::AreEqual({ 1U }, outbox.GetStatistics().nInFlight);
+        Assert::IsFalse(bCallbackCalled);
+
+        outbox.mockThreadPool.ExecuteNextTask();
+        Assert::IsTrue(bCallbackCalled);
+        Assert::AreEqual({ 1U }, outbox.vUnlocked.size());
+        Assert::AreEqual(std::string("U:1:12:1:hash:\nD:1:\n"), outbox.GetJournal());
+
+        const auto pStatistics = outbox.GetStatistics();
+        Assert::AreEqual({ 0U }, pStatistics.nQueued);
+        Assert::AreEqual({ 0U }, pStatistics.nInFlight);
+        Assert::AreEqual({ 1U }, pStatistics.nDelivered);
+        Assert::AreEqual({ 0U }, pStatistics.nRetries);
+    }
+
+    TEST_METHOD(TestQueueLeaderboardEntryNegativeScore)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+        outbox.bServerAvailable = false;
+
+        outbox.QueueLeaderboardEntry(7U, -1234);
+        Assert::AreEqual(std::string("L:1:7:-1234:hash:\n"), outbox.GetJournal());
+        outbox.mockThreadPool.ExecuteNextTask();
+
+        // a new session should resend the entry with the same score
+        SubmissionOutboxHarness outbox2;
+        outbox2.MockJournal(outbox.GetJournal());
+        outbox2.mockServer.HandleRequest<ra::api::SubmitLeaderboardEntry>([](const ra::api::SubmitLeaderboardEntry::Request& request, ra::api::SubmitLeaderboardEntry::Response& response)
+        {
+            Assert::AreEqual(7U, request.LeaderboardId);
+            Assert::AreEqual(-1234, request.Score);
+            Assert::AreEqual(std::string("hash"), request.GameHash);
+            response.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        outbox2.Initialize("User");
+        outbox2.ExecuteAllTasks();
+        Assert::AreEqual({ 1U }, outbox2.GetStatistics().nDelivered);
+    }
+
+    TEST_METHOD(TestQueueBeforeInitialize)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.QueueUnlock(12U);
+        Assert::IsFalse(outbox.mockLocalStorage.HasStoredData(ra::services::StorageItemType::SubmissionJournal, L"User"));
+
+        // undelivered submissions are written when the journal is opened
+        outbox.Initialize("User");
+        Assert::AreEqual(std::string("U:1:12:1:hash:\n"), outbox.GetJournal());
+
+        outbox.ExecuteAllTasks();
+        Assert::AreEqual({ 1U }, outbox.vUnlocked.size());
+        Assert::AreEqual(std::string("U:1:12:1:hash:\nD:1:\n"), outbox.GetJournal());
+    }
+
+    TEST_METHOD(TestInitializeResendsUndelivered)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.MockJournal(
+            "U:1:12:1:hash:\n"
+            "L:2:7:500:hash:\n"
+            "U:3:13:0:hash:\n"
+            "D:1:\n"
+            "U:4:14:1:ha"); // partially written record is ignored
+
+        outbox.Initialize("User");
+
+        // journal is rewritten with only the undelivered submissions
+        Assert::AreEqual(std::string("L:1:7:500:hash:\nU:2:13:0:hash:\n"), outbox.GetJournal());
+
+        outbox.ExecuteAllTasks();
+        Assert::AreEqual({ 1U }, outbox.vUnlocked.size());
+        Assert::AreEqual(13U, outbox.vUnlocked.at(0));
+        Assert::AreEqual({ 1U }, outbox.vSubmitted.size());
+        Assert::AreEqual(7U, outbox.vSubmitted.at(0));
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nDelivered);
+    }
+
+    TEST_METHOD(TestInitializeSameUser)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.MockJournal("U:1:12:1:hash:\n");
+
+        outbox.Initialize("User");
+        Assert::AreEqual({ 1U }, outbox.mockThreadPool.PendingTasks());
+
+        // already open - don't resend
+        outbox.Initialize("User");
+        Assert::AreEqual({ 1U }, outbox.mockThreadPool.PendingTasks());
+    }
+
+    TEST_METHOD(TestInitializeDifferentUser)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+
+        for (unsigned int i = 1; i <= SubmissionOutbox::MaxInFlight + 1; ++i)
+            outbox.QueueUnlock(i);
+        Assert::AreEqual({ 1U }, outbox.GetStatistics().nQueued);
+
+        // pending submissions stay in the previous user's journal and are not sent for the new user
+        outbox.Initialize("User2");
+        Assert::AreEqual(std::string("U:1:1:1:hash:\nU:2:2:1:hash:\nU:3:3:1:hash:\nU:4:4:1:hash:\nU:5:5:1:hash:\n"), outbox.GetJournal());
+        Assert::AreEqual(std::string(), outbox.GetJournal(L"User2"));
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nQueued);
+
+        // a submission that was already in flight for the previous user is not requeued
+        outbox.bServerAvailable = false;
+        outbox.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nQueued);
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nRetries);
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight - 1, outbox.GetStatistics().nInFlight);
+
+        outbox.bServerAvailable = true;
+        outbox.ExecuteAllTasks();
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight - 1, outbox.vUnlocked.size());
+        Assert::AreEqual(std::string(), outbox.GetJournal(L"User2"));
+
+        // new submissions are journaled for the new user
+        outbox.QueueUnlock(20U);
+        Assert::AreEqual(std::string("U:6:20:1:hash:\n"), outbox.GetJournal(L"User2"));
+        outbox.ExecuteAllTasks();
+        Assert::AreEqual(20U, outbox.vUnlocked.back());
+        Assert::AreEqual(std::string("U:1:1:1:hash:\nU:2:2:1:hash:\nU:3:3:1:hash:\nU:4:4:1:hash:\nU:5:5:1:hash:\n"), outbox.GetJournal());
+    }
+
+    TEST_METHOD(TestMaxInFlight)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+
+        for (unsigned int i = 1; i <= SubmissionOutbox::MaxInFlight + 2; ++i)
+            outbox.QueueUnlock(i);
+
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight, outbox.mockThreadPool.PendingTasks());
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight, outbox.GetStatistics().nInFlight);
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nQueued);
+
+        // completing a request frees a slot for the next one
+        outbox.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight, outbox.GetStatistics().nInFlight);
+        Assert::AreEqual({ 1U }, outbox.GetStatistics().nQueued);
+
+        outbox.ExecuteAllTasks();
+        Assert::AreEqual(SubmissionOutbox::MaxInFlight + 2, outbox.vUnlocked.size());
+        for (unsigned int i = 1; i <= SubmissionOutbox::MaxInFlight + 2; ++i)
+            Assert::AreEqual(i, outbox.vUnlocked.at(i - 1));
+    }
+
+    TEST_METHOD(TestRetryBackoff)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+        outbox.bServerAvailable = false;
+
+        bool bCallbackCalled = false;
+        outbox.QueueUnlock(12U, [&bCallbackCalled](const ra::api::AwardAchievement::Response&)
+        {
+            bCallbackCalled = true;
+        });
+        outbox.mockThreadPool.ExecuteNextTask();
+        Assert::IsFalse(bCallbackCalled);
+        Assert::AreEqual({ 1U }, outbox.GetStatistics().nQueued);
+        Assert::AreEqual({ 1U }, outbox.GetStatistics().nRetries);
+
+        // new submissions wait for the retry
+        outbox.QueueUnlock(13U);
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nQueued);
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nInFlight);
+
+        outbox.mockThreadPool.AdvanceTime(std::chrono::milliseconds(499));
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nInFlight);
+        outbox.mockThreadPool.AdvanceTime(std::chrono::milliseconds(1));
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nInFlight);
+
+        // both fail. the delay doubles
+        outbox.mockThreadPool.ExecuteNextTask();
+        outbox.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nQueued);
+        Assert::AreEqual({ 3U }, outbox.GetStatistics().nRetries);
+
+        outbox.mockThreadPool.AdvanceTime(std::chrono::milliseconds(999));
+        Assert::AreEqual({ 0U }, outbox.GetStatistics().nInFlight);
+        outbox.bServerAvailable = true;
+        outbox.mockClock.AdvanceTime(std::chrono::milliseconds(1500));
+        outbox.mockThreadPool.AdvanceTime(std::chrono::milliseconds(1));
+        Assert::AreEqual({ 2U }, outbox.GetStatistics().nInFlight);
+
+        // resent in the order they were queued
+        outbox.ExecuteAllTasks();
+        Assert::IsTrue(bCallbackCalled);
+        Assert::AreEqual({ 2U }, outbox.vUnlocked.size());
+        Assert::AreEqual(12U, outbox.vUnlocked.at(0));
+        Assert::AreEqual(13U, outbox.vUnlocked.at(1));
+
+        const auto pStatistics = outbox.GetStatistics();
+        Assert::AreEqual({ 2U }, pStatistics.nDelivered);
+        Assert::AreEqual(3000, gsl::narrow_cast<int>(pStatistics.tTotalLatency.count()));
+        Assert::AreEqual(1500, gsl::narrow_cast<int>(pStatistics.tMaxLatency.count()));
+    }
+
+    TEST_METHOD(TestCompactJournal)
+    {
+        SubmissionOutboxHarness outbox;
+        outbox.Initialize("User");
+
+        // each delivered submission adds two records
+        for (unsigned int i = 1; i <= SubmissionOutbox::MaxJournalRecords / 2; ++i)
+        {
+            outbox.QueueUnlock(i);
+            outbox.mockThreadPool.ExecuteNextTask();
+        }
+        const auto& sJournal = outbox.GetJournal();
+        Assert::AreEqual(SubmissionOutbox::MaxJournalRecords, gsl::narrow_cast<size_t>(std::count(sJournal.begin(), sJournal.end(), '\n')));
+
+        // the next record causes the journal to be rewritten
+        outbox.QueueUnlock(100U);
+        Assert::AreEqual(std::string("U:33:100:1:hash:\n"), outbox.GetJournal());
+    }
+};
+
+} // namespace tests
+} // namespace services
+} // namespace ra
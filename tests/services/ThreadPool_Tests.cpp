@@ -0,0 +1,294 @@
+#include "CppUnitTest.h"
+
+#include "services\impl\ThreadPool.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockClock.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace services {
+namespace impl {
+namespace tests {
+
+TEST_CLASS(ThreadPool_Tests)
+{
+private:
+    static void WaitFor(const std::function<bool()>& fCondition)
+    {
+        const auto tTimeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!fCondition())
+        {
+            Assert::IsTrue(std::chrono::steady_clock::now() < tTimeout, L"Timed out waiting for tasks");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+public:
+    TEST_METHOD(TestRunAsync)
+    {
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+
+        std::atomic<int> nCompleted{ 0 };
+        for (int i = 0; i < 1000; ++i)
+            pThreadPool.RunAsync([&nCompleted]() noexcept { ++nCompleted; });
+
+        WaitFor([&nCompleted]() noexcept { return nCompleted == 1000; });
+
+        pThreadPool.Shutdown(true);
+    }
+
+    TEST_METHOD(TestRunAsyncFromWorker)
+    {
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+
+        // tasks queued by a worker go into its own queue. the other workers have to steal them.
+        std::atomic<int> nCompleted{ 0 };
+        pThreadPool.RunAsync([&pThreadPool, &nCompleted]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                pThreadPool.RunAsync([&nCompleted]() {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    ++nCompleted;
+                });
+            }
+        });
+
+        WaitFor([&nCompleted]() noexcept { return nCompleted == 100; });
+
+        pThreadPool.Shutdown(true);
+    }
+
+    TEST_METHOD(TestInteractiveBeforeBackground)
+    {
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(2);
+
+        // occupy both workers
+        std::atomic<int> nStarted{ 0 };
+        std::atomic<bool> bReleaseFirst{ false }, bReleaseSecond{ false };
+        pThreadPool.RunAsync([&]() {
+            ++nStarted;
+            while (!bReleaseFirst)
+                std::this_thread::yield();
+        });
+        pThreadPool.RunAsync([&]() {
+            ++nStarted;
+            while (!bReleaseSecond)
+                std::this_thread::yield();
+        });
+        WaitFor([&nStarted]() noexcept { return nStarted == 2; });
+
+        std::mutex oMutex;
+        std::string sOrder;
+        pThreadPool.RunAsync(IThreadPool::TaskPriority::Background, [&]() {
+            std::lock_guard<std::mutex> lock(oMutex);
+            sOrder.push_back('B');
+        });
+        pThreadPool.RunAsync(IThreadPool::TaskPriority::Interactive, [&]() {
+            std::lock_guard<std::mutex> lock(oMutex);
+            sOrder.push_back('I');
+        });
+
+        // free one worker. it should run the interactive task first even though it was queued second
+        bReleaseFirst = true;
+        WaitFor([&]() {
+            std::lock_guard<std::mutex> lock(oMutex);
+            return sOrder.length() == 2;
+        });
+        Assert::AreEqual(std::string("IB"), sOrder);
+
+        bReleaseSecond = true;
+        pThreadPool.Shutdown(true);
+    }
+
+    TEST_METHOD(TestParallelFor)
+    {
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+
+        std::vector<int> vVisits(10000);
+        std::atomic<int> nCalls{ 0 };
+        pThreadPool.ParallelFor(vVisits.size(), 64, [&vVisits, &nCalls](size_t nFirst, size_t nLast) {
+            Assert::IsTrue(nLast - nFirst <= 64);
+            for (size_t i = nFirst; i < nLast; ++i)
+                ++vVisits.at(i);
+            ++nCalls;
+        });
+
+        // ParallelFor doesn't return until all ranges have been processed, and each index is visited once
+        Assert::AreEqual(157, nCalls.load());
+        for (const auto nVisits : vVisits)
+            Assert::AreEqual(1, nVisits);
+
+        pThreadPool.Shutdown(true);
+    }
+
+    TEST_METHOD(TestParallelForException)
+    {
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+
+        std::atomic<int> nCalls{ 0 };
+        Assert::ExpectException<std::runtime_error>([&pThreadPool, &nCalls]() {
+            pThreadPool.ParallelFor(1000, 10, [&nCalls](size_t nFirst, size_t) {
+                ++nCalls;
+                if (nFirst == 500)
+                    throw std::runtime_error("failed");
+            });
+        });
+
+        // remaining ranges are still processed
+        Assert::AreEqual(100, nCalls.load());
+
+        pThreadPool.Shutdown(true);
+    }
+
+    TEST_METHOD(TestParallelForNoWorkers)
+    {
+        // mock thread pool never runs the queued tasks, so all the work happens on the calling thread
+        ra::services::mocks::MockThreadPool mockThreadPool;
+
+        size_t nTotal = 0;
+        mockThreadPool.ParallelFor(100, 30, [&nTotal](size_t nFirst, size_t nLast) noexcept {
+            for (size_t i = nFirst; i < nLast; ++i)
+                nTotal += i;
+        });
+        Assert::AreEqual({ 4950U }, nTotal);
+
+        // single range is processed directly without queueing any helpers
+        const auto nPendingTasks = mockThreadPool.PendingTasks();
+        nTotal = 0;
+        mockThreadPool.ParallelFor(10, 30, [&nTotal](size_t nFirst, size_t nLast) noexcept { nTotal += nLast - nFirst; });
+        Assert::AreEqual({ 10U }, nTotal);
+        Assert::AreEqual(nPendingTasks, mockThreadPool.PendingTasks());
+    }
+
+    TEST_METHOD(TestScheduleAsync)
+    {
+        ra::services::mocks::MockClock mockClock;
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(2);
+
+        std::mutex oMutex;
+        std::string sOrder;
+        const auto fAppend = [&oMutex, &sOrder](char c) {
+            std::lock_guard<std::mutex> lock(oMutex);
+            sOrder.push_back(c);
+        };
+        const auto fGetOrder = [&oMutex, &sOrder]() {
+            std::lock_guard<std::mutex> lock(oMutex);
+            return sOrder;
+        };
+
+        const auto nIdA = pThreadPool.ScheduleAsync(std::chrono::milliseconds(20), [&fAppend]() { fAppend('A'); });
+        const auto nIdB = pThreadPool.ScheduleAsync(std::chrono::milliseconds(10), [&fAppend]() { fAppend('B'); });
+        const auto nIdC = pThreadPool.ScheduleAsync(std::chrono::milliseconds(15), [&fAppend]() { fAppend('C'); });
+        Assert::AreNotEqual({ 0U }, nIdA);
+        Assert::AreNotEqual(nIdA, nIdB);
+        Assert::AreNotEqual(nIdB, nIdC);
+
+        Assert::IsTrue(pThreadPool.CancelScheduledTask(nIdC));
+        Assert::IsFalse(pThreadPool.CancelScheduledTask(nIdC));
+
+        // tasks are scheduled against the clock service, not the real time
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        Assert::AreEqual(std::string(), fGetOrder());
+
+        mockClock.AdvanceTime(std::chrono::milliseconds(10));
+        WaitFor([&fGetOrder]() { return fGetOrder() == "B"; });
+
+        mockClock.AdvanceTime(std::chrono::milliseconds(10));
+        WaitFor([&fGetOrder]() { return fGetOrder() == "BA"; });
+
+        // tasks that have already been started can't be cancelled
+        Assert::IsFalse(pThreadPool.CancelScheduledTask(nIdA));
+
+        pThreadPool.Shutdown(true);
+
+        Assert::AreEqual({ 0U }, pThreadPool.ScheduleAsync(std::chrono::milliseconds(10), []() noexcept {}));
+    }
+
+    TEST_METHOD(TestScheduleAsyncEarlierTask)
+    {
+        ra::services::mocks::MockClock mockClock;
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(2);
+
+        std::atomic<int> nCompleted{ 0 };
+        pThreadPool.ScheduleAsync(std::chrono::hours(1), [&nCompleted]() noexcept { nCompleted += 10; });
+
+        // give the timer thread a chance to start waiting for the first task
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // scheduling a task that's due sooner has to wake the timer thread, or it won't run for an hour
+        pThreadPool.ScheduleAsync(std::chrono::milliseconds(5), [&nCompleted]() noexcept { ++nCompleted; });
+        mockClock.AdvanceTime(std::chrono::milliseconds(5));
+        WaitFor([&nCompleted]() noexcept { return nCompleted == 1; });
+
+        pThreadPool.Shutdown(true);
+        Assert::AreEqual(1, nCompleted.load());
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(BenchmarkContention)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(BenchmarkContention)
+    {
+        // not a correctness test - run manually to measure queueing throughput with several producers
+        constexpr int nProducers = 4;
+        constexpr int nTasksPerProducer = 100000;
+
+        ThreadPool pThreadPool;
+        pThreadPool.Initialize(4);
+
+        std::atomic<int> nCompleted{ 0 };
+        auto tStart = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> vProducers;
+        for (int i = 0; i < nProducers; ++i)
+        {
+            vProducers.emplace_back([&pThreadPool, &nCompleted]() {
+                for (int j = 0; j < nTasksPerProducer; ++j)
+                    pThreadPool.RunAsync([&nCompleted]() noexcept { ++nCompleted; });
+            });
+        }
+        for (auto& pProducer : vProducers)
+            pProducer.join();
+
+        while (nCompleted < nProducers * nTasksPerProducer)
+            std::this_thread::yield();
+        const auto nExternalNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        // tasks queued from worker threads
+        nCompleted = 0;
+        tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nProducers; ++i)
+        {
+            pThreadPool.RunAsync([&pThreadPool, &nCompleted]() {
+                for (int j = 0; j < nTasksPerProducer; ++j)
+                    pThreadPool.RunAsync([&nCompleted]() noexcept { ++nCompleted; });
+            });
+        }
+
+        while (nCompleted < nProducers * nTasksPerProducer)
+            std::this_thread::yield();
+        const auto nWorkerNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+
+        pThreadPool.Shutdown(true);
+
+        constexpr int nTotalTasks = nProducers * nTasksPerProducer;
+        std::string sMessage = "External producers: " + std::to_string(nExternalNanoseconds / nTotalTasks) + "ns per task\n";
+        sMessage += "Worker producers: " + std::to_string(nWorkerNanoseconds / nTotalTasks) + "ns per task\n";
+        Logger::WriteMessage(sMessage.c_str());
+    }
+};
+
+} // namespace tests
+} // namespace impl
+} // namespace services
+} // namespace ra
@@ -0,0 +1,221 @@
+#include "CppUnitTest.h"
+
+#include "services\impl\TimerWheel.hh"
+
+#include "tests\mocks\MockClock.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::services::mocks::MockClock;
+
+namespace ra {
+namespace services {
+namespace impl {
+namespace tests {
+
+TEST_CLASS(TimerWheel_Tests)
+{
+private:
+    class TimerWheelHarness
+    {
+    public:
+        MockClock mockClock;
+        TimerWheel pWheel{ mockClock.UpTime() };
+        std::string sOrder;
+
+        TimerWheel::TimerId Schedule(std::chrono::milliseconds nDelay, char cTask)
+        {
+            return pWheel.Schedule(mockClock.UpTime() + nDelay, [this, cTask]() { sOrder.push_back(cTask); });
+        }
+
+        bool Cancel(TimerWheel::TimerId nId) { return pWheel.Cancel(nId); }
+
+        size_t Count() const noexcept { return pWheel.Count(); }
+
+        void AdvanceTime(std::chrono::milliseconds nDuration)
+        {
+            mockClock.AdvanceTime(nDuration);
+
+            std::vector<std::function<void()>> vExpired;
+            pWheel.Advance(mockClock.UpTime(), vExpired);
+            for (auto& fTask : vExpired)
+                fTask();
+        }
+
+        bool HasNextEvent() const noexcept
+        {
+            TimerWheel::TimePoint tNext;
+            return pWheel.GetNextEventTime(tNext);
+        }
+
+        int NextEventDelay() const
+        {
+            TimerWheel::TimePoint tNext;
+            Assert::IsTrue(pWheel.GetNextEventTime(tNext));
+            return gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tNext - mockClock.UpTime()).count());
+        }
+    };
+
+public:
+    TEST_METHOD(TestScheduleAdvance)
+    {
+        TimerWheelHarness wheel;
+        Assert::IsFalse(wheel.HasNextEvent());
+
+        Assert::AreNotEqual({ 0U }, wheel.Schedule(std::chrono::milliseconds(10), 'A'));
+        wheel.Schedule(std::chrono::milliseconds(5), 'B');
+        wheel.Schedule(std::chrono::milliseconds(20), 'C');
+        Assert::AreEqual({ 3U }, wheel.Count());
+        Assert::AreEqual(5, wheel.NextEventDelay());
+
+        wheel.AdvanceTime(std::chrono::milliseconds(4));
+        Assert::AreEqual(std::string(), wheel.sOrder);
+
+        // tasks are returned in the order they're due, not the order they were scheduled
+        wheel.AdvanceTime(std::chrono::milliseconds(6));
+        Assert::AreEqual(std::string("BA"), wheel.sOrder);
+        Assert::AreEqual({ 1U }, wheel.Count());
+        Assert::AreEqual(10, wheel.NextEventDelay());
+
+        wheel.AdvanceTime(std::chrono::milliseconds(10));
+        Assert::AreEqual(std::string("BAC"), wheel.sOrder);
+        Assert::AreEqual({ 0U }, wheel.Count());
+        Assert::IsFalse(wheel.HasNextEvent());
+    }
+
+    TEST_METHOD(TestScheduleAlreadyDue)
+    {
+        TimerWheelHarness wheel;
+        wheel.AdvanceTime(std::chrono::milliseconds(100));
+
+        wheel.Schedule(std::chrono::milliseconds(-50), 'A');
+        wheel.Schedule(std::chrono::milliseconds(0), 'B');
+
+        // the current tick has already been processed, so they're returned on the next one
+        Assert::AreEqual(1, wheel.NextEventDelay());
+        wheel.AdvanceTime(std::chrono::milliseconds(0));
+        Assert::AreEqual(std::string(), wheel.sOrder);
+
+        wheel.AdvanceTime(std::chrono::milliseconds(1));
+        Assert::AreEqual(std::string("AB"), wheel.sOrder);
+    }
+
+    TEST_METHOD(TestCancel)
+    {
+        TimerWheelHarness wheel;
+        const auto nIdA = wheel.Schedule(std::chrono::milliseconds(10), 'A');
+        const auto nIdB = wheel.Schedule(std::chrono::milliseconds(10), 'B');
+        wheel.Schedule(std::chrono::milliseconds(10), 'C');
+        const auto nIdD = wheel.Schedule(std::chrono::milliseconds(30), 'D');
+
+        Assert::IsTrue(wheel.Cancel(nIdB));
+        Assert::IsFalse(wheel.Cancel(nIdB));
+        Assert::IsTrue(wheel.Cancel(nIdD));
+        Assert::AreEqual({ 2U }, wheel.Count());
+
+        // the slot for D is empty, so nothing needs to be done after the slot for A and C
+        wheel.AdvanceTime(std::chrono::milliseconds(10));
+        Assert::AreEqual(std::string("AC"), wheel.sOrder);
+        Assert::IsFalse(wheel.HasNextEvent());
+
+        // tasks that have already been returned can't be cancelled
+        Assert::IsFalse(wheel.Cancel(nIdA));
+        Assert::IsFalse(wheel.Cancel(0));
+
+        wheel.AdvanceTime(std::chrono::milliseconds(100));
+        Assert::AreEqual(std::string("AC"), wheel.sOrder);
+    }
+
+    TEST_METHOD(TestLongDelays)
+    {
+        TimerWheelHarness wheel;
+        wheel.AdvanceTime(std::chrono::milliseconds(37)); // don't start on a lap boundary
+
+        wheel.Schedule(std::chrono::hours(1), 'A');
+        wheel.Schedule(std::chrono::milliseconds(5000), 'B');
+        wheel.Schedule(std::chrono::milliseconds(70), 'C');
+        wheel.Schedule(std::chrono::milliseconds(4096), 'D');
+
+        // higher level slots have to be redistributed before their tasks are due. advance one event at a time
+        // and make sure nothing happens early.
+        std::vector<int> vTimes;
+        int nElapsed = 0;
+        while (wheel.Count() > 0)
+        {
+            const auto nDelay = wheel.NextEventDelay();
+            Assert::IsTrue(nDelay > 0);
+
+            const auto nCount = wheel.sOrder.length();
+            wheel.AdvanceTime(std::chrono::milliseconds(nDelay));
+            nElapsed += nDelay;
+
+            if (wheel.sOrder.length() != nCount)
+                vTimes.push_back(nElapsed);
+        }
+
+        Assert::AreEqual(std::string("CDBA"), wheel.sOrder);
+        Assert::AreEqual({ 4U }, vTimes.size());
+        Assert::AreEqual(70, vTimes.at(0));
+        Assert::AreEqual(4096, vTimes.at(1));
+        Assert::AreEqual(5000, vTimes.at(2));
+        Assert::AreEqual(3600000, vTimes.at(3));
+    }
+
+    TEST_METHOD(TestLargeAdvance)
+    {
+        TimerWheelHarness wheel;
+        wheel.Schedule(std::chrono::minutes(10), 'A');
+        wheel.Schedule(std::chrono::milliseconds(200), 'B');
+        wheel.Schedule(std::chrono::seconds(30), 'C');
+
+        wheel.AdvanceTime(std::chrono::seconds(29));
+        Assert::AreEqual(std::string("B"), wheel.sOrder);
+
+        // a single advance past several tasks returns all of them, in order
+        wheel.AdvanceTime(std::chrono::hours(1));
+        Assert::AreEqual(std::string("BCA"), wheel.sOrder);
+    }
+
+    TEST_METHOD(TestBeyondRange)
+    {
+        // the wheel covers about four and a half hours. tasks further out than that are placed in the last
+        // slot and redistributed when it's reached.
+        TimerWheelHarness wheel;
+        wheel.Schedule(std::chrono::hours(10), 'A');
+
+        wheel.AdvanceTime(std::chrono::hours(5));
+        Assert::AreEqual(std::string(), wheel.sOrder);
+        Assert::AreEqual({ 1U }, wheel.Count());
+
+        wheel.AdvanceTime(std::chrono::hours(5) - std::chrono::milliseconds(1));
+        Assert::AreEqual(std::string(), wheel.sOrder);
+
+        wheel.AdvanceTime(std::chrono::milliseconds(1));
+        Assert::AreEqual(std::string("A"), wheel.sOrder);
+    }
+
+    TEST_METHOD(TestRescheduleSupersededTask)
+    {
+        // debounce pattern: each new request cancels the previous one
+        TimerWheelHarness wheel;
+        auto nId = wheel.Schedule(std::chrono::milliseconds(300), 'A');
+        for (int i = 0; i < 10; ++i)
+        {
+            wheel.AdvanceTime(std::chrono::milliseconds(100));
+            Assert::IsTrue(wheel.Cancel(nId));
+            nId = wheel.Schedule(std::chrono::milliseconds(300), 'A');
+        }
+        Assert::AreEqual({ 1U }, wheel.Count());
+
+        wheel.AdvanceTime(std::chrono::milliseconds(299));
+        Assert::AreEqual(std::string(), wheel.sOrder);
+
+        wheel.AdvanceTime(std::chrono::milliseconds(1));
+        Assert::AreEqual(std::string("A"), wheel.sOrder);
+    }
+};
+
+} // namespace tests
+} // namespace impl
+} // namespace services
+} // namespace ra
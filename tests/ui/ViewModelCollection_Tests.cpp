@@ -60,6 +60,7 @@ TEST_CLASS(ViewModelCollection_Tests)
         void OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args) noexcept override
         {
             GSL_SUPPRESS_F6 m_sLastPropertyChanged = args.Property.GetPropertyName();
+            ++m_nValueChanges;
 
             m_nChangeIndex = nIndex;
             m_bOldValue = args.tOldValue;
@@ -79,6 +80,7 @@ TEST_CLASS(ViewModelCollection_Tests)
         void OnViewModelStringValueChanged(gsl::index nIndex, const StringModelProperty::ChangeArgs& args) noexcept override
         {
            GSL_SUPPRESS_F6 m_sLastPropertyChanged = args.Property.GetPropertyName();
+           ++m_nValueChanges;
 
            m_nChangeIndex = nIndex;
            GSL_SUPPRESS_F6 m_sOldValue = args.tOldValue;
@@ -98,6 +100,7 @@ TEST_CLASS(ViewModelCollection_Tests)
         void OnViewModelIntValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args) noexcept override
         {
             GSL_SUPPRESS_F6 m_sLastPropertyChanged = args.Property.GetPropertyName();
+            ++m_nValueChanges;
 
             m_nChangeIndex = nIndex;
             m_nOldValue = args.tOldValue;
@@ -159,6 +162,11 @@ TEST_CLASS(ViewModelCollection_Tests)
             m_nChanges.clear();
         }
 
+        void OnBeginViewModelCollectionUpdate() noexcept override { ++m_nUpdates; }
+
+        int GetValueChanges() const noexcept { return m_nValueChanges; }
+        int GetUpdates() const noexcept { return m_nUpdates; }
+
     private:
         std::string m_sLastPropertyChanged;
         std::wstring m_sOldValue, m_sNewValue;
@@ -166,6 +174,8 @@ TEST_CLASS(ViewModelCollection_Tests)
         bool m_bOldValue{}, m_bNewValue{};
         gsl::index m_nChangeIndex = 0;
         std::map<gsl::index, std::string> m_nChanges;
+        int m_nValueChanges = 0;
+        int m_nUpdates = 0;
     };
 
 public:
@@ -846,6 +856,174 @@ public:
         oNotify.AssertItemChanged(4);
         oNotify.AssertItemChanged(5);
     }
+
+    TEST_METHOD(TestNotificationBatch)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        auto& pItem1 = vmCollection.Add(1, L"Test1");
+        auto& pItem2 = vmCollection.Add(2, L"Test2");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        Assert::IsTrue(vmCollection.IsBatchingNotifications());
+
+        pItem1.SetInt(10);
+        pItem1.SetInt(11);
+        pItem1.SetInt(12);
+        pItem2.SetString(L"Test2a");
+        pItem2.SetString(L"Test2b");
+        oNotify.AssertNotChanged();
+        Assert::AreEqual(0, oNotify.GetValueChanges());
+
+        vmCollection.EndNotificationBatch();
+        Assert::IsFalse(vmCollection.IsBatchingNotifications());
+
+        // one notification per item/property, from the original value to the final value, in a single update
+        Assert::AreEqual(2, oNotify.GetValueChanges());
+        Assert::AreEqual(1, oNotify.GetUpdates());
+        oNotify.AssertStringChanged(TestViewModel::StringProperty, 1, L"Test2", L"Test2b");
+        Assert::AreEqual(12, pItem1.GetInt());
+    }
+
+    TEST_METHOD(TestNotificationBatchIntChange)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        vmCollection.Add(1, L"Test1");
+        auto& pItem2 = vmCollection.Add(2, L"Test2");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        pItem2.SetInt(20);
+        pItem2.SetInt(21);
+        vmCollection.EndNotificationBatch();
+
+        Assert::AreEqual(1, oNotify.GetValueChanges());
+        oNotify.AssertIntChanged(TestViewModel::IntProperty, 1, 2, 21);
+    }
+
+    TEST_METHOD(TestNotificationBatchChangedBack)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        auto& pItem1 = vmCollection.Add(1, L"Test1");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        pItem1.SetBool(true);
+        pItem1.SetBool(false);
+        pItem1.SetInt(3);
+        pItem1.SetInt(1);
+        vmCollection.EndNotificationBatch();
+
+        // values ended where they started - no notifications, and no empty update
+        Assert::AreEqual(0, oNotify.GetValueChanges());
+        Assert::AreEqual(0, oNotify.GetUpdates());
+    }
+
+    TEST_METHOD(TestNotificationBatchNested)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        auto& pItem1 = vmCollection.Add(1, L"Test1");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        vmCollection.BeginNotificationBatch();
+        pItem1.SetBool(true);
+        vmCollection.EndNotificationBatch();
+        Assert::AreEqual(0, oNotify.GetValueChanges());
+
+        vmCollection.EndNotificationBatch();
+        Assert::AreEqual(1, oNotify.GetValueChanges());
+        oNotify.AssertBoolChanged(TestViewModel::BoolProperty, 0, false, true);
+    }
+
+    TEST_METHOD(TestNotificationBatchRemovedItem)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        auto& pItem1 = vmCollection.Add(1, L"Test1");
+        auto& pItem2 = vmCollection.Add(2, L"Test2");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        pItem1.SetInt(10);
+        pItem2.SetInt(20);
+        vmCollection.RemoveAt(0);
+        oNotify.AssertItemRemoved(0);
+
+        vmCollection.EndNotificationBatch();
+
+        // the removed item does not raise a notification. the remaining item uses its new index
+        Assert::AreEqual(1, oNotify.GetValueChanges());
+        oNotify.AssertIntChanged(TestViewModel::IntProperty, 0, 2, 20);
+    }
+
+    TEST_METHOD(TestNotificationBatchMovedItem)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        vmCollection.Add(1, L"Test1");
+        auto& pItem2 = vmCollection.Add(2, L"Test2");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        vmCollection.BeginNotificationBatch();
+        pItem2.SetString(L"Test2a");
+        vmCollection.MoveItem(1, 0);
+        vmCollection.EndNotificationBatch();
+
+        Assert::AreEqual(1, oNotify.GetValueChanges());
+        oNotify.AssertStringChanged(TestViewModel::StringProperty, 0, L"Test2", L"Test2a");
+    }
+
+    TEST_METHOD(TestRemoveNotifyTargetDuringNotification)
+    {
+        class RemovingNotifyTarget : public ViewModelCollectionBase::NotifyTarget
+        {
+        public:
+            RemovingNotifyTarget(ViewModelCollectionBase& vmCollection, ViewModelCollectionBase::NotifyTarget& pOther) noexcept
+                : m_vmCollection(vmCollection), m_pOther(pOther)
+            {
+            }
+
+            void OnViewModelIntValueChanged(gsl::index, const IntModelProperty::ChangeArgs&) override
+            {
+                m_vmCollection.RemoveNotifyTarget(m_pOther);
+                m_vmCollection.RemoveNotifyTarget(*this);
+            }
+
+        private:
+            ViewModelCollectionBase& m_vmCollection;
+            ViewModelCollectionBase::NotifyTarget& m_pOther;
+        };
+
+        ViewModelCollection<TestViewModel> vmCollection;
+        auto& pItem1 = vmCollection.Add(1, L"Test1");
+
+        NotifyTargetHarness oNotify;
+        RemovingNotifyTarget oRemover(vmCollection, oNotify);
+        vmCollection.AddNotifyTarget(oRemover);
+        vmCollection.AddNotifyTarget(oNotify);
+
+        // the remover is called first and removes both targets. the removed target should not be called.
+        pItem1.SetInt(10);
+        Assert::AreEqual(0, oNotify.GetValueChanges());
+
+        pItem1.SetInt(11);
+        Assert::AreEqual(0, oNotify.GetValueChanges());
+
+        vmCollection.AddNotifyTarget(oNotify);
+        pItem1.SetInt(12);
+        Assert::AreEqual(1, oNotify.GetValueChanges());
+    }
 };
 
 } // namespace tests
@@ -0,0 +1,228 @@
+#include "CppUnitTest.h"
+
+#include "ui\drawing\software\SoftwareSurface.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockFileSystem.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace software {
+namespace tests {
+
+TEST_CLASS(SoftwareSurface_Tests)
+{
+private:
+    static uint32_t GetPixel(const SoftwareSurface& pSurface, int nX, int nY)
+    {
+        return pSurface.GetPixels()[nY * pSurface.GetWidth() + nX];
+    }
+
+public:
+    TEST_METHOD(TestInitialize)
+    {
+        SoftwareSurfaceFactory factory;
+        const auto pSurface = factory.CreateSurface(4, 3);
+        Assert::AreEqual(4U, pSurface->GetWidth());
+        Assert::AreEqual(3U, pSurface->GetHeight());
+
+        const auto& pSoftwareSurface = dynamic_cast<const SoftwareSurface&>(*pSurface);
+        Assert::IsFalse(pSoftwareSurface.IsTransparent());
+        Assert::AreEqual(0xFF000000U, GetPixel(pSoftwareSurface, 0, 0));
+        Assert::AreEqual(0xFF000000U, GetPixel(pSoftwareSurface, 3, 2));
+        Assert::IsTrue(pSoftwareSurface.GetDirtyRect().IsEmpty());
+
+        const auto pTransparentSurface = factory.CreateTransparentSurface(4, 3);
+        const auto& pSoftwareTransparentSurface = dynamic_cast<const SoftwareSurface&>(*pTransparentSurface);
+        Assert::IsTrue(pSoftwareTransparentSurface.IsTransparent());
+        Assert::AreEqual(0x00000000U, GetPixel(pSoftwareTransparentSurface, 0, 0));
+    }
+
+    TEST_METHOD(TestFillRectangleClipped)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pSurface(4, 4, false, pResources);
+        pSurface.FillRectangle(-2, 2, 4, 8, Color(0xFF123456));
+
+        Assert::AreEqual(0xFF000000U, GetPixel(pSurface, 0, 1));
+        Assert::AreEqual(0xFF123456U, GetPixel(pSurface, 0, 2));
+        Assert::AreEqual(0xFF123456U, GetPixel(pSurface, 1, 3));
+        Assert::AreEqual(0xFF000000U, GetPixel(pSurface, 2, 3));
+
+        const auto& rcDirty = pSurface.GetDirtyRect();
+        Assert::AreEqual(0, rcDirty.X);
+        Assert::AreEqual(2, rcDirty.Y);
+        Assert::AreEqual(2, rcDirty.Width);
+        Assert::AreEqual(2, rcDirty.Height);
+
+        pSurface.FillRectangle(3, 0, 1, 1, Color(0xFF654321));
+        Assert::AreEqual(0, rcDirty.X);
+        Assert::AreEqual(0, rcDirty.Y);
+        Assert::AreEqual(4, rcDirty.Width);
+        Assert::AreEqual(4, rcDirty.Height);
+
+        pSurface.ResetDirtyRect();
+        Assert::IsTrue(pSurface.GetDirtyRect().IsEmpty());
+
+        pSurface.FillRectangle(10, 10, 4, 4, Color(0xFF654321));
+        Assert::IsTrue(pSurface.GetDirtyRect().IsEmpty());
+    }
+
+    TEST_METHOD(TestBlendPixels)
+    {
+        // seven pixels to exercise both the vectorized and scalar code paths
+        std::array<uint32_t, 7> pDst{ 0xFF000000, 0xFF000000, 0xFF000000, 0x80000000,
+                                      0xFFFFFFFF, 0xFF204060, 0xFF000000 };
+        const std::array<uint32_t, 7> pSrc{ 0x00FFFFFF, 0xFFFFFFFF, 0x80FFFFFF, 0xFF102030,
+                                            0x80000000, 0x00FFFFFF, 0x80FF0000 };
+
+        SoftwareSurface::BlendPixels(pDst.data(), pSrc.data(), pDst.size());
+
+        Assert::AreEqual(0xFF000000U, pDst.at(0)); // transparent source leaves destination
+        Assert::AreEqual(0xFFFFFFFFU, pDst.at(1)); // opaque source replaces destination
+        Assert::AreEqual(0xFF808080U, pDst.at(2)); // half blend
+        Assert::AreEqual(0x80102030U, pDst.at(3)); // destination alpha is preserved
+        Assert::AreEqual(0xFF7E7E7EU, pDst.at(4));
+        Assert::AreEqual(0xFF204060U, pDst.at(5));
+        Assert::AreEqual(0xFF800000U, pDst.at(6));
+    }
+
+    TEST_METHOD(TestDrawSurfaceTransparent)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pSurface(8, 8, false, pResources);
+        pSurface.FillRectangle(0, 0, 8, 8, Color(0xFF0000FF));
+
+        SoftwareSurface pOverlay(4, 4, true, pResources);
+        pOverlay.FillRectangle(0, 0, 2, 4, Color(0xFFFF0000));
+
+        pSurface.ResetDirtyRect();
+        pSurface.DrawSurface(6, 6, pOverlay);
+
+        Assert::AreEqual(0xFF0000FFU, GetPixel(pSurface, 5, 6));
+        Assert::AreEqual(0xFFFF0000U, GetPixel(pSurface, 6, 6));
+        Assert::AreEqual(0xFFFF0000U, GetPixel(pSurface, 7, 7));
+
+        const auto& rcDirty = pSurface.GetDirtyRect();
+        Assert::AreEqual(6, rcDirty.X);
+        Assert::AreEqual(6, rcDirty.Y);
+        Assert::AreEqual(2, rcDirty.Width);
+        Assert::AreEqual(2, rcDirty.Height);
+    }
+
+    TEST_METHOD(TestDrawSurfacePartialOpaque)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pSurface(4, 4, false, pResources);
+
+        SoftwareSurface pSource(4, 4, false, pResources);
+        pSource.FillRectangle(2, 2, 2, 2, Color(0xFF00FF00));
+
+        pSurface.DrawSurface(-1, 0, pSource, 2, 2, 2, 2);
+
+        Assert::AreEqual(0xFF00FF00U, GetPixel(pSurface, 0, 0));
+        Assert::AreEqual(0xFF00FF00U, GetPixel(pSurface, 0, 1));
+        Assert::AreEqual(0xFF000000U, GetPixel(pSurface, 1, 0));
+    }
+
+    TEST_METHOD(TestSetOpacity)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pSurface(2, 1, true, pResources);
+        pSurface.FillRectangle(0, 0, 1, 1, Color(0xFF336699));
+
+        pSurface.SetOpacity(0.5);
+
+        Assert::AreEqual(0x7F336699U, GetPixel(pSurface, 0, 0));
+        Assert::AreEqual(0x00000000U, GetPixel(pSurface, 1, 0));
+    }
+
+    TEST_METHOD(TestText)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pSurface(64, 32, false, pResources);
+
+        const auto nFont = pSurface.LoadFont("Tahoma", 16, FontStyles::Normal);
+        Assert::AreNotEqual(0, nFont);
+        Assert::AreEqual(nFont, pSurface.LoadFont("Tahoma", 16, FontStyles::Normal));
+        Assert::AreNotEqual(nFont, pSurface.LoadFont("Tahoma", 16, FontStyles::Bold));
+
+        const auto szText = pSurface.MeasureText(nFont, L"ABC");
+        Assert::AreEqual(36, szText.Width);
+        Assert::AreEqual(16, szText.Height);
+
+        pSurface.WriteText(2, 4, nFont, Color(0xFFFFFFFF), L"ABC");
+
+        // glyphs for all three letters only need to be rasterized once
+        pSurface.WriteText(2, 4, nFont, Color(0xFFFFFFFF), L"CBA");
+        Assert::AreEqual({ 3U }, pResources.Glyphs().GetGlyphCount());
+
+        const auto& rcDirty = pSurface.GetDirtyRect();
+        Assert::AreEqual(2, rcDirty.X);
+        Assert::AreEqual(4, rcDirty.Y);
+        Assert::AreEqual(36, rcDirty.Width);
+        Assert::AreEqual(16, rcDirty.Height);
+
+        bool bHasText = false;
+        for (int nY = 0; nY < 32; ++nY)
+        {
+            for (int nX = 0; nX < 64; ++nX)
+            {
+                const auto nPixel = GetPixel(pSurface, nX, nY);
+                if (nX < rcDirty.X || nX >= rcDirty.Right() || nY < rcDirty.Y || nY >= rcDirty.Bottom())
+                    Assert::AreEqual(0xFF000000U, nPixel);
+                else if (nPixel == 0xFFFFFFFF)
+                    bHasText = true;
+            }
+        }
+
+        Assert::IsTrue(bHasText);
+    }
+
+    TEST_METHOD(TestDrawImageStretched)
+    {
+        SoftwareResourceRepository pResources;
+        SoftwareSurface pImage(2, 2, false, pResources);
+        pImage.FillRectangle(0, 0, 1, 1, Color(0xFFFF0000));
+        pImage.FillRectangle(1, 1, 1, 1, Color(0xFF0000FF));
+
+        pResources.SetImageProvider([&pImage](const ImageReference&) noexcept { return &pImage; });
+
+        SoftwareSurface pSurface(4, 4, false, pResources);
+        const ImageReference pReference(ImageType::Badge, "12345");
+        pSurface.DrawImageStretched(0, 0, 4, 4, pReference);
+
+        Assert::AreEqual(0xFFFF0000U, GetPixel(pSurface, 0, 0));
+        Assert::AreEqual(0xFFFF0000U, GetPixel(pSurface, 1, 1));
+        Assert::AreEqual(0xFF000000U, GetPixel(pSurface, 2, 1));
+        Assert::AreEqual(0xFF0000FFU, GetPixel(pSurface, 3, 3));
+    }
+
+    TEST_METHOD(TestSaveImage)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        SoftwareSurfaceFactory factory;
+        const auto pSurface = factory.CreateSurface(2, 2);
+        pSurface->FillRectangle(0, 0, 1, 1, Color(0xFF112233));
+
+        Assert::IsTrue(factory.SaveImage(*pSurface, L"screenshot.png"));
+
+        const auto& sContents = mockFileSystem.GetFileContents(L"screenshot.png");
+        Assert::AreEqual(std::string("\x89PNG\r\n\x1A\n", 8), sContents.substr(0, 8));
+        Assert::AreEqual(std::string("IHDR"), sContents.substr(12, 4));
+        Assert::AreEqual(std::string("IEND"), sContents.substr(sContents.length() - 8, 4));
+
+        // uncompressed data starts after the IHDR chunk (33 bytes), the IDAT length and type (8 bytes),
+        // the zlib header (2 bytes), and the stored block header (5 bytes). first byte is the filter type.
+        Assert::AreEqual(std::string("\0\x11\x22\x33\0\0\0", 7), sContents.substr(8 + 33 + 8 + 2 + 5, 7));
+    }
+};
+
+} // namespace tests
+} // namespace software
+} // namespace drawing
+} // namespace ui
+} // namespace ra
@@ -0,0 +1,416 @@
+#include "CppUnitTest.h"
+
+#include "ui\drawing\gdi\ImageRepository.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockConfiguration.hh"
+#include "tests\mocks\MockFileSystem.hh"
+#include "tests\mocks\MockHttpRequester.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::services::mocks::MockConfiguration;
+using ra::services::mocks::MockFileSystem;
+using ra::services::mocks::MockHttpRequester;
+using ra::services::mocks::MockThreadPool;
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace gdi {
+namespace tests {
+
+TEST_CLASS(ImageRepository_Tests)
+{
+private:
+    class ImageRepositoryHarness : public ImageRepository
+    {
+    public:
+        ImageRepositoryHarness()
+            : mockHttpRequester([this](const ra::services::Http::Request& pRequest)
+              {
+                  vRequestedUrls.push_back(pRequest.GetUrl());
+                  return ra::services::Http::Response(nStatusCode, "PNG");
+              })
+        {
+            mockFileSystem.SetBaseDirectory(L"C:\\RA\\");
+            mockConfiguration.SetImageHostUrl("http://media.host");
+            mockConfiguration.SetHostUrl("http://host");
+
+            MockBadge("00000", "PNG");
+        }
+
+        MockConfiguration mockConfiguration;
+        MockFileSystem mockFileSystem;
+        MockThreadPool mockThreadPool;
+        MockHttpRequester mockHttpRequester;
+
+        std::vector<std::string> vRequestedUrls;
+        ra::services::Http::StatusCode nStatusCode = ra::services::Http::StatusCode::OK;
+        std::set<std::wstring> vCorruptFiles;
+        mutable size_t nDecodes = 0;
+
+        static constexpr size_t ImageBytes = 64 * 64 * sizeof(uint32_t);
+
+        void MockBadge(const std::string& sName, const std::string& sContents)
+        {
+            mockFileSystem.MockFile(L"C:\\RA\\RACache\\Badge\\" + ra::Widen(sName) + L".png", sContents);
+        }
+
+        void MockCorruptBadge(const std::string& sName)
+        {
+            MockBadge(sName, "PNG");
+            vCorruptFiles.insert(L"C:\\RA\\RACache\\Badge\\" + ra::Widen(sName) + L".png");
+        }
+
+        void ExecuteAllTasks()
+        {
+            while (mockThreadPool.PendingTasks() > 0)
+                mockThreadPool.ExecuteNextTask();
+        }
+
+        void LoadBadge(const std::string& sName)
+        {
+            MockBadge(sName, "PNG");
+
+            // requesting the image starts decoding it in the background. when the reference goes out of
+            // scope, the decoded image is no longer referenced, and becomes eligible for eviction.
+            {
+                ImageReference pImage(ImageType::Badge, sName);
+                ImageRepository::GetHBitmap(pImage);
+            }
+
+            ExecuteAllTasks();
+        }
+
+    protected:
+        std::unique_ptr<DecodedImage> DecodeImage(const std::wstring& sFilename, unsigned int nWidth, unsigned int nHeight) const override
+        {
+            ++nDecodes;
+
+            if (vCorruptFiles.find(sFilename) != vCorruptFiles.end())
+                return nullptr;
+
+            auto pImage = std::make_unique<DecodedImage>();
+            pImage->nWidth = nWidth;
+            pImage->nHeight = nHeight;
+            pImage->vPixels.resize(gsl::narrow_cast<size_t>(nWidth) * nHeight);
+            return pImage;
+        }
+
+    private:
+        ra::services::ServiceLocator::ServiceOverride<ra::ui::IImageRepository> m_Override{ this };
+    };
+
+    class ImageChangedListener : public IImageRepository::NotifyTarget
+    {
+    public:
+        std::vector<std::string> vChanged;
+
+        void OnImageChanged(ImageType, const std::string& sName) override
+        {
+            vChanged.push_back(sName);
+        }
+    };
+
+public:
+    TEST_METHOD(TestFetchImagesDownloadsMissingImages)
+    {
+        ImageRepositoryHarness repository;
+        repository.FetchImages(ImageType::Badge, { "12345", "23456" }, false);
+
+        Assert::AreEqual({ 2U }, repository.mockThreadPool.PendingTasks());
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 2U }, repository.vRequestedUrls.size());
+        Assert::AreEqual(std::string("http://media.host/Badge/12345.png"), repository.vRequestedUrls.at(0));
+        Assert::AreEqual(std::string("http://media.host/Badge/23456.png"), repository.vRequestedUrls.at(1));
+        Assert::AreEqual(std::string("PNG"), repository.mockFileSystem.GetFileContents(L"C:\\RA\\RACache\\Badge\\12345.png"));
+        Assert::AreEqual(std::string("PNG"), repository.mockFileSystem.GetFileContents(L"C:\\RA\\RACache\\Badge\\23456.png"));
+    }
+
+    TEST_METHOD(TestFetchImagesSkipsExistingImages)
+    {
+        ImageRepositoryHarness repository;
+        repository.MockBadge("12345", "PNG");
+
+        repository.FetchImages(ImageType::Badge, { "12345", "23456" }, false);
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 1U }, repository.vRequestedUrls.size());
+        Assert::AreEqual(std::string("http://media.host/Badge/23456.png"), repository.vRequestedUrls.at(0));
+    }
+
+    TEST_METHOD(TestFetchImagesRefetchesEmptyImages)
+    {
+        ImageRepositoryHarness repository;
+        repository.MockBadge("12345", "");
+
+        repository.FetchImages(ImageType::Badge, { "12345" }, false);
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 1U }, repository.vRequestedUrls.size());
+        Assert::AreEqual(std::string("http://media.host/Badge/12345.png"), repository.vRequestedUrls.at(0));
+        Assert::AreEqual(std::string("PNG"), repository.mockFileSystem.GetFileContents(L"C:\\RA\\RACache\\Badge\\12345.png"));
+    }
+
+    TEST_METHOD(TestFetchImagesIgnoresDuplicates)
+    {
+        ImageRepositoryHarness repository;
+        repository.FetchImages(ImageType::Badge, { "12345", "12345", "" }, false);
+        repository.FetchImages(ImageType::Badge, { "12345" }, false);
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 1U }, repository.vRequestedUrls.size());
+    }
+
+    TEST_METHOD(TestFetchImagesLimitsConcurrentDownloads)
+    {
+        ImageRepositoryHarness repository;
+        repository.FetchImages(ImageType::Badge, { "1", "2", "3", "4", "5", "6" }, false);
+
+        // only four downloads should be started at a time
+        Assert::AreEqual({ 4U }, repository.mockThreadPool.PendingTasks());
+
+        // as each download completes, the next one is started
+        repository.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 1U }, repository.vRequestedUrls.size());
+        Assert::AreEqual({ 4U }, repository.mockThreadPool.PendingTasks());
+
+        repository.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 2U }, repository.vRequestedUrls.size());
+        Assert::AreEqual({ 4U }, repository.mockThreadPool.PendingTasks());
+
+        repository.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 3U }, repository.vRequestedUrls.size());
+        Assert::AreEqual({ 3U }, repository.mockThreadPool.PendingTasks());
+
+        repository.ExecuteAllTasks();
+        Assert::AreEqual({ 6U }, repository.vRequestedUrls.size());
+    }
+
+    TEST_METHOD(TestFetchImagesPriority)
+    {
+        ImageRepositoryHarness repository;
+        repository.FetchImages(ImageType::Badge, { "1", "2", "3", "4", "5", "6" }, false);
+        repository.FetchImages(ImageType::Badge, { "7", "8" }, true);
+
+        // the first four downloads have already started. the priority images should be
+        // downloaded before the remaining images.
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 8U }, repository.vRequestedUrls.size());
+        Assert::AreEqual(std::string("http://media.host/Badge/7.png"), repository.vRequestedUrls.at(4));
+        Assert::AreEqual(std::string("http://media.host/Badge/8.png"), repository.vRequestedUrls.at(5));
+        Assert::AreEqual(std::string("http://media.host/Badge/5.png"), repository.vRequestedUrls.at(6));
+        Assert::AreEqual(std::string("http://media.host/Badge/6.png"), repository.vRequestedUrls.at(7));
+    }
+
+    TEST_METHOD(TestFetchImagesFailedDownload)
+    {
+        ImageRepositoryHarness repository;
+        repository.nStatusCode = ra::services::Http::StatusCode::NotFound;
+        repository.FetchImages(ImageType::Badge, { "12345" }, false);
+        repository.ExecuteAllTasks();
+
+        Assert::AreEqual({ 1U }, repository.vRequestedUrls.size());
+        Assert::AreEqual({ -1 }, repository.mockFileSystem.GetFileSize(L"C:\\RA\\RACache\\Badge\\12345.png"));
+    }
+
+    TEST_METHOD(TestFetchImagesOffline)
+    {
+        ImageRepositoryHarness repository;
+        repository.mockConfiguration.SetFeatureEnabled(ra::services::Feature::Offline, true);
+        repository.FetchImages(ImageType::Badge, { "12345" }, false);
+
+        Assert::AreEqual({ 0U }, repository.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 0U }, repository.vRequestedUrls.size());
+    }
+
+    TEST_METHOD(TestIsImageAvailableStartsDecode)
+    {
+        ImageRepositoryHarness repository;
+        repository.MockBadge("12345", "PNG");
+        ImageChangedListener listener;
+        repository.AddNotifyTarget(listener);
+
+        // file exists, but hasn't been decoded. decoding it is started in the background
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "12345"));
+        Assert::AreEqual({ 1U }, repository.mockThreadPool.PendingTasks());
+
+        // asking again doesn't start another decode
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "12345"));
+        Assert::AreEqual({ 1U }, repository.mockThreadPool.PendingTasks());
+
+        repository.ExecuteAllTasks();
+        Assert::AreEqual({ 1U }, repository.nDecodes);
+        Assert::AreEqual({ 1U }, listener.vChanged.size());
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "12345"));
+
+        repository.RemoveNotifyTarget(listener);
+    }
+
+    TEST_METHOD(TestGetImageDecodesInBackground)
+    {
+        ImageRepositoryHarness repository;
+        repository.MockBadge("12345", "PNG");
+        ImageChangedListener listener;
+        repository.AddNotifyTarget(listener);
+
+        // image is decoded in the background. neither the image or the placeholder is available yet.
+        ImageReference pImage(ImageType::Badge, "12345");
+        Assert::IsNull(ImageRepository::GetHBitmap(pImage));
+        Assert::AreEqual({ 2U }, repository.mockThreadPool.PendingTasks());
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "12345"));
+
+        repository.ExecuteAllTasks();
+        Assert::AreEqual({ 2U }, listener.vChanged.size());
+        Assert::AreEqual(std::string("12345"), listener.vChanged.at(0));
+        Assert::AreEqual(std::string("00000"), listener.vChanged.at(1));
+
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "12345"));
+        Assert::IsNotNull(ImageRepository::GetHBitmap(pImage));
+        Assert::AreEqual({ 2U }, repository.nDecodes);
+
+        repository.RemoveNotifyTarget(listener);
+    }
+
+    TEST_METHOD(TestDecodeFailureRemembered)
+    {
+        ImageRepositoryHarness repository;
+        repository.MockCorruptBadge("12345");
+        ImageChangedListener listener;
+        repository.AddNotifyTarget(listener);
+
+        ImageReference pImage(ImageType::Badge, "12345");
+        Assert::IsNull(ImageRepository::GetHBitmap(pImage));
+        repository.ExecuteAllTasks();
+        Assert::AreEqual({ 2U }, repository.nDecodes);
+        Assert::AreEqual({ 2U }, listener.vChanged.size());
+
+        // waiting won't make the image available, so it shouldn't be reported as pending
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "12345"));
+
+        // the placeholder should be returned without trying to decode the file again
+        const auto hDefault = ImageRepository::GetHBitmap(pImage);
+        Assert::IsNotNull(hDefault);
+        ImageRepository::GetHBitmap(pImage);
+        Assert::AreEqual({ 0U }, repository.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 2U }, repository.nDecodes);
+        Assert::AreEqual({ 2U }, listener.vChanged.size());
+
+        repository.RemoveNotifyTarget(listener);
+    }
+
+    TEST_METHOD(TestUnreferencedImagesEvictedWhenOverBudget)
+    {
+        ImageRepositoryHarness repository;
+        repository.SetCacheBudget(ImageRepositoryHarness::ImageBytes * 3);
+
+        repository.LoadBadge("1");
+        repository.LoadBadge("2");
+        auto pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 3U }, pStatistics.nImages); // includes placeholder
+        Assert::AreEqual(ImageRepositoryHarness::ImageBytes * 3, pStatistics.nBytesUsed);
+        Assert::AreEqual({ 0U }, pStatistics.nEvictions);
+
+        // least recently used image should be evicted
+        repository.LoadBadge("3");
+        pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 3U }, pStatistics.nImages);
+        Assert::AreEqual(ImageRepositoryHarness::ImageBytes * 3, pStatistics.nBytesUsed);
+        Assert::AreEqual({ 1U }, pStatistics.nEvictions);
+
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "1"));
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "2"));
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "3"));
+    }
+
+    TEST_METHOD(TestRecentlyUsedImagesKept)
+    {
+        ImageRepositoryHarness repository;
+        repository.SetCacheBudget(ImageRepositoryHarness::ImageBytes * 3);
+
+        repository.LoadBadge("1");
+        repository.LoadBadge("2");
+
+        // using the image makes it the most recently used
+        {
+            ImageReference pImage(ImageType::Badge, "1");
+            Assert::IsNotNull(ImageRepository::GetHBitmap(pImage));
+        }
+
+        repository.LoadBadge("3");
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "1"));
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "2"));
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "3"));
+    }
+
+    TEST_METHOD(TestReferencedImagesNotEvicted)
+    {
+        ImageRepositoryHarness repository;
+        repository.SetCacheBudget(ImageRepositoryHarness::ImageBytes * 2);
+
+        repository.LoadBadge("1");
+        ImageReference pImage(ImageType::Badge, "1");
+        Assert::IsNotNull(ImageRepository::GetHBitmap(pImage));
+
+        // referenced image and placeholder fill the budget. new images are evicted as soon as they're decoded
+        repository.LoadBadge("2");
+        repository.LoadBadge("3");
+
+        auto pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 2U }, pStatistics.nEvictions);
+        Assert::AreEqual(ImageRepositoryHarness::ImageBytes * 2, pStatistics.nBytesUsed);
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "1"));
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "2"));
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "3"));
+
+        // releasing the reference makes the image eligible for eviction, but it's within budget
+        pImage.Release();
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "1"));
+
+        repository.SetCacheBudget(ImageRepositoryHarness::ImageBytes);
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "1"));
+    }
+
+    TEST_METHOD(TestPlaceholderNotEvicted)
+    {
+        ImageRepositoryHarness repository;
+        repository.LoadBadge("1");
+
+        repository.SetCacheBudget(0);
+
+        const auto pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 1U }, pStatistics.nImages);
+        Assert::AreEqual({ 1U }, pStatistics.nEvictions);
+        Assert::AreEqual(ImageRepositoryHarness::ImageBytes, pStatistics.nBytesUsed);
+        Assert::IsFalse(repository.IsImageAvailable(ImageType::Badge, "1"));
+        Assert::IsTrue(repository.IsImageAvailable(ImageType::Badge, "00000"));
+    }
+
+    TEST_METHOD(TestCacheHitsAndMisses)
+    {
+        ImageRepositoryHarness repository;
+        repository.LoadBadge("1");
+
+        // the requested image and the placeholder were not in the cache
+        auto pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 0U }, pStatistics.nHits);
+        Assert::AreEqual({ 2U }, pStatistics.nMisses);
+
+        ImageReference pImage(ImageType::Badge, "1");
+        Assert::IsNotNull(ImageRepository::GetHBitmap(pImage));
+
+        pStatistics = repository.GetCacheStatistics();
+        Assert::AreEqual({ 1U }, pStatistics.nHits);
+        Assert::AreEqual({ 2U }, pStatistics.nMisses);
+    }
+};
+
+} // namespace tests
+} // namespace gdi
+} // namespace drawing
+} // namespace ui
+} // namespace ra
@@ -964,6 +964,24 @@ public:
         Assert::AreEqual(0, vmAssetList.GetTotalPoints());
     }
 
+    TEST_METHOD(TestRemoveItemWithChangedId)
+    {
+        AssetListViewModelHarness vmAssetList;
+        vmAssetList.SetFilterCategory(AssetListViewModel::FilterCategory::Core);
+        vmAssetList.AddThreeAchievements();
+
+        vmAssetList.mockGameContext.Assets().GetItemAt(2)->SetID(33U);
+        Assert::AreEqual({ 2U }, vmAssetList.FilteredAssets().Count());
+        Assert::AreEqual(33, vmAssetList.FilteredAssets().GetItemAt(1)->GetId());
+
+        vmAssetList.mockGameContext.Assets().RemoveAt(2);
+
+        Assert::AreEqual({ 2U }, vmAssetList.mockGameContext.Assets().Count());
+        Assert::AreEqual({ 1U }, vmAssetList.FilteredAssets().Count());
+        Assert::AreEqual(5, vmAssetList.GetTotalPoints());
+        Assert::AreEqual(1, vmAssetList.FilteredAssets().GetItemAt(0)->GetId());
+    }
+
     TEST_METHOD(TestChangeItemForFilter)
     {
         AssetListViewModelHarness vmAssetList;
@@ -1212,6 +1230,41 @@ public:
         Assert::AreEqual(std::wstring(L"Final condition type expects another condition to follow"), pItem->GetWarning());
     }
 
+    TEST_METHOD(TestSyncFilteredItemAfterIdChange)
+    {
+        AssetListViewModelHarness vmAssetList;
+        vmAssetList.SetFilterCategory(AssetListViewModel::FilterCategory::Local);
+
+        vmAssetList.AddAchievement(AssetCategory::Local, 5, L"Ach1");
+        vmAssetList.AddAchievement(AssetCategory::Local, 10, L"Ach2");
+        auto* vmAchievement = dynamic_cast<ra::data::models::AchievementModel*>(vmAssetList.mockGameContext.Assets().GetItemAt(0));
+        Expects(vmAchievement != nullptr);
+
+        Assert::AreEqual({ 2U }, vmAssetList.FilteredAssets().Count());
+        const auto* pItem = vmAssetList.FilteredAssets().GetItemAt(0);
+        Expects(pItem != nullptr);
+        Assert::AreEqual(1, pItem->GetId());
+        Assert::AreEqual(15, vmAssetList.GetTotalPoints());
+
+        // changing the ID (as happens when a local achievement is published) should not break the association
+        vmAchievement->SetID(1234U);
+        Assert::AreEqual(1234, pItem->GetId());
+
+        vmAchievement->SetName(L"New Title");
+        Assert::AreEqual(std::wstring(L"New Title"), pItem->GetLabel());
+
+        vmAchievement->SetPoints(25);
+        Assert::AreEqual(25, pItem->GetPoints());
+        Assert::AreEqual(35, vmAssetList.GetTotalPoints());
+
+        // moving the item out of the filter should remove it and its points
+        vmAchievement->SetCategory(AssetCategory::Core);
+        Assert::AreEqual({ 1U }, vmAssetList.FilteredAssets().Count());
+        Assert::AreEqual(2, vmAssetList.FilteredAssets().GetItemAt(0)->GetId());
+        Assert::AreEqual(1, vmAssetList.GetAchievementCount());
+        Assert::AreEqual(10, vmAssetList.GetTotalPoints());
+    }
+
     TEST_METHOD(TestSyncAddItem)
     {
         AssetListViewModelHarness vmAssetList;
@@ -829,6 +829,188 @@ public:
         vmUpload.AssertFailed(1, 1, L"* Title2: Timeout");
     }
 
+    TEST_METHOD(TestSingleCoreAchievementRetry)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"12345", "0xH1234=1");
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement.GetChanges());
+
+        vmUpload.QueueAsset(pAchievement);
+        Assert::AreEqual({ 1U }, vmUpload.TaskCount());
+
+        int nApiCount = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nApiCount]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            if (++nApiCount == 1)
+            {
+                // server could not be reached - should be retried
+                pResponse.ErrorMessage = "HTTP error code: 503";
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(2, nApiCount);
+        Assert::AreEqual({ 2U }, vmUpload.TaskCount());
+        Assert::AreEqual(AssetChanges::None, pAchievement.GetChanges());
+
+        vmUpload.AssertSuccess(1);
+    }
+
+    TEST_METHOD(TestSingleCoreAchievementRetryLimit)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"12345", "0xH1234=1");
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement.GetChanges());
+
+        vmUpload.QueueAsset(pAchievement);
+        Assert::AreEqual({ 1U }, vmUpload.TaskCount());
+
+        int nApiCount = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nApiCount]
+                (const ra::api::UpdateAchievement::Request&, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            ++nApiCount;
+            pResponse.ErrorMessage = "HTTP error code: 503";
+            pResponse.Result = ra::api::ApiResult::Incomplete;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(3, nApiCount);
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement.GetChanges());
+
+        vmUpload.AssertFailed(0, 1, L"* Title1: HTTP error code: 503");
+    }
+
+    TEST_METHOD(TestCoreAchievementErrorNotRetried)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement);
+
+        int nApiCount = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nApiCount]
+                (const ra::api::UpdateAchievement::Request&, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            ++nApiCount;
+            pResponse.ErrorMessage = "HTTP error code: 404";
+            pResponse.Result = ra::api::ApiResult::Error;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(1, nApiCount);
+        Assert::AreEqual({ 1U }, vmUpload.TaskCount());
+
+        vmUpload.AssertFailed(0, 1, L"* Title1: HTTP error code: 404");
+    }
+
+    TEST_METHOD(TestImageUploadedBeforeOtherAssets)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pLeaderboard = vmUpload.AddLeaderboard(AssetCategory::Core, L"LB1", L"Desc1", "0xH1234=1", "0xH1234=2", "0xH1234=3", "0xH2345", ra::data::ValueFormat::Score);
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"local\\12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pLeaderboard);
+        vmUpload.QueueAsset(pAchievement);
+        Assert::AreEqual({ 2U }, vmUpload.TaskCount());
+
+        std::string sOrder;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&sOrder]
+                (const ra::api::UploadBadge::Request&, ra::api::UploadBadge::Response& pResponse)
+        {
+            sOrder.push_back('B');
+            pResponse.BadgeId = "76543";
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateLeaderboard>([&sOrder]
+                (const ra::api::UpdateLeaderboard::Request& pRequest, ra::api::UpdateLeaderboard::Response& pResponse)
+        {
+            sOrder.push_back('L');
+            pResponse.LeaderboardId = pRequest.LeaderboardId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&sOrder]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            sOrder.push_back('A');
+            Assert::AreEqual(std::string("76543"), pRequest.Badge);
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        // badge is uploaded first, then the leaderboard (which was already queued), then the achievement that
+        // was waiting on the badge
+        Assert::AreEqual(std::string("BLA"), sOrder);
+        Assert::AreEqual(AssetChanges::None, pLeaderboard.GetChanges());
+        Assert::AreEqual(AssetChanges::None, pAchievement.GetChanges());
+        Assert::AreEqual(std::wstring(L"76543"), pAchievement.GetBadge());
+
+        vmUpload.AssertSuccess(2);
+    }
+
+    TEST_METHOD(TestImageUploadRetry)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"local\\12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement);
+        Assert::AreEqual({ 1U }, vmUpload.TaskCount());
+
+        int nImagesUploaded = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&nImagesUploaded]
+                (const ra::api::UploadBadge::Request&, ra::api::UploadBadge::Response& pResponse)
+        {
+            if (++nImagesUploaded == 1)
+            {
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            pResponse.BadgeId = "76543";
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        int nAchievementsUploaded = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nAchievementsUploaded]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            ++nAchievementsUploaded;
+            Assert::AreEqual(std::string("76543"), pRequest.Badge);
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(2, nImagesUploaded);
+        Assert::AreEqual(1, nAchievementsUploaded);
+        Assert::AreEqual(AssetChanges::None, pAchievement.GetChanges());
+        Assert::AreEqual(std::wstring(L"76543"), pAchievement.GetBadge());
+
+        vmUpload.AssertSuccess(1);
+    }
+
     TEST_METHOD(TestSingleLocalLeaderboard)
     {
         AssetUploadViewModelHarness vmUpload;
@@ -1138,6 +1320,39 @@ public:
         Assert::AreEqual(2, nApiCount);
         Assert::AreEqual(AssetChanges::None, vmUpload.CodeNotes().GetChanges());
 
+        vmUpload.AssertSuccess(2);
+    }
+    TEST_METHOD(TestCodeNoteRetry)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        vmUpload.CodeNotes().SetCodeNote(0x1234, L"This is a note.");
+        vmUpload.CodeNotes().SetCodeNote(0x1235, L"This is another note.");
+
+        vmUpload.QueueAsset(vmUpload.CodeNotes());
+        Assert::AreEqual({ 2U }, vmUpload.TaskCount());
+
+        int nApiCount = 0;
+        bool bFailed = false;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateCodeNote>([&nApiCount, &bFailed]
+                (const ra::api::UpdateCodeNote::Request& pRequest, ra::api::UpdateCodeNote::Response& pResponse)
+        {
+            nApiCount++;
+            if (pRequest.Address == 0x1234U && !bFailed)
+            {
+                bFailed = true;
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(3, nApiCount);
+        Assert::AreEqual(AssetChanges::None, vmUpload.CodeNotes().GetChanges());
+
         vmUpload.AssertSuccess(2);
     }
 };
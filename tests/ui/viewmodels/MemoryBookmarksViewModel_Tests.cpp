@@ -578,6 +578,134 @@ public:
         Assert::AreEqual(15, (int)memory.at(18));
     }
 
+    TEST_METHOD(TestDoFrameGroupedBookmarks)
+    {
+        MemoryBookmarksViewModelHarness bookmarks;
+        std::array<uint8_t, 64> memory = {};
+        for (uint8_t i = 0; i < memory.size(); ++i)
+            memory.at(i) = i;
+        bookmarks.mockEmulatorContext.MockMemory(memory);
+
+        // out of order, overlapping, and separated by gaps of varying sizes
+        bookmarks.AddBookmark(40U, MemSize::EightBit);
+        bookmarks.AddBookmark(4U, MemSize::SixteenBit);
+        bookmarks.AddBookmark(5U, MemSize::SixteenBitBigEndian);
+        bookmarks.AddBookmark(12U, MemSize::ThirtyTwoBit);
+        bookmarks.AddBookmark(13U, MemSize::Nibble_Upper);
+        bookmarks.AddBookmark(60U, MemSize::TwentyFourBit);
+        auto& bookmark40 = *bookmarks.Bookmarks().GetItemAt(0);
+        auto& bookmark4 = *bookmarks.Bookmarks().GetItemAt(1);
+        auto& bookmark5 = *bookmarks.Bookmarks().GetItemAt(2);
+        auto& bookmark12 = *bookmarks.Bookmarks().GetItemAt(3);
+        auto& bookmark13 = *bookmarks.Bookmarks().GetItemAt(4);
+        auto& bookmark60 = *bookmarks.Bookmarks().GetItemAt(5);
+
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"28"), bookmark40.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"0504"), bookmark4.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"0506"), bookmark5.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"0f0e0d0c"), bookmark12.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"0"), bookmark13.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"3e3d3c"), bookmark60.GetCurrentValue());
+
+        memory.at(5) = 0xAB;
+        memory.at(13) = 0x47;
+        memory.at(62) = 0x99;
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"28"), bookmark40.GetCurrentValue());
+        Assert::AreEqual(0U, bookmark40.GetChanges());
+        Assert::AreEqual(std::wstring(L"ab04"), bookmark4.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark4.GetChanges());
+        Assert::AreEqual(std::wstring(L"ab06"), bookmark5.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark5.GetChanges());
+        Assert::AreEqual(std::wstring(L"0f0e470c"), bookmark12.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark12.GetChanges());
+        Assert::AreEqual(std::wstring(L"4"), bookmark13.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark13.GetChanges());
+        Assert::AreEqual(std::wstring(L"993d3c"), bookmark60.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark60.GetChanges());
+
+        // moving a bookmark should read from the new address
+        bookmark40.SetAddress(20U);
+        Assert::AreEqual(std::wstring(L"14"), bookmark40.GetCurrentValue());
+        memory.at(20) = 0x55;
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"55"), bookmark40.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"14"), bookmark40.GetPreviousValue());
+
+        // removing a bookmark should not affect the others
+        bookmarks.Bookmarks().RemoveAt(1);
+        memory.at(6) = 0x66;
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"ab66"), bookmark5.GetCurrentValue());
+        Assert::AreEqual(2U, bookmark5.GetChanges());
+    }
+
+    TEST_METHOD(TestDoFrameBookmarksAcrossBlockBoundary)
+    {
+        MemoryBookmarksViewModelHarness bookmarks;
+        std::array<uint8_t, 64> memory = {};
+        for (uint8_t i = 0; i < memory.size(); ++i)
+            memory.at(i) = i;
+        bookmarks.mockEmulatorContext.MockMemory(memory);
+        bookmarks.mockAchievementRuntime.ActivateAchievement(1, "0xH003e=62");
+        bookmarks.mockAchievementRuntime.ActivateAchievement(2, "0xH0040=0");
+
+        // adjacent bookmarks on either side of the end of the readable memory
+        bookmarks.AddBookmark(62U, MemSize::EightBit);
+        bookmarks.AddBookmark(64U, MemSize::EightBit);
+        auto& bookmark62 = *bookmarks.Bookmarks().GetItemAt(0);
+        auto& bookmark64 = *bookmarks.Bookmarks().GetItemAt(1);
+        bookmarks.DoFrame();
+
+        // then the following memory is registered as unreadable
+        bookmarks.mockEmulatorContext.AddMemoryBlock(1, 16, nullptr, nullptr);
+        memory.at(62) = 0x12;
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"12"), bookmark62.GetCurrentValue());
+        Assert::AreEqual(std::wstring(L"00"), bookmark64.GetCurrentValue());
+
+        // only the achievement using the unreadable address is disabled
+        Assert::IsTrue(bookmarks.mockAchievementRuntime.IsAchievementSupported(1));
+        Assert::IsFalse(bookmarks.mockAchievementRuntime.IsAchievementSupported(2));
+    }
+
+    TEST_METHOD(TestDoFrameFrozenOverlapping)
+    {
+        MemoryBookmarksViewModelHarness bookmarks;
+        std::array<uint8_t, 64> memory = {};
+        for (uint8_t i = 0; i < memory.size(); ++i)
+            memory.at(i) = i;
+        bookmarks.mockEmulatorContext.MockMemory(memory);
+
+        bookmarks.AddBookmark(8U, MemSize::SixteenBit);
+        bookmarks.AddBookmark(9U, MemSize::EightBit);
+        bookmarks.AddBookmark(8U, MemSize::EightBit);
+        auto& bookmark16 = *bookmarks.Bookmarks().GetItemAt(0);
+        auto& bookmark9 = *bookmarks.Bookmarks().GetItemAt(1);
+        auto& bookmark8 = *bookmarks.Bookmarks().GetItemAt(2);
+        bookmark8.SetBehavior(MemoryBookmarksViewModel::BookmarkBehavior::Frozen);
+
+        bookmarks.DoFrame();
+        Assert::AreEqual(std::wstring(L"0908"), bookmark16.GetCurrentValue());
+
+        // frozen byte is restored before the overlapping bookmark is evaluated
+        memory.at(8) = 0x77;
+        memory.at(9) = 0x44;
+        bookmarks.DoFrame();
+        Assert::AreEqual(8, (int)memory.at(8));
+        Assert::AreEqual(std::wstring(L"08"), bookmark8.GetCurrentValue());
+        Assert::AreEqual(0U, bookmark8.GetChanges());
+        Assert::AreEqual(std::wstring(L"4408"), bookmark16.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark16.GetChanges());
+        Assert::AreEqual(std::wstring(L"44"), bookmark9.GetCurrentValue());
+        Assert::AreEqual(1U, bookmark9.GetChanges());
+
+        bookmarks.DoFrame();
+        Assert::AreEqual(1U, bookmark16.GetChanges());
+        Assert::AreEqual(1U, bookmark9.GetChanges());
+    }
+
     TEST_METHOD(TestAddBookmark)
     {
         MemoryBookmarksViewModelHarness bookmarks;
@@ -4,9 +4,12 @@
 
 #include "services\ServiceLocator.hh"
 
+#include "ui\EditorTheme.hh"
+
 #include "tests\RA_UnitTestHelpers.h"
 #include "tests\mocks\MockEmulatorContext.hh"
 #include "tests\mocks\MockGameContext.hh"
+#include "tests\mocks\MockSurface.hh"
 #include "tests\mocks\MockWindowManager.hh"
 
 #undef GetMessage
@@ -20,6 +23,8 @@ namespace tests {
 
 constexpr unsigned char COLOR_RED = gsl::narrow_cast<unsigned char>(ra::etoi(MemoryViewerViewModel::TextColor::Selected));
 constexpr unsigned char COLOR_BLACK = gsl::narrow_cast<unsigned char>(ra::etoi(MemoryViewerViewModel::TextColor::Default));
+constexpr unsigned char COLOR_BOOKMARK = gsl::narrow_cast<unsigned char>(ra::etoi(MemoryViewerViewModel::TextColor::HasBookmark));
+constexpr unsigned char COLOR_FROZEN = gsl::narrow_cast<unsigned char>(ra::etoi(MemoryViewerViewModel::TextColor::Frozen));
 constexpr unsigned char COLOR_REDRAW = 0x80;
 
 constexpr int CHAR_WIDTH = 8;
@@ -83,6 +88,18 @@ private:
             DoFrame(); // populates m_pMemory and m_pColor
         }
 
+        void MockMemoryByte(ra::ByteAddress nAddress, unsigned char nValue) noexcept
+        {
+            m_pBytes[nAddress] = nValue;
+        }
+
+        int GetDrawSurfaceCount() const
+        {
+            const auto* pSurface = dynamic_cast<const ra::ui::drawing::mocks::MockSurface*>(&GetRenderImage());
+            Expects(pSurface != nullptr);
+            return pSurface->GetDrawSurfaceCount();
+        }
+
         void MockRender() noexcept
         {
             for (size_t i = 0; i < m_nTotalMemorySize; ++i)
@@ -1849,6 +1866,67 @@ public:
         Assert::IsTrue(viewer.NeedsRedraw());
         viewer.MockRender();
     }
+
+    TEST_METHOD(TestUpdateColorsBookmarks)
+    {
+        MemoryViewerViewModelHarness viewer;
+        viewer.InitializeMemory(256);
+        viewer.MockRender();
+
+        auto& pBookmarks = viewer.mockWindowManager.MemoryBookmarks.Bookmarks();
+        pBookmarks.BeginUpdate();
+        pBookmarks.Add().SetAddress(4U);
+        pBookmarks.Add().SetAddress(6U);
+        pBookmarks.GetItemAt(1)->SetBehavior(MemoryBookmarksViewModel::BookmarkBehavior::Frozen);
+        pBookmarks.Add().SetAddress(6U); // frozen bookmark takes priority over unfrozen bookmark at same address
+        pBookmarks.Add().SetAddress(200U); // not visible
+        pBookmarks.EndUpdate();
+
+        Assert::AreEqual({ COLOR_RED | COLOR_REDRAW }, viewer.GetColor(0U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(3U));
+        Assert::AreEqual({ COLOR_BOOKMARK | COLOR_REDRAW }, viewer.GetColor(4U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(5U));
+        Assert::AreEqual({ COLOR_FROZEN | COLOR_REDRAW }, viewer.GetColor(6U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(7U));
+
+        viewer.SetFirstAddress(128U);
+        Assert::AreEqual({ COLOR_BOOKMARK | COLOR_REDRAW }, viewer.GetColor(200U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(201U));
+    }
+
+    TEST_METHOD(TestRenderOnlyDrawsStaleBytes)
+    {
+        MemoryViewerViewModelHarness viewer;
+        ra::ui::drawing::mocks::MockSurfaceFactory mockSurfaceFactory;
+        ra::ui::EditorTheme pTheme;
+        ra::services::ServiceLocator::ServiceOverride<ra::ui::EditorTheme> pThemeOverride(&pTheme, false);
+        viewer.InitializeMemory(256);
+
+        // initial render draws every visible byte with a single blit
+        viewer.UpdateRenderImage();
+        Assert::AreEqual(128, viewer.GetDrawSurfaceCount());
+        Assert::IsFalse(viewer.NeedsRedraw());
+
+        // nothing changed, nothing drawn
+        viewer.DoFrame();
+        Assert::IsFalse(viewer.NeedsRedraw());
+        viewer.UpdateRenderImage();
+        Assert::AreEqual(128, viewer.GetDrawSurfaceCount());
+
+        // only the changed bytes are redrawn
+        viewer.MockMemoryByte(17U, 0x44);
+        viewer.MockMemoryByte(100U, 0x55);
+        viewer.DoFrame();
+        Assert::IsTrue(viewer.NeedsRedraw());
+        viewer.UpdateRenderImage();
+        Assert::AreEqual(130, viewer.GetDrawSurfaceCount());
+
+        // when the cursor is only on one nibble, the nibbles are drawn separately
+        viewer.SetReadOnly(false);
+        viewer.OnGotFocus();
+        viewer.UpdateRenderImage();
+        Assert::AreEqual(132, viewer.GetDrawSurfaceCount());
+    }
 };
 
 } // namespace tests
@@ -293,6 +293,34 @@ public:
         Assert::IsNull(overlay.GetScoreTracker(3)); // render should erase and destroy
     }
 
+    TEST_METHOD(TestRenderScoreTrackerOnlyRedrawsChangedTracker)
+    {
+        OverlayManagerHarness overlay;
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker, ra::ui::viewmodels::PopupLocation::BottomRight);
+
+        auto& vmScoreTracker1 = overlay.AddScoreTracker(1);
+        overlay.AddScoreTracker(2);
+
+        ra::ui::drawing::mocks::MockSurface mockSurface(800, 600);
+        overlay.Render(mockSurface, false);
+        Assert::AreEqual(2, mockSurface.GetDrawSurfaceCount());
+
+        // nothing changed, nothing should be redrawn
+        mockSurface.ResetDrawSurfaceCount();
+        overlay.Render(mockSurface, false);
+        Assert::AreEqual(0, mockSurface.GetDrawSurfaceCount());
+
+        // value changed, but size did not. only the changed tracker should be redrawn
+        vmScoreTracker1.SetDisplayText(L"5");
+        overlay.Render(mockSurface, false);
+        Assert::AreEqual(1, mockSurface.GetDrawSurfaceCount());
+
+        // full redraw requested, both trackers should be redrawn
+        mockSurface.ResetDrawSurfaceCount();
+        overlay.Render(mockSurface, true);
+        Assert::AreEqual(2, mockSurface.GetDrawSurfaceCount());
+    }
+
     TEST_METHOD(TestQueueScoreboard)
     {
         OverlayManagerHarness overlay;
@@ -520,6 +548,67 @@ public:
         Assert::IsTrue(&vmIndicator == &vmIndicator2);
     }
 
+    TEST_METHOD(TestCaptureScreenshotEncodesInBackground)
+    {
+        OverlayManagerHarness overlay;
+        overlay.mockDesktop.SetClientAreaSize(800, 600);
+        overlay.mockImageRepository.SetImageAvailable(ra::ui::ImageType::Badge, "12345");
+        const auto nId = overlay.QueueMessage(L"Title", L"Description", ra::ui::ImageType::Badge, "12345");
+
+        // capture only copies the client area, everything else is deferred
+        overlay.CaptureScreenshot(nId, L"screenshot.png");
+        Assert::AreEqual({ 1U }, overlay.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 0U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+
+        // compose step hands the image off to the writer
+        overlay.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 1U }, overlay.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 0U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+
+        // writer encodes and saves the image
+        overlay.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 0U }, overlay.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 1U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+        Assert::AreEqual(std::wstring(L"screenshot.png"), overlay.mockSurfaceFactory.GetSavedImages().at(0));
+
+        // second screenshot should reuse the surface from the first. only the transparent copy of the
+        // popup should be allocated.
+        overlay.AdvanceFrame();
+        const auto nSurfacesCreated = overlay.mockSurfaceFactory.GetSurfacesCreated();
+        overlay.CaptureScreenshot(nId, L"screenshot2.png");
+        overlay.mockThreadPool.ExecuteNextTask();
+        overlay.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 2U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+        Assert::AreEqual(std::wstring(L"screenshot2.png"), overlay.mockSurfaceFactory.GetSavedImages().at(1));
+        Assert::AreEqual(1, overlay.mockSurfaceFactory.GetSurfacesCreated() - nSurfacesCreated);
+    }
+
+    TEST_METHOD(TestCaptureScreenshotSaveQueueBounded)
+    {
+        OverlayManagerHarness overlay;
+        overlay.mockDesktop.SetClientAreaSize(800, 600);
+        overlay.mockImageRepository.SetImageAvailable(ra::ui::ImageType::Badge, "12345");
+        const auto nId = overlay.QueueMessage(L"Title", L"Description", ra::ui::ImageType::Badge, "12345");
+
+        for (int i = 1; i <= 5; ++i)
+        {
+            overlay.CaptureScreenshot(nId, ra::StringPrintf(L"screenshot%d.png", i));
+            overlay.AdvanceFrame();
+        }
+
+        // only four images can be waiting for the writer. the fifth has to wait
+        overlay.mockThreadPool.ExecuteNextTask();
+        overlay.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 4U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+        Assert::AreEqual({ 1U }, overlay.mockThreadPool.PendingTasks());
+
+        overlay.mockThreadPool.AdvanceTime(std::chrono::milliseconds(200));
+        overlay.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 5U }, overlay.mockSurfaceFactory.GetSavedImages().size());
+        Assert::AreEqual(std::wstring(L"screenshot5.png"), overlay.mockSurfaceFactory.GetSavedImages().at(4));
+        Assert::AreEqual({ 0U }, overlay.mockThreadPool.PendingTasks());
+    }
+
     TEST_METHOD(TestShowHideOverlay)
     {
         OverlayManagerHarness overlay;
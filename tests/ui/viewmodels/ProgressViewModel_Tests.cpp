@@ -112,6 +112,81 @@ public:
         Assert::AreEqual(DialogResult::OK, vmProgress.GetDialogResult());
     }
 
+    TEST_METHOD(TestTaskQueuedWhileOtherTaskRunning)
+    {
+        ProgressViewModelHarness vmProgress;
+        std::string sOrder;
+        vmProgress.QueueTask([&vmProgress, &sOrder]()
+        {
+            sOrder.push_back('A');
+
+            // run the second worker while this task is still in progress. it will process the second
+            // task, and then exit because there's nothing else to start.
+            Assert::AreEqual({ 1U }, vmProgress.mockThreadPool.PendingTasks());
+            vmProgress.mockThreadPool.ExecuteNextTask();
+            Assert::AreEqual(std::string("AB"), sOrder);
+
+            // queue is not complete because this task is still running
+            Assert::AreEqual(DialogResult::None, vmProgress.GetDialogResult());
+
+            // queueing a task while processing will start another worker, as one just exited
+            vmProgress.QueueTask([&sOrder]() { sOrder.push_back('C'); });
+            Assert::AreEqual({ 1U }, vmProgress.mockThreadPool.PendingTasks());
+        });
+        vmProgress.QueueTask([&sOrder]() { sOrder.push_back('B'); });
+
+        vmProgress.SetIsVisible(true);
+        Assert::AreEqual({ 2U }, vmProgress.mockThreadPool.PendingTasks());
+
+        // the first worker will pick up the task queued by the first task after it completes
+        vmProgress.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(std::string("ABC"), sOrder);
+        Assert::AreEqual({ 3U }, vmProgress.TaskCount());
+        Assert::AreEqual(100, vmProgress.GetProgress());
+        Assert::AreEqual(DialogResult::OK, vmProgress.GetDialogResult());
+
+        // the new worker will be starved in the mock pool. flush it too
+        Assert::AreEqual({ 1U }, vmProgress.mockThreadPool.PendingTasks());
+        vmProgress.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 0U }, vmProgress.mockThreadPool.PendingTasks());
+        Assert::AreEqual(std::string("ABC"), sOrder);
+        Assert::AreEqual(DialogResult::OK, vmProgress.GetDialogResult());
+    }
+
+    TEST_METHOD(TestPriorityTask)
+    {
+        ProgressViewModelHarness vmProgress;
+        std::string sOrder;
+        vmProgress.QueueTask([&vmProgress, &sOrder]()
+        {
+            sOrder.push_back('1');
+
+            // priority task should run before the remaining tasks, normal task should run after
+            vmProgress.QueueTask([&sOrder]() { sOrder.push_back('4'); });
+            vmProgress.QueuePriorityTask([&sOrder]() { sOrder.push_back('Q'); });
+        });
+        vmProgress.QueueTask([&sOrder]() { sOrder.push_back('2'); });
+        vmProgress.QueueTask([&sOrder]() { sOrder.push_back('3'); });
+        vmProgress.QueuePriorityTask([&sOrder]() { sOrder.push_back('P'); });
+        Assert::AreEqual({ 4U }, vmProgress.TaskCount());
+
+        vmProgress.SetIsVisible(true);
+        Assert::AreEqual({ 4U }, vmProgress.mockThreadPool.PendingTasks());
+        vmProgress.mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual(std::string("P1Q234"), sOrder);
+        Assert::AreEqual({ 6U }, vmProgress.TaskCount());
+        Assert::AreEqual(100, vmProgress.GetProgress());
+        Assert::AreEqual(DialogResult::OK, vmProgress.GetDialogResult());
+
+        // maximum number of workers were already started, so no new ones should have been queued
+        Assert::AreEqual({ 3U }, vmProgress.mockThreadPool.PendingTasks());
+        vmProgress.mockThreadPool.ExecuteNextTask();
+        vmProgress.mockThreadPool.ExecuteNextTask();
+        vmProgress.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 0U }, vmProgress.mockThreadPool.PendingTasks());
+    }
+
     TEST_METHOD(TestCancel)
     {
         ProgressViewModelHarness vmProgress;
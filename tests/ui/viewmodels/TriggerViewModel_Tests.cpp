@@ -2,6 +2,8 @@
 
 #include "ui\viewmodels\TriggerViewModel.hh"
 
+#include "ui\EditorTheme.hh"
+
 #include "tests\ui\UIAsserts.hh"
 #include "tests\mocks\MockClipboard.hh"
 #include "tests\mocks\MockConfiguration.hh"
@@ -110,6 +112,43 @@ private:
         TriggerViewModel* m_vmTrigger;
     };
 
+    class ConditionRowMonitor : public ViewModelCollectionBase::NotifyTarget
+    {
+    public:
+        ConditionRowMonitor(TriggerViewModel& vmTrigger) noexcept : m_vmTrigger(vmTrigger)
+        {
+            vmTrigger.Conditions().AddNotifyTarget(*this);
+        }
+
+        ~ConditionRowMonitor() noexcept
+        {
+            m_vmTrigger.Conditions().RemoveNotifyTarget(*this);
+        }
+
+        ConditionRowMonitor(const ConditionRowMonitor&) noexcept = delete;
+        ConditionRowMonitor& operator=(const ConditionRowMonitor&) noexcept = delete;
+        ConditionRowMonitor(ConditionRowMonitor&&) noexcept = delete;
+        ConditionRowMonitor& operator=(ConditionRowMonitor&&) noexcept = delete;
+
+        int nUpdates = 0;
+        std::vector<gsl::index> vChangedHits;
+        std::vector<gsl::index> vChangedColors;
+
+    protected:
+        void OnBeginViewModelCollectionUpdate() noexcept override { ++nUpdates; }
+
+        void OnViewModelIntValueChanged(gsl::index nIndex, const IntModelProperty::ChangeArgs& args) override
+        {
+            if (args.Property == TriggerConditionViewModel::CurrentHitsProperty)
+                vChangedHits.push_back(nIndex);
+            else if (args.Property == TriggerConditionViewModel::RowColorProperty)
+                vChangedColors.push_back(nIndex);
+        }
+
+    private:
+        TriggerViewModel& m_vmTrigger;
+    };
+
 public:
     TEST_METHOD(TestInitialState)
     {
@@ -1302,6 +1341,150 @@ public:
         Assert::AreEqual(62U, vmTrigger.Conditions().GetItemAt(6)->GetTotalHits()); // end of hit-chain (2+12+48)
     }
 
+    TEST_METHOD(TestDoFrameOnlyUpdatesChangedHits)
+    {
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, "0=0.5._0=0.10._0=0.20.");
+        Assert::AreEqual({ 3U }, vmTrigger.Conditions().Count());
+
+        auto* cond = vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions;
+        cond->current_hits = 1;
+        cond->next->current_hits = 2;
+        cond->next->next->current_hits = 3;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(1U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+        Assert::AreEqual(2U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
+        Assert::AreEqual(3U, vmTrigger.Conditions().GetItemAt(2)->GetCurrentHits());
+
+        ConditionRowMonitor pMonitor(vmTrigger);
+
+        // nothing changed, nothing should be updated
+        vmTrigger.DoFrame();
+        Assert::AreEqual(0, pMonitor.nUpdates);
+        Assert::AreEqual({ 0U }, pMonitor.vChangedHits.size());
+
+        // only the second condition changed
+        cond->next->current_hits = 4;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(1, pMonitor.nUpdates);
+        Assert::AreEqual({ 1U }, pMonitor.vChangedHits.size());
+        Assert::AreEqual({ 1 }, pMonitor.vChangedHits.at(0));
+        Assert::AreEqual(1U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+        Assert::AreEqual(4U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
+        Assert::AreEqual(3U, vmTrigger.Conditions().GetItemAt(2)->GetCurrentHits());
+
+        // hits reset
+        cond->current_hits = 0;
+        cond->next->current_hits = 0;
+        cond->next->next->current_hits = 0;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2, pMonitor.nUpdates);
+        Assert::AreEqual({ 4U }, pMonitor.vChangedHits.size());
+        Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+        Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
+        Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(2)->GetCurrentHits());
+    }
+
+    TEST_METHOD(TestDoFrameHitsChainPartialUpdate)
+    {
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, "0=0.5._C:0=0.10._0=0.20._0=0.30._C:0=0.50._D:0=0.60._0=0.70.");
+        Assert::AreEqual({ 1U }, vmTrigger.Groups().Count());
+
+        auto* cond = vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions;
+        cond->next->current_hits = 3;                   // AddHits 0=0 (10)
+        cond->next->next->current_hits = 6;             //         0=0 (20)
+        vmTrigger.DoFrame();
+        Assert::AreEqual(9U, vmTrigger.Conditions().GetItemAt(2)->GetTotalHits()); // end of hit-chain (3+6)
+        Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(6)->GetTotalHits()); // end of new hit-chain (empty)
+
+        // only the AddHits changed, the total at the end of the chain should still be updated
+        cond->next->current_hits = 5;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(5U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
+        Assert::AreEqual(6U, vmTrigger.Conditions().GetItemAt(2)->GetCurrentHits());
+        Assert::AreEqual(11U, vmTrigger.Conditions().GetItemAt(2)->GetTotalHits()); // end of hit-chain (5+6)
+        Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(6)->GetTotalHits()); // end of new hit-chain (empty)
+    }
+
+    TEST_METHOD(TestDoFrameAfterGroupChange)
+    {
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, "0=0.5.S0=0.10.S0=0.20.");
+        Assert::AreEqual({ 3U }, vmTrigger.Groups().Count());
+
+        vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions->current_hits = 2;
+        vmTrigger.Groups().GetItemAt(1)->m_pConditionSet->conditions->current_hits = 2;
+        vmTrigger.Groups().GetItemAt(2)->m_pConditionSet->conditions->current_hits = 7;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+
+        // changing groups should resynchronize with the new group
+        vmTrigger.SetSelectedGroupIndex(1);
+        vmTrigger.Groups().GetItemAt(1)->m_pConditionSet->conditions->current_hits = 3;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(3U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+
+        vmTrigger.SetSelectedGroupIndex(2);
+        vmTrigger.DoFrame();
+        Assert::AreEqual(7U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+
+        vmTrigger.SetSelectedGroupIndex(0);
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+    }
+
+    TEST_METHOD(TestUpdateColorsOnlyUpdatesChangedRows)
+    {
+        TriggerViewModelHarness vmTrigger;
+        ra::ui::EditorTheme pTheme;
+        ra::services::ServiceLocator::ServiceOverride<ra::ui::EditorTheme> pThemeOverride(&pTheme, false);
+        const auto nDefaultColor = ra::to_unsigned(TriggerConditionViewModel::RowColorProperty.GetDefaultValue());
+
+        Parse(vmTrigger, "0=0_0=0.10._0=0");
+        Assert::AreEqual({ 3U }, vmTrigger.Conditions().Count());
+
+        rc_trigger_t pTrigger;
+        memset(&pTrigger, 0, sizeof(pTrigger));
+        pTrigger.requirement = vmTrigger.Groups().GetItemAt(0)->m_pConditionSet;
+        pTrigger.has_hits = 1;
+
+        auto* cond = pTrigger.requirement->conditions;
+        cond->is_true = 1;
+        cond->next->is_true = 1;
+        cond->next->current_hits = 4;
+        vmTrigger.UpdateColors(&pTrigger);
+        Assert::AreEqual(pTheme.ColorTriggerIsTrue().ARGB, vmTrigger.Conditions().GetItemAt(0)->GetRowColor().ARGB);
+        Assert::AreEqual(pTheme.ColorTriggerBecomingTrue().ARGB, vmTrigger.Conditions().GetItemAt(1)->GetRowColor().ARGB);
+        Assert::AreEqual(nDefaultColor, vmTrigger.Conditions().GetItemAt(2)->GetRowColor().ARGB);
+
+        ConditionRowMonitor pMonitor(vmTrigger);
+
+        // nothing changed
+        vmTrigger.UpdateColors(&pTrigger);
+        Assert::AreEqual({ 0U }, pMonitor.vChangedColors.size());
+
+        // hit target met
+        cond->next->current_hits = 10;
+        vmTrigger.UpdateColors(&pTrigger);
+        Assert::AreEqual({ 1U }, pMonitor.vChangedColors.size());
+        Assert::AreEqual({ 1 }, pMonitor.vChangedColors.at(0));
+        Assert::AreEqual(pTheme.ColorTriggerIsTrue().ARGB, vmTrigger.Conditions().GetItemAt(1)->GetRowColor().ARGB);
+
+        // third condition became true
+        cond->next->next->is_true = 1;
+        vmTrigger.UpdateColors(&pTrigger);
+        Assert::AreEqual({ 2U }, pMonitor.vChangedColors.size());
+        Assert::AreEqual({ 2 }, pMonitor.vChangedColors.at(1));
+        Assert::AreEqual(pTheme.ColorTriggerIsTrue().ARGB, vmTrigger.Conditions().GetItemAt(2)->GetRowColor().ARGB);
+
+        // highlights disabled
+        vmTrigger.UpdateColors(nullptr);
+        Assert::AreEqual(nDefaultColor, vmTrigger.Conditions().GetItemAt(0)->GetRowColor().ARGB);
+        Assert::AreEqual(nDefaultColor, vmTrigger.Conditions().GetItemAt(1)->GetRowColor().ARGB);
+        Assert::AreEqual(nDefaultColor, vmTrigger.Conditions().GetItemAt(2)->GetRowColor().ARGB);
+    }
+
     TEST_METHOD(TestBuildHitChainTooltip)
     {
         TriggerViewModelHarness vmTrigger;